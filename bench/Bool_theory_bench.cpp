@@ -0,0 +1,62 @@
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "test.h"
+#include "Bool_theory.h"
+
+TEST_CASE("Boolean constraint propagation", "[benchmark][bool_theory]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    constexpr int num_vars = 2'000;
+    constexpr int num_clauses = 8'000;
+
+    // random 3-SAT formula below the phase transition (most decisions do not end in a conflict)
+    std::mt19937 eng{42};
+    std::uniform_int_distribution<int> var_dist{0, num_vars - 1};
+    std::bernoulli_distribution sign_dist;
+    Database db;
+    for (int i = 0; i < num_clauses; ++i)
+    {
+        std::vector<Literal> lits;
+        for (int j = 0; j < 3; ++j)
+        {
+            auto l = lit(var_dist(eng));
+            lits.push_back(sign_dist(eng) ? ~l : l);
+        }
+        db.assert_clause(std::move(lits));
+    }
+
+    Bool_theory theory;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&theory);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, num_vars);
+    trail.resize(Variable::boolean, num_vars);
+    theory.propagate(db, trail);
+
+    BENCHMARK("decide and propagate until a conflict")
+    {
+        int decisions = 0;
+        for (int ord = 0; ord < num_vars; ++ord)
+        {
+            if (model.is_defined(ord))
+            {
+                continue;
+            }
+            model.set_value(ord, sign_dist(eng));
+            trail.decide(bool_var(ord));
+            ++decisions;
+            if (!theory.propagate(db, trail).empty())
+            {
+                break;
+            }
+        }
+        dispatcher.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        return decisions;
+    };
+}
@@ -0,0 +1,78 @@
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "test.h"
+#include "Linear_arithmetic.h"
+
+TEST_CASE("Propagation in linear arithmetic", "[benchmark][linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    constexpr int num_vars = 200;
+    constexpr int num_constraints = 2'000;
+    constexpr int vars_per_constraint = 3;
+
+    Database db;
+    Linear_arithmetic lra;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    auto& model = trail.set_model<Rational>(Variable::rational, num_vars);
+
+    // random constraints `c1 * x + c2 * y + c3 * z <= c` which hold at level 0
+    std::mt19937 eng{42};
+    std::uniform_int_distribution<int> var_dist{0, num_vars - 1};
+    std::uniform_int_distribution<int> coef_dist{-10, 10};
+    std::uniform_int_distribution<int> rhs_dist{0, 100};
+    std::vector<Literal> constraints;
+    for (int i = 0; i < num_constraints; ++i)
+    {
+        std::vector<int> vars;
+        std::vector<Rational> coef;
+        for (int j = 0; j < vars_per_constraint; ++j)
+        {
+            vars.push_back(var_dist(eng));
+            auto value = coef_dist(eng);
+            coef.emplace_back(value == 0 ? 1 : value);
+        }
+        auto cons = lra.constraint(trail, vars, coef, Order_predicate::leq, Rational{rhs_dist(eng)});
+        constraints.push_back(cons.lit());
+    }
+
+    auto& bool_model = trail.model<bool>(Variable::boolean);
+    for (auto lit : constraints)
+    {
+        if (!bool_model.is_defined(lit.var().ord()))
+        {
+            bool_model.set_value(lit.var().ord(), !lit.is_negation());
+            trail.propagate(lit.var(), nullptr, 0);
+        }
+    }
+    lra.propagate(db, trail);
+
+    BENCHMARK("decide rational variables and propagate bounds")
+    {
+        int decisions = 0;
+        for (int ord = 0; ord < num_vars; ++ord)
+        {
+            if (model.is_defined(ord))
+            {
+                continue;
+            }
+            lra.decide(db, trail, real_var(ord));
+            ++decisions;
+            if (!lra.propagate(db, trail).empty())
+            {
+                break;
+            }
+        }
+        dispatcher.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        return decisions;
+    };
+}
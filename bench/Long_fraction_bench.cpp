@@ -0,0 +1,62 @@
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "Long_fraction.h"
+
+TEST_CASE("Long fraction arithmetic", "[benchmark][long_fraction]")
+{
+    using namespace yaga;
+
+    constexpr int count = 10'000;
+
+    std::mt19937 eng{42};
+    std::uniform_int_distribution<int> num_dist{1, 1'000};
+    std::uniform_int_distribution<int> den_dist{1, 1'000};
+    std::bernoulli_distribution sign_dist;
+    std::vector<Long_fraction> values;
+    for (int i = 0; i < count; ++i)
+    {
+        auto num = num_dist(eng);
+        values.emplace_back(sign_dist(eng) ? -num : num, den_dist(eng));
+    }
+
+    BENCHMARK("multiply and add small values")
+    {
+        int num_negative = 0;
+        for (int i = 0; i + 2 < count; ++i)
+        {
+            if (values[i] * values[i + 1] + values[i + 2] < 0)
+            {
+                ++num_negative;
+            }
+        }
+        return num_negative;
+    };
+
+    BENCHMARK("divide and compare small values")
+    {
+        int num_less = 0;
+        for (int i = 0; i + 1 < count; ++i)
+        {
+            if (values[i] / values[i + 1] < values[i])
+            {
+                ++num_less;
+            }
+        }
+        return num_less;
+    };
+
+    // the product overflows machine words after a few steps so this measures the GMP path
+    BENCHMARK("multiply large values")
+    {
+        Long_fraction product{1};
+        for (int i = 0; i < 200; ++i)
+        {
+            product *= values[i] + Long_fraction{1'000'003};
+        }
+        return product;
+    };
+}
@@ -0,0 +1,97 @@
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <vector>
+
+#include "Term_manager.h"
+#include "Terms.h"
+
+namespace {
+
+using namespace yaga;
+using namespace yaga::terms;
+
+// create `count` distinct polynomials `i * x + y` in `table`
+term_t make_polynomials(Term_table& table, term_t x, term_t y, int count)
+{
+    term_t last = null_term;
+    for (int i = 1; i <= count; ++i)
+    {
+        std::array<term_t, 2> monomials{table.arithmetic_product(Rational{i}, x),
+                                        table.arithmetic_product(Rational{1}, y)};
+        last = table.arithmetic_polynomial(monomials);
+    }
+    return last;
+}
+
+} // namespace
+
+TEST_CASE("Term manager construction of formulas", "[benchmark][terms]")
+{
+    constexpr int num_vars = 100;
+    constexpr int num_atoms = 10'000;
+
+    BENCHMARK("create linear atoms and clauses")
+    {
+        Term_manager tm;
+        std::vector<term_t> vars;
+        for (int i = 0; i < num_vars; ++i)
+        {
+            vars.push_back(tm.mk_uninterpreted_constant(types::real_type));
+        }
+
+        // atoms `c1 * x + c2 * y + z <= c3` chained by binary clauses
+        term_t last = false_term;
+        term_t result = true_term;
+        for (int i = 0; i < num_atoms; ++i)
+        {
+            std::array<term_t, 2> lhs_product{tm.mk_arithmetic_constant(Rational{i % 13 + 1}),
+                                              vars[i % num_vars]};
+            std::array<term_t, 2> rhs_product{tm.mk_arithmetic_constant(Rational{-(i % 7) - 1}),
+                                              vars[(i * 7 + 1) % num_vars]};
+            std::array<term_t, 3> addends{tm.mk_arithmetic_times(lhs_product),
+                                          tm.mk_arithmetic_times(rhs_product),
+                                          vars[(i * 31 + 2) % num_vars]};
+            auto atom = tm.mk_arithmetic_leq(tm.mk_arithmetic_plus(addends),
+                                             tm.mk_arithmetic_constant(Rational{i % 100}));
+            result = tm.mk_binary_or(opposite_term(last), atom);
+            last = atom;
+        }
+        return result;
+    };
+}
+
+TEST_CASE("Term table construction of polynomials", "[benchmark][terms]")
+{
+    constexpr int count = 100'000;
+
+    BENCHMARK("create new terms")
+    {
+        Term_table table;
+        auto x = table.new_uninterpreted_constant(types::real_type);
+        auto y = table.new_uninterpreted_constant(types::real_type);
+        return make_polynomials(table, x, y, count);
+    };
+
+    Term_table table;
+    auto x = table.new_uninterpreted_constant(types::real_type);
+    auto y = table.new_uninterpreted_constant(types::real_type);
+    make_polynomials(table, x, y, count);
+
+    BENCHMARK("look up existing terms") { return make_polynomials(table, x, y, count); };
+}
+
+TEST_CASE("Term manager construction of long sums", "[benchmark][terms]")
+{
+    Term_manager tm;
+    std::vector<term_t> addends;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        std::array<term_t, 2> product{tm.mk_arithmetic_constant(Rational{i % 7 + 1}),
+                                      tm.mk_uninterpreted_constant(types::real_type)};
+        addends.push_back(tm.mk_arithmetic_times(product));
+    }
+
+    BENCHMARK("sum of 10000 addends") { return tm.mk_arithmetic_plus(addends); };
+}
@@ -0,0 +1,46 @@
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "Variable_priority_queue.h"
+
+TEST_CASE("Variable priority queue operations", "[benchmark][variable_priority_queue]")
+{
+    using namespace yaga;
+
+    constexpr int num_vars = 100'000;
+
+    std::mt19937 eng{42};
+    std::uniform_int_distribution<int> var_dist{0, num_vars - 1};
+    std::uniform_real_distribution<float> score_dist{0.f, 1.f};
+    std::vector<float> scores(
+        Variable_priority_queue::index(Variable{num_vars - 1, Variable::rational}) + 1, 0.f);
+    Variable_priority_queue pq{scores};
+
+    BENCHMARK("push, bump and pop all variables")
+    {
+        for (int ord = 0; ord < num_vars; ++ord)
+        {
+            Variable var{ord, Variable::boolean};
+            scores[Variable_priority_queue::index(var)] = score_dist(eng);
+            pq.push(var);
+        }
+
+        // bump scores like conflict analysis does
+        for (int i = 0; i < num_vars; ++i)
+        {
+            Variable var{var_dist(eng), Variable::boolean};
+            scores[Variable_priority_queue::index(var)] += 1.f;
+            pq.increase(var);
+        }
+
+        int num_popped = 0;
+        for (; !pq.empty(); ++num_popped)
+        {
+            pq.pop();
+        }
+        return num_popped;
+    };
+}
@@ -2,6 +2,6 @@
 
 namespace yaga {
 
-Clause_id Clause::next_id = 0;
+std::atomic<Clause_id> Clause::next_id = 0;
 
 }
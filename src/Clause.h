@@ -1,6 +1,7 @@
 #ifndef YAGA_CLAUSE_H
 #define YAGA_CLAUSE_H
 
+#include <atomic>
 #include <cassert>
 #include <vector>
 
@@ -39,8 +40,9 @@ public:
     Clause_id id() const { return id_; }
 
 private:
-    static Clause_id next_id;
-    Clause_id id_ = next_id++;
+    // shared by all solvers (atomic since solvers can run in parallel threads)
+    static std::atomic<Clause_id> next_id;
+    Clause_id id_ = next_id.fetch_add(1, std::memory_order_relaxed);
 };
 
 
@@ -0,0 +1,55 @@
+#ifndef YAGA_CLAUSE_PTR_H
+#define YAGA_CLAUSE_PTR_H
+
+#include <cstdint>
+
+#include "Clause.h"
+#include "Literal.h"
+
+namespace yaga {
+
+/** Clause pointer proxy which also stores signature of the clause.
+ *
+ * Signature is a 64-bit mask of the clause such that if a clause A is a subset of a clause B,
+ * then A.sig() is a subset of B.sig() (but not necessarily vice versa)
+ */
+class Clause_ptr {
+public:
+    inline Clause_ptr() {}
+    inline Clause_ptr(Clause* ptr, std::uint64_t sig) : clause_ptr(ptr), clause_sig(sig) {}
+    inline Clause_ptr(Clause_ptr const&) = default;
+    inline Clause_ptr& operator=(Clause_ptr const&) = default;
+    inline Clause* operator->() { return clause_ptr; }
+    inline Clause& operator*() { return *clause_ptr; }
+    inline std::uint64_t sig() const { return clause_sig; }
+    inline bool operator==(Clause_ptr const& other) const { return clause_ptr == other.clause_ptr; }
+    inline bool operator!=(Clause_ptr const& other) const { return !operator==(other); }
+
+private:
+    // pointer to the clause
+    Clause* clause_ptr;
+    // clause signature
+    std::uint64_t clause_sig;
+};
+
+/** Compute signature of a clause and create a proxy object which includes this signature
+ *
+ * @param clause pointer to a clause
+ * @return proxy of @p clause with its signature
+ */
+inline Clause_ptr make_clause_ptr(Clause* clause)
+{
+    Literal_hash hash;
+
+    constexpr std::uint64_t MOD64 = (1 << 6) - 1; // bitmask for mod 64
+    std::uint64_t sig = 0;
+    for (auto lit : *clause)
+    {
+        sig |= 1UL << (hash(lit) & MOD64);
+    }
+    return {clause, sig};
+}
+
+} // namespace yaga
+
+#endif // YAGA_CLAUSE_PTR_H
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <thread>
+
+#include "Cube_and_conquer.h"
+
+namespace yaga {
+
+/** Listener which publishes short learned clauses of a worker and imports clauses of other
+ * workers on restart.
+ */
+class Cube_and_conquer::Exporter final : public Event_listener {
+public:
+    // index of the next shared clause to import
+    std::size_t next = 0;
+
+    Exporter(Cube_and_conquer& owner, int id, int num_vars)
+        : owner(owner), id(id), num_vars(num_vars)
+    {
+    }
+
+    void on_learned_clause(Database&, Trail&, Clause const& learned) override
+    {
+        if (learned.size() <= static_cast<std::size_t>(owner.options.max_shared_size) &&
+            std::all_of(learned.begin(), learned.end(),
+                        [&](auto lit) { return lit.var().ord() < num_vars; }))
+        {
+            owner.publish(id, learned);
+        }
+    }
+
+    void on_restart(Database& db, Trail& trail) override
+    {
+        // watched literals are initialized from scratch only if the trail is empty
+        if (trail.empty())
+        {
+            owner.import(id, next, db);
+        }
+    }
+
+private:
+    Cube_and_conquer& owner;
+    // index of the worker
+    int id;
+    // number of original boolean variables
+    int num_vars;
+};
+
+Cube_and_conquer::Cube_and_conquer(Setup setup, Options options)
+    : setup(std::move(setup)), options(options)
+{
+}
+
+void Cube_and_conquer::collect_statistics(Statistics& stats) const
+{
+    stats.set("cube.cubes", total_cubes);
+    stats.set("cube.splits", total_splits);
+    stats.set("cube.probes", total_probes);
+    stats.set("cube.shared_clauses", static_cast<std::uint64_t>(shared.size()));
+    stats.set("cube.imported_clauses", total_imported);
+}
+
+void Cube_and_conquer::init(Solver& solver)
+{
+    setup(solver);
+    // the preprocessor could eliminate variables used in cubes
+    solver.set_preprocessing(false);
+}
+
+bool Cube_and_conquer::next_cube(Cube& cube)
+{
+    std::unique_lock lock{mutex};
+    cube_available.wait(lock, [&] { return is_done || !cubes.empty() || num_busy == 0; });
+    if (is_done || cubes.empty()) // all cubes are refuted
+    {
+        is_done = true;
+        cube_available.notify_all();
+        return false;
+    }
+
+    cube = std::move(cubes.front());
+    cubes.pop_front();
+    ++num_busy;
+    ++total_cubes;
+    return true;
+}
+
+void Cube_and_conquer::finish(Solver::Result value)
+{
+    result = value;
+    is_done = true;
+    for (auto solver : solvers)
+    {
+        solver->terminate();
+    }
+    cube_available.notify_all();
+}
+
+void Cube_and_conquer::publish(int id, Clause const& clause)
+{
+    std::lock_guard lock{mutex};
+    shared.emplace_back(id, Literals{clause.begin(), clause.end()});
+}
+
+void Cube_and_conquer::import(int id, std::size_t& next, Database& db)
+{
+    std::lock_guard lock{mutex};
+    for (; next < shared.size(); ++next)
+    {
+        auto const& [source, literals] = shared[next];
+        if (source != id)
+        {
+            db.learn_clause(literals.begin(), literals.end());
+            ++total_imported;
+        }
+    }
+}
+
+void Cube_and_conquer::work(int id)
+{
+    Solver solver;
+    try
+    {
+        init(solver);
+        auto num_vars = static_cast<int>(solver.trail().model<bool>(Variable::boolean).num_vars());
+        Exporter exporter{*this, id, num_vars};
+        if (options.max_shared_size > 0)
+        {
+            solver.add_listener(&exporter);
+        }
+        Cuber cuber{num_vars, options.num_candidates};
+        Solver::Limits limits;
+        limits.conflicts = options.conflicts_per_cube;
+        solver.set_limits(limits);
+
+        {
+            std::lock_guard lock{mutex};
+            solvers.push_back(&solver);
+        }
+
+        auto is_stopped = [&] {
+            std::lock_guard lock{mutex};
+            return is_done;
+        };
+
+        Cube cube;
+        while (next_cube(cube))
+        {
+            if (options.max_shared_size > 0)
+            {
+                import(id, exporter.next, solver.db());
+            }
+
+            // `finish()` could have terminated the solver before it started the check
+            auto answer = is_stopped() ? Solver::Result::unknown : solver.check(cube);
+            std::vector<Cube> parts;
+            if (answer == Solver::Result::unknown && !is_stopped())
+            {
+                parts = cuber.split(solver, cube, /*depth=*/1);
+                if (parts.size() == 1 && parts.front().size() == cube.size() && !is_stopped())
+                {
+                    // there is no variable to split on so the worker finishes the cube itself
+                    solver.set_limits({});
+                    answer = solver.check(cube);
+                    solver.set_limits(limits);
+                    parts.clear();
+                }
+            }
+
+            std::lock_guard lock{mutex};
+            --num_busy;
+            if (is_done)
+            {
+                break;
+            }
+
+            if (answer == Solver::Result::sat)
+            {
+                bool_model = solver.trail().model<bool>(Variable::boolean);
+                finish(Solver::Result::sat);
+            }
+            else if (answer == Solver::Result::unsat && !solver.failed_assumption())
+            {
+                // asserted clauses are unsatisfiable regardless of the cube
+                finish(Solver::Result::unsat);
+            }
+            else if (answer == Solver::Result::unknown)
+            {
+                ++total_splits;
+                for (auto& part : parts)
+                {
+                    cubes.push_back(std::move(part));
+                }
+            }
+            cube_available.notify_all();
+        }
+
+        std::lock_guard lock{mutex};
+        total_probes += cuber.num_probes();
+    }
+    catch (...)
+    {
+        std::lock_guard lock{mutex};
+        if (!error)
+        {
+            error = std::current_exception();
+        }
+        finish(Solver::Result::unknown);
+    }
+
+    std::lock_guard lock{mutex};
+    std::erase(solvers, &solver);
+}
+
+Solver::Result Cube_and_conquer::solve()
+{
+    cubes.clear();
+    shared.clear();
+    num_busy = 0;
+    is_done = false;
+    result = Solver::Result::unsat;
+    error = nullptr;
+    total_cubes = total_splits = total_imported = total_probes = 0;
+
+    // generate enough cubes so that each worker gets several of them
+    int depth = 0;
+    while ((1 << depth) < options.num_workers * options.cubes_per_worker)
+    {
+        ++depth;
+    }
+
+    {
+        Solver solver;
+        init(solver);
+        auto num_vars = static_cast<int>(solver.trail().model<bool>(Variable::boolean).num_vars());
+        Cuber cuber{num_vars, options.num_candidates};
+        auto initial = cuber.split(solver, {}, depth);
+        cubes.assign(std::make_move_iterator(initial.begin()),
+                     std::make_move_iterator(initial.end()));
+        total_probes = cuber.num_probes();
+    }
+
+    if (cubes.empty()) // lookahead refuted all branches
+    {
+        return Solver::Result::unsat;
+    }
+
+    std::vector<std::thread> workers;
+    for (int id = 0; id < options.num_workers; ++id)
+    {
+        workers.emplace_back([this, id] { work(id); });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return result;
+}
+
+} // namespace yaga
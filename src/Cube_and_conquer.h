@@ -0,0 +1,148 @@
+#ifndef YAGA_CUBE_AND_CONQUER_H
+#define YAGA_CUBE_AND_CONQUER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Clause.h"
+#include "Cuber.h"
+#include "Database.h"
+#include "Model.h"
+#include "Solver.h"
+#include "Statistics.h"
+
+namespace yaga {
+
+/** Parallel solver which splits the problem into cubes by lookahead and solves them by
+ * independent solvers under assumptions.
+ *
+ * Cubes are kept in a shared queue from which idle workers take them. If a worker exceeds the
+ * conflict limit of a cube, it splits the cube into two by lookahead in its own solver and puts
+ * the new cubes back to the queue so that other workers can pick them up. Optionally, workers
+ * share short learned clauses which contain only boolean variables created by the setup function
+ * (original atoms). Other variables are local to each solver.
+ */
+class Cube_and_conquer {
+public:
+    using Cube = Cuber::Cube;
+
+    /** Function which initializes a new solver (it sets a theory, heuristics and asserts clauses)
+     *
+     * It is called concurrently from worker threads. Boolean variables have to be created in a
+     * deterministic order so that their ordinal numbers denote the same atoms in all solvers.
+     */
+    using Setup = std::function<void(Solver&)>;
+
+    struct Options {
+        // number of worker threads
+        int num_workers = 1;
+        // number of cubes generated for each worker before the search starts
+        int cubes_per_worker = 4;
+        // number of conflicts after which a worker splits its cube
+        std::uint64_t conflicts_per_cube = 10'000;
+        // learned clauses over original atoms with at most this many literals are shared
+        // between workers (0 disables sharing)
+        int max_shared_size = 0;
+        // maximal number of variables examined by lookahead in each node
+        int num_candidates = 32;
+    };
+
+    /** Create a new parallel solver
+     *
+     * @param setup function which initializes a solver of each worker
+     * @param options parameters of the search
+     */
+    Cube_and_conquer(Setup setup, Options options);
+
+    /** Split the problem into cubes and solve them in parallel
+     *
+     * Exceptions thrown in a worker (e.g., by the setup function) are rethrown by this method.
+     *
+     * @return `sat` if some cube is satisfiable, `unsat` if all cubes are unsatisfiable
+     */
+    Solver::Result solve();
+
+    /** Get model of the boolean variables found by the last `solve()`
+     *
+     * @return model of the satisfiable cube (valid only if `solve()` returned `sat`)
+     */
+    inline Model<bool> const& model() const { return bool_model; }
+
+    /** Get number of cubes solved by workers
+     *
+     * @return number of cubes taken from the queue in the last `solve()`
+     */
+    inline std::uint64_t num_cubes() const { return total_cubes; }
+
+    /** Get number of cubes split by workers after they exceeded the conflict limit
+     *
+     * @return number of splits in the last `solve()`
+     */
+    inline std::uint64_t num_splits() const { return total_splits; }
+
+    /** Get number of learned clauses shared between workers
+     *
+     * @return number of clauses published by workers in the last `solve()`
+     */
+    inline std::uint64_t num_shared_clauses() const { return shared.size(); }
+
+    /** Copy counters of cubes and sharing to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const;
+
+private:
+    class Exporter;
+
+    Setup setup;
+    Options options;
+
+    // protects all members below
+    std::mutex mutex;
+    // notified when the queue or `is_done` changes
+    std::condition_variable cube_available;
+    // cubes which have not been taken by a worker yet
+    std::deque<Cube> cubes;
+    // number of workers which are solving a cube
+    int num_busy = 0;
+    // true iff the result is known and workers should stop
+    bool is_done = false;
+    Solver::Result result = Solver::Result::unsat;
+    // exception thrown by a worker (it is rethrown by `solve()`)
+    std::exception_ptr error;
+    // solvers of running workers (to terminate them if the result is known)
+    std::vector<Solver*> solvers;
+    // boolean model of the satisfiable cube
+    Model<bool> bool_model;
+    // shared learned clauses together with index of the worker which has published them
+    std::vector<std::pair<int, Literals>> shared;
+    std::uint64_t total_cubes = 0;
+    std::uint64_t total_splits = 0;
+    std::uint64_t total_imported = 0;
+    std::uint64_t total_probes = 0;
+
+    // initialize a new solver
+    void init(Solver& solver);
+    // solve cubes from the queue by a new solver in worker `id`
+    void work(int id);
+    // take the next cube or return false if there are no more cubes
+    bool next_cube(Cube& cube);
+    // stop the search with result `value` (the mutex has to be locked)
+    void finish(Solver::Result value);
+    // add clause `clause` learned by worker `id` to the shared clauses
+    void publish(int id, Clause const& clause);
+    // add clauses shared by other workers since index `next` to learned clauses in `db`
+    void import(int id, std::size_t& next, Database& db);
+};
+
+} // namespace yaga
+
+#endif // YAGA_CUBE_AND_CONQUER_H
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <utility>
+
+#include "Cuber.h"
+
+namespace yaga {
+
+Cuber::Cuber(int num_vars, int num_candidates) : num_vars(num_vars), num_candidates(num_candidates)
+{
+}
+
+void Cuber::count_occurrences(Solver& solver)
+{
+    std::vector<int> count(num_vars, 0);
+    for (auto const& clause : solver.db().asserted())
+    {
+        for (auto lit : clause)
+        {
+            if (lit.var().ord() < num_vars)
+            {
+                ++count[lit.var().ord()];
+            }
+        }
+    }
+
+    by_occurrences.resize(num_vars);
+    for (int ord = 0; ord < num_vars; ++ord)
+    {
+        by_occurrences[ord] = ord;
+    }
+    std::stable_sort(by_occurrences.begin(), by_occurrences.end(),
+                     [&](auto lhs, auto rhs) { return count[lhs] > count[rhs]; });
+}
+
+std::optional<int> Cuber::probe(Solver& solver, Literal lit)
+{
+    ++total_probes;
+    auto num_assigned = solver.trail().num_assigned();
+    bool is_consistent = solver.push(lit);
+    auto num_propagated = solver.trail().num_assigned() - num_assigned;
+    solver.pop();
+    if (!is_consistent)
+    {
+        return {};
+    }
+    return num_propagated;
+}
+
+Cuber::Branch Cuber::select(Solver& solver)
+{
+    auto const& model = solver.trail().model<bool>(Variable::boolean);
+    Branch best;
+    std::uint64_t best_score = 0;
+    int num_examined = 0;
+    for (auto it = by_occurrences.begin();
+         it != by_occurrences.end() && num_examined < num_candidates; ++it)
+    {
+        if (model.is_defined(*it))
+        {
+            continue;
+        }
+        ++num_examined;
+
+        Literal lit{*it};
+        auto positive = probe(solver, lit);
+        auto negative = probe(solver, ~lit);
+        if (!positive || !negative) // failed literal
+        {
+            return {.lit = lit, .is_positive_failed = !positive, .is_negative_failed = !negative};
+        }
+
+        // prefer variables which simplify the problem in both branches
+        auto score = static_cast<std::uint64_t>(positive.value() + 1) *
+                     static_cast<std::uint64_t>(negative.value() + 1);
+        if (!best.lit || score > best_score)
+        {
+            best.lit = lit;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+void Cuber::generate(Solver& solver, Cube& cube, int depth, std::vector<Cube>& cubes)
+{
+    if (depth <= 0)
+    {
+        cubes.push_back(cube);
+        return;
+    }
+
+    auto branch = select(solver);
+    if (!branch.lit) // all candidates are assigned
+    {
+        cubes.push_back(cube);
+        return;
+    }
+
+    for (auto [lit, is_failed] : {std::pair{branch.lit.value(), branch.is_positive_failed},
+                                  std::pair{~branch.lit.value(), branch.is_negative_failed}})
+    {
+        if (is_failed)
+        {
+            continue;
+        }
+
+        cube.push_back(lit);
+        if (solver.push(lit))
+        {
+            generate(solver, cube, depth - 1, cubes);
+        }
+        solver.pop();
+        cube.pop_back();
+    }
+}
+
+std::vector<Cuber::Cube> Cuber::split(Solver& solver, Cube const& prefix, int depth)
+{
+    if (by_occurrences.empty())
+    {
+        count_occurrences(solver);
+    }
+
+    std::vector<Cube> cubes;
+    if (solver.begin_lookahead())
+    {
+        auto const& model = solver.trail().model<bool>(Variable::boolean);
+        Cube cube;
+        bool is_refuted = false;
+        for (auto lit : prefix)
+        {
+            cube.push_back(lit);
+            if (model.is_defined(lit.var().ord()))
+            {
+                // skip literals implied by the prefix
+                is_refuted = model.value(lit.var().ord()) == lit.is_negation();
+            }
+            else
+            {
+                is_refuted = !solver.push(lit);
+            }
+
+            if (is_refuted)
+            {
+                break;
+            }
+        }
+
+        if (!is_refuted)
+        {
+            generate(solver, cube, depth, cubes);
+        }
+    }
+    solver.end_lookahead();
+    return cubes;
+}
+
+} // namespace yaga
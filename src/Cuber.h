@@ -0,0 +1,84 @@
+#ifndef YAGA_CUBER_H
+#define YAGA_CUBER_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Literal.h"
+#include "Solver.h"
+
+namespace yaga {
+
+/** Lookahead cuber which splits the search space of a solver into cubes (conjunctions of
+ * boolean literals).
+ *
+ * The cuber branches on boolean variables with the highest lookahead score. The score of a
+ * variable is the product of the numbers of variables assigned by propagation (in the theory of
+ * the solver, e.g., boolean and linear arithmetic propagation) after each of its values is
+ * decided. Only a limited number of candidate variables with the most occurrences in asserted
+ * clauses is examined in each node. Branches which end in a conflict are left out so the
+ * disjunction of cubes covers all models of asserted clauses.
+ */
+class Cuber {
+public:
+    using Cube = std::vector<Literal>;
+
+    /** Create a cuber which branches on boolean variables with ordinal number lower than
+     * @p num_vars
+     *
+     * @param num_vars number of boolean variables which can be used in cubes
+     * @param num_candidates maximal number of variables examined by lookahead in each node
+     */
+    Cuber(int num_vars, int num_candidates = 32);
+
+    /** Split @p prefix into cubes
+     *
+     * The solver is left at decision level 0 (its learned clauses are kept).
+     *
+     * @param solver solver with asserted clauses
+     * @param prefix cube to split
+     * @param depth maximal number of literals added to @p prefix
+     * @return cubes which extend @p prefix (empty if lookahead refutes @p prefix)
+     */
+    std::vector<Cube> split(Solver& solver, Cube const& prefix, int depth);
+
+    /** Get total number of lookahead decisions
+     *
+     * @return number of literals decided by lookahead
+     */
+    inline std::uint64_t num_probes() const { return total_probes; }
+
+private:
+    // result of lookahead in one node of the cube tree
+    struct Branch {
+        // variable to branch on or none if there are no unassigned candidates
+        std::optional<Literal> lit;
+        // true iff propagation of `lit` ends in a conflict
+        bool is_positive_failed = false;
+        // true iff propagation of `~lit` ends in a conflict
+        bool is_negative_failed = false;
+    };
+
+    // number of boolean variables which can be used in cubes
+    int num_vars;
+    // maximal number of variables examined by lookahead in each node
+    int num_candidates;
+    // variables sorted by the number of occurrences in asserted clauses (computed lazily)
+    std::vector<int> by_occurrences;
+    // total number of lookahead decisions
+    std::uint64_t total_probes = 0;
+
+    // sort variables by the number of occurrences in asserted clauses of `solver`
+    void count_occurrences(Solver& solver);
+    // decide `lit` and count newly assigned variables (none if propagation ends in a conflict)
+    std::optional<int> probe(Solver& solver, Literal lit);
+    // pick the best literal to branch on at the current decision level
+    Branch select(Solver& solver);
+    // recursively add cubes which extend `cube` by at most `depth` literals to `cubes`
+    void generate(Solver& solver, Cube& cube, int depth, std::vector<Cube>& cubes);
+};
+
+} // namespace yaga
+
+#endif // YAGA_CUBER_H
@@ -0,0 +1,555 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "Dimacs_reader.h"
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<unistd.h>)
+#define YAGA_HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef YAGA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef YAGA_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+namespace yaga {
+
+namespace {
+
+using File_ptr = std::unique_ptr<std::FILE, decltype(&std::fclose)>;
+
+/** Input read from a C stream in blocks
+ */
+class File_input final : public Dimacs_reader::Input {
+public:
+    /** Create a new input
+     *
+     * @param file open file
+     * @param block_size size of blocks
+     * @param prefix bytes which have already been read from @p file
+     */
+    File_input(File_ptr file, std::size_t block_size, std::string prefix)
+        : file(std::move(file)), prefix(std::move(prefix)), block(block_size)
+    {
+    }
+
+    std::string_view next() override
+    {
+        if (!is_prefix_read)
+        {
+            is_prefix_read = true;
+            if (!prefix.empty())
+            {
+                return prefix;
+            }
+        }
+
+        auto size = std::fread(block.data(), 1, block.size(), file.get());
+        if (size == 0 && std::ferror(file.get()))
+        {
+            throw std::logic_error{"Failed to read DIMACS input."};
+        }
+        return {block.data(), size};
+    }
+
+private:
+    File_ptr file;
+    std::string prefix;
+    bool is_prefix_read = false;
+    std::vector<char> block;
+};
+
+/** Uncompressed input read from a C++ stream in blocks
+ */
+class Stream_input final : public Dimacs_reader::Input {
+public:
+    Stream_input(std::istream& input, std::size_t block_size) : input(input), block(block_size) {}
+
+    std::string_view next() override
+    {
+        input.read(block.data(), static_cast<std::streamsize>(block.size()));
+        return {block.data(), static_cast<std::size_t>(input.gcount())};
+    }
+
+private:
+    std::istream& input;
+    std::vector<char> block;
+};
+
+#ifdef YAGA_HAVE_MMAP
+/** Whole file mapped to memory
+ */
+class Memory_map_input final : public Dimacs_reader::Input {
+public:
+    Memory_map_input(void* data, std::size_t size) : data(data), size(size) {}
+
+    ~Memory_map_input() override { munmap(data, size); }
+
+    std::string_view next() override
+    {
+        if (is_read)
+        {
+            return {};
+        }
+        is_read = true;
+        return {static_cast<char const*>(data), size};
+    }
+
+    /** Map a regular file to memory
+     *
+     * @param file open file
+     * @return mapped file or nullptr if @p file cannot be mapped
+     */
+    static std::unique_ptr<Memory_map_input> map(std::FILE* file)
+    {
+        struct stat info;
+        auto fd = fileno(file);
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0)
+        {
+            return nullptr;
+        }
+
+        auto size = static_cast<std::size_t>(info.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        madvise(data, size, MADV_SEQUENTIAL);
+        return std::make_unique<Memory_map_input>(data, size);
+    }
+
+private:
+    void* data;
+    std::size_t size;
+    bool is_read = false;
+};
+#endif // YAGA_HAVE_MMAP
+
+#ifdef YAGA_HAVE_ZLIB
+/** Input compressed by gzip (possibly with several concatenated members)
+ */
+class Gzip_input final : public Dimacs_reader::Input {
+public:
+    Gzip_input(std::unique_ptr<Dimacs_reader::Input> source, std::size_t block_size)
+        : source(std::move(source)), block(block_size)
+    {
+        // 32 enables automatic detection of the gzip header
+        if (inflateInit2(&stream, 15 + 32) != Z_OK)
+        {
+            throw std::logic_error{"Failed to initialize gzip decoder."};
+        }
+    }
+
+    ~Gzip_input() override { inflateEnd(&stream); }
+
+    std::string_view next() override
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(block.data());
+        stream.avail_out = static_cast<uInt>(block.size());
+        while (!is_finished && stream.avail_out == block.size())
+        {
+            if (stream.avail_in == 0)
+            {
+                if (pending.empty())
+                {
+                    pending = source->next();
+                }
+                if (pending.empty())
+                {
+                    if (!is_member_end)
+                    {
+                        throw std::logic_error{"Unexpected end of gzip input."};
+                    }
+                    is_finished = true;
+                    break;
+                }
+                // zlib counts input bytes in `uInt` so large blocks are fed in several chunks
+                auto size = std::min<std::size_t>(pending.size(), std::numeric_limits<uInt>::max());
+                stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(pending.data()));
+                stream.avail_in = static_cast<uInt>(size);
+                pending.remove_prefix(size);
+            }
+
+            auto ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END)
+            {
+                is_member_end = true;
+                inflateReset(&stream);
+            }
+            else if (ret == Z_OK || ret == Z_BUF_ERROR)
+            {
+                is_member_end = false;
+            }
+            else
+            {
+                throw std::logic_error{"Failed to decompress gzip input."};
+            }
+        }
+        return {block.data(), block.size() - stream.avail_out};
+    }
+
+private:
+    std::unique_ptr<Dimacs_reader::Input> source;
+    // part of the last block of `source` which has not been passed to `stream` yet
+    std::string_view pending;
+    z_stream stream{};
+    bool is_member_end = false;
+    bool is_finished = false;
+    std::vector<char> block;
+};
+#endif // YAGA_HAVE_ZLIB
+
+#ifdef YAGA_HAVE_LZMA
+/** Input compressed by xz
+ */
+class Xz_input final : public Dimacs_reader::Input {
+public:
+    Xz_input(std::unique_ptr<Dimacs_reader::Input> source, std::size_t block_size)
+        : source(std::move(source)), block(block_size)
+    {
+        if (lzma_stream_decoder(&stream, std::numeric_limits<std::uint64_t>::max(),
+                                LZMA_CONCATENATED) != LZMA_OK)
+        {
+            throw std::logic_error{"Failed to initialize xz decoder."};
+        }
+    }
+
+    ~Xz_input() override { lzma_end(&stream); }
+
+    std::string_view next() override
+    {
+        stream.next_out = reinterpret_cast<std::uint8_t*>(block.data());
+        stream.avail_out = block.size();
+        while (!is_finished && stream.avail_out == block.size())
+        {
+            if (stream.avail_in == 0 && action == LZMA_RUN)
+            {
+                auto data = source->next();
+                stream.next_in = reinterpret_cast<std::uint8_t const*>(data.data());
+                stream.avail_in = data.size();
+                if (data.empty())
+                {
+                    action = LZMA_FINISH;
+                }
+            }
+
+            auto ret = lzma_code(&stream, action);
+            if (ret == LZMA_STREAM_END)
+            {
+                is_finished = true;
+            }
+            else if (ret != LZMA_OK)
+            {
+                throw std::logic_error{"Failed to decompress xz input."};
+            }
+        }
+        return {block.data(), block.size() - stream.avail_out};
+    }
+
+private:
+    std::unique_ptr<Dimacs_reader::Input> source;
+    lzma_stream stream = LZMA_STREAM_INIT;
+    lzma_action action = LZMA_RUN;
+    bool is_finished = false;
+    std::vector<char> block;
+};
+#endif // YAGA_HAVE_LZMA
+
+/** Tokenizer of DIMACS input which reads integers directly from input blocks
+ */
+class Scanner {
+public:
+    static constexpr int end_of_input = -1;
+
+    explicit Scanner(Dimacs_reader::Input& input) : input(input) {}
+
+    /** Get the next character without consuming it
+     *
+     * @return next character or `end_of_input`
+     */
+    inline int peek()
+    {
+        if (pos == end && !refill())
+        {
+            return end_of_input;
+        }
+        return static_cast<unsigned char>(*pos);
+    }
+
+    /** Consume the next character (it must not be the end of input)
+     */
+    inline void skip() { ++pos; }
+
+    /** Skip all whitespace characters
+     */
+    inline void skip_whitespace()
+    {
+        for (;;)
+        {
+            while (pos != end && is_space(*pos))
+            {
+                ++pos;
+            }
+            if (pos != end || !refill())
+            {
+                return;
+            }
+        }
+    }
+
+    /** Skip the rest of the current line including the line break
+     */
+    void skip_line()
+    {
+        for (;;)
+        {
+            auto line_end =
+                static_cast<char const*>(std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+            if (line_end != nullptr)
+            {
+                pos = line_end + 1;
+                return;
+            }
+            pos = end;
+            if (!refill())
+            {
+                return;
+            }
+        }
+    }
+
+    /** Read a word which consists of letters
+     *
+     * @return the word
+     */
+    std::string read_word()
+    {
+        std::string word;
+        for (int c = peek(); ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'); c = peek())
+        {
+            word.push_back(static_cast<char>(c));
+            skip();
+        }
+        return word;
+    }
+
+    /** Read a decimal integer with an optional minus sign
+     *
+     * @return parsed integer
+     */
+    int read_int()
+    {
+        bool is_negative = false;
+        if (peek() == '-')
+        {
+            is_negative = true;
+            skip();
+        }
+
+        int c = peek();
+        if (c < '0' || c > '9')
+        {
+            throw std::logic_error{c == end_of_input
+                                       ? std::string{"Unexpected end of DIMACS input."}
+                                       : "Unexpected character '" + std::string(1, static_cast<char>(c)) +
+                                             "' in DIMACS input."};
+        }
+
+        long long value = 0;
+        for (; '0' <= c && c <= '9'; c = peek())
+        {
+            value = value * 10 + (c - '0');
+            if (value > std::numeric_limits<int>::max())
+            {
+                throw std::logic_error{"Number out of range in DIMACS input."};
+            }
+            skip();
+        }
+        return static_cast<int>(is_negative ? -value : value);
+    }
+
+private:
+    Dimacs_reader::Input& input;
+    char const* pos = nullptr;
+    char const* end = nullptr;
+
+    static inline bool is_space(char c) { return c == ' ' || ('\t' <= c && c <= '\r'); }
+
+    inline bool refill()
+    {
+        auto block = input.next();
+        pos = block.data();
+        end = block.data() + block.size();
+        return !block.empty();
+    }
+};
+
+} // namespace
+
+Dimacs_problem Dimacs_reader::read_file(std::string const& path, Solver& solver)
+{
+    File_ptr file{std::fopen(path.c_str(), "rb"), &std::fclose};
+    if (!file)
+    {
+        throw std::logic_error{"Failed to open '" + path + "'."};
+    }
+
+    // detect compression from magic bytes
+    std::string magic(6, '\0');
+    magic.resize(std::fread(magic.data(), 1, magic.size(), file.get()));
+    bool is_gzip = magic.starts_with("\x1F\x8B");
+    bool is_xz = magic == std::string_view{"\xFD" "7zXZ\0", 6};
+    bool is_seekable = std::fseek(file.get(), 0, SEEK_SET) == 0;
+
+    std::unique_ptr<Input> input;
+#ifdef YAGA_HAVE_MMAP
+    if (is_seekable)
+    {
+        input = Memory_map_input::map(file.get());
+    }
+#endif
+    if (!input)
+    {
+        input = std::make_unique<File_input>(std::move(file), block_size,
+                                             is_seekable ? std::string{} : std::move(magic));
+    }
+
+    if (is_gzip)
+    {
+#ifdef YAGA_HAVE_ZLIB
+        input = std::make_unique<Gzip_input>(std::move(input), block_size);
+#else
+        throw std::logic_error{"Reading gzip input requires yaga built with zlib."};
+#endif
+    }
+    else if (is_xz)
+    {
+#ifdef YAGA_HAVE_LZMA
+        input = std::make_unique<Xz_input>(std::move(input), block_size);
+#else
+        throw std::logic_error{"Reading xz input requires yaga built with liblzma."};
+#endif
+    }
+    return read(*input, solver);
+}
+
+Dimacs_problem Dimacs_reader::read(std::istream& input, Solver& solver)
+{
+    Stream_input stream{input, block_size};
+    return read(stream, solver);
+}
+
+Dimacs_problem Dimacs_reader::read(Input& input, Solver& solver)
+{
+    Dimacs_problem problem;
+    Scanner scanner{input};
+    bool is_initialized = false;
+    int num_read = 0;
+    buffer.clear();
+    for (;;)
+    {
+        scanner.skip_whitespace();
+        auto c = scanner.peek();
+        if (c == Scanner::end_of_input || c == '%') // '%' ends some SATLIB benchmarks
+        {
+            break;
+        }
+        else if (c == 'c')
+        {
+            scanner.skip_line();
+        }
+        else if (c == 'p')
+        {
+            if (is_initialized)
+            {
+                throw std::logic_error{"Duplicate DIMACS problem line 'p cnf ...'."};
+            }
+            scanner.skip();
+            scanner.skip_whitespace();
+            if (scanner.read_word() != "cnf")
+            {
+                throw std::logic_error{"Failed to parse the DIMACS problem line. Expected: 'p cnf "
+                                       "[num_vars] [num_clauses]'."};
+            }
+            scanner.skip_whitespace();
+            problem.num_vars = scanner.read_int();
+            scanner.skip_whitespace();
+            problem.num_clauses = scanner.read_int();
+            if (problem.num_vars < 0 || problem.num_clauses < 0)
+            {
+                throw std::logic_error{"Negative number in the DIMACS problem line."};
+            }
+            is_initialized = true;
+            solver.trail().set_model<bool>(Variable::boolean, problem.num_vars);
+        }
+        else
+        {
+            if (!is_initialized)
+            {
+                throw std::logic_error{"Clause before DIMACS problem line."};
+            }
+
+            auto value = scanner.read_int();
+            if (value > problem.num_vars || value < -problem.num_vars)
+            {
+                throw std::logic_error{"Unknown literal " + std::to_string(value) +
+                                       " in DIMACS input."};
+            }
+
+            if (value != 0)
+            {
+                buffer.push_back(value < 0 ? ~Literal{-value - 1} : Literal{value - 1});
+                continue;
+            }
+
+            // clauses after the declared number of clauses are ignored
+            if (num_read < problem.num_clauses)
+            {
+                if (buffer.empty())
+                {
+                    problem.has_empty_clause = true;
+                    return problem;
+                }
+                solver.db().assert_clause(buffer.begin(), buffer.end());
+            }
+            buffer.clear();
+            ++num_read;
+        }
+    }
+
+    if (!is_initialized)
+    {
+        throw std::logic_error{
+            "Missing DIMACS problem line. Expected 'p cnf [num_vars] [num_clauses]'."};
+    }
+
+    if (!buffer.empty()) // the last clause does not have to be terminated by 0
+    {
+        if (num_read < problem.num_clauses)
+        {
+            solver.db().assert_clause(buffer.begin(), buffer.end());
+        }
+        buffer.clear();
+        ++num_read;
+    }
+
+    if (num_read < problem.num_clauses)
+    {
+        throw std::logic_error{"Insufficient number of clauses in DIMACS input."};
+    }
+    return problem;
+}
+
+} // namespace yaga
@@ -0,0 +1,93 @@
+#ifndef YAGA_DIMACS_READER_H
+#define YAGA_DIMACS_READER_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Literal.h"
+#include "Solver.h"
+
+namespace yaga {
+
+/** Summary of a CNF formula read by `Dimacs_reader`
+ */
+struct Dimacs_problem {
+    // number of variables declared in the problem line
+    int num_vars = 0;
+    // number of clauses declared in the problem line
+    int num_clauses = 0;
+    // true iff the formula contains an empty clause (the rest of the input is not read)
+    bool has_empty_clause = false;
+};
+
+/** Reader of CNF formulas in the DIMACS format.
+ *
+ * Clauses are asserted directly to the database of a solver. Uncompressed regular files are
+ * memory mapped if the platform supports it. Other inputs are read in large blocks. Files
+ * compressed by gzip or xz are decompressed transparently if yaga is built with zlib or liblzma,
+ * respectively. Compression is detected from the first bytes of the file.
+ *
+ * Malformed input is reported by throwing `std::logic_error`.
+ */
+class Dimacs_reader {
+public:
+    /** Source of input bytes
+     */
+    class Input {
+    public:
+        virtual ~Input() = default;
+
+        /** Read the next block of input
+         *
+         * @return view of the next block which is valid until the next call or an empty view at
+         * the end of input
+         */
+        virtual std::string_view next() = 0;
+    };
+
+    /** Read a CNF formula from a file and assert its clauses in @p solver
+     *
+     * @param path path to a DIMACS file (optionally compressed by gzip or xz)
+     * @param solver solver whose boolean model is resized to the number of variables in the
+     * problem line
+     * @return summary of the formula
+     */
+    Dimacs_problem read_file(std::string const& path, Solver& solver);
+
+    /** Read an uncompressed CNF formula from a stream and assert its clauses in @p solver
+     *
+     * @param input input stream with a formula in the DIMACS format
+     * @param solver solver whose boolean model is resized to the number of variables in the
+     * problem line
+     * @return summary of the formula
+     */
+    Dimacs_problem read(std::istream& input, Solver& solver);
+
+    /** Read a CNF formula from a custom source of input and assert its clauses in @p solver
+     *
+     * @param input source of input blocks
+     * @param solver solver whose boolean model is resized to the number of variables in the
+     * problem line
+     * @return summary of the formula
+     */
+    Dimacs_problem read(Input& input, Solver& solver);
+
+    /** Set size of blocks in which input which is not memory mapped is read
+     *
+     * @param size number of bytes in each block
+     */
+    inline void set_block_size(std::size_t size) { block_size = size; }
+
+private:
+    // size of blocks in which streams and compressed files are read
+    std::size_t block_size = 1 << 20;
+    // literals of the current clause
+    std::vector<Literal> buffer;
+};
+
+} // namespace yaga
+
+#endif // YAGA_DIMACS_READER_H
@@ -40,6 +40,20 @@ public:
         }
     }
 
+    /** Calls the variable remap event in all registered listeners.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map, int num_vars) override
+    {
+        for (auto&& listener : listeners)
+        {
+            listener->on_variable_remap(type, map, num_vars);
+        }
+    }
+
     /** Calls the event in all registers listeners.
      *
      * @param db clause database
@@ -95,6 +109,18 @@ public:
         }
     }
 
+    /** Collect statistics of all registered listeners.
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override
+    {
+        for (auto&& listener : listeners)
+        {
+            listener->collect_statistics(stats);
+        }
+    }
+
     /** Add @p listener to the list of listeners.
      * 
      * @param listener new listener to add
@@ -1,8 +1,11 @@
 #ifndef YAGA_EVENT_LISTENER_H
 #define YAGA_EVENT_LISTENER_H
 
+#include <vector>
+
 #include "Clause.h"
 #include "Database.h"
+#include "Statistics.h"
 #include "Trail.h"
 
 namespace yaga {
@@ -25,6 +28,25 @@ public:
      */
     virtual void on_variable_resize(Variable::Type, int) {}
 
+    /** Called when variables of type @p type are renumbered (e.g., after some of them have been
+     * garbage collected). It is only called when the trail is empty.
+     *
+     * `map[ord]` is the new ordinal number of variable `ord` or -1 if the variable has been
+     * removed. No two variables are mapped to the same ordinal number and no variable is mapped
+     * to a greater ordinal number. Ordinal numbers lower than @p num_vars which are not in the
+     * image of @p map represent new variables.
+     *
+     * The default implementation only calls `on_variable_resize()`.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables
+     */
+    virtual void on_variable_remap(Variable::Type type, std::vector<int> const&, int num_vars)
+    {
+        on_variable_resize(type, num_vars);
+    }
+
     /** Called when the solver is about to backtrack to @p decision_level
      *
      * @param db clause database
@@ -56,8 +78,38 @@ public:
      * @param trail current solver trail after restart
      */
     virtual void on_restart(Database&, Trail&) {}
+
+    /** Copy counters of this object to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    virtual void collect_statistics(Statistics&) const {}
 };
 
+/** Move values of renumbered variables to their new position (see
+ * `Event_listener::on_variable_remap()`)
+ *
+ * @tparam T type of values
+ * @param values map variable ordinal -> value
+ * @param map map old ordinal number -> new ordinal number or -1
+ * @param num_vars new number of variables
+ * @param value value of new variables
+ */
+template <typename T>
+inline void remap_values(std::vector<T>& values, std::vector<int> const& map, int num_vars,
+                         T const& value = T{})
+{
+    std::vector<T> result(num_vars, value);
+    for (std::size_t ord = 0; ord < map.size() && ord < values.size(); ++ord)
+    {
+        if (map[ord] >= 0)
+        {
+            result[map[ord]] = values[ord];
+        }
+    }
+    values = std::move(result);
+}
+
 } // namespace yaga
 
 #endif // YAGA_EVENT_LISTENER_H
\ No newline at end of file
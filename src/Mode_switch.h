@@ -0,0 +1,223 @@
+#ifndef YAGA_MODE_SWITCH_H
+#define YAGA_MODE_SWITCH_H
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Restart.h"
+#include "Trail.h"
+
+namespace yaga {
+
+/** Restart policy which alternates between a focused and a stable search mode.
+ *
+ * In focused mode, the solver restarts often (by default using `Glucose_restart`). In stable
+ * mode, the solver restarts rarely (by default using `Luby_restart`). The mode is switched at a
+ * restart once the current mode has lasted for a given number of conflicts. The number of
+ * conflicts in a mode doubles each time the solver enters focused mode again.
+ *
+ * Variable order heuristics can use `mode()` to select a heuristic for the current mode (see
+ * `Mode_order`).
+ */
+class Mode_switch final : public Restart {
+public:
+    enum class Mode {
+        focused,
+        stable,
+    };
+
+    virtual ~Mode_switch() = default;
+
+    /** Create a mode switch with `Glucose_restart` in focused mode and `Luby_restart` in stable
+     * mode. The solver starts in focused mode.
+     */
+    inline Mode_switch()
+    {
+        set_focused<Glucose_restart>();
+        set_stable<Luby_restart>();
+    }
+
+    /** Create a new restart policy used in focused mode.
+     *
+     * @tparam T type of the restart policy
+     * @tparam Args types of arguments passed to a constructor of T
+     * @param args arguments passed to a constructor of T
+     * @return reference to the new restart policy
+     */
+    template <class T, typename... Args>
+        requires std::is_base_of_v<Restart, T>
+    inline T& set_focused(Args&&... args)
+    {
+        return set<T>(focused, std::forward<Args>(args)...);
+    }
+
+    /** Create a new restart policy used in stable mode.
+     *
+     * @tparam T type of the restart policy
+     * @tparam Args types of arguments passed to a constructor of T
+     * @param args arguments passed to a constructor of T
+     * @return reference to the new restart policy
+     */
+    template <class T, typename... Args>
+        requires std::is_base_of_v<Restart, T>
+    inline T& set_stable(Args&&... args)
+    {
+        return set<T>(stable, std::forward<Args>(args)...);
+    }
+
+    /** Set number of conflicts in the first focused mode.
+     *
+     * @param conflicts new number of conflicts
+     * @return this
+     */
+    inline Mode_switch& set_interval(int conflicts)
+    {
+        interval = conflicts;
+        next_switch = num_conflicts + interval;
+        return *this;
+    }
+
+    /** Get current search mode
+     *
+     * @return current search mode
+     */
+    inline Mode mode() const { return current_mode; }
+
+    /** Get number of mode switches so far
+     *
+     * @return number of mode switches
+     */
+    inline int num_switches() const { return switches; }
+
+    /** Forward the event to both restart policies.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_init(Database& db, Trail& trail) override
+    {
+        focused->on_init(db, trail);
+        stable->on_init(db, trail);
+    }
+
+    /** Forward the event to both restart policies.
+     *
+     * @param type type of variables
+     * @param num_vars new number of variables
+     */
+    void on_variable_resize(Variable::Type type, int num_vars) override
+    {
+        focused->on_variable_resize(type, num_vars);
+        stable->on_variable_resize(type, num_vars);
+    }
+
+    /** Forward the event to the active restart policy.
+     *
+     * @param db clause database
+     * @param trail solver trail before backtracking
+     * @param level decision level to backtrack to
+     */
+    void on_before_backtrack(Database& db, Trail& trail, int level) override
+    {
+        active().on_before_backtrack(db, trail, level);
+    }
+
+    /** Count a conflict and forward the event to the active restart policy.
+     *
+     * Conflicts are not counted on backtrack since restarts backtrack as well.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned newly learned clause
+     */
+    void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override
+    {
+        ++num_conflicts;
+        active().on_learned_clause(db, trail, learned);
+    }
+
+    /** Forward the event to the active restart policy.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param other clause resolved with the conflict clause
+     */
+    void on_conflict_resolved(Database& db, Trail& trail, Clause const& other) override
+    {
+        active().on_conflict_resolved(db, trail, other);
+    }
+
+    /** Forward the event to the active restart policy and switch the mode if the current mode
+     * has lasted long enough.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_restart(Database& db, Trail& trail) override
+    {
+        active().on_restart(db, trail);
+        if (num_conflicts >= next_switch)
+        {
+            ++switches;
+            if (current_mode == Mode::focused)
+            {
+                current_mode = Mode::stable;
+            }
+            else
+            {
+                current_mode = Mode::focused;
+                interval *= 2;
+            }
+            next_switch = num_conflicts + interval;
+            active().on_restart(db, trail);
+        }
+    }
+
+    /** Check whether the solver should restart
+     *
+     * @return true iff the active restart policy wants to restart or the mode should be switched
+     */
+    bool should_restart() const override
+    {
+        return num_conflicts >= next_switch || active().should_restart();
+    }
+
+private:
+    // restart policy in focused mode
+    std::unique_ptr<Restart> focused;
+    // restart policy in stable mode
+    std::unique_ptr<Restart> stable;
+    // current search mode
+    Mode current_mode = Mode::focused;
+    // number of conflicts in the current mode
+    std::int64_t interval = 1000;
+    // total number of conflicts
+    std::int64_t num_conflicts = 0;
+    // number of conflicts at which the mode will be switched
+    std::int64_t next_switch = 1000;
+    // number of mode switches
+    int switches = 0;
+
+    template <class T, typename... Args>
+    inline T& set(std::unique_ptr<Restart>& policy, Args&&... args)
+    {
+        auto obj_ptr = std::make_unique<T>(std::forward<Args>(args)...);
+        auto actual_ptr = obj_ptr.get();
+        policy = std::move(obj_ptr);
+        return *actual_ptr;
+    }
+
+    inline Restart& active() { return current_mode == Mode::focused ? *focused : *stable; }
+
+    inline Restart const& active() const
+    {
+        return current_mode == Mode::focused ? *focused : *stable;
+    }
+};
+
+} // namespace yaga
+
+#endif // YAGA_MODE_SWITCH_H
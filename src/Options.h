@@ -2,6 +2,7 @@
 #define YAGA_OPTIONS_H
 
 #include "Bool_phase.h"
+#include <cstdint>
 #include <string>
 
 namespace yaga {
@@ -16,6 +17,13 @@ struct Options {
         alethe_memory, // Alethe built and pruned in memory
     };
 
+    enum class Restart_policy {
+        glucose, // dynamic restarts based on LBD averages (`Glucose_restart`)
+        luby, // Luby sequence (`Luby_restart`)
+        reluctant_doubling, // reluctant doubling (`Reluctant_doubling_restart`)
+        geometric, // geometrically increasing intervals (`Geometric_restart`)
+    };
+
     /** If true, the LRA plugin will decide rational variables with only one allowed value first.
      *
      * For example, if 0 <= x and x <= 0 are on the trail, we will decide x before any other
@@ -27,14 +35,92 @@ struct Options {
      */
     bool deduce_bounds = false;
 
+    /** If true, the LRA plugin will periodically remove constraints derived in conflict analysis
+     * which are not used in any clause and renumber boolean variables.
+     */
+    bool collect_derived = false;
+
+    /** If true, the LRA plugin will periodically check feasibility of asserted constraints using
+     * simplex and prefer values from the simplex assignment.
+     */
+    bool simplex = false;
+
+    /** If true, top-level linear equalities are eliminated, unconstrained variables are removed,
+     * and bounds are propagated before the assertions are internalized.
+     *
+     * Preprocessing is disabled if proofs are produced or if the logic has uninterpreted functions.
+     */
+    bool preprocess = false;
+
+    /** If true, asserted clauses are simplified by bounded variable elimination, failed literal
+     * probing, and equivalent literal substitution before search.
+     *
+     * Boolean variables interpreted by a theory are never removed. Clause preprocessing is disabled
+     * if proofs are produced.
+     */
+    bool sat_preprocess = false;
+
+    /** If true, top-level conjunctions are split and nested disjunctions are flattened, so they are
+     * asserted as clauses without auxiliary variables.
+     */
+    bool flatten = false;
+
+    /** If true, learned clauses with a low glucose level are strengthened on restart by assigning
+     * negation of their literals and propagating.
+     */
+    bool vivify = false;
+
     /** If true, the program will print solver counters like the number of conflicts.
      */
     bool print_stats = false;
 
+    /** Maximal number of conflicts in `check-sat` (0 means no limit). The solver answers `unknown`
+     * if it exceeds any limit.
+     */
+    std::uint64_t conflict_limit = 0;
+
+    /** Maximal number of decisions in `check-sat` (0 means no limit).
+     */
+    std::uint64_t decision_limit = 0;
+
+    /** Maximal number of variables assigned by propagation in `check-sat` (0 means no limit).
+     */
+    std::uint64_t propagation_limit = 0;
+
+    /** Maximal wall-clock time of `check-sat` in seconds (0 means no limit).
+     */
+    double time_limit = 0;
+
+    /** Maximal resident memory of the process in MiB (0 means no limit).
+     */
+    std::uint64_t memory_limit = 0;
+
+    /** If not empty, the program will write counters and timers of solver components as a JSON
+     * object to this path (`-` is the standard error output).
+     */
+    std::string stats_path;
+
     /** Value selection strategy for boolean variables.
+     *
+     * `Phase::target` also makes the LRA plugin prefer values of rational variables from the 
+     * longest conflict-free trail.
      */
     Phase phase = Phase::positive;
 
+    /** If true, the solver alternates between focused mode (VMTF and Glucose restarts) and
+     * stable mode (VSIDS and Luby restarts) on a conflict-count schedule.
+     */
+    bool mode_switch = false;
+
+    /** Restart policy (ignored if `mode_switch` is set).
+     */
+    Restart_policy restart = Restart_policy::glucose;
+
+    /** If true, restarts keep decision levels which would most likely be recreated by the
+     * variable order.
+     */
+    bool trail_reuse = false;
+
     /** Input file path.
      */
     std::string input_path;
@@ -50,8 +136,13 @@ struct Options {
     /** Proof file path (for tracers that output to a file)
      * 
      * If not set, the proof path will be derived from the input path by appending a format-specific suffix.
+     * The proof is compressed by gzip or xz if the path ends with `.gz` or `.xz`, respectively.
      */
     std::string proof_path;
+
+    /** If true, proof files are written (and compressed) by a background thread.
+     */
+    bool proof_async = false;
 };
 
 } // namespace yaga
@@ -1,6 +1,8 @@
 #ifndef YAGA_RESTART_H
 #define YAGA_RESTART_H
 
+#include <cstdint>
+
 #include "Database.h"
 #include "Event_listener.h"
 #include "Trail.h"
@@ -87,10 +89,152 @@ private:
     inline void next() { countdown = luby(++index) * mult; }
 };
 
+/** Restart policy based on reluctant doubling (Knuth's formulation of the Luby sequence).
+ *
+ * The pair (u, v) generates the sequence of restart intervals 1, 1, 2, 1, 1, 2, 4, ... in
+ * constant time per restart.
+ */
+class Reluctant_doubling_restart final : public Restart {
+public:
+    virtual ~Reluctant_doubling_restart() = default;
+
+    inline Reluctant_doubling_restart() { countdown = base; }
+
+    /** Mark that a conflict has occurred.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned learned clause
+     */
+    void on_learned_clause(Database&, Trail&, Clause const&) override { --countdown; }
+
+    /** Move to the next element of the sequence and reset the countdown.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_restart(Database&, Trail&) override
+    {
+        if ((u & -u) == v)
+        {
+            ++u;
+            v = 1;
+        }
+        else
+        {
+            v *= 2;
+        }
+        countdown = v * base;
+    }
+
+    /** Check whether the solver should restart
+     *
+     * @return true iff number of conflicts since the last restart exceeded current limit
+     */
+    bool should_restart() const override { return countdown <= 0; }
+
+    /** Set number of conflicts which corresponds to one unit of the sequence
+     *
+     * @param conflicts new number of conflicts
+     * @return this
+     */
+    inline Reluctant_doubling_restart& set_base(int conflicts)
+    {
+        countdown = static_cast<std::int64_t>(v) * conflicts;
+        base = conflicts;
+        return *this;
+    }
+
+    /** Get current element of the sequence
+     *
+     * @return number of base intervals until the next restart
+     */
+    inline std::int64_t current() const { return v; }
+
+private:
+    // countdown to the next restart
+    std::int64_t countdown;
+    // number of conflicts in one unit of the sequence
+    std::int64_t base = 512;
+    // state of the reluctant doubling sequence
+    std::int64_t u = 1;
+    // current element of the sequence
+    std::int64_t v = 1;
+};
+
+/** Restart policy with geometrically increasing number of conflicts between restarts.
+ */
+class Geometric_restart final : public Restart {
+public:
+    virtual ~Geometric_restart() = default;
+
+    inline Geometric_restart() { countdown = static_cast<std::int64_t>(interval); }
+
+    /** Mark that a conflict has occurred.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned learned clause
+     */
+    void on_learned_clause(Database&, Trail&, Clause const&) override { --countdown; }
+
+    /** Multiply the interval between restarts by the growth factor.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_restart(Database&, Trail&) override
+    {
+        interval *= factor;
+        countdown = static_cast<std::int64_t>(interval);
+    }
+
+    /** Check whether the solver should restart
+     *
+     * @return true iff number of conflicts since the last restart exceeded current limit
+     */
+    bool should_restart() const override { return countdown <= 0; }
+
+    /** Set number of conflicts before the first restart
+     *
+     * @param conflicts number of conflicts before the first restart
+     * @return this
+     */
+    inline Geometric_restart& set_initial(int conflicts)
+    {
+        countdown = conflicts;
+        interval = conflicts;
+        return *this;
+    }
+
+    /** Set growth factor of the interval between restarts
+     *
+     * @param value new factor >= 1
+     * @return this
+     */
+    inline Geometric_restart& set_factor(double value)
+    {
+        factor = value;
+        return *this;
+    }
+
+private:
+    // countdown to the next restart
+    std::int64_t countdown;
+    // current number of conflicts between restarts
+    double interval = 100;
+    // growth factor of `interval`
+    double factor = 1.5;
+};
+
 /** Dynamic restart policy based on clause glucose (LBD - number of distinct
  * decision levels in a clause)
  *
  * Implementation as described in "Weaknesses of CDCL Solvers", Armin Biere
+ *
+ * Restarts are blocked (postponed) as in the Glucose solver if the number of assigned variables
+ * at a conflict exceeds an exponential average of trail sizes by some threshold. The solver is
+ * likely close to a model in that case.
  */
 class Glucose_restart final : public Restart {
 public:
@@ -115,6 +259,16 @@ public:
     void on_learned_clause(Database&, Trail& trail, Clause const& learned) override
     {
         --countdown;
+        ++num_conflicts;
+        auto trail_size = static_cast<float>(trail.num_assigned());
+        if (num_conflicts > block_min_conflicts && countdown <= 0 &&
+            trail_size > block_threshold * trail_ema)
+        {
+            countdown = min_num_conflicts;
+            ++blocked;
+        }
+        trail_ema += (trail_size - trail_ema) / static_cast<float>(1 << trail_exp);
+
         std::vector<int> levels(learned.size());
         auto it = levels.begin();
         for (auto lit : learned)
@@ -138,6 +292,12 @@ public:
      */
     inline float slow() const { return slow_ema; }
 
+    /** Get number of blocked restarts
+     *
+     * @return number of times a restart has been postponed because of a long trail
+     */
+    inline int num_blocked() const { return blocked; }
+
     /** Get value of fast moving exponential average of LBDs
      *
      * @return fast moving exponential average of LBDs
@@ -191,8 +351,54 @@ public:
         return *this;
     }
 
+    /** Set by how much does the trail size have to exceed its average in order to block
+     * a restart.
+     *
+     * @param value new threshold (use infinity to disable blocking)
+     * @return this
+     */
+    inline Glucose_restart& set_block_threshold(float value)
+    {
+        block_threshold = value;
+        return *this;
+    }
+
+    /** Set exponent for the moving average of trail sizes
+     *
+     * @param exp new exponent
+     * @return this
+     */
+    inline Glucose_restart& set_trail_exp(int exp)
+    {
+        trail_exp = exp;
+        return *this;
+    }
+
+    /** Set minimal number of conflicts before restarts can be blocked
+     *
+     * @param conflicts minimal number of conflicts
+     * @return this
+     */
+    inline Glucose_restart& set_block_min_conflicts(int conflicts)
+    {
+        block_min_conflicts = conflicts;
+        return *this;
+    }
+
 private:
     int countdown = 0;
+    // total number of learned clauses
+    int num_conflicts = 0;
+    // number of blocked restarts
+    int blocked = 0;
+    // exponential moving average of the number of assigned variables at conflicts
+    float trail_ema = 0.f;
+    // exponent for the trail size average
+    int trail_exp = 12;
+    // restarts are blocked if the trail size exceeds `block_threshold` times its average
+    float block_threshold = 1.4f;
+    // minimal number of conflicts before restarts can be blocked
+    int block_min_conflicts = 10'000;
     // slow moving exponential average
     float slow_ema = 0.f;
     // fast moving exponential average
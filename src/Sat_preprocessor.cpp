@@ -0,0 +1,758 @@
+#include <algorithm>
+
+#include "Sat_preprocessor.h"
+
+namespace yaga {
+
+void Sat_preprocessor::on_variable_resize(Variable::Type type, int num_vars)
+{
+    if (type == Variable::boolean)
+    {
+        frozen.resize(num_vars, false);
+        removed.resize(num_vars, false);
+    }
+}
+
+void Sat_preprocessor::on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                                         int num_vars)
+{
+    if (type != Variable::boolean)
+    {
+        return;
+    }
+
+    remap_values(frozen, map, num_vars, false);
+    remap_values(removed, map, num_vars, false);
+    auto remap = [&](Literal lit) {
+        assert(map[lit.var().ord()] >= 0);
+        Literal result{map[lit.var().ord()]};
+        return lit.is_negation() ? ~result : result;
+    };
+    for (auto& witness : stack)
+    {
+        witness.lit = remap(witness.lit);
+        std::transform(witness.clause.begin(), witness.clause.end(), witness.clause.begin(), remap);
+    }
+}
+
+void Sat_preprocessor::freeze(Variable var)
+{
+    if (var.type() != Variable::boolean)
+    {
+        return;
+    }
+
+    if (var.ord() >= static_cast<int>(frozen.size()))
+    {
+        frozen.resize(var.ord() + 1, false);
+    }
+    frozen[var.ord()] = true;
+}
+
+bool Sat_preprocessor::is_frozen(Variable var) const
+{
+    return var.type() == Variable::boolean && var.ord() < static_cast<int>(frozen.size()) &&
+           frozen[var.ord()];
+}
+
+bool Sat_preprocessor::is_removed(Variable var) const
+{
+    return var.type() == Variable::boolean && var.ord() < static_cast<int>(removed.size()) &&
+           removed[var.ord()];
+}
+
+bool Sat_preprocessor::run(Database& db, Trail& trail)
+{
+    auto num_vars = static_cast<int>(trail.model<bool>(Variable::boolean).num_vars());
+    on_variable_resize(Variable::boolean, num_vars);
+    occur.resize(num_vars);
+    lit_bitset.resize(num_vars);
+    lit_bitset.assign(false);
+    assignment.resize(num_vars);
+    assignment.clear();
+    assigned.clear();
+
+    // reset the state of the previous run
+    stack.clear();
+    removed.assign(removed.size(), false);
+    eliminated = 0;
+    substituted = 0;
+    failed = 0;
+
+    if (std::any_of(db.asserted().begin(), db.asserted().end(),
+                    [](auto const& clause) { return clause.empty(); }))
+    {
+        return false;
+    }
+
+    for (int round = 0; round < max_rounds; ++round)
+    {
+        if (!simplify(db))
+        {
+            return false;
+        }
+
+        auto num_substituted = substitute_equivalences(db);
+        if (!num_substituted)
+        {
+            return false;
+        }
+        substituted += num_substituted.value();
+
+        auto num_units = probe(db);
+        if (!num_units)
+        {
+            return false;
+        }
+        failed += num_units.value();
+
+        auto num_eliminated = eliminate(db);
+        if (!num_eliminated)
+        {
+            return false;
+        }
+        eliminated += num_eliminated.value();
+
+        if (num_substituted.value() + num_units.value() + num_eliminated.value() == 0)
+        {
+            break;
+        }
+    }
+
+    if (!simplify(db))
+    {
+        return false;
+    }
+
+    // learned clauses are only implied by the original clauses
+    std::erase_if(db.learned(), [&](auto const& clause) {
+        return std::any_of(clause.begin(), clause.end(),
+                           [&](auto lit) { return removed[lit.var().ord()]; });
+    });
+    return true;
+}
+
+void Sat_preprocessor::extend_model(Model<bool>& model) const
+{
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+    {
+        if (std::none_of(it->clause.begin(), it->clause.end(),
+                         [&](auto lit) { return eval(model, lit) == true; }))
+        {
+            model.set_value(it->lit.var().ord(), !it->lit.is_negation());
+        }
+    }
+}
+
+void Sat_preprocessor::index(Database& db)
+{
+    for (auto& list : occur)
+    {
+        list.clear();
+    }
+
+    for (auto& clause : db.asserted())
+    {
+        if (clause.empty())
+        {
+            continue;
+        }
+
+        auto clause_ptr = make_clause_ptr(&clause);
+        for (auto lit : clause)
+        {
+            occur[lit].emplace_back(clause_ptr);
+        }
+    }
+}
+
+bool Sat_preprocessor::propagate(Literal lit)
+{
+    if (auto value = eval(assignment, lit))
+    {
+        return value.value();
+    }
+
+    auto head = assigned.size();
+    assignment.set_value(lit.var().ord(), !lit.is_negation());
+    assigned.push_back(lit);
+    for (; head < assigned.size(); ++head)
+    {
+        for (auto clause : occur[~assigned[head]])
+        {
+            ++num_visits;
+
+            // find an unassigned literal unless the clause is satisfied
+            bool is_satisfied = false;
+            int num_unassigned = 0;
+            Literal unassigned{0};
+            for (auto other : *clause)
+            {
+                auto value = eval(assignment, other);
+                if (value == true)
+                {
+                    is_satisfied = true;
+                    break;
+                }
+                else if (!value && ++num_unassigned == 1)
+                {
+                    unassigned = other;
+                }
+            }
+
+            if (is_satisfied || num_unassigned > 1 || clause->empty())
+            {
+                continue;
+            }
+            else if (num_unassigned == 0)
+            {
+                return false;
+            }
+            assignment.set_value(unassigned.var().ord(), !unassigned.is_negation());
+            assigned.push_back(unassigned);
+        }
+    }
+    return true;
+}
+
+void Sat_preprocessor::backtrack(std::size_t size)
+{
+    for (auto i = size; i < assigned.size(); ++i)
+    {
+        assignment.clear(assigned[i].var().ord());
+    }
+    assigned.resize(size);
+}
+
+bool Sat_preprocessor::normalize(Clause& clause)
+{
+    bool is_tautology = false;
+    auto end = clause.begin();
+    for (auto lit : clause)
+    {
+        if (lit_bitset[~lit])
+        {
+            is_tautology = true;
+        }
+        if (!lit_bitset[lit])
+        {
+            lit_bitset[lit] = true;
+            *end++ = lit;
+        }
+    }
+    clause.erase(end, clause.end());
+
+    for (auto lit : clause)
+    {
+        lit_bitset[lit] = false;
+    }
+    return !is_tautology;
+}
+
+bool Sat_preprocessor::simplify(Database& db)
+{
+    for (auto& clause : db.asserted())
+    {
+        if (!normalize(clause))
+        {
+            clause.clear();
+        }
+    }
+
+    // propagate unit clauses
+    index(db);
+    backtrack(0);
+    for (auto& clause : db.asserted())
+    {
+        if (clause.size() == 1 && !propagate(clause[0]))
+        {
+            return false;
+        }
+    }
+
+    // remove satisfied clauses and false literals
+    for (auto& clause : db.asserted())
+    {
+        if (std::any_of(clause.begin(), clause.end(),
+                        [&](auto lit) { return eval(assignment, lit) == true; }))
+        {
+            clause.clear();
+        }
+        else
+        {
+            clause.erase(std::remove_if(clause.begin(), clause.end(),
+                                        [&](auto lit) { return eval(assignment, lit) == false; }),
+                         clause.end());
+            // clauses with no unassigned literal would be a conflict in `propagate()`
+            assert(clause.empty() || eval(assignment, clause) != false);
+        }
+    }
+
+    std::erase_if(db.asserted(), [](auto const& clause) { return clause.empty(); });
+    for (auto lit : assigned)
+    {
+        db.assert_clause(lit);
+    }
+    return true;
+}
+
+std::optional<int> Sat_preprocessor::substitute_equivalences(Database& db)
+{
+    index(db);
+    auto num_vars = occur.num_vars();
+
+    // Tarjan's algorithm on the binary implication graph (`a -> b` for each clause `~a or b`)
+    struct Frame {
+        Literal lit;
+        // position of the next clause in `occur[~lit]`
+        std::size_t next;
+    };
+
+    Literal_map<int> order(num_vars, -1);
+    Literal_map<int> low(num_vars, 0);
+    Literal_map<bool> on_stack(num_vars, false);
+    Literal_map<Literal> repr(num_vars);
+    std::vector<Literal> component;
+    std::vector<Frame> frames;
+    int counter = 0;
+
+    auto visit = [&](Literal lit) {
+        order[lit] = low[lit] = counter++;
+        on_stack[lit] = true;
+        component.push_back(lit);
+        frames.push_back({lit, 0});
+    };
+
+    auto next_successor = [&](Frame& frame) -> std::optional<Literal> {
+        auto const& list = occur[~frame.lit];
+        while (frame.next < list.size())
+        {
+            auto clause = list[frame.next++];
+            if (clause->size() == 2)
+            {
+                return (*clause)[0] == ~frame.lit ? (*clause)[1] : (*clause)[0];
+            }
+        }
+        return {};
+    };
+
+    // frozen variables are preferred as representatives
+    auto is_better = [&](Literal lhs, Literal rhs) {
+        if (frozen[lhs.var().ord()] != frozen[rhs.var().ord()])
+        {
+            return static_cast<bool>(frozen[lhs.var().ord()]);
+        }
+        return lhs.var().ord() < rhs.var().ord();
+    };
+
+    for (int ord = 0; ord < num_vars; ++ord)
+    {
+        repr[Literal{ord}] = Literal{ord};
+        repr[~Literal{ord}] = ~Literal{ord};
+    }
+
+    for (int ord = 0; ord < num_vars; ++ord)
+    {
+        if (removed[ord] || assignment.is_defined(ord))
+        {
+            continue;
+        }
+
+        for (auto root : {Literal{ord}, ~Literal{ord}})
+        {
+            if (order[root] >= 0)
+            {
+                continue;
+            }
+
+            visit(root);
+            while (!frames.empty())
+            {
+                if (auto succ = next_successor(frames.back()))
+                {
+                    if (order[succ.value()] < 0)
+                    {
+                        visit(succ.value());
+                    }
+                    else if (on_stack[succ.value()])
+                    {
+                        auto& top = frames.back().lit;
+                        low[top] = std::min(low[top], order[succ.value()]);
+                    }
+                    continue;
+                }
+
+                auto lit = frames.back().lit;
+                frames.pop_back();
+                if (!frames.empty())
+                {
+                    auto parent = frames.back().lit;
+                    low[parent] = std::min(low[parent], low[lit]);
+                }
+
+                if (low[lit] != order[lit])
+                {
+                    continue;
+                }
+
+                // pop the strongly connected component of `lit`
+                auto begin = std::find(component.begin(), component.end(), lit);
+                auto best = lit;
+                for (auto it = begin; it != component.end(); ++it)
+                {
+                    on_stack[*it] = false;
+                    lit_bitset[*it] = true;
+                    best = is_better(*it, best) ? *it : best;
+                }
+
+                bool is_consistent = std::none_of(begin, component.end(),
+                                                  [&](auto other) { return lit_bitset[~other]; });
+                for (auto it = begin; it != component.end(); ++it)
+                {
+                    lit_bitset[*it] = false;
+                    repr[*it] = frozen[it->var().ord()] ? *it : best;
+                }
+                component.erase(begin, component.end());
+
+                if (!is_consistent)
+                {
+                    return {};
+                }
+            }
+        }
+    }
+
+    // record substituted variables
+    int count = 0;
+    for (int ord = 0; ord < num_vars; ++ord)
+    {
+        Literal lit{ord};
+        if (removed[ord] || assignment.is_defined(ord) || repr[lit] == lit)
+        {
+            continue;
+        }
+
+        removed[ord] = true;
+        ++count;
+        stack.push_back({lit, {lit, ~repr[lit]}});
+        stack.push_back({~lit, {~lit, repr[lit]}});
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // replace substituted literals in clauses
+    for (auto& clause : db.asserted())
+    {
+        bool is_changed = false;
+        for (auto& lit : clause)
+        {
+            if (removed[lit.var().ord()])
+            {
+                lit = repr[lit];
+                is_changed = true;
+            }
+        }
+
+        if (is_changed && !normalize(clause))
+        {
+            clause.clear();
+        }
+    }
+    return count;
+}
+
+std::optional<int> Sat_preprocessor::probe(Database& db)
+{
+    index(db);
+
+    // propagate units created by substitution
+    for (auto& clause : db.asserted())
+    {
+        if (clause.size() == 1 && !propagate(clause[0]))
+        {
+            return {};
+        }
+    }
+
+    int count = 0;
+    auto add_unit = [&](Literal lit) {
+        ++count;
+        db.assert_clause(lit);
+        return propagate(lit);
+    };
+
+    auto is_binary = [&](Literal lit) {
+        return std::any_of(occur[lit].begin(), occur[lit].end(),
+                           [](auto clause) { return clause->size() == 2; });
+    };
+
+    num_visits = 0;
+    std::vector<Literal> common;
+    for (int ord = 0; ord < occur.num_vars() && num_visits < probing_budget; ++ord)
+    {
+        Literal lit{ord};
+        if (removed[ord] || assignment.is_defined(ord) || (!is_binary(lit) && !is_binary(~lit)))
+        {
+            continue;
+        }
+
+        auto size = assigned.size();
+        if (!propagate(lit))
+        {
+            backtrack(size);
+            if (!add_unit(~lit))
+            {
+                return {};
+            }
+            continue;
+        }
+
+        // remember literals implied by `lit`
+        for (auto i = size + 1; i < assigned.size(); ++i)
+        {
+            lit_bitset[assigned[i]] = true;
+        }
+        auto implied = std::vector<Literal>(assigned.begin() + size + 1, assigned.end());
+        backtrack(size);
+
+        bool is_consistent = propagate(~lit);
+        common.clear();
+        if (is_consistent)
+        {
+            for (auto i = size + 1; i < assigned.size(); ++i)
+            {
+                if (lit_bitset[assigned[i]])
+                {
+                    common.push_back(assigned[i]);
+                }
+            }
+        }
+        backtrack(size);
+        for (auto other : implied)
+        {
+            lit_bitset[other] = false;
+        }
+
+        if (!is_consistent)
+        {
+            if (!add_unit(lit))
+            {
+                return {};
+            }
+            continue;
+        }
+
+        // literals implied by both `lit` and `~lit`
+        for (auto other : common)
+        {
+            if (!assignment.is_defined(other.var().ord()) && !add_unit(other))
+            {
+                return {};
+            }
+        }
+    }
+    return count;
+}
+
+std::optional<int> Sat_preprocessor::eliminate(Database& db)
+{
+    index(db);
+
+    // try variables with fewer potential resolvents first
+    std::vector<std::pair<std::size_t, int>> candidates;
+    for (int ord = 0; ord < occur.num_vars(); ++ord)
+    {
+        if (!frozen[ord] && !removed[ord])
+        {
+            Literal lit{ord};
+            candidates.emplace_back(occur[lit].size() * occur[~lit].size(), ord);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    int count = 0;
+    std::vector<std::vector<Literal>> resolvents;
+    std::vector<Literal> resolvent;
+    for (auto [_, ord] : candidates)
+    {
+        Literal lit{ord};
+        auto pos = occurrences(lit);
+        auto neg = occurrences(~lit);
+        if (pos.empty() && neg.empty())
+        {
+            continue;
+        }
+
+        if (!pos.empty() && !neg.empty() &&
+            (pos.size() > max_occurrences || neg.size() > max_occurrences))
+        {
+            continue;
+        }
+
+        // the number of clauses must not increase
+        resolvents.clear();
+        bool is_bounded = true;
+        for (auto first : pos)
+        {
+            for (auto second : neg)
+            {
+                if (!resolve(*first, *second, lit.var(), resolvent))
+                {
+                    continue;
+                }
+
+                if (resolvent.size() > max_resolvent_size ||
+                    resolvents.size() >= pos.size() + neg.size())
+                {
+                    is_bounded = false;
+                    break;
+                }
+                resolvents.push_back(resolvent);
+            }
+
+            if (!is_bounded)
+            {
+                break;
+            }
+        }
+
+        if (!is_bounded)
+        {
+            continue;
+        }
+
+        // Record clauses of the less frequent literal `l` and a default value `~l`. If some of the
+        // recorded clauses is falsified, `l` is made true. All clauses with `~l` are then
+        // satisfied since the resolvents are satisfied.
+        auto witness_lit = pos.size() <= neg.size() ? lit : ~lit;
+        for (auto clause : witness_lit == lit ? pos : neg)
+        {
+            stack.push_back({witness_lit, {clause->begin(), clause->end()}});
+        }
+        stack.push_back({~witness_lit, {~witness_lit}});
+
+        for (auto clause : pos)
+        {
+            clause->clear();
+        }
+        for (auto clause : neg)
+        {
+            clause->clear();
+        }
+        removed[ord] = true;
+        ++count;
+
+        for (auto& literals : resolvents)
+        {
+            if (literals.empty())
+            {
+                return {};
+            }
+
+            auto& clause = db.assert_clause(std::move(literals));
+            auto clause_ptr = make_clause_ptr(&clause);
+            for (auto other : clause)
+            {
+                occur[other].emplace_back(clause_ptr);
+            }
+            remove_subsumed(clause_ptr);
+        }
+    }
+    return count;
+}
+
+bool Sat_preprocessor::resolve(Clause const& first, Clause const& second, Variable var,
+                               std::vector<Literal>& out)
+{
+    out.clear();
+    for (auto lit : first)
+    {
+        if (lit.var() != var && !lit_bitset[lit])
+        {
+            lit_bitset[lit] = true;
+            out.push_back(lit);
+        }
+    }
+
+    bool is_tautology = false;
+    for (auto lit : second)
+    {
+        if (lit.var() == var || lit_bitset[lit])
+        {
+            continue;
+        }
+
+        if (lit_bitset[~lit])
+        {
+            is_tautology = true;
+            break;
+        }
+        lit_bitset[lit] = true;
+        out.push_back(lit);
+    }
+
+    for (auto lit : out)
+    {
+        lit_bitset[lit] = false;
+    }
+    return !is_tautology;
+}
+
+void Sat_preprocessor::remove_subsumed(Clause_ptr clause)
+{
+    // find literal in clause with the shortest occur list
+    auto best_lit = *std::min_element(clause->begin(), clause->end(), [&](auto lhs, auto rhs) {
+        return occur[lhs].size() < occur[rhs].size();
+    });
+
+    for (auto lit : *clause)
+    {
+        lit_bitset[lit] = true;
+    }
+
+    for (auto other : occur[best_lit])
+    {
+        if (other == clause || other->size() <= clause->size() ||
+            (clause.sig() & ~other.sig()) != 0)
+        {
+            continue;
+        }
+
+        auto num_common = std::count_if(other->begin(), other->end(),
+                                        [&](auto lit) { return lit_bitset[lit]; });
+        if (num_common == static_cast<long>(clause->size()))
+        {
+            other->clear();
+        }
+    }
+
+    for (auto lit : *clause)
+    {
+        lit_bitset[lit] = false;
+    }
+}
+
+std::vector<Clause*> Sat_preprocessor::occurrences(Literal lit)
+{
+    std::vector<Clause*> result;
+    for (auto clause : occur[lit])
+    {
+        if (!clause->empty())
+        {
+            result.push_back(&*clause);
+        }
+    }
+    return result;
+}
+
+void Sat_preprocessor::collect_statistics(Statistics& stats) const
+{
+    stats.set("sat_preprocessor.eliminated_variables", eliminated);
+    stats.set("sat_preprocessor.substituted_variables", substituted);
+    stats.set("sat_preprocessor.failed_literals", failed);
+}
+
+} // namespace yaga
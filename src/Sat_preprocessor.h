@@ -0,0 +1,270 @@
+#ifndef YAGA_SAT_PREPROCESSOR_H
+#define YAGA_SAT_PREPROCESSOR_H
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "Clause.h"
+#include "Clause_ptr.h"
+#include "Database.h"
+#include "Event_listener.h"
+#include "Literal.h"
+#include "Literal_map.h"
+#include "Model.h"
+#include "Trail.h"
+#include "Variable.h"
+
+namespace yaga {
+
+/** Simplification of asserted clauses before search.
+ *
+ * The preprocessor repeats the following steps until the clauses do not change:
+ * 1. Unit propagation: clauses satisfied by unit clauses are removed and false literals are
+ *    removed from the remaining clauses.
+ * 2. Equivalent literal substitution: literals in a strongly connected component of the binary
+ *    implication graph are equivalent. They are replaced with a single representative.
+ * 3. Failed literal probing: if unit propagation of a literal `l` leads to a conflict, `~l` is
+ *    asserted. Literals implied by both `l` and `~l` are asserted as well.
+ * 4. Bounded variable elimination [Een and Biere, SAT 2005]: clauses with a variable `x` are
+ *    replaced by all non-tautological resolvents on `x` if the number of clauses does not increase.
+ *
+ * Frozen variables are never substituted or eliminated. All variables which are interpreted by a
+ * theory (e.g., linear constraints) have to be frozen.
+ *
+ * Clauses removed by substitution and elimination are recorded on a witness stack. The stack is
+ * used by `extend_model()` to extend a model of the simplified clauses to a model of the original
+ * clauses.
+ */
+class Sat_preprocessor final : public Event_listener {
+public:
+    /** Clause removed by the preprocessor
+     */
+    struct Witness {
+        // literal which is made true if `clause` is not satisfied
+        Literal lit;
+        // removed clause (it contains `lit`)
+        std::vector<Literal> clause;
+    };
+
+    /** Allocate memory for internal structures.
+     *
+     * @param type type of variables
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_resize(Variable::Type type, int num_vars) override;
+
+    /** Renumber frozen variables and variables in the witness stack.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                           int num_vars) override;
+
+    /** Prevent the preprocessor from removing a boolean variable
+     *
+     * @param var boolean variable (other variables are ignored)
+     */
+    void freeze(Variable var);
+
+    /** Check whether a variable is frozen
+     *
+     * @param var checked variable
+     * @return true iff @p var is a frozen boolean variable
+     */
+    bool is_frozen(Variable var) const;
+
+    /** Check whether a variable has been removed by the last `run()`
+     *
+     * @param var checked variable
+     * @return true iff @p var is a boolean variable which does not occur in the simplified clauses
+     * because it was substituted or eliminated
+     */
+    bool is_removed(Variable var) const;
+
+    /** Simplify asserted clauses in @p db
+     *
+     * The witness stack from the previous call is discarded. Learned clauses which contain a
+     * removed variable are deleted.
+     *
+     * @param db clause database
+     * @param trail empty solver trail
+     * @return false iff the asserted clauses are found to be unsatisfiable
+     */
+    bool run(Database& db, Trail& trail);
+
+    /** Assign values to variables removed by the last `run()`.
+     *
+     * @param model model of the simplified clauses which is extended to a model of the original
+     * clauses
+     */
+    void extend_model(Model<bool>& model) const;
+
+    /** Get clauses removed by the last `run()`
+     *
+     * @return witness stack in the order in which the clauses have been removed
+     */
+    inline std::vector<Witness> const& witnesses() const { return stack; }
+
+    /** Set maximal number of preprocessing rounds
+     *
+     * @param rounds maximal number of rounds
+     */
+    inline void set_max_rounds(int rounds) { max_rounds = rounds; }
+
+    /** Set maximal number of occurrences of each literal of an eliminated variable
+     *
+     * @param count maximal number of clauses with a literal of an eliminated variable
+     */
+    inline void set_max_occurrences(std::size_t count) { max_occurrences = count; }
+
+    /** Set maximal size of a resolvent added by variable elimination
+     *
+     * @param size maximal number of literals in a resolvent
+     */
+    inline void set_max_resolvent_size(std::size_t size) { max_resolvent_size = size; }
+
+    /** Set maximal number of clause visits in failed literal probing in each round
+     *
+     * @param budget maximal number of clause visits
+     */
+    inline void set_probing_budget(std::size_t budget) { probing_budget = budget; }
+
+    /**
+     * @return number of variables eliminated by the last `run()`
+     */
+    inline int num_eliminated() const { return eliminated; }
+
+    /**
+     * @return number of variables substituted by an equivalent literal in the last `run()`
+     */
+    inline int num_substituted() const { return substituted; }
+
+    /**
+     * @return number of units found by failed literal probing in the last `run()`
+     */
+    inline int num_failed() const { return failed; }
+
+    /** Copy counters of the last `run()` to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
+
+private:
+    // map variable ordinal -> true iff the variable cannot be removed
+    std::vector<bool> frozen;
+    // map variable ordinal -> true iff the variable has been removed by the last `run()`
+    std::vector<bool> removed;
+    // witness stack for model extension
+    std::vector<Witness> stack;
+    // map literal -> asserted clauses in which it occurs (set by `index()`)
+    Literal_map<std::vector<Clause_ptr>> occur;
+    // auxiliary bitset for resolution and subset tests
+    Literal_map<bool> lit_bitset;
+    // assignment of unit propagation (level 0 and the probed literal)
+    Model<bool> assignment;
+    // literals assigned in `assignment` in the order in which they were assigned
+    std::vector<Literal> assigned;
+    // number of clause visits in `propagate()`
+    std::size_t num_visits = 0;
+    // maximal number of preprocessing rounds
+    int max_rounds = 4;
+    // maximal number of occurrences of each literal of an eliminated variable
+    std::size_t max_occurrences = 16;
+    // maximal size of a resolvent
+    std::size_t max_resolvent_size = 16;
+    // maximal number of clause visits in failed literal probing in each round
+    std::size_t probing_budget = 1'000'000;
+    // statistics of the last run
+    int eliminated = 0;
+    int substituted = 0;
+    int failed = 0;
+
+    /** Construct `occur` from non-empty asserted clauses in @p db
+     *
+     * @param db clause database
+     */
+    void index(Database& db);
+
+    /** Assign @p lit and propagate it through clauses in `occur`
+     *
+     * @param lit literal to assign
+     * @return false iff a conflict is detected
+     */
+    bool propagate(Literal lit);
+
+    /** Unassign literals assigned after the first @p size assigned literals
+     *
+     * @param size number of assigned literals to keep
+     */
+    void backtrack(std::size_t size);
+
+    /** Remove duplicate literals from @p clause
+     *
+     * @param clause clause to normalize
+     * @return false iff @p clause is a tautology
+     */
+    bool normalize(Clause& clause);
+
+    /** Propagate unit clauses, remove satisfied clauses and false literals, duplicate literals,
+     * and tautologies.
+     *
+     * Empty clauses are removed from @p db. Units are kept as unit clauses.
+     *
+     * @param db clause database
+     * @return false iff a conflict is detected
+     */
+    bool simplify(Database& db);
+
+    /** Replace equivalent literals with a representative of their equivalence class
+     *
+     * @param db clause database
+     * @return number of substituted variables or none if a conflict is detected
+     */
+    std::optional<int> substitute_equivalences(Database& db);
+
+    /** Find failed literals and literals implied by both polarities of a variable.
+     *
+     * @param db clause database
+     * @return number of units added to @p db or none if a conflict is detected
+     */
+    std::optional<int> probe(Database& db);
+
+    /** Eliminate variables whose clauses can be replaced by fewer resolvents
+     *
+     * @param db clause database
+     * @return number of eliminated variables or none if an empty resolvent is derived
+     */
+    std::optional<int> eliminate(Database& db);
+
+    /** Compute a resolvent of @p first and @p second on @p var
+     *
+     * @param first clause which contains positive literal of @p var
+     * @param second clause which contains negative literal of @p var
+     * @param var boolean variable
+     * @param out resolvent (only valid if the return value is true)
+     * @return false iff the resolvent is a tautology
+     */
+    bool resolve(Clause const& first, Clause const& second, Variable var,
+                 std::vector<Literal>& out);
+
+    /** Remove clauses subsumed by @p clause (by making them empty)
+     *
+     * @param clause pointer to a clause with its signature
+     */
+    void remove_subsumed(Clause_ptr clause);
+
+    /** Collect non-empty clauses from an occurrence list
+     *
+     * @param lit literal
+     * @return clauses in `occur[lit]` which have not been removed
+     */
+    std::vector<Clause*> occurrences(Literal lit);
+};
+
+} // namespace yaga
+
+#endif // YAGA_SAT_PREPROCESSOR_H
@@ -1,20 +1,70 @@
 #include "Solver.h"
 
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
 namespace yaga {
 
+namespace {
+
+// number of iterations of the main loop between two checks of time and memory limits
+constexpr int clock_period = 64;
+
+// get current resident set size of this process in bytes (0 if it is not available)
+std::size_t resident_memory()
+{
+#if defined(__linux__)
+    // the second field is the number of resident pages
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    if (statm >> size >> resident)
+    {
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) == KERN_SUCCESS)
+    {
+        return static_cast<std::size_t>(info.resident_size);
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
 Solver::Solver(const terms::Term_manager& tm, proof::Tracer_wrapper tracer) 
     : solver_trail(dispatcher), term_manager(tm), tracer_(tracer)
 {
     subsumption = std::make_unique<Subsumption>(tracer);
     dispatcher.add(subsumption.get());
+    sat_preprocessor = std::make_unique<Sat_preprocessor>();
+    dispatcher.add(sat_preprocessor.get());
+    clause_vivification = std::make_unique<Vivification>(tracer);
+    dispatcher.add(clause_vivification.get());
 }
 
 Solver::Solver() : Solver(terms::Term_manager()) {}
 
-std::vector<Clause> Solver::propagate() { return theory()->propagate(database, solver_trail); }
+std::vector<Clause> Solver::propagate()
+{
+    Scoped_timer timer{propagate_time};
+    auto num_assigned = solver_trail.num_assigned();
+    auto conflicts = theory()->propagate(database, solver_trail);
+    total_propagations += static_cast<std::uint64_t>(solver_trail.num_assigned() - num_assigned);
+    return conflicts;
+}
 
 std::pair<std::vector<Clause>, int> Solver::analyze_conflicts(std::vector<Clause>&& conflicts)
 {
+    Scoped_timer timer{analyze_time};
     ++total_conflicts;
     std::vector<Clause> learned;
     int level = std::numeric_limits<int>::max();
@@ -53,6 +103,7 @@ std::pair<std::vector<Clause>, int> Solver::analyze_conflicts(std::vector<Clause
 
 Solver::Clause_range Solver::learn(std::vector<Clause>&& clauses)
 {
+    Scoped_timer timer{learn_time};
     // remove duplicate clauses
     std::sort(clauses.begin(), clauses.end(), [](auto const& lhs, auto const& rhs) {
         if (lhs.size() < rhs.size())
@@ -103,6 +154,7 @@ bool Solver::is_semantic_split(Clause const& clause) const
 
 void Solver::backtrack_with(Clause_range clauses, int level)
 {
+    Scoped_timer timer{backtrack_time};
     dispatcher.on_before_backtrack(db(), trail(), level);
 
     auto& model = trail().model<bool>(Variable::boolean);
@@ -159,13 +211,21 @@ std::optional<Variable> Solver::pick_variable() { return variable_order->pick(db
 
 void Solver::decide(Variable var)
 {
+    Scoped_timer timer{decide_time};
     ++total_decisions;
     theory()->decide(db(), trail(), var);
 }
 
-void Solver::init()
+void Solver::decide(Literal lit)
+{
+    Scoped_timer timer{decide_time};
+    ++total_decisions;
+    trail().model<bool>(Variable::boolean).set_value(lit.var().ord(), !lit.is_negation());
+    trail().decide(lit.var());
+}
+
+void Solver::resize()
 {
-    // allocate memory
     for (auto [type, model] : trail().models())
     {
         if (type == Variable::boolean)
@@ -174,31 +234,228 @@ void Solver::init()
         }
         dispatcher.on_variable_resize(type, model->num_vars());
     }
+}
+
+void Solver::init()
+{
+    resize();
 
     // reset solver state
     total_conflicts = 0;
+    total_conflict_clauses = 0;
+    total_learned_clauses = 0;
     total_decisions = 0;
     total_restarts = 0;
+    total_partial_restarts = 0;
+    total_propagations = 0;
+    propagate_time = analyze_time = learn_time = backtrack_time = decide_time = restart_time = {};
     dispatcher.on_init(db(), trail());
 }
 
-void Solver::restart()
+void Solver::collect_statistics(Statistics& stats) const
 {
-    dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+    stats.set("solver.conflicts", total_conflicts);
+    stats.set("solver.conflict_clauses", total_conflict_clauses);
+    stats.set("solver.learned_clauses", total_learned_clauses);
+    stats.set("solver.decisions", total_decisions);
+    stats.set("solver.restarts", total_restarts);
+    stats.set("solver.partial_restarts", total_partial_restarts);
+    stats.set("solver.propagations", total_propagations);
+    stats.set("solver.propagate", propagate_time);
+    stats.set("solver.analyze", analyze_time);
+    stats.set("solver.learn", learn_time);
+    stats.set("solver.backtrack", backtrack_time);
+    stats.set("solver.decide", decide_time);
+    stats.set("solver.restart", restart_time);
+    dispatcher.collect_statistics(stats);
+    tracer_.collect_statistics(stats);
+}
+
+bool Solver::is_out_of_resources()
+{
+    if (terminate_flag->load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    auto const& limits = solver_limits;
+    if ((limits.conflicts && total_conflicts - start_conflicts >= limits.conflicts.value()) ||
+        (limits.decisions && total_decisions - start_decisions >= limits.decisions.value()) ||
+        (limits.propagations &&
+         total_propagations - start_propagations >= limits.propagations.value()))
+    {
+        return true;
+    }
+
+    if ((limits.time || limits.memory) && --clock_countdown <= 0)
+    {
+        clock_countdown = clock_period;
+        if (limits.time && std::chrono::steady_clock::now() - start_time >= limits.time.value())
+        {
+            return true;
+        }
+        if (limits.memory && resident_memory() >= limits.memory.value())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Solver::reuse_level(int level)
+{
+    // find the best variable which will be unassigned after backtracking to `level`
+    auto next = variable_order->pick(db(), trail());
+    for (int i = level + 1; i <= trail().decision_level(); ++i)
+    {
+        for (auto [var, _] : trail().assigned(i))
+        {
+            if (trail().decision_level(var).value() == i &&
+                (!next || variable_order->is_before(var, next.value())))
+            {
+                next = var;
+            }
+        }
+    }
+
+    if (!next)
+    {
+        return level;
+    }
+
+    // keep decisions which would be made before `next` again
+    int reuse = 0;
+    while (reuse < level &&
+           variable_order->is_before(trail().assigned(reuse + 1).front().var, next.value()))
+    {
+        ++reuse;
+    }
+    return reuse;
+}
 
+void Solver::restart(Clause_range clauses, int level)
+{
+    Scoped_timer timer{restart_time};
+    auto target = trail_reuse ? reuse_level(level) : 0;
     ++total_restarts;
-    trail().clear();
+    if (trail_reuse && level > 0 && target >= level) // keep all levels kept by backtracking
+    {
+        ++total_partial_restarts;
+        backtrack_with(clauses, level);
+    }
+    else if (target > 0)
+    {
+        ++total_partial_restarts;
+        dispatcher.on_before_backtrack(db(), trail(), target);
+        trail().backtrack(target);
+    }
+    else
+    {
+        dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+        trail().clear();
+    }
 
     dispatcher.on_restart(db(), trail());
 }
 
-Solver::Result Solver::check()
+void Solver::suspend()
+{
+    dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+    trail().clear();
+    is_interrupted = true;
+}
+
+bool Solver::begin_lookahead()
 {
-    init();
-    tracer_.begin_proof(database);
+    if (!trail().empty())
+    {
+        dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+        trail().clear();
+    }
+
+    // keep the state of heuristics if the lookahead splits a stopped search
+    if (is_interrupted)
+    {
+        resize();
+    }
+    else
+    {
+        init();
+    }
+    return propagate().empty();
+}
+
+bool Solver::push(Literal lit)
+{
+    auto& model = trail().model<bool>(Variable::boolean);
+    assert(!model.is_defined(lit.var().ord()));
+    model.set_value(lit.var().ord(), !lit.is_negation());
+    trail().decide(lit.var());
+    return propagate().empty();
+}
+
+void Solver::pop()
+{
+    assert(trail().decision_level() > 0);
+    auto level = trail().decision_level() - 1;
+    dispatcher.on_before_backtrack(db(), trail(), level);
+    trail().backtrack(level);
+}
+
+void Solver::end_lookahead()
+{
+    dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+    trail().clear();
+}
+
+Solver::Result Solver::check(std::span<Literal const> assumptions)
+{
+    auto result = search(assumptions);
+    // a request to terminate is pending until it stops a check() or until a check() finishes
+    terminate_flag->store(false, std::memory_order_relaxed);
+    return result;
+}
+
+Solver::Result Solver::search(std::span<Literal const> assumptions)
+{
+    failed.reset();
+
+    // simplify asserted clauses unless they have to be traced (the preprocessor cannot run
+    // again when a stopped search is resumed since it would forget eliminated variables)
+    if (preprocessing && !tracer_ && !is_interrupted && assumptions.empty() && trail().empty() &&
+        !sat_preprocessor->run(db(), trail()))
+    {
+        return Result::unsat;
+    }
+
+    // a stopped search is resumed with the state of heuristics and statistics it has reached
+    if (is_interrupted)
+    {
+        resize();
+    }
+    else
+    {
+        init();
+        tracer_.begin_proof(database);
+    }
+    is_interrupted = false;
+
+    // limits are counted from the beginning of this check()
+    start_conflicts = total_conflicts;
+    start_decisions = total_decisions;
+    start_propagations = total_propagations;
+    start_time = std::chrono::steady_clock::now();
+    clock_countdown = 0;
 
     for (;;)
     {
+        if (is_out_of_resources())
+        {
+            // keep learned clauses for the next check()
+            suspend();
+            return Result::unknown;
+        }
+
         auto conflicts = propagate();
         if (!conflicts.empty())
         {
@@ -221,7 +478,7 @@ Solver::Result Solver::check()
             auto clauses = learn(std::move(learned));
             if (restart_policy->should_restart())
             {
-                restart();
+                restart(clauses, level);
             }
             else // backtrack instead of restarting
             {
@@ -230,10 +487,35 @@ Solver::Result Solver::check()
         }
         else // no conflict
         {
+            // decide assumptions before other variables
+            if (!assumptions.empty())
+            {
+                auto const& model = trail().model<bool>(Variable::boolean);
+                auto it = std::find_if(assumptions.begin(), assumptions.end(), [&](auto lit) {
+                    return !model.is_defined(lit.var().ord()) ||
+                           model.value(lit.var().ord()) == lit.is_negation();
+                });
+                if (it != assumptions.end())
+                {
+                    if (model.is_defined(it->var().ord())) // the assumption is false
+                    {
+                        failed = *it;
+                        suspend();
+                        return Result::unsat;
+                    }
+                    decide(*it);
+                    continue;
+                }
+            }
+
             auto var = pick_variable();
             if (!var)
             {
                 // TODO clean up proof file?
+                if (preprocessing)
+                {
+                    sat_preprocessor->extend_model(trail().model<bool>(Variable::boolean));
+                }
                 return Result::sat;
             }
             decide(var.value());
@@ -3,8 +3,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <type_traits>
 #include <vector>
 #include <ranges>
@@ -16,6 +22,8 @@
 #include "Event_listener.h"
 #include "Event_dispatcher.h"
 #include "Restart.h"
+#include "Sat_preprocessor.h"
+#include "Statistics.h"
 #include "Subsumption.h"
 #include "Term_manager.h"
 #include "Theory.h"
@@ -23,12 +31,28 @@
 #include "Tracer_wrapper.h"
 #include "Variable.h"
 #include "Variable_order.h"
+#include "Vivification.h"
 
 namespace yaga {
 
 class Solver {
 public:
-    enum class Result { unsat = 0, sat = 1 };
+    enum class Result { unsat = 0, sat = 1, unknown = 2 };
+
+    /** Resource limits of one `check()`. Limits which are not set are not checked.
+     */
+    struct Limits {
+        // maximal number of conflicts
+        std::optional<std::uint64_t> conflicts;
+        // maximal number of decisions
+        std::optional<std::uint64_t> decisions;
+        // maximal number of variables assigned by propagation
+        std::optional<std::uint64_t> propagations;
+        // maximal wall-clock time
+        std::optional<std::chrono::milliseconds> time;
+        // maximal resident set size of the process in bytes
+        std::optional<std::size_t> memory;
+    };
 
     Solver();
     Solver(const terms::Term_manager& tm, proof::Tracer_wrapper tracer = {});
@@ -135,39 +159,168 @@ public:
 
     /** Check satisfiability of asserted clauses in database `db()`
      *
-     * @return `sat` if asserted clauses are satisfiable, `unsat` otherwise
+     * If the search exceeds a limit set by `set_limits()` or if `terminate()` is called, the
+     * solver backtracks to decision level 0 and returns `unknown`. Learned clauses are kept so
+     * the next `check()` resumes the search.
+     *
+     * @return `sat` if asserted clauses are satisfiable, `unsat` if they are unsatisfiable,
+     * `unknown` if the search has been stopped
+     */
+    inline Result check() { return check(std::span<Literal const>{}); }
+
+    /** Check satisfiability of asserted clauses in database `db()` under @p assumptions
+     *
+     * Assumptions are decided before any other variable. Learned clauses do not depend on
+     * assumptions so they are kept for subsequent calls. Asserted clauses are not preprocessed if
+     * there are some assumptions.
+     *
+     * @param assumptions boolean literals which have to be true in the model
+     * @return `sat` if asserted clauses are satisfiable together with assumptions, `unsat` if they
+     * are not (see `failed_assumption()`), `unknown` if the search has been stopped
+     */
+    Result check(std::span<Literal const> assumptions);
+
+    /** Get assumption refuted by the last `check()`
+     *
+     * @return assumption which was false when the last `check()` returned `unsat` or none if
+     * asserted clauses are unsatisfiable regardless of assumptions
+     */
+    inline std::optional<Literal> failed_assumption() const { return failed; }
+
+    /** Backtrack to decision level 0 and propagate asserted clauses so that the effect of
+     * decisions can be examined by `push()` and `pop()`
+     *
+     * If the last `check()` has been stopped, heuristics are not reset, so the next `check()`
+     * still resumes the search.
+     *
+     * @return false iff propagation at decision level 0 ends in a conflict
+     */
+    bool begin_lookahead();
+
+    /** Decide @p lit at a new decision level and propagate it
+     *
+     * @param lit literal of an unassigned boolean variable
+     * @return false iff propagation ends in a conflict (the decision level is kept until `pop()`)
+     */
+    bool push(Literal lit);
+
+    /** Backtrack the decision level created by the last `push()`
+     */
+    void pop();
+
+    /** Backtrack to decision level 0 after `begin_lookahead()`
+     */
+    void end_lookahead();
+
+    /** Register an additional listener of events in this solver
+     *
+     * @param listener listener which is not owned by the solver
+     */
+    inline void add_listener(Event_listener* listener) { dispatcher.add(listener); }
+
+    /** Set resource limits of each subsequent `check()`
+     *
+     * Conflicts, decisions and propagations are counted from the beginning of `check()`. Time
+     * and memory are checked periodically.
+     *
+     * @param limits new resource limits
+     */
+    inline void set_limits(Limits const& limits) { solver_limits = limits; }
+
+    /** Get resource limits of `check()`
+     *
+     * @return current resource limits
      */
-    Result check();
+    inline Limits const& limits() const { return solver_limits; }
+
+    /** Stop the running `check()` as soon as possible so that it returns `unknown`. If no
+     * `check()` is running, the request is kept and the next `check()` returns `unknown`
+     * immediately. The request is cleared when `check()` returns.
+     *
+     * This method can be called from any thread.
+     */
+    inline void terminate() { terminate_flag->store(true, std::memory_order_relaxed); }
 
     /** Get total number of conflicts
      *
-     * @return total number of conflicts in the last `check()`
+     * @return total number of conflicts in the last `check()` and stopped checks it resumed
      */
-    inline int num_conflicts() const { return total_conflicts; }
+    inline std::uint64_t num_conflicts() const { return total_conflicts; }
 
     /** Get total number of decisions
      *
-     * @return total number of decisions in the last `check()`
+     * @return total number of decisions in the last `check()` and stopped checks it resumed
+     */
+    inline std::uint64_t num_decisions() const { return total_decisions; }
+
+    /** Get total number of variables assigned by propagation
+     *
+     * @return total number of propagations in the last `check()` and stopped checks it resumed
      */
-    inline int num_decisions() const { return total_decisions; }
+    inline std::uint64_t num_propagations() const { return total_propagations; }
 
     /** Get number of restart
      *
-     * @return total number of restarts in the last `check()`
+     * @return total number of restarts in the last `check()` and stopped checks it resumed
+     */
+    inline std::uint64_t num_restarts() const { return total_restarts; }
+
+    /** Get number of restarts which kept some decision levels on the trail
+     *
+     * @return total number of partial restarts in the last `check()` and stopped checks it resumed
+     */
+    inline std::uint64_t num_partial_restarts() const { return total_partial_restarts; }
+
+    /** Enable or disable partial restarts with trail reuse.
+     *
+     * If enabled, the solver backtracks only to the highest decision level such that all
+     * decisions up to that level would be decided before the next decision variable picked by
+     * the variable order. The solver would most likely make the same decisions again after a full
+     * restart.
+     *
+     * @param value true iff the solver should reuse trail on restart
+     */
+    inline void set_trail_reuse(bool value) { trail_reuse = value; }
+
+    /** Enable or disable preprocessing of asserted clauses at the beginning of `check()`.
+     *
+     * Preprocessing is skipped if proofs are produced or if the trail is not empty.
+     *
+     * @param value true iff `check()` should simplify asserted clauses using `preprocessor()`
+     */
+    inline void set_preprocessing(bool value) { preprocessing = value; }
+
+    /** Get SAT preprocessor used by this solver
+     *
+     * Boolean variables interpreted by a theory have to be frozen in the preprocessor.
+     *
+     * @return preprocessor of asserted clauses
      */
-    inline int num_restarts() const { return total_restarts; }
+    inline Sat_preprocessor& preprocessor() { return *sat_preprocessor; }
+
+    /** Enable or disable vivification of learned clauses on restart.
+     *
+     * @param value true iff learned clauses with a low glucose level should be strengthened
+     */
+    inline void set_vivification(bool value) { clause_vivification->set_enabled(value); }
+
+    /** Get vivification of learned clauses used by this solver
+     *
+     * @return listener which strengthens learned clauses on restart
+     */
+    inline Vivification& vivification() { return *clause_vivification; }
 
     /** Get total number of generated conflict clauses
      * 
      * @return total number of conflict clauses in the last `check()`
      */
-    inline int num_conflict_clauses() const { return total_conflict_clauses; }
+    inline std::uint64_t num_conflict_clauses() const { return total_conflict_clauses; }
 
     /** Get total number of learned clauses
      * 
      * @return total number of learned clauses in the last `check()`
      */
-    inline int num_learned_clauses() const { return total_learned_clauses; }
+    inline std::uint64_t num_learned_clauses() const { return total_learned_clauses; }
 
     /** Get theory used by this solver
      * 
@@ -177,28 +330,65 @@ public:
 
     inline proof::Tracer_wrapper& tracer() { return tracer_; }
 
+    /** Copy counters and timers of this solver, its theory, and other components to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const;
+
 private:
     Event_dispatcher dispatcher;
     Trail solver_trail;
     Database database;
     Conflict_analysis analysis;
     std::unique_ptr<Subsumption> subsumption;
+    std::unique_ptr<Sat_preprocessor> sat_preprocessor;
+    std::unique_ptr<Vivification> clause_vivification;
     std::unique_ptr<Theory> solver_theory;
     std::unique_ptr<Restart> restart_policy;
     std::unique_ptr<Variable_order> variable_order;
     const terms::Term_manager& term_manager;
     proof::Tracer_wrapper tracer_;
     int num_bool_vars = 0;
+    // true iff restarts keep decision levels which would most likely be recreated
+    bool trail_reuse = false;
+    // true iff asserted clauses are simplified at the beginning of `check()`
+    bool preprocessing = false;
+    // true iff the last `check()` has been stopped (the next one resumes the search)
+    bool is_interrupted = false;
+    // assumption which was false when the last `check()` returned `unsat`
+    std::optional<Literal> failed;
+    // resource limits of `check()`
+    Limits solver_limits;
+    // set by `terminate()` (allocated so that the solver stays movable)
+    std::unique_ptr<std::atomic<bool>> terminate_flag = std::make_unique<std::atomic<bool>>(false);
+    // number of iterations of `check()` until time and memory limits are checked again
+    int clock_countdown = 0;
+    // time when `check()` started
+    std::chrono::steady_clock::time_point start_time;
+    // values of counters when `check()` started (limits are relative to them)
+    std::uint64_t start_conflicts = 0;
+    std::uint64_t start_decisions = 0;
+    std::uint64_t start_propagations = 0;
 
     using Clause_iterator = std::deque<Clause>::iterator;
     using Clause_range = std::ranges::subrange<Clause_iterator>;
 
     // statistics
-    int total_conflicts = 0;
-    int total_conflict_clauses = 0;
-    int total_learned_clauses = 0;
-    int total_restarts = 0;
-    int total_decisions = 0;
+    std::uint64_t total_conflicts = 0;
+    std::uint64_t total_conflict_clauses = 0;
+    std::uint64_t total_learned_clauses = 0;
+    std::uint64_t total_restarts = 0;
+    std::uint64_t total_partial_restarts = 0;
+    std::uint64_t total_decisions = 0;
+    std::uint64_t total_propagations = 0;
+    // time spent in phases of `check()` (restarts include backtracking)
+    Statistics::Timer propagate_time;
+    Statistics::Timer analyze_time;
+    Statistics::Timer learn_time;
+    Statistics::Timer backtrack_time;
+    Statistics::Timer decide_time;
+    Statistics::Timer restart_time;
 
     // run propagate in theory
     [[nodiscard]] std::vector<Clause> propagate();
@@ -214,10 +404,22 @@ private:
     [[nodiscard]] std::optional<Variable> pick_variable();
     // decide value of an unassigned variable
     void decide(Variable var);
-    // restart the solver
-    void restart();
+    // decide an assumption
+    void decide(Literal lit);
+    // restart the solver after learning `clauses` with assertion level `level`
+    void restart(Clause_range clauses, int level);
+    // find the highest decision level <= `level` that can be kept on restart
+    int reuse_level(int level);
+    // allocate memory for all variables in the trail
+    void resize();
     // reset the solver for a new check()
     void init();
+    // implementation of `check()` (the terminate request is cleared by the caller)
+    [[nodiscard]] Result search(std::span<Literal const> assumptions);
+    // check if the search should stop because of `terminate()` or resource limits
+    bool is_out_of_resources();
+    // backtrack to decision level 0 so that the next `check()` resumes the search
+    void suspend();
 };
 
 } // namespace yaga
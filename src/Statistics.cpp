@@ -0,0 +1,127 @@
+#include "Statistics.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace yaga {
+
+namespace {
+
+/** Find an entry by name or add a new entry at the end
+ *
+ * @param entries list of named entries
+ * @param name name of the entry
+ * @return reference to the value of the entry
+ */
+template <typename T>
+T& find_or_add(std::vector<std::pair<std::string, T>>& entries, std::string_view name)
+{
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](auto const& entry) { return entry.first == name; });
+    if (it == entries.end())
+    {
+        return entries.emplace_back(std::string{name}, T{}).second;
+    }
+    return it->second;
+}
+
+/** Write a JSON string (names only contain printable characters)
+ *
+ * @param out output stream
+ * @param value string to write
+ */
+void write_json_string(std::ostream& out, std::string_view value)
+{
+    out << '"';
+    for (auto c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Statistics::set(std::string_view name, std::uint64_t value)
+{
+    find_or_add(counters, name) = value;
+}
+
+void Statistics::set(std::string_view name, Timer const& timer)
+{
+    find_or_add(timers, name) = timer;
+}
+
+std::optional<std::uint64_t> Statistics::counter(std::string_view name) const
+{
+    auto it = std::find_if(counters.begin(), counters.end(),
+                           [&](auto const& entry) { return entry.first == name; });
+    return it == counters.end() ? std::optional<std::uint64_t>{} : it->second;
+}
+
+std::optional<Statistics::Timer> Statistics::timer(std::string_view name) const
+{
+    auto it = std::find_if(timers.begin(), timers.end(),
+                           [&](auto const& entry) { return entry.first == name; });
+    return it == timers.end() ? std::optional<Timer>{} : it->second;
+}
+
+double Statistics::seconds(std::uint64_t ticks)
+{
+    static double const ticks_per_second = [] {
+        using Clock = std::chrono::steady_clock;
+        auto start_time = Clock::now();
+        auto start_ticks = read_ticks();
+        while (Clock::now() - start_time < std::chrono::milliseconds{10})
+        {
+        }
+        auto end_ticks = read_ticks();
+        std::chrono::duration<double> elapsed = Clock::now() - start_time;
+        return static_cast<double>(end_ticks - start_ticks) / elapsed.count();
+    }();
+    return static_cast<double>(ticks) / ticks_per_second;
+}
+
+void Statistics::write_text(std::ostream& out) const
+{
+    for (auto const& [name, value] : counters)
+    {
+        out << name << " = " << value << "\n";
+    }
+    for (auto const& [name, timer] : timers)
+    {
+        out << name << " = " << std::fixed << std::setprecision(6) << seconds(timer.ticks)
+            << " s (" << timer.calls << " calls)\n";
+    }
+    out << std::defaultfloat;
+}
+
+void Statistics::write_json(std::ostream& out) const
+{
+    out << "{\n  \"counters\": {";
+    for (std::size_t i = 0; i < counters.size(); ++i)
+    {
+        out << (i == 0 ? "\n    " : ",\n    ");
+        write_json_string(out, counters[i].first);
+        out << ": " << counters[i].second;
+    }
+    out << (counters.empty() ? "},\n" : "\n  },\n");
+
+    out << "  \"timers\": {";
+    for (std::size_t i = 0; i < timers.size(); ++i)
+    {
+        auto const& [name, timer] = timers[i];
+        out << (i == 0 ? "\n    " : ",\n    ");
+        write_json_string(out, name);
+        out << ": {\"seconds\": " << std::fixed << std::setprecision(6) << seconds(timer.ticks)
+            << std::defaultfloat << ", \"calls\": " << timer.calls << "}";
+    }
+    out << (timers.empty() ? "}\n" : "\n  }\n");
+    out << "}\n";
+}
+
+} // namespace yaga
@@ -0,0 +1,131 @@
+#ifndef YAGA_STATISTICS_H
+#define YAGA_STATISTICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace yaga {
+
+/** Read a cheap monotonic tick counter (time stamp counter on x86, steady clock elsewhere)
+ *
+ * @return current number of ticks
+ */
+inline std::uint64_t read_ticks()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/** Registry of named counters and timers of solver components.
+ *
+ * Components keep their counters in plain 64-bit integers so that counting does not cost more
+ * than an increment. The counters are copied to this object when statistics are reported (see
+ * `Event_listener::collect_statistics()`). Names are of the form `component.counter` and they are
+ * written in the order in which they were first set.
+ */
+class Statistics {
+public:
+    /** Time spent in a phase of the solver
+     */
+    struct Timer {
+        // total number of ticks (see `read_ticks()`)
+        std::uint64_t ticks = 0;
+        // number of measured intervals
+        std::uint64_t calls = 0;
+    };
+
+    /** Set value of a counter
+     *
+     * @param name name of the counter
+     * @param value new value of the counter
+     */
+    void set(std::string_view name, std::uint64_t value);
+
+    /** Set value of a timer
+     *
+     * @param name name of the timer
+     * @param timer new value of the timer
+     */
+    void set(std::string_view name, Timer const& timer);
+
+    /** Find a counter
+     *
+     * @param name name of the counter
+     * @return value of the counter or none if it has not been set
+     */
+    std::optional<std::uint64_t> counter(std::string_view name) const;
+
+    /** Find a timer
+     *
+     * @param name name of the timer
+     * @return value of the timer or none if it has not been set
+     */
+    std::optional<Timer> timer(std::string_view name) const;
+
+    /** Write all counters and timers as `name = value` lines
+     *
+     * @param out output stream
+     */
+    void write_text(std::ostream& out) const;
+
+    /** Write all counters and timers as a JSON object with `counters` and `timers` members.
+     *
+     * Timers are objects with `seconds` and `calls` members.
+     *
+     * @param out output stream
+     */
+    void write_json(std::ostream& out) const;
+
+    /** Convert ticks to seconds. The tick rate is calibrated against the steady clock on the
+     * first call.
+     *
+     * @param ticks number of ticks returned by `read_ticks()`
+     * @return number of seconds
+     */
+    static double seconds(std::uint64_t ticks);
+
+private:
+    // values of counters in the order in which they were first set
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    // values of timers in the order in which they were first set
+    std::vector<std::pair<std::string, Timer>> timers;
+};
+
+/** Adds time spent in a scope to a timer
+ */
+class Scoped_timer {
+public:
+    inline explicit Scoped_timer(Statistics::Timer& timer) : timer(timer), start(read_ticks()) {}
+
+    inline ~Scoped_timer()
+    {
+        timer.ticks += read_ticks() - start;
+        ++timer.calls;
+    }
+
+    Scoped_timer(Scoped_timer const&) = delete;
+    Scoped_timer& operator=(Scoped_timer const&) = delete;
+
+private:
+    Statistics::Timer& timer;
+    std::uint64_t start;
+};
+
+} // namespace yaga
+
+#endif // YAGA_STATISTICS_H
@@ -6,22 +6,63 @@ void Subsumption::minimize(Trail const& trail, Clause& clause)
 {
     auto const& model = trail.model<bool>(Variable::boolean);
 
+    redundant_vars.clear();
     auto is_redundant = [&](auto lit) {
         if (eval(model, ~lit) == true)
         {
             auto reason = trail.reason(lit.var());
             bool redundant = reason && selfsubsumes(*reason, clause, ~lit);
-            if (redundant)
+            if (redundant && tracer)
             {
-                // Simple self-subsumption minimization is just resolution
-                tracer.resolve_conflict(clause.id(), reason->id());
+                redundant_vars.push_back(lit.var());
             }
             return redundant;
         }
         return false;
     };
 
-    clause.erase(std::remove_if(clause.begin(), clause.end(), is_redundant), clause.end());
+    auto end = std::remove_if(clause.begin(), clause.end(), is_redundant);
+    num_minimized_literals += static_cast<std::uint64_t>(clause.end() - end);
+    clause.erase(end, clause.end());
+
+    if (!redundant_vars.empty())
+    {
+        trace_minimization(trail, clause);
+    }
+}
+
+void Subsumption::trace_minimization(Trail const& trail, Clause const& clause)
+{
+    // Simple self-subsumption minimization is just resolution with reasons of the removed
+    // literals. A reason can contain another removed literal which was assigned before, so the
+    // reasons are resolved in reverse trail order.
+    if (redundant_vars.size() == 1)
+    {
+        tracer.resolve_conflict(clause.id(), trail.reason(redundant_vars.front())->id());
+        return;
+    }
+
+    lit_bitset.assign(false);
+    for (auto var : redundant_vars)
+    {
+        lit_bitset[Literal{var.ord()}] = true;
+    }
+
+    auto remaining = redundant_vars.size();
+    for (int level = trail.decision_level(); level >= 0 && remaining > 0; --level)
+    {
+        auto const& assigned = trail.assigned(level);
+        for (auto it = assigned.rbegin(); it != assigned.rend() && remaining > 0; ++it)
+        {
+            // variables propagated at a lower level are also in lists of higher levels
+            if (it->var.type() == Variable::boolean && lit_bitset[Literal{it->var.ord()}])
+            {
+                lit_bitset[Literal{it->var.ord()}] = false;
+                tracer.resolve_conflict(clause.id(), it->reason->id());
+                --remaining;
+            }
+        }
+    }
 }
 
 void Subsumption::on_variable_resize(Variable::Type type, int num_vars)
@@ -33,9 +74,16 @@ void Subsumption::on_variable_resize(Variable::Type type, int num_vars)
     }
 }
 
-void Subsumption::on_restart(Database& db, Trail&) { remove_subsumed(db); }
+void Subsumption::on_restart(Database& db, Trail& trail)
+{
+    // partial restarts keep reason clauses on the trail so we cannot move clauses in `db`
+    if (trail.empty())
+    {
+        remove_subsumed(db);
+    }
+}
 
-bool Subsumption::subsumes(Subsumption::Clause_ptr first, Subsumption::Clause_ptr second)
+bool Subsumption::subsumes(Clause_ptr first, Clause_ptr second)
 {
     if ((first.sig() & ~second.sig()) != 0)
     {
@@ -109,7 +157,7 @@ void Subsumption::index(Clause_iterator it, Clause_iterator end)
     }
 }
 
-void Subsumption::remove_subsumed(Subsumption::Clause_ptr clause)
+void Subsumption::remove_subsumed(Clause_ptr clause)
 {
     if (clause->empty())
     {
@@ -135,6 +183,7 @@ void Subsumption::remove_subsumed(Subsumption::Clause_ptr clause)
         {
             tracer.delete_clause(*other_ptr);
             other_ptr->clear();
+            ++num_subsumed_clauses;
         }
     }
 }
@@ -164,4 +213,10 @@ void Subsumption::remove_subsumed(Database& db)
     old_size = db.learned().size();
 }
 
+void Subsumption::collect_statistics(Statistics& stats) const
+{
+    stats.set("subsumption.minimized_literals", num_minimized_literals);
+    stats.set("subsumption.subsumed_clauses", num_subsumed_clauses);
+}
+
 } // namespace yaga
\ No newline at end of file
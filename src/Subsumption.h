@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Clause.h"
+#include "Clause_ptr.h"
 #include "Database.h"
 #include "Event_listener.h"
 #include "Literal.h"
@@ -49,33 +50,13 @@ public:
      */
     void minimize(Trail const& trail, Clause& clause);
 
-private:
-    // Clause pointer proxy which also stores signature of the clause.
-    // Signature is a 64-bit mask of the clause such that if a clause A is a
-    // subset of a clause B, then A.sig() is a subset of B.sig() (but not
-    // necessarily vice versa)
-    class Clause_ptr {
-    public:
-        inline Clause_ptr() {}
-        inline Clause_ptr(Clause* ptr, std::uint64_t sig) : clause_ptr(ptr), clause_sig(sig) {}
-        inline Clause_ptr(Clause_ptr const&) = default;
-        inline Clause_ptr& operator=(Clause_ptr const&) = default;
-        inline Clause* operator->() { return clause_ptr; }
-        inline Clause& operator*() { return *clause_ptr; }
-        inline std::uint64_t sig() const { return clause_sig; }
-        inline bool operator==(Clause_ptr const& other) const
-        {
-            return clause_ptr == other.clause_ptr;
-        }
-        inline bool operator!=(Clause_ptr const& other) const { return !operator==(other); }
-
-    private:
-        // pointer to the clause
-        Clause* clause_ptr;
-        // clause signature
-        std::uint64_t clause_sig;
-    };
+    /** Copy counters of subsumption and minimization to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
 
+private:
     using Clause_iterator = std::deque<Clause>::iterator;
 
     // map literal -> clauses in which it occurs (set by `index()`)
@@ -86,21 +67,16 @@ private:
     std::size_t old_size = 0;
     // Tracer for proof production (optional)
     proof::Tracer_wrapper tracer;
+    // variables of literals removed by `minimize()` (only if `tracer` is set)
+    std::vector<Variable> redundant_vars;
+    // total number of literals removed from learned clauses by `minimize()`
+    std::uint64_t num_minimized_literals = 0;
+    // total number of learned clauses removed because they were subsumed
+    std::uint64_t num_subsumed_clauses = 0;
 
     // compute signature of a clause and create a proxy object which includes
     // this signature
-    inline Clause_ptr make_proxy(Clause* clause) const
-    {
-        Literal_hash hash;
-
-        constexpr std::uint64_t MOD64 = (1 << 6) - 1; // bitmask for mod 64
-        std::uint64_t sig = 0;
-        for (auto lit : *clause)
-        {
-            sig |= 1UL << (hash(lit) & MOD64);
-        }
-        return {clause, sig};
-    }
+    inline Clause_ptr make_proxy(Clause* clause) const { return make_clause_ptr(clause); }
 
     /** Check if @p first is a proper subset of @p second
      *
@@ -121,6 +97,13 @@ private:
      */
     bool selfsubsumes(Clause const& first, Clause const& second, Literal lit);
 
+    /** Trace resolution steps of the last `minimize()` call
+     *
+     * @param trail current solver trail
+     * @param clause minimized clause
+     */
+    void trace_minimization(Trail const& trail, Clause const& clause);
+
     /** Construct `occur` from learned clauses in @p db
      *
      * @param begin begin iterator of a range of clauses to index
@@ -66,6 +66,21 @@ void Theory_combination::on_variable_resize(Variable::Type type, int num_vars)
     }
 }
 
+void Theory_combination::on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                                           int num_vars)
+{
+    if (type >= current_num_vars.size())
+    {
+        current_num_vars.resize(type + 1);
+    }
+    current_num_vars[type] = num_vars;
+
+    for (auto&& theory : theories())
+    {
+        theory->on_variable_remap(type, map, num_vars);
+    }
+}
+
 void Theory_combination::on_learned_clause(Database& db, Trail& trail, Clause const& learned)
 {
     for (auto&& theory : theories())
@@ -90,4 +105,12 @@ void Theory_combination::on_restart(Database& db, Trail& trail)
     }
 }
 
+void Theory_combination::collect_statistics(Statistics& stats) const
+{
+    for (auto const& theory : theory_list)
+    {
+        theory->collect_statistics(stats);
+    }
+}
+
 } // namespace yaga
\ No newline at end of file
@@ -58,6 +58,14 @@ public:
      */
     void on_variable_resize(Variable::Type, int) override;
 
+    /** Call the event in all theories.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type, std::vector<int> const&, int) override;
+
     /** Call the event in all theories.
      *
      * @param db clause database
@@ -81,6 +89,12 @@ public:
      */
     void on_restart(Database&, Trail&) override;
 
+    /** Collect statistics of all theories.
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics&) const override;
+
     /** Create a new theory and add it to this object.
      *
      * @tparam T type of the theory to create
@@ -17,4 +17,16 @@ void Trail::resize(Variable::Type type, int num_vars)
     dispatcher.on_variable_resize(type, num_vars);
 }
 
+void Trail::remap(Variable::Type type, std::vector<int> const& map, int num_vars)
+{
+    assert(type < var_models.size());
+    assert(empty());
+
+    // values of unassigned variables are irrelevant so it is sufficient to resize the model
+    var_models[type]->resize(num_vars);
+    var_reason[type].assign(num_vars, nullptr);
+    var_level[type].assign(num_vars, unassigned);
+    dispatcher.on_variable_remap(type, map, num_vars);
+}
+
 }
\ No newline at end of file
@@ -60,6 +60,12 @@ public:
     // get current decision level
     inline int decision_level() const { return static_cast<int>(trail.size()) - 1; }
 
+    /** Get number of assigned variables of all types
+     *
+     * @return number of assigned variables in this trail
+     */
+    inline int num_assigned() const { return assigned_count; }
+
     /** Get decision level of a variable
      *
      * @param var queried variable
@@ -97,6 +103,26 @@ public:
      */
     inline auto const& assigned(int level) const { return trail[level]; }
 
+    /** Call @p fn for each variable assigned at a decision level lower than the current one
+     *
+     * Each variable is visited once, in the list of its own decision level.
+     *
+     * @param fn function called with each such variable
+     */
+    template <typename Fn> inline void for_each_below_top(Fn&& fn) const
+    {
+        for (int i = 0; i < decision_level(); ++i)
+        {
+            for (auto [var, _] : assigned(i))
+            {
+                if (decision_level(var) == i)
+                {
+                    fn(var);
+                }
+            }
+        }
+    }
+
     /** Create a new model for variables of type @p type in this trail
      *
      * @tparam T value type of variables of type @p type
@@ -167,6 +193,17 @@ public:
      */
     void resize(Variable::Type type, int num_vars);
 
+    /** Renumber variables of type @p type and notify all listeners.
+     *
+     * Precondition: the trail is empty.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1 if the variable is removed
+     * (see `Event_listener::on_variable_remap()`)
+     * @param num_vars new number of variables of type @p type
+     */
+    void remap(Variable::Type type, std::vector<int> const& map, int num_vars);
+
     /** Decide variable at a new decision level.
      *
      * The caller is responsible for setting new @p var value in the appropriate
@@ -181,6 +218,7 @@ public:
         assert(var.type() < var_models.size());
 
         trail.emplace_back(std::vector<Assignment>{Assignment{var, /*reason=*/nullptr}});
+        ++assigned_count;
         var_level[var.type()][var.ord()] = decision_level();
         var_reason[var.type()][var.ord()] = nullptr;
     }
@@ -204,6 +242,7 @@ public:
         {
             trail[i].push_back(Assignment{var, reason});
         }
+        ++assigned_count;
         var_level[var.type()][var.ord()] = level;
         var_reason[var.type()][var.ord()] = reason;
     }
@@ -225,6 +264,7 @@ public:
                     var_level[assignment.var.type()][assignment.var.ord()] = unassigned;
                     var_reason[assignment.var.type()][assignment.var.ord()] = nullptr;
                     var_models[assignment.var.type()]->clear(assignment.var.ord());
+                    --assigned_count;
                 }
             }
         }
@@ -267,6 +307,7 @@ public:
 
         trail.clear();
         trail.emplace_back();
+        assigned_count = 0;
     }
 
 private:
@@ -284,6 +325,8 @@ private:
     std::vector<std::vector<int>> var_level;
     // models managed by this trail
     std::vector<std::unique_ptr<Model_base>> var_models;
+    // number of assigned variables
+    int assigned_count = 0;
 };
 
 } // namespace yaga
@@ -0,0 +1,294 @@
+#include <algorithm>
+
+#include "Vivification.h"
+
+namespace yaga {
+
+void Vivification::on_learned_clause(Database&, Trail& trail, Clause const& learned)
+{
+    if (!enabled || learned.size() <= 1)
+    {
+        return;
+    }
+
+    std::vector<int> levels(learned.size());
+    auto it = levels.begin();
+    for (auto lit : learned)
+    {
+        *it++ = trail.decision_level(lit.var()).value();
+    }
+    std::sort(levels.begin(), levels.end());
+    auto lbd = std::distance(levels.begin(), std::unique(levels.begin(), levels.end()));
+    if (lbd <= max_lbd)
+    {
+        candidates.insert(learned.id());
+    }
+}
+
+void Vivification::on_restart(Database& db, Trail& trail)
+{
+    // partial restarts keep reason clauses on the trail so we cannot modify clauses in `db`
+    if (enabled && trail.empty() && !candidates.empty())
+    {
+        vivify(db, trail);
+    }
+}
+
+void Vivification::vivify(Database& db, Trail& trail)
+{
+    // forget clauses which have been deleted from the database
+    if (candidates.size() > 2 * db.learned().size())
+    {
+        std::unordered_set<Clause_id> live;
+        for (auto const& clause : db.learned())
+        {
+            if (candidates.contains(clause.id()))
+            {
+                live.insert(clause.id());
+            }
+        }
+        candidates = std::move(live);
+    }
+
+    num_visits = 0;
+    if (!initialize(db, static_cast<int>(trail.model<bool>(Variable::boolean).num_vars())))
+    {
+        return; // the conflict will be found by the solver
+    }
+
+    // clauses are replaced after all candidates are processed since they are watched
+    std::vector<std::pair<Clause*, Clause>> replacements;
+    std::vector<Literal> literals;
+    std::vector<Clause_id> steps;
+    for (auto& clause : db.learned())
+    {
+        if (num_visits >= propagation_budget)
+        {
+            break;
+        }
+
+        if (clause.size() <= 1 || candidates.erase(clause.id()) == 0)
+        {
+            continue;
+        }
+
+        // assign negation of literals in the clause until there is a conflict or a true literal
+        auto size = assigned.size();
+        Clause const* conflict = nullptr;
+        literals.assign(clause.begin(), clause.end());
+        for (auto lit : literals)
+        {
+            auto value = eval(model, lit);
+            if (value == true)
+            {
+                conflict = reason[lit.var().ord()];
+                break;
+            }
+            else if (!value)
+            {
+                assign(~lit, nullptr);
+                if ((conflict = propagate()) != nullptr)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (conflict != nullptr)
+        {
+            steps.clear();
+            auto result = analyze(*conflict, steps);
+            if (result.size() < clause.size())
+            {
+                Clause vivified{std::move(result)};
+                if (tracer)
+                {
+                    tracer.init_conflict(*conflict, proof::conflict::Boolean{});
+                    for (auto id : steps)
+                    {
+                        tracer.resolve_conflict(conflict->id(), id);
+                    }
+                    tracer.rename_conflict(conflict->id(), vivified.id());
+                    tracer.learn_clause(vivified);
+                    tracer.finish_conflicts();
+                }
+                replacements.emplace_back(&clause, std::move(vivified));
+            }
+        }
+        backtrack(size);
+    }
+
+    for (auto& [clause, vivified] : replacements)
+    {
+        ++strengthened;
+        removed_literals += static_cast<int>(clause->size() - vivified.size());
+        tracer.delete_clause(*clause);
+        *clause = std::move(vivified);
+    }
+}
+
+bool Vivification::initialize(Database& db, int num_vars)
+{
+    watched.resize(num_vars);
+    for (auto& list : watched)
+    {
+        list.clear();
+    }
+    model.resize(num_vars);
+    model.clear();
+    reason.assign(num_vars, nullptr);
+    seen.assign(num_vars, false);
+    assigned.clear();
+    head = 0;
+
+    for (auto clause_list : {&db.asserted(), &db.learned()})
+    {
+        for (auto& clause : *clause_list)
+        {
+            if (clause.size() == 1) // propagate unit clauses
+            {
+                auto value = eval(model, clause[0]);
+                if (value == false)
+                {
+                    return false;
+                }
+                else if (!value)
+                {
+                    assign(clause[0], &clause);
+                }
+            }
+            else if (clause.size() >= 2)
+            {
+                watched[clause[0]].push_back(&clause);
+                watched[clause[1]].push_back(&clause);
+            }
+        }
+    }
+    return propagate() == nullptr;
+}
+
+void Vivification::assign(Literal lit, Clause const* reason_clause)
+{
+    model.set_value(lit.var().ord(), !lit.is_negation());
+    reason[lit.var().ord()] = reason_clause;
+    assigned.push_back(lit);
+}
+
+Clause const* Vivification::propagate()
+{
+    while (head < assigned.size())
+    {
+        auto false_lit = ~assigned[head++];
+        auto& list = watched[false_lit];
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            ++num_visits;
+            auto& clause = *list[i];
+
+            // move falsified literal to index 1
+            if (clause[0] == false_lit)
+            {
+                std::swap(clause[0], clause[1]);
+            }
+
+            // skip satisfied clauses
+            if (eval(model, clause[0]) == true)
+            {
+                list[j++] = list[i];
+                continue;
+            }
+
+            // find a new literal to watch
+            auto it = std::find_if(clause.begin() + 2, clause.end(),
+                                   [&](auto lit) { return eval(model, lit) != false; });
+            if (it != clause.end())
+            {
+                std::swap(clause[1], *it);
+                watched[clause[1]].push_back(&clause);
+                continue;
+            }
+
+            list[j++] = list[i];
+            if (eval(model, clause[0]) == false) // conflict
+            {
+                for (++i; i < list.size(); ++i)
+                {
+                    list[j++] = list[i];
+                }
+                list.resize(j);
+                return &clause;
+            }
+            assign(clause[0], &clause);
+        }
+        list.resize(j);
+    }
+    return nullptr;
+}
+
+void Vivification::backtrack(std::size_t size)
+{
+    for (auto i = size; i < assigned.size(); ++i)
+    {
+        model.clear(assigned[i].var().ord());
+        reason[assigned[i].var().ord()] = nullptr;
+    }
+    assigned.resize(size);
+    head = std::min(head, size);
+}
+
+std::vector<Literal> Vivification::analyze(Clause const& clause, std::vector<Clause_id>& steps)
+{
+    std::vector<Literal> result;
+    int num_open = 0;
+    for (auto lit : clause)
+    {
+        if (eval(model, lit) == true)
+        {
+            result.push_back(lit);
+        }
+        else if (!seen[lit.var().ord()])
+        {
+            seen[lit.var().ord()] = true;
+            ++num_open;
+        }
+    }
+
+    // resolve false literals in reverse order of assignment
+    for (auto i = assigned.size(); num_open > 0 && i-- > 0;)
+    {
+        auto lit = assigned[i];
+        if (!seen[lit.var().ord()])
+        {
+            continue;
+        }
+        seen[lit.var().ord()] = false;
+        --num_open;
+
+        auto lit_reason = reason[lit.var().ord()];
+        if (lit_reason == nullptr) // decision
+        {
+            result.push_back(~lit);
+            continue;
+        }
+
+        steps.push_back(lit_reason->id());
+        for (auto other : *lit_reason)
+        {
+            if (other != lit && !seen[other.var().ord()])
+            {
+                seen[other.var().ord()] = true;
+                ++num_open;
+            }
+        }
+    }
+    return result;
+}
+
+void Vivification::collect_statistics(Statistics& stats) const
+{
+    stats.set("vivification.strengthened_clauses", strengthened);
+    stats.set("vivification.removed_literals", removed_literals);
+}
+
+} // namespace yaga
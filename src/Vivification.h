@@ -0,0 +1,158 @@
+#ifndef YAGA_VIVIFICATION_H
+#define YAGA_VIVIFICATION_H
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Event_listener.h"
+#include "Literal.h"
+#include "Literal_map.h"
+#include "Model.h"
+#include "Tracer_wrapper.h"
+#include "Trail.h"
+#include "Variable.h"
+
+namespace yaga {
+
+/** Periodically (on restart) strengthens learned clauses with a low glucose level (LBD).
+ *
+ * A clause `l1 or ... or ln` is vivified by assigning `~l1, ~l2, ...` one by one and propagating
+ * all clauses in the database using boolean constraint propagation. If propagation leads to a
+ * conflict or if it makes some literal of the clause true, the clause is replaced by a clause
+ * derived by resolution which contains only the decided literals (and the true literal). Literals
+ * which are implied to be false by the previous literals are thus removed.
+ *
+ * Each learned clause is vivified at most once.
+ */
+class Vivification final : public Event_listener {
+public:
+    Vivification(proof::Tracer_wrapper tracer = {}) : tracer(tracer) {}
+
+    /** Compute glucose level of @p learned and remember it if it is a candidate for vivification
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned newly learned clause
+     */
+    void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override;
+
+    /** Vivify candidate learned clauses if the trail is empty
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_restart(Database& db, Trail& trail) override;
+
+    /** Enable or disable vivification
+     *
+     * @param value true iff learned clauses should be vivified on restart
+     */
+    inline void set_enabled(bool value) { enabled = value; }
+
+    /** Set maximal glucose level of vivified clauses
+     *
+     * @param lbd maximal number of distinct decision levels in a vivified clause when it was
+     * learned
+     */
+    inline void set_max_lbd(int lbd) { max_lbd = lbd; }
+
+    /** Set maximal number of clause visits in boolean constraint propagation in each restart
+     *
+     * @param budget maximal number of clause visits
+     */
+    inline void set_budget(std::size_t budget) { propagation_budget = budget; }
+
+    /**
+     * @return total number of strengthened clauses
+     */
+    inline int num_strengthened() const { return strengthened; }
+
+    /**
+     * @return total number of literals removed from learned clauses
+     */
+    inline int num_removed_literals() const { return removed_literals; }
+
+    /** Copy counters of vivification to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
+
+    /** Strengthen candidate learned clauses in @p db
+     *
+     * @param db clause database
+     * @param trail empty solver trail
+     */
+    void vivify(Database& db, Trail& trail);
+
+private:
+    // Tracer for proof production (optional)
+    proof::Tracer_wrapper tracer;
+    // true iff clauses are vivified on restart
+    bool enabled = false;
+    // maximal glucose level of a vivified clause
+    int max_lbd = 6;
+    // maximal number of clause visits in each restart
+    std::size_t propagation_budget = 100'000;
+    // ids of learned clauses which have not been vivified yet
+    std::unordered_set<Clause_id> candidates;
+    // map literal -> clauses in which it is one of the first two literals
+    Literal_map<std::vector<Clause*>> watched;
+    // partial assignment of boolean variables
+    Model<bool> model;
+    // map variable ordinal -> reason clause (nullptr for decisions)
+    std::vector<Clause const*> reason;
+    // assigned literals in the order in which they were assigned
+    std::vector<Literal> assigned;
+    // index of the next literal in `assigned` to propagate
+    std::size_t head = 0;
+    // number of clause visits in the current restart
+    std::size_t num_visits = 0;
+    // auxiliary map variable ordinal -> flag for analysis
+    std::vector<bool> seen;
+    // statistics
+    int strengthened = 0;
+    int removed_literals = 0;
+
+    /** Watch all clauses in @p db and propagate unit clauses
+     *
+     * @param db clause database
+     * @param num_vars number of boolean variables
+     * @return false iff a conflict is detected without any decision
+     */
+    bool initialize(Database& db, int num_vars);
+
+    /** Assign @p lit with @p reason
+     *
+     * @param lit literal which becomes true
+     * @param reason clause which implies @p lit or nullptr if @p lit is a decision
+     */
+    void assign(Literal lit, Clause const* reason);
+
+    /** Propagate all assigned literals using watched literals
+     *
+     * @return conflict clause or nullptr if there is no conflict
+     */
+    Clause const* propagate();
+
+    /** Unassign literals assigned after the first @p size literals
+     *
+     * @param size number of assigned literals to keep
+     */
+    void backtrack(std::size_t size);
+
+    /** Resolve @p clause with reasons of its false literals until only decisions remain
+     *
+     * @param clause clause whose literals are all false except for at most one true literal
+     * @param steps output: ids of resolved reason clauses in resolution order
+     * @return literals of the resolvent
+     */
+    std::vector<Literal> analyze(Clause const& clause, std::vector<Clause_id>& steps);
+};
+
+} // namespace yaga
+
+#endif // YAGA_VIVIFICATION_H
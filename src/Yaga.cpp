@@ -1,16 +1,82 @@
+#include <chrono>
+#include <cstdint>
 #include <span>
 
 #include "Yaga.h"
 
 namespace yaga {
 
+namespace {
+
+// create restart policy selected in `options`
+void set_restart_policy(Solver& solver, Options const& options)
+{
+    switch (options.restart)
+    {
+        case Options::Restart_policy::luby:
+            solver.set_restart_policy<Luby_restart>();
+            break;
+        case Options::Restart_policy::reluctant_doubling:
+            solver.set_restart_policy<Reluctant_doubling_restart>();
+            break;
+        case Options::Restart_policy::geometric:
+            solver.set_restart_policy<Geometric_restart>();
+            break;
+        default:
+            solver.set_restart_policy<Glucose_restart>();
+            break;
+    }
+}
+
+// convert resource limits in `options` to limits of the solver
+Solver::Limits make_limits(Options const& options)
+{
+    Solver::Limits limits;
+    if (options.conflict_limit > 0)
+    {
+        limits.conflicts = options.conflict_limit;
+    }
+    if (options.decision_limit > 0)
+    {
+        limits.decisions = options.decision_limit;
+    }
+    if (options.propagation_limit > 0)
+    {
+        limits.propagations = options.propagation_limit;
+    }
+    if (options.time_limit > 0)
+    {
+        limits.time = std::chrono::milliseconds{static_cast<std::int64_t>(options.time_limit * 1000)};
+    }
+    if (options.memory_limit > 0)
+    {
+        limits.memory = static_cast<std::size_t>(options.memory_limit) * 1024 * 1024;
+    }
+    return limits;
+}
+
+} // namespace
+
 void Propositional::setup(Yaga* yaga, Options const& options) const
 {
     yaga->solver().trail().set_model<bool>(Variable::boolean, 0);
     auto& bcp = yaga->solver().set_theory<Bool_theory>(yaga->solver().tracer());
     bcp.set_phase(options.phase);
-    yaga->solver().set_restart_policy<Glucose_restart>();
-    yaga->solver().set_variable_order<Evsids>();
+    yaga->solver().set_trail_reuse(options.trail_reuse);
+    yaga->solver().set_preprocessing(options.sat_preprocess);
+    yaga->solver().set_vivification(options.vivify);
+    if (options.mode_switch)
+    {
+        auto& modes = yaga->solver().set_restart_policy<Mode_switch>();
+        auto& order = yaga->solver().set_variable_order<Mode_order>(modes);
+        order.set_focused<Vmtf>();
+        order.set_stable<Evsids>();
+    }
+    else
+    {
+        set_restart_policy(yaga->solver(), options);
+        yaga->solver().set_variable_order<Evsids>();
+    }
 }
 
 void Qf_lra::setup(Yaga* yaga, Options const& options) const
@@ -25,12 +91,29 @@ void Qf_lra::setup(Yaga* yaga, Options const& options) const
     Linear_arithmetic::Options lra_options;
     lra_options.prop_rational = options.prop_rational;
     lra_options.prop_bounds = options.deduce_bounds;
+    lra_options.best_values = options.phase == Phase::target;
+    lra_options.collect_derived = options.collect_derived;
+    lra_options.simplex = options.simplex;
     auto& lra = theories.add_theory<Linear_arithmetic>(yaga->solver().tracer());
     lra.set_options(lra_options);
+    lra.set_rephase_schedule(&bcp);
 
     // add heuristics
-    yaga->solver().set_restart_policy<Glucose_restart>();
-    yaga->solver().set_variable_order<Generalized_vsids>(lra);
+    yaga->solver().set_trail_reuse(options.trail_reuse);
+    yaga->solver().set_preprocessing(options.sat_preprocess);
+    yaga->solver().set_vivification(options.vivify);
+    if (options.mode_switch)
+    {
+        auto& modes = yaga->solver().set_restart_policy<Mode_switch>();
+        auto& order = yaga->solver().set_variable_order<Mode_order>(modes);
+        order.set_focused<Vmtf>(lra);
+        order.set_stable<Generalized_vsids>(lra);
+    }
+    else
+    {
+        set_restart_policy(yaga->solver(), options);
+        yaga->solver().set_variable_order<Generalized_vsids>(lra);
+    }
 }
 
 void Qf_uflra::setup(Yaga* yaga, Options const& options) const
@@ -45,15 +128,32 @@ void Qf_uflra::setup(Yaga* yaga, Options const& options) const
     Linear_arithmetic::Options lra_options;
     lra_options.prop_rational = options.prop_rational;
     lra_options.prop_bounds = options.deduce_bounds;
+    lra_options.best_values = options.phase == Phase::target;
+    lra_options.collect_derived = options.collect_derived;
+    lra_options.simplex = options.simplex;
     auto& lra = theories.add_theory<Linear_arithmetic>(yaga->solver().tracer());
     lra.set_options(lra_options);
+    lra.set_rephase_schedule(&bcp);
 
     theories.add_theory<Uninterpreted_functions>(yaga->solver().tm(), yaga->real_vars(),
                                                  yaga->bool_vars(), yaga->solver().tracer());
 
     // add heuristics
-    yaga->solver().set_restart_policy<Glucose_restart>();
-    yaga->solver().set_variable_order<Generalized_vsids>(lra);
+    yaga->solver().set_trail_reuse(options.trail_reuse);
+    yaga->solver().set_preprocessing(options.sat_preprocess);
+    yaga->solver().set_vivification(options.vivify);
+    if (options.mode_switch)
+    {
+        auto& modes = yaga->solver().set_restart_policy<Mode_switch>();
+        auto& order = yaga->solver().set_variable_order<Mode_order>(modes);
+        order.set_focused<Vmtf>(lra);
+        order.set_stable<Generalized_vsids>(lra);
+    }
+    else
+    {
+        set_restart_policy(yaga->solver(), options);
+        yaga->solver().set_variable_order<Generalized_vsids>(lra);
+    }
 }
 
 Yaga::Yaga(terms::Term_manager const& tm,
@@ -70,6 +170,7 @@ void Yaga::init()
 
 void Yaga::set_logic(Initializer const& init, Options const& options) {
     init.setup(this, options);
+    smt.set_limits(make_limits(options));
 
     // find the LRA and UF plugins so we can add linear constraints and function applications
     lra = nullptr;
@@ -105,6 +206,8 @@ Variable Yaga::make_function_application(Variable::Type type, terms::term_t app_
     Variable result = make(type);
     if (uf)
         uf->register_application_term(result, app_term);
+    // value of the application is interpreted by the UF plugin
+    smt.preprocessor().freeze(result);
     return result;
 }
 
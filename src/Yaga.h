@@ -9,6 +9,8 @@
 #include "Linear_constraint.h"
 #include "Linear_arithmetic.h"
 #include "Literal.h"
+#include "Mode_order.h"
+#include "Mode_switch.h"
 #include "Options.h"
 #include "Rational.h"
 #include "Restart.h"
@@ -21,6 +23,7 @@
 #include "uf/Uninterpreted_functions.h"
 #include "Variable.h"
 #include "Variable_order.h"
+#include "Vmtf.h"
 
 #include <algorithm>
 #include <cassert>
@@ -190,8 +193,11 @@ public:
             }
         }
 
-        return lra->constraint(smt.trail(), std::forward<Var_range>(vars), 
-                               std::forward<Coef_range>(coef), pred, rhs).lit();
+        auto lit = lra->constraint(smt.trail(), std::forward<Var_range>(vars),
+                                   std::forward<Coef_range>(coef), pred, rhs).lit();
+        // the constraint is interpreted by the LRA plugin
+        smt.preprocessor().freeze(lit.var());
+        return lit;
     }
 
     std::ranges::ref_view<std::unordered_map<yaga::terms::term_t, int> > real_vars();
@@ -214,6 +220,12 @@ public:
      * @return yaga solver instance
      */
     inline Solver& solver() { return smt; }
+
+    /** Get the LRA plugin
+     *
+     * @return LRA plugin or nullptr if this logic does not support linear constraints
+     */
+    inline Linear_arithmetic* linear_arithmetic() { return lra; }
 private:
     Solver smt;
 
@@ -15,6 +15,11 @@ enum class Phase {
     /** Cache values of boolean variables.
      */
     cache,
+
+    /** Prefer values of boolean variables from the longest conflict-free trail (target phase) and
+     * periodically reset cached values (rephasing).
+     */
+    target,
 };
 
 }
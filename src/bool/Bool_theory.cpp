@@ -18,6 +18,9 @@ void Bool_theory::decide(Database&, Trail& trail, Variable var)
             case Phase::cache:
                 model.set_value(var.ord(), phase[var.ord()]);
                 break;
+            case Phase::target:
+                model.set_value(var.ord(), target[var.ord()]);
+                break;
             default:
                 assert(false && "unreachable");
                 break;
@@ -32,6 +35,23 @@ void Bool_theory::on_variable_resize(Variable::Type type, int num_vars)
     {
         watched.resize(num_vars);
         phase.resize(num_vars, true);
+        target.resize(num_vars, true);
+        best.resize(num_vars, true);
+    }
+}
+
+void Bool_theory::on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                                    int num_vars)
+{
+    if (type == Variable::boolean)
+    {
+        // watch lists are rebuilt in `initialize()` since the trail is empty
+        watched.resize(num_vars);
+        remap_values(phase, map, num_vars, true);
+        remap_values(target, map, num_vars, true);
+        remap_values(best, map, num_vars, true);
+        target_size = std::min(target_size, num_vars);
+        best_size = std::min(best_size, num_vars);
     }
 }
 
@@ -39,6 +59,11 @@ void Bool_theory::on_before_backtrack(Database& db, Trail& trail, int level)
 {
     Theory::on_before_backtrack(db, trail, level);
 
+    if (var_phase == Phase::target)
+    {
+        update_target(trail);
+    }
+
     auto& model = trail.model<bool>(Variable::boolean);
     for (int i = trail.decision_level(); i > level; --i)
     {
@@ -52,8 +77,94 @@ void Bool_theory::on_before_backtrack(Database& db, Trail& trail, int level)
     }
 }
 
+void Bool_theory::update_target(Trail const& trail)
+{
+    auto const& model = trail.model<bool>(Variable::boolean);
+
+    // count boolean variables assigned before the conflict level
+    int num_assigned = 0;
+    trail.for_each_below_top([&](Variable var) {
+        if (var.type() == Variable::boolean)
+        {
+            ++num_assigned;
+        }
+    });
+
+    if (num_assigned <= target_size && num_assigned <= best_size)
+    {
+        return;
+    }
+
+    bool is_target = num_assigned > target_size;
+    bool is_best = num_assigned > best_size;
+    trail.for_each_below_top([&](Variable var) {
+        if (var.type() == Variable::boolean)
+        {
+            if (is_target)
+            {
+                target[var.ord()] = model.value(var.ord());
+            }
+
+            if (is_best)
+            {
+                best[var.ord()] = model.value(var.ord());
+            }
+        }
+    });
+    target_size = std::max<int>(target_size, num_assigned);
+    best_size = std::max<int>(best_size, num_assigned);
+}
+
+void Bool_theory::on_restart(Database& db, Trail&)
+{
+    if (var_phase == Phase::target && num_conflicts >= next_rephase)
+    {
+        rephase(db);
+    }
+}
+
+void Bool_theory::collect_statistics(Statistics& stats) const
+{
+    stats.set("bool.propagations", num_propagations);
+    stats.set("bool.watch_visits", num_watch_visits);
+    stats.set("bool.rephases", total_rephases);
+}
+
+void Bool_theory::rephase(Database const& db)
+{
+    switch (rephase_schedule[total_rephases % rephase_schedule.size()])
+    {
+        case Rephase::original:
+            phase.assign(phase.size(), true);
+            break;
+        case Rephase::inverted:
+            phase.assign(phase.size(), false);
+            break;
+        case Rephase::best:
+            phase = best;
+            best_size = 0;
+            break;
+        case Rephase::walk:
+            walker.run(db, phase);
+            break;
+        default:
+            assert(false && "unreachable");
+            break;
+    }
+
+    // start searching for a new target phase
+    target = phase;
+    target_size = 0;
+
+    ++total_rephases;
+    next_rephase = num_conflicts + rephase_interval * (total_rephases + 1);
+}
+
 void Bool_theory::on_learned_clause(Database& db, Trail&, Clause const& learned)
 {
+    // backtracking is also caused by restarts so conflicts are counted here
+    ++num_conflicts;
+
     // find the learned clause in database (should be exactly one comparison since learned clauses
     // are added to the back)
     auto it = std::find_if(
@@ -136,6 +247,7 @@ std::vector<Clause> Bool_theory::propagate(Database& db, Trail& trail)
         {
             model.set_value(lit.var().ord(), !lit.is_negation());
             trail.propagate(lit.var(), reason, trail.decision_level());
+            ++num_propagations;
         }
         assert(eval(model, lit) == true);
         // reason clause is a unit clause which implies lit
@@ -200,6 +312,7 @@ Bool_theory::falsified([[maybe_unused]] Trail const& trail, Model<bool> const& m
     auto& watchlist = watched[falsified_lit];
     for (std::size_t i = 0; i < watchlist.size();)
     {
+        ++num_watch_visits;
         auto& watch = watchlist[i];
         auto& clause = *watch.clause;
 
@@ -2,6 +2,8 @@
 #define YAGA_BOOL_THEORY_H
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <vector>
 #include <ranges>
@@ -11,6 +13,7 @@
 #include "Literal.h"
 #include "Literal_map.h"
 #include "Model.h"
+#include "Random_walk.h"
 #include "Theory.h"
 #include "Tracer_wrapper.h"
 #include "Trail.h"
@@ -38,7 +41,7 @@ public:
      */
     void decide(Database& db, Trail& trail, Variable var) override;
 
-    /** Initialize @p learned clause
+    /** Initialize @p learned clause and count the conflict which derived it
      *
      * @param db clause database
      * @param trail current solver trail
@@ -46,7 +49,8 @@ public:
      */
     void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override;
 
-    /** Cache variable polarity
+    /** Cache variable polarity and update target and best phase if the conflict-free part of
+     * the trail is the longest so far.
      * 
      * @param db clause database
      * @param trail current solver trail
@@ -54,6 +58,22 @@ public:
      */
     void on_before_backtrack(Database&, Trail&, int) override;
 
+    /** Reset cached phases if the next rephase is due (only if phase is `Phase::target`).
+     *
+     * Rephasing is only done on restart, so the rephase schedule follows the restart policy
+     * (e.g., `Glucose_restart`).
+     *
+     * @param db clause database
+     * @param trail current solver trail after restart
+     */
+    void on_restart(Database&, Trail&) override;
+
+    /** Copy counters of BCP to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
+
     /** Allocates memory for @p num_vars watch lists if @p type is boolean
      *
      * @param type variable type
@@ -61,12 +81,60 @@ public:
      */
     void on_variable_resize(Variable::Type, int) override;
 
+    /** Move cached, target, and best phases of renumbered boolean variables
+     *
+     * @param type variable type
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type, std::vector<int> const&, int) override;
+
     /** Set phase of variables decided in `decide()`
      * 
      * @param phase phase of boolean variables decided in `decide()`
      */
     inline void set_phase(Phase phase) { var_phase = phase; }
 
+    /** Set number of conflicts between the first two rephases.
+     *
+     * The number of conflicts between subsequent rephases grows linearly.
+     *
+     * @param conflicts number of conflicts
+     */
+    inline void set_rephase_interval(int conflicts)
+    {
+        rephase_interval = conflicts;
+        next_rephase = conflicts;
+    }
+
+    /** Get number of rephases
+     *
+     * @return total number of rephases so far
+     */
+    inline int num_rephases() const { return total_rephases; }
+
+    /** Get phase of a boolean variable that is used in `decide()` with `Phase::cache`
+     *
+     * @param var_ord ordinal of a boolean variable
+     * @return cached value of the variable
+     */
+    inline bool saved_phase(int var_ord) const { return phase[var_ord]; }
+
+    /** Get phase of a boolean variable that is used in `decide()` with `Phase::target`
+     *
+     * @param var_ord ordinal of a boolean variable
+     * @return value of the variable in the longest conflict-free trail since the last rephase
+     */
+    inline bool target_phase(int var_ord) const { return target[var_ord]; }
+
+    /** Get value of a boolean variable in the longest conflict-free trail since cached phases
+     * were last reset to the best phase
+     *
+     * @param var_ord ordinal of a boolean variable
+     * @return value of the variable in the best assignment
+     */
+    inline bool best_phase(int var_ord) const { return best[var_ord]; }
+
 private:
     // we move the watched literals to the first two position in each clause
     struct Watched_clause {
@@ -96,17 +164,70 @@ private:
         inline operator std::pair<Literal, Clause*>() { return {lit, reason}; }
     };
 
+    // kinds of rephasing
+    enum class Rephase {
+        // reset cached phases to the default phase (true)
+        original,
+        // reset cached phases to the inverted default phase (false)
+        inverted,
+        // reset cached phases to the best phase
+        best,
+        // improve cached phases using local search
+        walk,
+    };
+
+    // order in which rephase kinds are used
+    inline static std::array<Rephase, 6> const rephase_schedule{
+        Rephase::original, Rephase::best, Rephase::walk, 
+        Rephase::inverted, Rephase::best, Rephase::walk,
+    };
+
     // map literal -> list of clauses in which it is watched
     Literal_map<std::vector<Watched_clause>> watched;
     // stack of true literals to propagate with a pointer to the reason clause
     std::vector<Satisfied_literal> satisfied;
     // cached variable phase
     std::vector<bool> phase;
+    // variable phase in the longest conflict-free trail since the last rephase
+    std::vector<bool> target;
+    // variable phase in the longest conflict-free trail since the last rephase to best phase
+    std::vector<bool> best;
+    // number of boolean variables in `target`
+    int target_size = 0;
+    // number of boolean variables in `best`
+    int best_size = 0;
+    // total number of conflicts
+    int num_conflicts = 0;
+    // total number of rephases
+    int total_rephases = 0;
+    // total number of literals propagated by BCP
+    std::uint64_t num_propagations = 0;
+    // total number of visited watched clauses
+    std::uint64_t num_watch_visits = 0;
+    // number of conflicts between the first two rephases
+    int rephase_interval = 1000;
+    // number of conflicts when the next rephase is due
+    int next_rephase = 1000;
+    // local search used to rephase
+    Random_walk walker;
     // phase strategy
     Phase var_phase{Phase::positive};
     // tracer for proof production (optional)
     proof::Tracer_wrapper tracer;
 
+    /** Update target and best phase using assignment of boolean variables on @p trail at levels
+     * lower than the current decision level (i.e., the trail without the conflict)
+     *
+     * @param trail current solver trail
+     */
+    void update_target(Trail const& trail);
+
+    /** Reset cached phases using the next rephase kind in `rephase_schedule`
+     *
+     * @param db clause database
+     */
+    void rephase(Database const& db);
+
     /** Propagate assigned literals at current decision level in @p trail
      *
      * @param db clause database
@@ -0,0 +1,145 @@
+#include <cassert>
+
+#include "Random_walk.h"
+
+namespace yaga {
+
+void Random_walk::init(Database const& db, std::vector<bool> const& assignment)
+{
+    clauses.clear();
+    falsified.clear();
+    occur.resize(assignment.size());
+    for (auto& list : occur)
+    {
+        list.clear();
+    }
+
+    for (auto clause_list : {&db.asserted(), &db.learned()})
+    {
+        for (auto const& clause : *clause_list)
+        {
+            if (!clause.empty())
+            {
+                clauses.push_back(&clause);
+            }
+        }
+    }
+
+    num_true.assign(clauses.size(), 0);
+    position.assign(clauses.size(), -1);
+    for (int i = 0; i < static_cast<int>(clauses.size()); ++i)
+    {
+        for (auto lit : *clauses[i])
+        {
+            occur[lit].push_back(i);
+            if (true_literal(assignment, lit.var().ord()) == lit)
+            {
+                ++num_true[i];
+            }
+        }
+
+        if (num_true[i] == 0)
+        {
+            add_falsified(i);
+        }
+    }
+}
+
+void Random_walk::add_falsified(int clause_index)
+{
+    assert(position[clause_index] < 0);
+    position[clause_index] = static_cast<int>(falsified.size());
+    falsified.push_back(clause_index);
+}
+
+void Random_walk::remove_falsified(int clause_index)
+{
+    assert(position[clause_index] >= 0);
+    auto last = falsified.back();
+    falsified[position[clause_index]] = last;
+    position[last] = position[clause_index];
+    position[clause_index] = -1;
+    falsified.pop_back();
+}
+
+int Random_walk::break_count(std::vector<bool> const& assignment, int var_ord) const
+{
+    int count = 0;
+    for (auto clause_index : occur[true_literal(assignment, var_ord)])
+    {
+        if (num_true[clause_index] == 1)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void Random_walk::flip(std::vector<bool>& assignment, int var_ord)
+{
+    auto old_lit = true_literal(assignment, var_ord);
+    assignment[var_ord] = !assignment[var_ord];
+
+    for (auto clause_index : occur[old_lit])
+    {
+        if (--num_true[clause_index] == 0)
+        {
+            add_falsified(clause_index);
+        }
+    }
+
+    for (auto clause_index : occur[~old_lit])
+    {
+        if (num_true[clause_index]++ == 0)
+        {
+            remove_falsified(clause_index);
+        }
+    }
+}
+
+int Random_walk::run(Database const& db, std::vector<bool>& assignment)
+{
+    init(db, assignment);
+
+    std::uniform_real_distribution<double> coin{0.0, 1.0};
+    auto best_assignment = assignment;
+    auto best_falsified = falsified.size();
+    for (int flips = 0; flips < max_flips && !falsified.empty(); ++flips)
+    {
+        auto const& clause = *clauses[falsified[rng() % falsified.size()]];
+
+        // pick a variable to flip
+        int var_ord = clause[rng() % clause.size()].var().ord();
+        if (coin(rng) >= noise)
+        {
+            int min_break = break_count(assignment, var_ord);
+            for (auto lit : clause)
+            {
+                if (min_break == 0)
+                {
+                    break;
+                }
+
+                auto count = break_count(assignment, lit.var().ord());
+                if (count < min_break)
+                {
+                    min_break = count;
+                    var_ord = lit.var().ord();
+                }
+            }
+        }
+
+        flip(assignment, var_ord);
+
+        if (falsified.size() < best_falsified)
+        {
+            best_falsified = falsified.size();
+            best_assignment = assignment;
+        }
+    }
+
+    assignment = std::move(best_assignment);
+    return static_cast<int>(best_falsified);
+}
+
+} // namespace yaga
@@ -0,0 +1,105 @@
+#ifndef YAGA_RANDOM_WALK_H
+#define YAGA_RANDOM_WALK_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Literal.h"
+#include "Literal_map.h"
+
+namespace yaga {
+
+/** Local search over boolean clauses (WalkSAT with a noise parameter).
+ *
+ * The search starts with a complete assignment of boolean variables (typically saved phases) and
+ * repeatedly flips a variable from a random falsified clause. The assignment with the least number
+ * of falsified clauses is returned. Theory semantics of boolean variables is ignored, so the
+ * result is only a hint for value selection of boolean variables.
+ */
+class Random_walk {
+public:
+    /** Create a new random walk with a fixed seed so that runs are reproducible.
+     *
+     * @param seed seed of the random number generator
+     */
+    inline explicit Random_walk(std::uint32_t seed = 1) : rng(seed) {}
+
+    /** Improve @p assignment using local search over all clauses in @p db
+     *
+     * @param db clause database
+     * @param assignment map boolean variable ordinal -> value. The best assignment found by the
+     * local search is stored in this vector.
+     * @return number of falsified clauses in the best assignment found
+     */
+    int run(Database const& db, std::vector<bool>& assignment);
+
+    /** Set maximal number of flips in one `run()`
+     *
+     * @param value new maximal number of flips
+     * @return this
+     */
+    inline Random_walk& set_max_flips(int value)
+    {
+        max_flips = value;
+        return *this;
+    }
+
+    /** Set probability that a random variable is flipped instead of a variable with the lowest
+     * break count.
+     *
+     * @param value probability in the interval [0, 1]
+     * @return this
+     */
+    inline Random_walk& set_noise(double value)
+    {
+        noise = value;
+        return *this;
+    }
+
+private:
+    // random number generator
+    std::minstd_rand rng;
+    // maximal number of flips in one run
+    int max_flips = 100'000;
+    // probability of flipping a random variable in a falsified clause
+    double noise = 0.5;
+
+    // map literal -> indices of clauses in `clauses` in which it occurs
+    Literal_map<std::vector<int>> occur;
+    // clauses considered by the local search
+    std::vector<Clause const*> clauses;
+    // map clause index -> number of true literals in the clause
+    std::vector<int> num_true;
+    // indices of falsified clauses
+    std::vector<int> falsified;
+    // map clause index -> position in `falsified` (or -1 if the clause is satisfied)
+    std::vector<int> position;
+
+    // initialize internal structures for `assignment`
+    void init(Database const& db, std::vector<bool> const& assignment);
+
+    // get literal of `var_ord` which is true in `assignment`
+    inline Literal true_literal(std::vector<bool> const& assignment, int var_ord) const
+    {
+        return assignment[var_ord] ? Literal{var_ord} : ~Literal{var_ord};
+    }
+
+    // compute number of clauses which become falsified if `var_ord` is flipped
+    int break_count(std::vector<bool> const& assignment, int var_ord) const;
+
+    // flip value of `var_ord` in `assignment`
+    void flip(std::vector<bool>& assignment, int var_ord);
+
+    // mark clause as falsified
+    void add_falsified(int clause_index);
+
+    // mark clause as satisfied
+    void remove_falsified(int clause_index);
+};
+
+} // namespace yaga
+
+#endif // YAGA_RANDOM_WALK_H
@@ -4,6 +4,15 @@ namespace yaga {
 
 void Bounds::resize(int num_vars) { bounds.resize(num_vars); }
 
+void Bounds::clear()
+{
+    auto num_vars = bounds.size();
+    bounds.clear();
+    bounds.resize(num_vars);
+    updated_read.clear();
+    updated_write.clear();
+}
+
 bool Bounds::depends_on(Bound const& bound, int bool_var) const
 {
     return std::any_of(bound.bounds().begin(), bound.bounds().end(), [&](auto const& other) {
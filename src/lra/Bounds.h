@@ -26,6 +26,10 @@ public:
      */
     void resize(int num_vars);
 
+    /** Remove all bounds of all variables
+     */
+    void clear();
+
     /** Deduce a new bounds from @p cons
      *
      * @param models partial assignment of variables
@@ -1,4 +1,5 @@
 #include "Linear_arithmetic.h"
+#include "Bool_theory.h"
 
 namespace yaga {
 
@@ -9,14 +10,165 @@ void Linear_arithmetic::on_variable_resize(Variable::Type type, int num_vars)
         bounds.resize(num_vars);
         watched.resize(num_vars);
         cached_values.resize(num_vars);
+        best_values.resize(num_vars);
         occur.resize(num_vars);
     }
     else if (type == Variable::boolean)
     {
         constraints.resize(num_vars);
+        origin.resize(num_vars, Origin::none);
+        simplex_vars.resize(num_vars, -1);
     }
 }
 
+void Linear_arithmetic::on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                                          int num_vars)
+{
+    if (type != Variable::boolean)
+    {
+        on_variable_resize(type, num_vars);
+        return;
+    }
+
+    // constraint objects are invalidated by `compact()`
+    constraints.compact(map, num_vars);
+    remap_values(origin, map, num_vars, Origin::removed);
+    remap_values(simplex_vars, map, num_vars, -1);
+    rebuild_watches();
+
+    // the trail is empty so there are no bounds (reasons of bounds would be renumbered)
+    simplex.clear_bounds();
+    std::vector<bool> is_used;
+    for (auto var : simplex_vars)
+    {
+        if (var >= 0)
+        {
+            if (is_used.size() <= static_cast<std::size_t>(var))
+            {
+                is_used.resize(var + 1, false);
+            }
+            is_used[var] = true;
+        }
+    }
+    simplex.remove_unused_forms(is_used);
+}
+
+void Linear_arithmetic::rebuild_watches()
+{
+    for (auto& list : watched)
+    {
+        list.clear();
+    }
+    for (auto& list : occur)
+    {
+        list.clear();
+    }
+    bounds.clear();
+    to_check.clear();
+    decided.clear();
+
+    for (auto cons : constraints)
+    {
+        if (cons.empty())
+        {
+            continue;
+        }
+
+        if (options.prop_bounds || options.prop_unassigned)
+        {
+            for (auto var : cons.vars())
+            {
+                occur[var].push_back(cons);
+            }
+        }
+        watch(cons);
+    }
+}
+
+void Linear_arithmetic::collect_garbage(Database& db, Trail& trail)
+{
+    assert(trail.empty());
+
+    auto num_vars = static_cast<int>(origin.size());
+    if (num_vars == 0)
+    {
+        return;
+    }
+
+    std::vector<bool> is_referenced(num_vars, false);
+    for (auto clause_list : {&db.asserted(), &db.learned()})
+    {
+        for (auto const& clause : *clause_list)
+        {
+            for (auto lit : clause)
+            {
+                is_referenced[lit.var().ord()] = true;
+            }
+        }
+    }
+
+    // find unused derived constraints
+    auto is_hole = [&](int ord) {
+        return origin[ord] == Origin::removed ||
+               (origin[ord] == Origin::derived && !is_referenced[ord]);
+    };
+
+    std::vector<int> map(num_vars);
+    std::iota(map.begin(), map.end(), 0);
+    int num_removed = 0;
+    for (int ord = 0; ord < num_vars; ++ord)
+    {
+        if (is_hole(ord))
+        {
+            num_removed += origin[ord] == Origin::derived ? 1 : 0;
+            map[ord] = -1;
+        }
+    }
+
+    // move derived constraints with the highest ordinal numbers to the lowest holes
+    int hole = 0;
+    int last = num_vars - 1;
+    for (;;)
+    {
+        while (hole < num_vars && !is_hole(hole))
+        {
+            ++hole;
+        }
+        while (last >= 0 && (is_hole(last) || origin[last] != Origin::derived))
+        {
+            --last;
+        }
+        if (hole >= last)
+        {
+            break;
+        }
+        map[last--] = hole++;
+    }
+
+    auto new_num_vars = std::ranges::max(map) + 1;
+    if (num_removed == 0 && new_num_vars == num_vars)
+    {
+        return; // nothing to collect
+    }
+
+    // renumber boolean variables in all clauses
+    for (auto clause_list : {&db.asserted(), &db.learned()})
+    {
+        for (auto& clause : *clause_list)
+        {
+            for (auto& lit : clause)
+            {
+                assert(map[lit.var().ord()] >= 0);
+                Literal new_lit{map[lit.var().ord()]};
+                lit = lit.is_negation() ? ~new_lit : new_lit;
+            }
+        }
+    }
+
+    collected += num_removed;
+    trail.remap(Variable::boolean, map, new_num_vars);
+}
+
 bool Linear_arithmetic::is_effectively_decided(Models const& models, int lra_var_ord)
 {
     if (models.owned().is_defined(lra_var_ord))
@@ -84,7 +236,94 @@ std::vector<Clause> Linear_arithmetic::propagate(Database&, Trail& trail)
     {
         propagate_unassigned(trail, models);
     }
-    return finish(trail);
+
+    auto conflicts = finish(trail);
+    if (options.simplex && !tracer_)
+    {
+        auto conflict = assert_simplex(trail, variables);
+        if (!conflict && conflicts.empty() && ++num_propagations >= simplex_frequency)
+        {
+            num_propagations = 0;
+            if (simplex.check() == Simplex::Result::infeasible)
+            {
+                conflict = simplex_conflict();
+            }
+        }
+
+        if (conflict && conflicts.empty())
+        {
+            ++simplex_conflicts;
+            conflicts.push_back(std::move(*conflict));
+        }
+    }
+    return conflicts;
+}
+
+std::optional<Clause> Linear_arithmetic::assert_simplex(Trail const& trail,
+                                                        std::vector<Variable> const& variables)
+{
+    auto const& model = trail.model<bool>(Variable::boolean);
+    for (auto var : variables)
+    {
+        if (var.type() != Variable::boolean)
+        {
+            continue;
+        }
+
+        auto cons = constraints[var.ord()];
+        bool value = model.value(var.ord());
+        if (!value && cons.pred() == Order_predicate::eq)
+        {
+            continue; // disequalities are not supported
+        }
+
+        auto& simplex_var = simplex_vars[var.ord()];
+        if (simplex_var < 0)
+        {
+            simplex_var = cons.size() == 1 && cons.coef()[0] == Rational{1}
+                              ? simplex.variable(cons.vars()[0])
+                              : simplex.linear_form(cons.vars(), cons.coef());
+        }
+
+        // `cons` is `vars * coef pred rhs` and `~cons` is `rhs pred' vars * coef`
+        Literal reason = value ? cons.lit() : ~cons.lit();
+        auto level = trail.decision_level(var).value();
+        bool is_consistent = true;
+        if (value)
+        {
+            Delta_rational bound{cons.rhs(), cons.pred() == Order_predicate::lt ? Rational{-1}
+                                                                                : Rational{0}};
+            is_consistent = simplex.assert_upper(simplex_var, bound, reason, level);
+            if (is_consistent && cons.pred() == Order_predicate::eq)
+            {
+                is_consistent = simplex.assert_lower(simplex_var, bound, reason, level);
+            }
+        }
+        else
+        {
+            Delta_rational bound{cons.rhs(), cons.pred() == Order_predicate::leq ? Rational{1}
+                                                                                 : Rational{0}};
+            is_consistent = simplex.assert_lower(simplex_var, bound, reason, level);
+        }
+
+        if (!is_consistent)
+        {
+            return simplex_conflict();
+        }
+    }
+    return {};
+}
+
+Clause Linear_arithmetic::simplex_conflict() const
+{
+    std::vector<Literal> lits;
+    for (auto lit : simplex.conflict())
+    {
+        lits.push_back(~lit);
+    }
+    std::sort(lits.begin(), lits.end());
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+    return Clause{lits.begin(), lits.end()};
 }
 
 void Linear_arithmetic::watch(Constraint& cons)
@@ -187,6 +426,7 @@ void Linear_arithmetic::replace_watch(Trail& trail, Models& models, int lra_var_
     auto& watchlist = watched[lra_var_ord];
     for (std::size_t i = 0; i < watchlist.size();)
     {
+        ++num_watch_visits;
         auto& watch = watchlist[i];
         auto& cons = watch.constraint;
 
@@ -260,11 +500,13 @@ std::optional<Clause> Linear_arithmetic::check_bounds(Trail& trail, int var_ord)
 {
     if (auto conflict = Bound_conflict_analysis{this}.analyze(trail, bounds, var_ord))
     {
+        ++num_bound_conflicts;
         return conflict;
     }
 
     if (auto conflict = Inequality_conflict_analysis{this}.analyze(trail, bounds, var_ord))
     {
+        ++num_inequality_conflicts;
         return conflict;
     }
     return {}; // no conflict
@@ -272,6 +514,7 @@ std::optional<Clause> Linear_arithmetic::check_bounds(Trail& trail, int var_ord)
 
 void Linear_arithmetic::unit(Models const& models, Constraint const& cons) 
 { 
+    ++num_bound_updates;
     bounds.update(models, cons); 
 }
 
@@ -317,6 +560,7 @@ void Linear_arithmetic::propagate_unassigned(Trail& trail, Models& models)
             {
                 if (bounds.is_implied(models, c))
                 {
+                    ++num_propagated_literals;
                     trail.propagate(c.lit().var(), nullptr, trail.decision_level());
                     models.boolean().set_value(c.lit().var().ord(), !c.lit().is_negation());
                 }
@@ -375,6 +619,7 @@ void Linear_arithmetic::propagate(Trail& trail, Models& models, Constraint const
     auto value = cons.eval(models.owned());
     models.boolean().set_value(cons.lit().var().ord(), cons.lit().is_negation() ^ value);
     trail.propagate(cons.lit().var(), /*reason=*/nullptr, dec_level);
+    ++num_propagated_literals;
 }
 
 bool Linear_arithmetic::is_new(Models const& models, Variable var) const
@@ -503,6 +748,59 @@ std::optional<Rational> Linear_arithmetic::find_integer(Models const& models, Bo
     return {};
 }
 
+std::optional<Rational> Linear_arithmetic::find_shared(Models const& models, int lra_var_ord)
+{
+    auto& bnds = bounds[lra_var_ord];
+    for (auto bound : {bnds.lower_bound(models), bnds.upper_bound(models)})
+    {
+        if (bound == nullptr)
+        {
+            continue;
+        }
+
+        for (auto other_var_ord : bound->reason().vars())
+        {
+            if (other_var_ord != lra_var_ord && models.owned().is_defined(other_var_ord) &&
+                bnds.is_allowed(models, models.owned().value(other_var_ord)))
+            {
+                return models.owned().value(other_var_ord);
+            }
+        }
+    }
+    return {};
+}
+
+std::optional<Rational> Linear_arithmetic::find_preferred(Models const& models, int lra_var_ord)
+{
+    auto& bnds = bounds[lra_var_ord];
+    if (options.best_values && best_values.is_defined(lra_var_ord) &&
+        bnds.is_allowed(models, best_values.value(lra_var_ord)))
+    {
+        return best_values.value(lra_var_ord);
+    }
+
+    if (options.simplex)
+    {
+        if (auto value = simplex.value(lra_var_ord); value && bnds.is_allowed(models, *value))
+        {
+            return value;
+        }
+    }
+
+    if (cached_values.is_defined(lra_var_ord) &&
+        bnds.is_allowed(models, cached_values.value(lra_var_ord)))
+    {
+        ++num_cached_value_hits;
+        return cached_values.value(lra_var_ord);
+    }
+
+    if (options.best_values)
+    {
+        return find_shared(models, lra_var_ord);
+    }
+    return {};
+}
+
 void Linear_arithmetic::decide(Database&, Trail& trail, Variable var)
 {
     if (var.type() != Variable::rational)
@@ -513,9 +811,12 @@ void Linear_arithmetic::decide(Database&, Trail& trail, Variable var)
     auto models = relevant_models(trail);
     auto& bnds = bounds[var.ord()];
 
-    Rational value =
-        cached_values.is_defined(var.ord()) ? cached_values.value(var.ord()) : Rational{0};
-    if (!bnds.is_allowed(models, value))
+    Rational value{0};
+    if (auto preferred = find_preferred(models, var.ord()))
+    {
+        value = std::move(preferred.value());
+    }
+    else if (!bnds.is_allowed(models, value))
     {
         if (auto int_value = find_integer(models, bnds))
         {
@@ -544,6 +845,88 @@ void Linear_arithmetic::decide(Database&, Trail& trail, Variable var)
     trail.decide(var);
 }
 
+void Linear_arithmetic::on_init(Database&, Trail&)
+{
+    // asserted clauses could have been removed since the last check
+    simplex.clear_bounds();
+}
+
+void Linear_arithmetic::on_before_backtrack(Database& db, Trail& trail, int level)
+{
+    Theory::on_before_backtrack(db, trail, level);
+
+    if (options.simplex)
+    {
+        simplex.backtrack(level);
+    }
+
+    if (options.best_values)
+    {
+        update_best(trail);
+    }
+}
+
+void Linear_arithmetic::update_best(Trail const& trail)
+{
+    auto const& model = trail.model<Rational>(Variable::rational);
+
+    // count rational variables assigned before the conflict level
+    int num_assigned = 0;
+    trail.for_each_below_top([&](Variable var) {
+        if (var.type() == Variable::rational)
+        {
+            ++num_assigned;
+        }
+    });
+
+    if (num_assigned <= best_size)
+    {
+        return;
+    }
+
+    best_size = num_assigned;
+    trail.for_each_below_top([&](Variable var) {
+        if (var.type() == Variable::rational)
+        {
+            best_values.set_value(var.ord(), model.value(var.ord()));
+        }
+    });
+}
+
+void Linear_arithmetic::on_restart(Database& db, Trail& trail)
+{
+    // derived constraints can only be renumbered if they are not on the trail
+    if (options.collect_derived && !tracer_ && trail.empty() && num_new_derived >= gc_interval)
+    {
+        num_new_derived = 0;
+        collect_garbage(db, trail);
+    }
+
+    // start tracking a new best assignment when boolean phases are reset
+    if (options.best_values && rephase_schedule != nullptr &&
+        rephase_schedule->num_rephases() != last_rephase)
+    {
+        last_rephase = rephase_schedule->num_rephases();
+        best_values.clear();
+        best_size = 0;
+    }
+}
+
+void Linear_arithmetic::collect_statistics(Statistics& stats) const
+{
+    stats.set("lra.propagated_literals", num_propagated_literals);
+    stats.set("lra.bound_updates", num_bound_updates);
+    stats.set("lra.watch_visits", num_watch_visits);
+    stats.set("lra.bound_conflicts", num_bound_conflicts);
+    stats.set("lra.inequality_conflicts", num_inequality_conflicts);
+    stats.set("lra.fm_resolutions", num_fm_resolutions);
+    stats.set("lra.cached_value_hits", num_cached_value_hits);
+    stats.set("lra.simplex_conflicts", simplex_conflicts);
+    stats.set("lra.collected_constraints", collected);
+    stats.set("lra.mpq_allocations", Rational::num_mpq_allocations());
+    stats.set("lra.mpq_objects", Rational::num_mpq_objects());
+}
+
 void Linear_arithmetic::check_bounds_consistency([[maybe_unused]] Trail const& trail,
                                                  Models const& models)
 {
@@ -4,7 +4,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <numeric>
 #include <optional>
 #include <ranges>
 #include <unordered_map>
@@ -15,12 +17,15 @@
 #include "Linear_constraints.h"
 #include "Lra_conflict_analysis.h"
 #include "Model.h"
+#include "Simplex.h"
 #include "Theory.h"
 #include "Tracer_wrapper.h"
 #include "Variable_bounds.h"
 
 namespace yaga {
 
+class Bool_theory;
+
 class Linear_arithmetic final : public Theory {
 public:
     // bounds object which keeps implied bounds of variables
@@ -52,6 +57,31 @@ public:
          * A rational variable is effectively decided if it can only be assigned one value.
          */
         bool prop_rational = false;
+
+        /** If true, rational variables are decided using their values in the longest 
+         * conflict-free trail (best values) or using values of other variables in constraints 
+         * which bound them.
+         */
+        bool best_values = false;
+
+        /** If true, constraints derived in conflict analysis which do not occur in any clause in 
+         * the database are periodically removed at restart together with their boolean variables.
+         * Boolean variables of the remaining derived constraints are renumbered so that 
+         * ordinal numbers of boolean variables stay dense.
+         *
+         * Garbage collection is disabled if proofs are produced.
+         */
+        bool collect_derived = false;
+
+        /** If true, asserted constraints are periodically checked by an incremental simplex. 
+         * Bounds are asserted to simplex when constraints are assigned and retracted on 
+         * backtracking. If the constraints are infeasible, a conflict clause is derived from the Farkas 
+         * certificate before all rational variables in the conflict are assigned. Values from 
+         * the last feasible simplex assignment are preferred in `decide()`.
+         *
+         * The check is disabled if proofs are produced.
+         */
+        bool simplex = false;
     };
 
     Linear_arithmetic(proof::Tracer_wrapper tracer = {}) : tracer_(tracer) {}
@@ -65,6 +95,15 @@ public:
      */
     void on_variable_resize(Variable::Type type, int num_vars) override;
 
+    /** Move constraints of renumbered boolean variables and rebuild all watch lists.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                           int num_vars) override;
+
     /** Add all semantic propagations to the @p trail and update variable bounds
      *
      * @param db clause database
@@ -82,6 +121,37 @@ public:
      */
     void decide(Database&, Trail&, Variable) override;
 
+    /** Remove all bounds from simplex (see `Options::simplex`).
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_init(Database&, Trail&) override;
+
+    /** Retract simplex bounds above @p level and update best values if the conflict-free part
+     * of @p trail is the longest so far.
+     *
+     * @param db clause database
+     * @param trail current solver trail before backtracking
+     * @param level decision level to backtrack to
+     */
+    void on_before_backtrack(Database&, Trail&, int) override;
+
+    /** Start tracking a new best assignment if boolean phases have been reset since the last
+     * restart (see `set_rephase_schedule()`). Remove unused derived
+     * constraints if garbage collection is due (see `Options::collect_derived`).
+     *
+     * @param db clause database
+     * @param trail current solver trail after restart
+     */
+    void on_restart(Database&, Trail&) override;
+
+    /** Copy counters of this plugin to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
+
     /** Propagate a fully assigned constraint @p cons to @p trail
      *
      * Precondition: @p cons (its boolean variable) is not on the trail
@@ -107,23 +177,38 @@ public:
     Constraint constraint(Trail& trail, Var_range&& vars, Coef_range&& coef,
                           Order_predicate pred, Rational const& rhs)
     {
-        // create the constraint
-        auto cons = constraints.make(std::forward<Var_range>(vars), std::forward<Coef_range>(coef),
-                                     pred, rhs);
+        auto cons = make_constraint(trail, std::forward<Var_range>(vars),
+                                    std::forward<Coef_range>(coef), pred, rhs);
+        origin[cons.lit().var().ord()] = Origin::external;
+        return cons;
+    }
 
-        // create a new variable in trail if the constraint represents a new variable
-        auto models = relevant_models(trail);
-        if (is_new(models, cons.lit().var()))
+    /** Create a constraint derived by the theory (e.g., in conflict analysis) or return an
+     * existing object that represents the same constraint.
+     *
+     * Unlike `constraint()`, a new constraint created by this method can be removed by garbage
+     * collection if it does not occur in any clause (see `Options::collect_derived`).
+     *
+     * @tparam Var_range range of LRA variable numbers (ints)
+     * @tparam Coef_range range of coefficients (Value_types)
+     * @param trail current solver trail
+     * @param vars range of LRA variable numbers
+     * @param coef range of coefficients of @p vars
+     * @param pred predicate of the constraint
+     * @param rhs constant on the right-hand-side of the constraint
+     * @return linear constraint
+     */
+    template <std::ranges::range Var_range, std::ranges::range Coef_range>
+    Constraint derived_constraint(Trail& trail, Var_range&& vars, Coef_range&& coef,
+                                  Order_predicate pred, Rational const& rhs)
+    {
+        auto cons = make_constraint(trail, std::forward<Var_range>(vars),
+                                    std::forward<Coef_range>(coef), pred, rhs);
+        auto& cons_origin = origin[cons.lit().var().ord()];
+        if (cons_origin == Origin::none)
         {
-            if (options.prop_bounds || options.prop_unassigned)
-            {
-                for (auto var : cons.vars())
-                {
-                    occur[var].push_back(cons.lit().is_negation() ? ~cons : cons);
-                }
-            }
-            add_variable(trail, models, cons.lit().var());
-            watch(cons, models.owned());
+            cons_origin = Origin::derived;
+            ++num_new_derived;
         }
         return cons;
     }
@@ -193,9 +278,63 @@ public:
         return result;
     }
 
+    /** Get assignment of rational variables in the longest conflict-free trail since the last
+     * rephase (only tracked if `Options::best_values` is set)
+     *
+     * @return partial assignment of rational variables
+     */
+    inline Model<Rational> const& best_model() const { return best_values; }
+
+    /** Reset best values whenever @p theory resets phases of boolean variables.
+     *
+     * @param theory boolean theory which determines when rephase happens (none to keep best
+     * values until they are replaced by a longer conflict-free assignment)
+     */
+    inline void set_rephase_schedule(Bool_theory const* theory) { rephase_schedule = theory; }
+
+    /** Set number of new derived constraints after which the next garbage collection is done.
+     *
+     * @param num_constraints number of derived constraints
+     */
+    inline void set_gc_interval(int num_constraints) { gc_interval = num_constraints; }
+
+    /** Set how often asserted constraints are checked by simplex (see `Options::simplex`)
+     *
+     * @param calls simplex is run in every @p calls -th call of `propagate()`
+     */
+    inline void set_simplex_frequency(int calls) { simplex_frequency = calls; }
+
+    /** Get number of conflicts detected by simplex
+     *
+     * @return number of conflicts detected by simplex
+     */
+    inline int num_simplex_conflicts() const { return simplex_conflicts; }
+
+    /** Get total number of derived constraints removed by garbage collection
+     *
+     * @return number of removed constraints
+     */
+    inline int num_collected() const { return collected; }
+
+    /** Count a resolution step of Fourier-Motzkin elimination in conflict analysis
+     */
+    inline void count_fm_resolution() { ++num_fm_resolutions; }
+
     proof::Tracer_wrapper& tracer() { return tracer_; }
 
 private:
+    // source of the constraint of a boolean variable
+    enum class Origin {
+        // not a linear constraint (or a constraint which is being created)
+        none,
+        // constraint created by the user of this plugin
+        external,
+        // constraint derived by this plugin
+        derived,
+        // no constraint (the constraint has been removed by garbage collection)
+        removed,
+    };
+
     struct Watched_constraint {
         // watched constraint
         Constraint constraint;
@@ -216,6 +355,14 @@ private:
     Bounds bounds;
     // cached assignment of LRA variables
     Model<Rational> cached_values;
+    // assignment of LRA variables in the longest conflict-free trail since the last rephase
+    Model<Rational> best_values;
+    // number of LRA variables assigned in `best_values` since the last rephase
+    int best_size = 0;
+    // boolean theory whose rephases reset `best_values`
+    Bool_theory const* rephase_schedule = nullptr;
+    // number of rephases of `rephase_schedule` when `best_values` were last reset
+    int last_rephase = 0;
     // list of rational variables whose bound has changed at this level
     std::vector<int> to_check;
     // map real variable -> list of constraints in which it occurs
@@ -226,6 +373,108 @@ private:
     std::vector<int> decided;
     // tracer for proof production (optional)
     proof::Tracer_wrapper tracer_;
+    // map boolean variable -> source of its constraint
+    std::vector<Origin> origin;
+    // number of derived constraints created since the last garbage collection
+    int num_new_derived = 0;
+    // number of new derived constraints which triggers garbage collection
+    int gc_interval = 2000;
+    // total number of derived constraints removed by garbage collection
+    int collected = 0;
+    // global consistency check of asserted constraints (optional)
+    Simplex simplex;
+    // map boolean variable -> tableau variable which implements its constraint or -1
+    std::vector<int> simplex_vars;
+    // simplex is run in every `simplex_frequency`-th call of `propagate()`
+    int simplex_frequency = 4;
+    // number of calls of `propagate()` since simplex was last run
+    int num_propagations = 0;
+    // number of conflicts detected by simplex
+    int simplex_conflicts = 0;
+    // total number of boolean variables of constraints propagated by this plugin
+    std::uint64_t num_propagated_literals = 0;
+    // total number of bound updates from unit constraints
+    std::uint64_t num_bound_updates = 0;
+    // total number of visited watched constraints
+    std::uint64_t num_watch_visits = 0;
+    // total number of conflicts detected by bound and inequality conflict analysis
+    std::uint64_t num_bound_conflicts = 0;
+    std::uint64_t num_inequality_conflicts = 0;
+    // total number of resolution steps of Fourier-Motzkin elimination
+    std::uint64_t num_fm_resolutions = 0;
+    // total number of decisions which reused a cached value allowed by current bounds
+    std::uint64_t num_cached_value_hits = 0;
+
+    /** Create a constraint or return an existing object that represents the same constraint.
+     *
+     * @tparam Var_range range of LRA variable numbers (ints)
+     * @tparam Coef_range range of coefficients (Value_types)
+     * @param trail current solver trail
+     * @param vars range of LRA variable numbers
+     * @param coef range of coefficients of @p vars
+     * @param pred predicate of the constraint
+     * @param rhs constant on the right-hand-side of the constraint
+     * @return linear constraint
+     */
+    template <std::ranges::range Var_range, std::ranges::range Coef_range>
+    Constraint make_constraint(Trail& trail, Var_range&& vars, Coef_range&& coef,
+                               Order_predicate pred, Rational const& rhs)
+    {
+        // create the constraint
+        auto cons = constraints.make(std::forward<Var_range>(vars), std::forward<Coef_range>(coef),
+                                     pred, rhs);
+
+        // create a new variable in trail if the constraint represents a new variable
+        auto models = relevant_models(trail);
+        if (is_new(models, cons.lit().var()))
+        {
+            if (options.prop_bounds || options.prop_unassigned)
+            {
+                for (auto var : cons.vars())
+                {
+                    occur[var].push_back(cons.lit().is_negation() ? ~cons : cons);
+                }
+            }
+            add_variable(trail, models, cons.lit().var());
+            watch(cons, models.owned());
+        }
+        return cons;
+    }
+
+    /** Remove derived constraints which do not occur in any clause in @p db and renumber
+     * boolean variables of the remaining derived constraints.
+     *
+     * Only derived constraints are moved. Ordinal numbers of removed variables which cannot be
+     * reused are kept without a constraint until the next garbage collection.
+     *
+     * Precondition: @p trail is empty
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void collect_garbage(Database& db, Trail& trail);
+
+    /** Assert bounds of constraints of boolean variables in @p variables to simplex
+     *
+     * @param trail current solver trail
+     * @param variables newly assigned variables
+     * @return conflict clause if a new bound is inconsistent with a bound of the same tableau
+     * variable. None, otherwise.
+     */
+    [[nodiscard]] std::optional<Clause> assert_simplex(Trail const& trail,
+                                                       std::vector<Variable> const& variables);
+
+    /** Create a conflict clause from the last conflict found by simplex
+     *
+     * @return conflict clause
+     */
+    [[nodiscard]] Clause simplex_conflict() const;
+
+    /** Rebuild watch lists and occurrence lists of all constraints and remove all bounds.
+     *
+     * Precondition: no rational variable is assigned
+     */
+    void rebuild_watches();
 
     /** Start watching LRA variables in @p cons
      *
@@ -351,6 +600,36 @@ private:
      */
     [[nodiscard]] std::optional<Rational> find_integer(Models const& models, Bounds_type& bounds);
 
+    /** Find a value for @p lra_var_ord preferred by value caching
+     *
+     * The best value is tried first (if enabled), then the value from simplex (if enabled), then
+     * the cached value, then values of other variables in constraints which imply the current
+     * bounds of @p lra_var_ord (if enabled).
+     *
+     * @param models partial assignment of variables in trail
+     * @param lra_var_ord unassigned rational variable
+     * @return preferred value allowed by bounds of @p lra_var_ord or none if there is no such value
+     */
+    [[nodiscard]] std::optional<Rational> find_preferred(Models const& models, int lra_var_ord);
+
+    /** Try to find a value of another variable in a constraint which bounds @p lra_var_ord
+     *
+     * For example, if `x <= y` is unit and `y = 3`, the value 3 is tried for `x`.
+     *
+     * @param models partial assignment of variables in trail
+     * @param lra_var_ord unassigned rational variable
+     * @return value of some other variable allowed by bounds of @p lra_var_ord or none if there is
+     * no such value
+     */
+    [[nodiscard]] std::optional<Rational> find_shared(Models const& models, int lra_var_ord);
+
+    /** Copy values of rational variables assigned before the conflict level to `best_values` if 
+     * there are more of them than in the current best assignment.
+     *
+     * @param trail current solver trail
+     */
+    void update_best(Trail const& trail);
+
     /** Check that bounds is consistent with all unit constraints on the trail
      *
      * @param trail solver trail
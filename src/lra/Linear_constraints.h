@@ -89,6 +89,56 @@ public:
      */
     void resize(int num_bool_vars) { constraints.resize(num_bool_vars); }
 
+    /** Remove constraints of removed boolean variables and move the rest to their new boolean
+     * variables.
+     *
+     * All constraint objects returned by this repository before this call are invalidated.
+     *
+     * @param map map old boolean variable ordinal -> new ordinal or -1 if the variable (and its
+     * constraint) is removed
+     * @param num_bool_vars new number of boolean variables
+     */
+    void compact(std::vector<int> const& map, int num_bool_vars)
+    {
+        std::vector<int> new_variables;
+        std::vector<Value> new_coefficients;
+        std::vector<Constraint> new_constraints(num_bool_vars);
+        new_variables.reserve(variables.size());
+        new_coefficients.reserve(coefficients.size());
+        for (std::size_t ord = 0; ord < map.size() && ord < constraints.size(); ++ord)
+        {
+            auto const& cons = constraints[ord];
+            if (map[ord] < 0 || cons.constraints == nullptr)
+            {
+                continue;
+            }
+
+            std::pair<int, int> range{static_cast<int>(new_variables.size()), 0};
+            new_variables.insert(new_variables.end(), variables.begin() + cons.pos().first,
+                                 variables.begin() + cons.pos().second);
+            new_coefficients.insert(new_coefficients.end(),
+                                    coefficients.begin() + cons.pos().first,
+                                    coefficients.begin() + cons.pos().second);
+            range.second = static_cast<int>(new_variables.size());
+            new_constraints[map[ord]] = Constraint{Literal{map[ord]}, range, cons.pred(),
+                                                   cons.rhs(), this};
+        }
+
+        variables = std::move(new_variables);
+        coefficients = std::move(new_coefficients);
+        constraints = std::move(new_constraints);
+
+        // rebuild the deduplication set
+        cons_set.clear();
+        for (auto const& cons : constraints)
+        {
+            if (cons.constraints != nullptr)
+            {
+                cons_set.insert(cons);
+            }
+        }
+    }
+
     /** Find boolean constraint which implements @p bool_var_ord
      *
      * @param bool_var_ord ordinal number of a boolean variable
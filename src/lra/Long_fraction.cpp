@@ -18,6 +18,7 @@ Jan Kofron (Charles University, Prague)
 namespace yaga {
 
     mpq_ptr Long_fraction::mpqPool::alloc() {
+        ++num_allocations;
         mpq_ptr r;
         if (!pool.empty()) {
             r = pool.top();
@@ -33,7 +34,7 @@ namespace yaga {
     }
 
     Long_fraction::Long_fraction(const char *s, const int base) {
-        mpq = pool.alloc();
+        mpq = pool().alloc();
         mpq_set_str(mpq, s, base);
         mpq_canonicalize(mpq);
         state = State::MPQ_ALLOCATED_AND_VALID;
@@ -49,16 +50,81 @@ namespace yaga {
             den = 1;
             state = State::WORD_VALID;
         } else {
-            mpq = pool.alloc();
+            mpq = pool().alloc();
             mpz_set(mpq_numref(mpq), z);
             mpz_set_ui(mpq_denref(mpq), 1);
             state = State::MPQ_ALLOCATED_AND_VALID;
         }
     }
 
+    namespace {
+        // Set z to the value of decimal digits in str
+        void set_digits(mpz_ptr z, std::string_view str) {
+            constexpr std::size_t chunk_size = 18;
+            mpz_set_ui(z, 0);
+            while (!str.empty()) {
+                auto chunk = str.substr(0, chunk_size);
+                str.remove_prefix(chunk.size());
+                unsigned long value = 0;
+                unsigned long scale = 1;
+                for (char c : chunk) {
+                    value = value * 10 + static_cast<unsigned long>(c - '0');
+                    scale *= 10;
+                }
+                mpz_mul_ui(z, z, scale);
+                mpz_add_ui(z, z, value);
+            }
+        }
+    }
+
+    Long_fraction Long_fraction::from_decimal(std::string_view str) {
+        auto point = str.find('.');
+        auto integral = str.substr(0, point);
+        auto fractional = point == std::string_view::npos ? std::string_view{} : str.substr(point + 1);
+        assert(std::all_of(integral.begin(), integral.end(), [](char c) { return '0' <= c && c <= '9'; }));
+        assert(std::all_of(fractional.begin(), fractional.end(), [](char c) { return '0' <= c && c <= '9'; }));
+
+        // fast path: the numerator fits in lword and the denominator fits in uword
+        if (integral.size() + fractional.size() <= 18 && fractional.size() <= 9) {
+            lword n = 0;
+            uword d = 1;
+            for (char c : integral) {
+                n = n * 10 + (c - '0');
+            }
+            for (char c : fractional) {
+                n = n * 10 + (c - '0');
+                d *= 10;
+            }
+            auto common = static_cast<lword>(gcd<ulword>(static_cast<ulword>(n), d));
+            n /= common;
+            if (n <= INT_MAX) {
+                return Long_fraction(static_cast<word>(n), static_cast<uword>(d / common));
+            }
+        }
+
+        Long_fraction result;
+        result.mpq = pool().alloc();
+        set_digits(mpq_numref(result.mpq), integral);
+        if (!fractional.empty()) {
+            mpz_ui_pow_ui(mpq_denref(result.mpq), 10, fractional.size());
+            mpz_mul(mpq_numref(result.mpq), mpq_numref(result.mpq), mpq_denref(result.mpq));
+            set_digits(mpz(), fractional);
+            mpz_add(mpq_numref(result.mpq), mpq_numref(result.mpq), mpz());
+        } else {
+            mpz_set_ui(mpq_denref(result.mpq), 1);
+        }
+        mpq_canonicalize(result.mpq);
+        result.state = State::MPQ_ALLOCATED_AND_VALID;
+        result.try_fit_word();
+        if (result.wordPartValid())
+            result.kill_mpq();
+        assert(result.isWellFormed());
+        return result;
+    }
+
     Long_fraction::Long_fraction(uint32_t x)  {
         if (x > INT_MAX) {
-            mpq = pool.alloc();
+            mpq = pool().alloc();
             mpq_set_ui(mpq, x, 1);
             state = State::MPQ_ALLOCATED_AND_VALID;
         } else {
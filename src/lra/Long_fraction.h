@@ -16,12 +16,16 @@ Jan Kofron (Charles University, Prague)
 #ifndef LONG_FRACTION_H
 #define LONG_FRACTION_H
 #include <string>
+#include <string_view>
 #include <gmpxx.h>
 #include <cassert>
 #include <climits>
 #include <stack>
 #include <vector>
 #include <cstdint>
+#include <cstdlib>
+
+#include "Hash.h"
 
 namespace yaga {
 
@@ -86,15 +90,29 @@ class Long_fraction
         std::stack<mpq_class> store; // uses deque as storage to avoid realloc
         std::stack<mpq_ptr, std::vector<mpq_ptr>> pool;
     public:
+        // number of calls of `alloc()`
+        std::uint64_t num_allocations = 0;
+
         mpq_ptr alloc();
         void release(mpq_ptr);
+        inline std::size_t size() const { return store.size(); }
     };
     State state;
     word num{0};
     uword den{1};
     mpq_ptr mpq{nullptr};
 
-    inline static mpqPool pool;
+    // pool of the current thread (pools are never destroyed since a value can outlive the thread
+    // which allocated it)
+    inline static thread_local mpqPool* local_pool = nullptr;
+    inline static mpqPool& pool()
+    {
+        if (local_pool == nullptr) [[unlikely]]
+        {
+            local_pool = new mpqPool{};
+        }
+        return *local_pool;
+    }
     inline static thread_local mpz_class temp;
     inline static mpz_ptr mpz() { return temp.get_mpz_t(); }
 
@@ -143,6 +161,16 @@ public:
 
     explicit Long_fraction(mpz_t x);
 
+    // Parse an SMT-LIB numeral or decimal, i.e., "<digits>" or "<digits>.<digits>". Small values
+    // are converted without GMP.
+    static Long_fraction from_decimal(std::string_view str);
+
+    // Number of mpq values taken from the pool of this thread so far (each value which does not
+    // fit into words takes one)
+    static std::uint64_t num_mpq_allocations() { return pool().num_allocations; }
+    // Number of mpq objects created by the pool of this thread
+    static std::uint64_t num_mpq_objects() { return pool().size(); }
+
     //
     // Destroyer
     //
@@ -161,7 +189,7 @@ private:
     constexpr void kill_mpq()
     {
         if (mpqMemoryAllocated()) {
-            pool.release(mpq);
+            pool().release(mpq);
             state = State::WORD_VALID;
         }
     }
@@ -169,7 +197,7 @@ private:
         if (!mpqPartValid()) {
             assert(wordPartValid());
             if (!mpqMemoryAllocated()) {
-                mpq = pool.alloc();
+                mpq = pool().alloc();
             }
             mpz_set_si(mpq_numref(mpq), num);
             mpz_set_ui(mpq_denref(mpq), den);
@@ -183,7 +211,7 @@ private:
     void ensure_mpq_memory_allocated()
     {
         if (!mpqMemoryAllocated()) {
-            mpq = pool.alloc();
+            mpq = pool().alloc();
             setMpqMemoryAllocated();
         }
     }
@@ -295,6 +323,25 @@ public:
         }
     }
 
+    // 64-bit hash which mixes all bits of the numerator and the denominator
+    uint64_t hash() const {
+        if (wordPartValid()) {
+            return utils::hash_mix(static_cast<uint64_t>(static_cast<int64_t>(num)) ^ 0xa0761d6478bd642full,
+                                   static_cast<uint64_t>(den) ^ 0xe7037ed1a0b428dbull);
+        }
+        else {
+            utils::Hasher hasher{static_cast<uint64_t>(mpq->_mp_num._mp_size)};
+            for (int i = 0; i < std::abs(mpq->_mp_num._mp_size); i++) {
+                hasher.add(mpq->_mp_num._mp_d[i]);
+            }
+            hasher.add(static_cast<uint64_t>(mpq->_mp_den._mp_size));
+            for (int i = 0; i < mpq->_mp_den._mp_size; i++) {
+                hasher.add(mpq->_mp_den._mp_d[i]);
+            }
+            return hasher.value();
+        }
+    }
+
     bool isInteger() const {
         if (wordPartValid())
             return den == 1;
@@ -449,7 +496,7 @@ inline Long_fraction::Long_fraction(const Long_fraction& x) {
     }
     else {
         assert(x.mpqPartValid());
-        mpq = pool.alloc();
+        mpq = pool().alloc();
         mpq_set(mpq, x.mpq);
         state = State::MPQ_ALLOCATED_AND_VALID;
     }
@@ -471,7 +518,7 @@ inline Long_fraction& Long_fraction::operator=(const Long_fraction& x) {
     else {
         assert(x.mpqPartValid());
         if (!this->mpqMemoryAllocated()) {
-            mpq = pool.alloc();
+            mpq = pool().alloc();
         }
         mpq_set(mpq, x.mpq);
         this->state = State::MPQ_ALLOCATED_AND_VALID;
@@ -494,7 +541,7 @@ inline Long_fraction Long_fraction::operator-() const {
     } else {
         force_ensure_mpq_valid();
         Long_fraction x;
-        x.mpq = pool.alloc();
+        x.mpq = pool().alloc();
         mpq_neg(x.mpq, mpq);
         x.state = State::MPQ_ALLOCATED_AND_VALID;
         x.try_fit_word(); // MB: If current value is 2^31, it does not fit word representation, but it's negation -2^31 does.
@@ -650,7 +697,8 @@ inline Long_fraction::Long_fraction(word n, uword d) : state{State::WORD_VALID}
     } else {
         uword common = gcd<uword>(absVal(n), d);
         if (common > 1) {
-            num = n / common;
+            // divide as signed numbers (`n / common` would convert `n` to unsigned)
+            num = static_cast<word>(static_cast<lword>(n) / static_cast<lword>(common));
             den = d / common;
         } else {
             num = n;
@@ -1101,7 +1149,7 @@ Long_fraction get_multiplicand(const std::vector<Long_fraction>& reals);
 template<> struct std::hash<yaga::Long_fraction> {
         inline std::size_t operator()(const yaga::Long_fraction& frac) const
         {
-            return std::hash<std::uint64_t>{}(frac.getHashValue());
+            return frac.hash();
         }
     };
 
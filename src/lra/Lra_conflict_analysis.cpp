@@ -41,16 +41,24 @@ void Fm_elimination::init(Constraint const& cons, Order_predicate p, Rational mu
         poly.variables.emplace_back(*var_it, *coef_it * mult);
     }
     poly.constant = -cons.rhs() * mult;
+
+    premise_list.clear();
+    if (lra->tracer())
+    {
+        premise_list.emplace_back(cons.lit(), mult);
+    }
 }
 
 void Fm_elimination::init(Fm_elimination&& other)
 {
     pred = other.pred;
     poly = std::move(other.poly);
+    premise_list = std::move(other.premise_list);
 }
 
 void Fm_elimination::resolve(Fm_elimination const& other, int var_ord)
 {
+    lra->count_fm_resolution();
     assert(!poly.empty());
     assert(!other.derived().variables.empty());
 
@@ -76,6 +84,10 @@ void Fm_elimination::resolve(Fm_elimination const& other, int var_ord)
             coef = -coef;
         }
         poly.constant = -poly.constant;
+        for (auto& [_, premise_mult] : premise_list)
+        {
+            premise_mult = -premise_mult;
+        }
     }
 
     // eliminate `var_ord`
@@ -85,6 +97,10 @@ void Fm_elimination::resolve(Fm_elimination const& other, int var_ord)
     }
     poly.constant = poly.constant + other.derived().constant * other_mult;
     poly.normalize();
+    for (auto const& [lit, premise_mult] : other.premises())
+    {
+        premise_list.emplace_back(lit, premise_mult * other_mult);
+    }
 
     assert(std::find_if(poly.begin(), poly.end(), [&](auto var) { return var.first == var_ord; }) ==
            poly.end());
@@ -123,8 +139,8 @@ Fm_elimination::Constraint Fm_elimination::finish(Trail& trail)
         return trail.decision_level(lhs_var).value() > trail.decision_level(rhs_var).value();
     });
 
-    auto cons = lra->constraint(trail, std::views::keys(poly.variables),
-                                std::views::values(poly.variables), pred, -poly.constant);
+    auto cons = lra->derived_constraint(trail, std::views::keys(poly.variables),
+                                        std::views::values(poly.variables), pred, -poly.constant);
     auto models = lra->relevant_models(trail);
     if (!models.boolean().is_defined(cons.lit().var().ord()))
     {
@@ -133,6 +149,43 @@ Fm_elimination::Constraint Fm_elimination::finish(Trail& trail)
     return cons;
 }
 
+std::vector<Rational> Fm_elimination::farkas_coefficients(Clause const& conflict,
+                                                          Constraint const& derived) const
+{
+    std::vector<Rational> coefficients(conflict.size());
+    auto coefficient = [&](Literal lit) -> Rational& {
+        auto it = std::find(conflict.begin(), conflict.end(), lit);
+        assert(it != conflict.end());
+        return coefficients[it - conflict.begin()];
+    };
+
+    for (auto const& [lit, mult] : premise_list)
+    {
+        auto is_equality = lra->constraint(lit.var().ord()).pred() == Order_predicate::eq;
+        coefficient(~lit) += is_equality || mult > 0 ? mult : -mult;
+    }
+
+    if (!derived.empty())
+    {
+        // `derived` is normalized as `scale * poly pred 0`
+        auto var = *derived.vars().begin();
+        auto poly_it = std::find_if(poly.begin(), poly.end(),
+                                    [var](auto const& pair) { return pair.first == var; });
+        assert(poly_it != poly.end());
+        Rational scale = *derived.coef().begin() / poly_it->second;
+        if (derived.pred() == Order_predicate::eq)
+        {
+            // `poly - derived / scale` is 0 so the lemma is split on the strict sides
+            coefficient(derived.lit()) -= Rational{1} / scale;
+        }
+        else
+        {
+            coefficient(derived.lit()) += Rational{1} / (scale > 0 ? scale : -scale);
+        }
+    }
+    return coefficients;
+}
+
 Fm_elimination Lra_conflict_analysis::eliminate(Models const& models, Bounds& bounds,
                                                 Implied_value<Rational> const& bound)
 {
@@ -193,8 +246,12 @@ std::optional<Clause> Bound_conflict_analysis::analyze(Trail& trail, Bounds& bou
 
     assert(conflict.size() >= 2);
     assert(eval(models.boolean(), conflict) == false);
-    // TODO: add proof
-    lra->tracer().init_conflict(conflict, proof::conflict::Lra_bounds{});
+    proof::conflict::Lra_bounds explanation;
+    if (lra->tracer())
+    {
+        explanation.coefficients = fm.farkas_coefficients(conflict, derived);
+    }
+    lra->tracer().init_conflict(conflict, std::move(explanation));
     return conflict;
 }
 
@@ -228,6 +285,8 @@ std::optional<Clause> Inequality_conflict_analysis::analyze(Trail& trail, Bounds
     Lra_conflict_analysis analysis{lra};
     analysis.conflict().push_back(~neq->reason().lit());
 
+    // derivations from the lower and the upper bound (only kept if proofs are produced)
+    std::vector<std::pair<Fm_elimination, Constraint>> derivations;
     auto mult = neq->reason().coef().front() > 0 ? 1 : -1;
     for (auto bound_ptr : {lb, ub})
     {
@@ -241,12 +300,23 @@ std::optional<Clause> Inequality_conflict_analysis::analyze(Trail& trail, Bounds
             analysis.conflict().push_back(derived.lit());
         }
         mult = -mult;
+        if (lra->tracer())
+        {
+            derivations.emplace_back(std::move(fm), derived);
+        }
     }
 
     assert(eval(models.boolean(), analysis.conflict()) == false);
     auto& conflict = analysis.finish();
-    // TODO: add proof
-    lra->tracer().init_conflict(conflict, proof::conflict::Lra_disequality{});
+    proof::conflict::Lra_disequality explanation;
+    if (lra->tracer())
+    {
+        auto const& [lower_fm, lower_derived] = derivations.front();
+        auto const& [upper_fm, upper_derived] = derivations.back();
+        explanation.coefficients = lower_fm.farkas_coefficients(conflict, lower_derived);
+        explanation.upper_coefficients = upper_fm.farkas_coefficients(conflict, upper_derived);
+    }
+    lra->tracer().init_conflict(conflict, std::move(explanation));
     return conflict;
 }
 
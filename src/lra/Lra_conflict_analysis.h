@@ -125,6 +125,7 @@ public:
     using Constraint = Linear_constraint<Rational>;
     using Polynomial = detail::Linear_polynomial<Rational>;
     using Variable_coefficient = std::pair<int, Rational>;
+    using Premise = std::pair<Literal, Rational>;
 
     inline explicit Fm_elimination(Linear_arithmetic* lra) : lra(lra) {}
 
@@ -185,6 +186,27 @@ public:
      */
     inline Order_predicate predicate() const { return pred; }
 
+    /** Get constraints used in the derivation (only tracked if proofs are produced)
+     *
+     * The derived polynomial is a sum of polynomials `lhs - rhs` of the constraints of premise
+     * literals multiplied by the premise multipliers.
+     *
+     * @return pairs of literal and multiplier
+     */
+    inline std::vector<Premise> const& premises() const { return premise_list; }
+
+    /** Compute Farkas coefficients of this derivation.
+     *
+     * Coefficients multiply polynomials `lhs - rhs` of constraints of literals in @p conflict.
+     * Inequalities are multiplied by non-negative numbers in the direction of the literal.
+     *
+     * @param conflict conflict clause which contains negations of all premises and @p derived
+     * @param derived constraint created by `finish()`
+     * @return Farkas coefficients aligned with literals of @p conflict
+     */
+    std::vector<Rational> farkas_coefficients(Clause const& conflict,
+                                              Constraint const& derived) const;
+
     /** Find predicate of the constraint after FM elimination
      *
      * @param first predicate of one constraint
@@ -198,6 +220,8 @@ private:
     Polynomial poly;
     // predicate of the currently derived constraint
     Order_predicate pred = Order_predicate::eq;
+    // constraints used to derive `poly` with their multipliers (empty if proofs are not produced)
+    std::vector<Premise> premise_list;
     // LRA plugin
     Linear_arithmetic* lra;
 
@@ -0,0 +1,398 @@
+#include "Simplex.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace yaga {
+
+int Simplex::add_variable()
+{
+    if (!free_vars.empty())
+    {
+        int var = free_vars.back();
+        free_vars.pop_back();
+        return var;
+    }
+
+    int var = static_cast<int>(values.size());
+    values.emplace_back();
+    lower.emplace_back();
+    upper.emplace_back();
+    row_of.push_back(-1);
+    return var;
+}
+
+int Simplex::variable(int lra_var_ord)
+{
+    if (lra_vars.size() <= static_cast<std::size_t>(lra_var_ord))
+    {
+        lra_vars.resize(lra_var_ord + 1, -1);
+    }
+
+    if (lra_vars[lra_var_ord] < 0)
+    {
+        auto var = add_variable();
+        lra_vars[lra_var_ord] = var;
+    }
+    return lra_vars[lra_var_ord];
+}
+
+int Simplex::add_row(Form const& form)
+{
+    // express the form using nonbasic variables
+    Row row;
+    Delta_rational value;
+    for (auto const& [lra_var_ord, coef] : form)
+    {
+        auto var = variable(lra_var_ord);
+        value += values[var] * coef;
+        if (row_of[var] < 0)
+        {
+            row.coef[var] += coef;
+        }
+        else
+        {
+            for (auto const& [other, other_coef] : rows[row_of[var]].coef)
+            {
+                row.coef[other] += coef * other_coef;
+            }
+        }
+    }
+    std::erase_if(row.coef, [](auto const& entry) { return entry.second == Rational{0}; });
+
+    auto slack = add_variable();
+    values[slack] = value;
+    row.basic = slack;
+    row_of[slack] = static_cast<int>(rows.size());
+    rows.push_back(std::move(row));
+    return slack;
+}
+
+void Simplex::remove_row(int slack)
+{
+    if (row_of[slack] < 0)
+    {
+        // make `slack` basic without changing the assignment
+        auto it = std::find_if(rows.begin(), rows.end(),
+                               [&](auto const& row) { return row.coef.contains(slack); });
+        assert(it != rows.end());
+        pivot_and_update(it->basic, slack, values[it->basic]);
+    }
+
+    auto index = row_of[slack];
+    if (index + 1 < static_cast<int>(rows.size()))
+    {
+        rows[index] = std::move(rows.back());
+        row_of[rows[index].basic] = index;
+    }
+    rows.pop_back();
+
+    row_of[slack] = -1;
+    values[slack] = Delta_rational{};
+    free_vars.push_back(slack);
+}
+
+void Simplex::remove_unused_forms(std::vector<bool> const& is_used)
+{
+    for (auto it = forms.begin(); it != forms.end();)
+    {
+        auto var = it->second;
+        if (var < static_cast<int>(is_used.size()) && is_used[var])
+        {
+            ++it;
+            continue;
+        }
+
+        assert(!lower[var] && !upper[var]);
+        remove_row(var);
+        it = forms.erase(it);
+    }
+}
+
+void Simplex::clear_bounds()
+{
+    std::fill(lower.begin(), lower.end(), std::nullopt);
+    std::fill(upper.begin(), upper.end(), std::nullopt);
+    changes.clear();
+}
+
+void Simplex::set_bound(int var, bool is_lower, Bound bound, int level)
+{
+    auto& current = is_lower ? lower[var] : upper[var];
+    auto max_level = changes.empty() ? level : std::max(level, changes.back().max_level);
+    changes.push_back(Change{var, is_lower, level, max_level, std::move(current)});
+    current = std::move(bound);
+}
+
+void Simplex::backtrack(int level)
+{
+    // variable, kind, level, and value of bounds at `level` or lower which have been asserted
+    // after some bound at a higher level
+    std::vector<std::tuple<int, bool, int, Bound>> kept;
+    while (!changes.empty() && changes.back().max_level > level)
+    {
+        auto change = std::move(changes.back());
+        changes.pop_back();
+
+        auto& current = change.is_lower ? lower[change.var] : upper[change.var];
+        if (change.level <= level)
+        {
+            kept.emplace_back(change.var, change.is_lower, change.level, *current);
+        }
+        current = std::move(change.previous);
+    }
+
+    for (auto it = kept.rbegin(); it != kept.rend(); ++it)
+    {
+        auto const& [var, is_lower, bound_level, bound] = *it;
+        [[maybe_unused]] bool is_consistent =
+            is_lower ? assert_lower(var, bound.value, bound.reason, bound_level)
+                     : assert_upper(var, bound.value, bound.reason, bound_level);
+        assert(is_consistent);
+    }
+}
+
+bool Simplex::assert_lower(int var, Delta_rational const& value, Literal reason, int level)
+{
+    if (lower[var] && value <= lower[var]->value)
+    {
+        return true;
+    }
+
+    if (upper[var] && value > upper[var]->value)
+    {
+        explanation = {reason, upper[var]->reason};
+        return false;
+    }
+
+    set_bound(var, /*is_lower=*/true, Bound{value, reason}, level);
+    if (row_of[var] < 0 && values[var] < value)
+    {
+        update(var, value);
+    }
+    return true;
+}
+
+bool Simplex::assert_upper(int var, Delta_rational const& value, Literal reason, int level)
+{
+    if (upper[var] && value >= upper[var]->value)
+    {
+        return true;
+    }
+
+    if (lower[var] && value < lower[var]->value)
+    {
+        explanation = {reason, lower[var]->reason};
+        return false;
+    }
+
+    set_bound(var, /*is_lower=*/false, Bound{value, reason}, level);
+    if (row_of[var] < 0 && values[var] > value)
+    {
+        update(var, value);
+    }
+    return true;
+}
+
+void Simplex::update(int var, Delta_rational const& value)
+{
+    assert(row_of[var] < 0);
+
+    auto diff = value - values[var];
+    for (auto& row : rows)
+    {
+        if (auto it = row.coef.find(var); it != row.coef.end())
+        {
+            values[row.basic] += diff * it->second;
+        }
+    }
+    values[var] = value;
+}
+
+void Simplex::pivot_and_update(int basic, int nonbasic, Delta_rational const& value)
+{
+    auto row_index = row_of[basic];
+    auto& row = rows[row_index];
+    auto pivot_coef = row.coef.at(nonbasic);
+
+    // update the assignment
+    auto theta = (value - values[basic]) / pivot_coef;
+    values[basic] = value;
+    values[nonbasic] += theta;
+    for (auto const& other : rows)
+    {
+        if (other.basic == basic)
+        {
+            continue;
+        }
+
+        if (auto it = other.coef.find(nonbasic); it != other.coef.end())
+        {
+            values[other.basic] += theta * it->second;
+        }
+    }
+
+    // express `nonbasic` using the other variables in the row
+    row.coef.erase(nonbasic);
+    for (auto& [_, coef] : row.coef)
+    {
+        coef = -coef / pivot_coef;
+    }
+    row.coef[basic] = Rational{1} / pivot_coef;
+    row.basic = nonbasic;
+    row_of[nonbasic] = row_index;
+    row_of[basic] = -1;
+
+    // substitute `nonbasic` in all other rows
+    for (auto& other : rows)
+    {
+        if (other.basic == nonbasic)
+        {
+            continue;
+        }
+
+        auto it = other.coef.find(nonbasic);
+        if (it == other.coef.end())
+        {
+            continue;
+        }
+
+        auto mult = it->second;
+        other.coef.erase(it);
+        for (auto const& [var, coef] : rows[row_index].coef)
+        {
+            auto& other_coef = other.coef[var];
+            other_coef += mult * coef;
+            if (other_coef == Rational{0})
+            {
+                other.coef.erase(var);
+            }
+        }
+    }
+    ++pivots;
+}
+
+void Simplex::explain(int row_index, bool is_lower)
+{
+    auto const& row = rows[row_index];
+    explanation.clear();
+    explanation.push_back(is_lower ? lower[row.basic]->reason : upper[row.basic]->reason);
+    for (auto const& [var, coef] : row.coef)
+    {
+        // bound which prevents `var` from moving the basic variable toward its bound
+        auto const& bound = (coef > Rational{0}) == is_lower ? upper[var] : lower[var];
+        assert(bound);
+        explanation.push_back(bound->reason);
+    }
+}
+
+Simplex::Result Simplex::check()
+{
+    for (int num_pivots = 0;; ++num_pivots)
+    {
+        // find the basic variable with the lowest index which violates its bounds (Bland's rule)
+        int basic = -1;
+        bool is_lower = false;
+        for (int var = 0; var < static_cast<int>(values.size()); ++var)
+        {
+            if (row_of[var] < 0)
+            {
+                continue;
+            }
+
+            if (lower[var] && values[var] < lower[var]->value)
+            {
+                basic = var;
+                is_lower = true;
+                break;
+            }
+            if (upper[var] && values[var] > upper[var]->value)
+            {
+                basic = var;
+                is_lower = false;
+                break;
+            }
+        }
+
+        if (basic < 0)
+        {
+            store_model();
+            return Result::feasible;
+        }
+
+        if (num_pivots >= pivot_limit)
+        {
+            return Result::unknown;
+        }
+
+        // find nonbasic variable with the lowest index which can fix the basic variable
+        int nonbasic = -1;
+        for (auto const& [var, coef] : rows[row_of[basic]].coef)
+        {
+            bool increase = (coef > Rational{0}) == is_lower;
+            if ((increase && (!upper[var] || values[var] < upper[var]->value)) ||
+                (!increase && (!lower[var] || values[var] > lower[var]->value)))
+            {
+                nonbasic = var;
+                break;
+            }
+        }
+
+        if (nonbasic < 0)
+        {
+            explain(row_of[basic], is_lower);
+            return Result::infeasible;
+        }
+
+        pivot_and_update(basic, nonbasic, is_lower ? lower[basic]->value : upper[basic]->value);
+    }
+}
+
+void Simplex::store_model()
+{
+    // find delta which satisfies all strict bounds
+    Rational delta{1};
+    for (std::size_t var = 0; var < values.size(); ++var)
+    {
+        auto const& value = values[var];
+        if (lower[var])
+        {
+            auto const& bound = lower[var]->value;
+            if (bound.constant() < value.constant() && bound.delta() > value.delta())
+            {
+                delta = std::min(delta, (value.constant() - bound.constant()) /
+                                            (bound.delta() - value.delta()));
+            }
+        }
+
+        if (upper[var])
+        {
+            auto const& bound = upper[var]->value;
+            if (value.constant() < bound.constant() && value.delta() > bound.delta())
+            {
+                delta = std::min(delta, (bound.constant() - value.constant()) /
+                                            (value.delta() - bound.delta()));
+            }
+        }
+    }
+
+    model.assign(lra_vars.size(), std::nullopt);
+    for (std::size_t lra_var_ord = 0; lra_var_ord < lra_vars.size(); ++lra_var_ord)
+    {
+        if (lra_vars[lra_var_ord] >= 0)
+        {
+            model[lra_var_ord] = values[lra_vars[lra_var_ord]].concretize(delta);
+        }
+    }
+}
+
+std::optional<Rational> Simplex::value(int lra_var_ord) const
+{
+    if (lra_var_ord < 0 || lra_var_ord >= static_cast<int>(model.size()))
+    {
+        return {};
+    }
+    return model[lra_var_ord];
+}
+
+} // namespace yaga
@@ -0,0 +1,358 @@
+#ifndef YAGA_SIMPLEX_H
+#define YAGA_SIMPLEX_H
+
+#include <cassert>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "Literal.h"
+#include "Rational.h"
+
+namespace yaga {
+
+/** Rational value of the form `c + k * delta` where `delta` is a positive infinitesimal.
+ *
+ * It is used to represent strict bounds (e.g., `x < 5` is represented as `x <= 5 - delta`).
+ */
+class Delta_rational {
+public:
+    inline Delta_rational() : c(0), k(0) {}
+    inline explicit Delta_rational(Rational c, Rational k = Rational{0})
+        : c(std::move(c)), k(std::move(k))
+    {
+    }
+
+    /** Get the standard part of this value
+     *
+     * @return constant `c`
+     */
+    inline Rational const& constant() const { return c; }
+
+    /** Get the coefficient of the infinitesimal
+     *
+     * @return coefficient `k`
+     */
+    inline Rational const& delta() const { return k; }
+
+    inline Delta_rational operator+(Delta_rational const& other) const
+    {
+        return Delta_rational{c + other.c, k + other.k};
+    }
+
+    inline Delta_rational operator-(Delta_rational const& other) const
+    {
+        return Delta_rational{c - other.c, k - other.k};
+    }
+
+    inline Delta_rational operator*(Rational const& mult) const
+    {
+        return Delta_rational{c * mult, k * mult};
+    }
+
+    inline Delta_rational operator/(Rational const& div) const
+    {
+        return Delta_rational{c / div, k / div};
+    }
+
+    inline Delta_rational& operator+=(Delta_rational const& other)
+    {
+        c += other.c;
+        k += other.k;
+        return *this;
+    }
+
+    inline bool operator==(Delta_rational const& other) const
+    {
+        return c == other.c && k == other.k;
+    }
+
+    inline bool operator<(Delta_rational const& other) const
+    {
+        return c < other.c || (c == other.c && k < other.k);
+    }
+
+    inline bool operator<=(Delta_rational const& other) const { return !(other < *this); }
+    inline bool operator>(Delta_rational const& other) const { return other < *this; }
+    inline bool operator>=(Delta_rational const& other) const { return !(*this < other); }
+
+    /** Substitute a concrete value for `delta`
+     *
+     * @param delta_value value of the infinitesimal
+     * @return `c + k * delta_value`
+     */
+    inline Rational concretize(Rational const& delta_value) const { return c + k * delta_value; }
+
+private:
+    Rational c;
+    Rational k;
+};
+
+/** Bound-based simplex procedure [1] which checks whether a set of bounds of linear forms is
+ * feasible.
+ *
+ * Variables of the tableau are rational variables of the LRA plugin and slack variables which
+ * represent linear forms (see `linear_form()`). Each bound is annotated with a literal which
+ * implies it. If the bounds are infeasible, `check()` finds a subset of the literals which is
+ * infeasible (derived from a Farkas certificate).
+ *
+ * The tableau and the assignment are kept between checks, so a check only has to fix bounds
+ * which have changed. Bounds are annotated with the decision level at which they have been
+ * asserted so that they can be retracted by `backtrack()`. Pivoting follows Bland's rule so the
+ * procedure terminates.
+ *
+ * [1] Bruno Dutertre and Leonardo de Moura. A fast linear-arithmetic solver for DPLL(T). CAV 2006.
+ */
+class Simplex {
+public:
+    enum class Result {
+        // all bounds are satisfied by the current assignment
+        feasible,
+        // bounds are infeasible (see `conflict()`)
+        infeasible,
+        // the limit on the number of pivots has been reached
+        unknown,
+    };
+
+    /** Get tableau variable which represents a rational variable of the LRA plugin.
+     *
+     * @param lra_var_ord ordinal number of a rational variable
+     * @return tableau variable of @p lra_var_ord
+     */
+    int variable(int lra_var_ord);
+
+    /** Get tableau variable which represents a linear form `sum of coef[i] * vars[i]`
+     *
+     * A new slack variable is created if the linear form is new.
+     *
+     * @tparam Var_range range of rational variables (ints)
+     * @tparam Coef_range range of coefficients (Rationals)
+     * @param vars rational variables in the linear form
+     * @param coef coefficients of @p vars
+     * @return tableau variable which is equal to the linear form
+     */
+    template <std::ranges::range Var_range, std::ranges::range Coef_range>
+    int linear_form(Var_range&& vars, Coef_range&& coef)
+    {
+        Form key;
+        auto coef_it = std::begin(coef);
+        for (auto var : vars)
+        {
+            key.emplace_back(var, *coef_it++);
+        }
+
+        auto [it, is_new] = forms.try_emplace(std::move(key), 0);
+        if (is_new)
+        {
+            it->second = add_row(it->first);
+        }
+        return it->second;
+    }
+
+    /** Remove rows of linear forms whose slack variables are not used anymore.
+     *
+     * Slack variables which are nonbasic are pivoted into the basis first. Tableau variables of
+     * the removed rows are reused by new linear forms.
+     *
+     * Precondition: slack variables of the removed forms have no bounds
+     *
+     * @param is_used map tableau variable -> true iff it is still used (variables outside of the
+     * range are not used)
+     */
+    void remove_unused_forms(std::vector<bool> const& is_used);
+
+    /** Remove bounds of all tableau variables.
+     *
+     * The tableau and the assignment are kept.
+     */
+    void clear_bounds();
+
+    /** Add a lower bound for a tableau variable.
+     *
+     * If the bound is weaker than the current lower bound, it is ignored.
+     *
+     * @param var tableau variable
+     * @param value new lower bound
+     * @param reason literal which implies the bound
+     * @param level decision level of @p reason
+     * @return false iff the new bound is inconsistent with the upper bound of @p var (the
+     * conflict is stored in `conflict()`)
+     */
+    bool assert_lower(int var, Delta_rational const& value, Literal reason, int level = 0);
+
+    /** Add an upper bound for a tableau variable.
+     *
+     * If the bound is weaker than the current upper bound, it is ignored.
+     *
+     * @param var tableau variable
+     * @param value new upper bound
+     * @param reason literal which implies the bound
+     * @param level decision level of @p reason
+     * @return false iff the new bound is inconsistent with the lower bound of @p var (the
+     * conflict is stored in `conflict()`)
+     */
+    bool assert_upper(int var, Delta_rational const& value, Literal reason, int level = 0);
+
+    /** Retract bounds asserted at a decision level higher than @p level
+     *
+     * Bounds are restored in reverse order in which they have been asserted. Bounds asserted at
+     * @p level or lower which are restored as well are asserted again. The assignment is kept
+     * since it satisfies the weaker bounds of nonbasic variables.
+     *
+     * @param level decision level to backtrack to
+     */
+    void backtrack(int level);
+
+    /** Find an assignment which satisfies all bounds.
+     *
+     * @return result of the check
+     */
+    Result check();
+
+    /** Get literals of bounds which are infeasible after `check()` or `assert_*()` fails.
+     *
+     * @return list of literals which cannot be true at the same time
+     */
+    inline std::vector<Literal> const& conflict() const { return explanation; }
+
+    /** Get value of a rational variable in the last feasible assignment
+     *
+     * @param lra_var_ord ordinal number of a rational variable
+     * @return value of @p lra_var_ord or none if it is not in the tableau or no feasible
+     * assignment has been found yet
+     */
+    std::optional<Rational> value(int lra_var_ord) const;
+
+    /** Set maximal number of pivots in one `check()`
+     *
+     * @param pivots maximal number of pivots
+     */
+    inline void set_pivot_limit(int pivots) { pivot_limit = pivots; }
+
+    /** Get total number of pivots
+     *
+     * @return number of pivots performed so far
+     */
+    inline int num_pivots() const { return pivots; }
+
+private:
+    // linear form - list of variables with coefficients
+    using Form = std::vector<std::pair<int, Rational>>;
+
+    struct Bound {
+        // value of the bound
+        Delta_rational value;
+        // literal which implies the bound
+        Literal reason;
+    };
+
+    // change of a bound which can be undone by `backtrack()`
+    struct Change {
+        // tableau variable whose bound has changed
+        int var;
+        // true iff the lower bound has changed
+        bool is_lower;
+        // decision level of the new bound
+        int level;
+        // the highest level of this change and all changes before it
+        int max_level;
+        // bound before the change
+        std::optional<Bound> previous;
+    };
+
+    struct Row {
+        // basic variable of this row
+        int basic;
+        // map nonbasic variable -> coefficient (basic = sum of coef * nonbasic)
+        std::map<int, Rational> coef;
+    };
+
+    // map linear form -> its slack variable
+    std::map<Form, int> forms;
+    // map rational variable of the LRA plugin -> tableau variable or -1
+    std::vector<int> lra_vars;
+    // map tableau variable -> its value in the current assignment
+    std::vector<Delta_rational> values;
+    // map tableau variable -> its lower bound
+    std::vector<std::optional<Bound>> lower;
+    // map tableau variable -> its upper bound
+    std::vector<std::optional<Bound>> upper;
+    // map tableau variable -> index of its row or -1 if it is nonbasic
+    std::vector<int> row_of;
+    // tableau
+    std::vector<Row> rows;
+    // changes of bounds in the order in which they have been made
+    std::vector<Change> changes;
+    // tableau variables of removed linear forms which can be reused
+    std::vector<int> free_vars;
+    // literals of the last conflict
+    std::vector<Literal> explanation;
+    // values of rational variables in the last feasible assignment
+    std::vector<std::optional<Rational>> model;
+    // maximal number of pivots in one check
+    int pivot_limit = 1000;
+    // total number of pivots
+    int pivots = 0;
+
+    /** Create a new nonbasic variable with value 0
+     *
+     * @return the new tableau variable
+     */
+    int add_variable();
+
+    /** Change a bound of @p var and remember the previous bound
+     *
+     * @param var tableau variable
+     * @param is_lower true iff the lower bound of @p var is changed
+     * @param bound new bound
+     * @param level decision level of @p bound
+     */
+    void set_bound(int var, bool is_lower, Bound bound, int level);
+
+    /** Remove the row of slack variable @p slack from the tableau
+     *
+     * @param slack slack variable of a linear form
+     */
+    void remove_row(int slack);
+
+    /** Create a new basic slack variable for @p form
+     *
+     * @param form linear form over rational variables
+     * @return the new slack variable
+     */
+    int add_row(Form const& form);
+
+    /** Change value of a nonbasic variable and update values of basic variables
+     *
+     * @param var nonbasic variable
+     * @param value new value of @p var
+     */
+    void update(int var, Delta_rational const& value);
+
+    /** Make @p basic nonbasic, make @p nonbasic basic, and set value of @p basic to @p value
+     *
+     * @param basic basic variable which violates its bound
+     * @param nonbasic nonbasic variable in the row of @p basic
+     * @param value new value of @p basic
+     */
+    void pivot_and_update(int basic, int nonbasic, Delta_rational const& value);
+
+    /** Store literals of a row whose basic variable cannot be moved to its bound
+     *
+     * @param row index of a row
+     * @param is_lower true iff the basic variable of @p row is below its lower bound
+     */
+    void explain(int row, bool is_lower);
+
+    /** Compute values of rational variables in the current assignment with a concrete
+     * value of delta which satisfies all bounds.
+     */
+    void store_model();
+};
+
+} // namespace yaga
+
+#endif // YAGA_SIMPLEX_H
@@ -1,5 +1,10 @@
 #include "Flex_lexer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
 namespace yaga::parser {
 
 void Flex_lexer::parseError(std::string_view msg) { throw std::logic_error(std::string(msg)); }
@@ -36,6 +41,40 @@ char const* Flex_lexer::token_string()
     return YYText();
 }
 
+std::string_view Flex_lexer::token_view() const
+{
+    return {YYText(), static_cast<std::size_t>(YYLeng())};
+}
+
+symbol_t Flex_lexer::token_symbol()
+{
+    auto name = token_view();
+    if (name.size() >= 2 && name.front() == '|' && name.back() == '|')
+    {
+        name = name.substr(1, name.size() - 2);
+    }
+    return symbol_table.intern(name);
+}
+
+void Flex_lexer::set_input(std::string_view data)
+{
+    memory_input = data;
+    has_memory_input = true;
+}
+
+int Flex_lexer::LexerInput(char* buf, int max_size)
+{
+    if (!has_memory_input)
+    {
+        return yyFlexLexer::LexerInput(buf, max_size);
+    }
+
+    auto size = std::min(memory_input.size(), static_cast<std::size_t>(max_size));
+    std::memcpy(buf, memory_input.data(), size);
+    memory_input.remove_prefix(size);
+    return static_cast<int>(size);
+}
+
 
 void Flex_lexer::unexpected_token_error(Token)
 {
@@ -6,8 +6,10 @@
 #include <FlexLexer.h>
 #endif
 
+#include "Symbol_table.h"
 #include "smt2_tokens.h"
 
+#include <cstddef>
 #include <string_view>
 
 namespace yaga::parser {
@@ -17,7 +19,23 @@ class Flex_lexer : public yyFlexLexer {
 protected:
     virtual Token lex_scan() = 0;
 
+    /**
+     * Copies the next part of the input to the flex buffer. Reads from the in-memory input if it
+     * has been set by `set_input()`, otherwise from the input stream.
+     * @param buf flex buffer
+     * @param max_size maximal number of characters to copy
+     * @return number of copied characters (0 at the end of input)
+     */
+    int LexerInput(char* buf, int max_size) override;
+
 public:
+    /**
+     * Read input from memory instead of an input stream. This has to be called before the first
+     * token is read.
+     * @param data whole input which has to outlive the lexer
+     */
+    void set_input(std::string_view data);
+
     void unexpected_token_error(Token token);
 
     void parseError(std::string_view msg);
@@ -47,6 +65,30 @@ public:
      */
     char const* token_string();
 
+    /**
+     * Gets a view of the last consumed token which is valid until the next token is consumed
+     */
+    std::string_view token_view() const;
+
+    /**
+     * Interns the last consumed symbol token. Quotes of a quoted symbol are not part of the name.
+     * @return id of the symbol in `symbols()`
+     */
+    symbol_t token_symbol();
+
+    /**
+     * Gets the table of symbols interned by this lexer
+     */
+    inline Symbol_table& symbols() { return symbol_table; }
+
+private:
+    // interned symbols
+    Symbol_table symbol_table;
+    // in-memory input (if set)
+    std::string_view memory_input;
+    // true iff `memory_input` is used instead of the input stream
+    bool has_memory_input = false;
+
 };
 
 } // namespace yaga::parser
@@ -0,0 +1,61 @@
+#include "Input_buffer.h"
+
+#include <fstream>
+#include <iterator>
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<fcntl.h>) &&   \
+    __has_include(<unistd.h>)
+#define YAGA_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace yaga::parser {
+
+Input_buffer::Input_buffer(std::string const& path)
+{
+#ifdef YAGA_HAVE_MMAP
+    if (auto fd = open(path.c_str(), O_RDONLY); fd >= 0)
+    {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            auto size = static_cast<std::size_t>(info.st_size);
+            auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                madvise(data, size, MADV_SEQUENTIAL);
+                mapped = data;
+                mapped_size = size;
+                view = {static_cast<char const*>(data), size};
+            }
+        }
+        close(fd);
+        if (mapped != nullptr)
+        {
+            return;
+        }
+    }
+#endif
+
+    std::ifstream file;
+    file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    file.open(path, std::ios::binary);
+    file.exceptions(std::ifstream::badbit);
+    contents.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    view = contents;
+}
+
+Input_buffer::~Input_buffer()
+{
+#ifdef YAGA_HAVE_MMAP
+    if (mapped != nullptr)
+    {
+        munmap(mapped, mapped_size);
+    }
+#endif
+}
+
+} // namespace yaga::parser
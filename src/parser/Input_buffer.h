@@ -0,0 +1,48 @@
+#ifndef YAGA_INPUT_BUFFER_H
+#define YAGA_INPUT_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace yaga::parser {
+
+/** Read-only contents of an input file.
+ *
+ * Regular files are memory mapped if the platform supports it. Other files (e.g., pipes) are read
+ * to memory.
+ */
+class Input_buffer {
+public:
+    /** Map or read a file
+     *
+     * @param path path to the file
+     * @throws std::ifstream::failure if the file cannot be opened
+     */
+    explicit Input_buffer(std::string const& path);
+
+    ~Input_buffer();
+
+    Input_buffer(Input_buffer const&) = delete;
+    Input_buffer& operator=(Input_buffer const&) = delete;
+
+    /** Get contents of the file
+     *
+     * @return view of the whole file which is valid for the lifetime of this object
+     */
+    inline std::string_view data() const { return view; }
+
+private:
+    // memory mapped file or nullptr if the file is not mapped
+    void* mapped = nullptr;
+    // size of the mapped memory
+    std::size_t mapped_size = 0;
+    // contents of the file if it is not mapped
+    std::string contents;
+    // view of the mapped memory or `contents`
+    std::string_view view;
+};
+
+} // namespace yaga::parser
+
+#endif // YAGA_INPUT_BUFFER_H
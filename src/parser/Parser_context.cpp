@@ -1,14 +1,22 @@
 #include "Parser_context.h"
 
+#include <unordered_map>
+
 #include "Solver_wrapper.h"
 #include "Term_manager.h"
 #include "Terms.h"
-#include "Term_rewriter.h"
 
 #define UNIMPLEMENTED throw std::logic_error("Not implemented yet!")
 
 namespace yaga::parser {
 
+Parser_context::Parser_context(Symbol_table& symbols, terms::Term_manager& term_manager,
+                               Options const& options)
+    : symbols(symbols), true_symbol(symbols.intern("true")), false_symbol(symbols.intern("false")),
+      term_manager(term_manager), substitute(term_manager), solver(term_manager, options)
+{
+}
+
 void Parser_context::add_let_bindings(let_bindings_t&& bindings)
 {
     let_records.push_frame();
@@ -20,13 +28,13 @@ void Parser_context::add_let_bindings(let_bindings_t&& bindings)
 
 void Parser_context::pop_let_bindings() { let_records.pop_frame(); }
 
-term_t Parser_context::get_term_for_symbol(std::string const& symbol)
+term_t Parser_context::get_term_for_symbol(symbol_t symbol)
 {
-    if (symbol == "true")
+    if (symbol == true_symbol)
     {
         return terms::true_term;
     }
-    if (symbol == "false")
+    if (symbol == false_symbol)
     {
         return terms::false_term;
     }
@@ -37,21 +45,26 @@ term_t Parser_context::get_term_for_symbol(std::string const& symbol)
     }
     if (defined_functions.has(symbol))
     {
-        auto defined = defined_functions.get(symbol);
+        auto const& defined = defined_functions.get(symbol);
         assert(defined.signature.args.empty());
         return defined.body;
     }
-    auto t = term_manager.get_term_by_name(symbol);
+    if (symbol < constants.size() && constants[symbol] != terms::null_term)
+    {
+        return constants[symbol];
+    }
+    auto t = term_manager.get_term_by_name(symbols.name(symbol));
     assert(t.has_value());
     return t.value();
 }
 
-type_t Parser_context::get_type_for_symbol(std::string const& symbol)
+type_t Parser_context::get_type_for_symbol(symbol_t symbol)
 {
-    if (symbol == "Bool") {
+    auto name = symbols.name(symbol);
+    if (name == "Bool") {
         return terms::types::bool_type;
     }
-    if (symbol == "Real") {
+    if (name == "Real") {
         return terms::types::real_type;
     }
     throw std::logic_error("Requested unknown type");
@@ -75,39 +88,44 @@ void Parser_context::model(Default_model_visitor& visitor)
     solver.model(visitor);
 }
 
-term_t Parser_context::declare_uninterpreted_constant(terms::type_t sort, std::string const& name)
+term_t Parser_context::declare_uninterpreted_constant(terms::type_t sort, symbol_t name)
 {
     term_t term = term_manager.mk_uninterpreted_constant(sort);
-    term_manager.set_term_name(term, name);
+    term_manager.set_term_name(term, symbols.name(name));
+    if (name >= constants.size())
+    {
+        constants.resize(name + 1, terms::null_term);
+    }
+    constants[name] = term;
     return term;
 }
 
-void Parser_context::declare_uninterpreted_function(terms::type_t ret_type, std::vector<terms::type_t> && arg_sorts, std::string const& name)
+void Parser_context::declare_uninterpreted_function(terms::type_t ret_type, std::vector<terms::type_t> && arg_sorts, symbol_t name)
 {
     term_t fnc_term = term_manager.mk_uninterpreted_constant(ret_type);
-    term_manager.set_term_name(fnc_term, name);
+    term_manager.set_term_name(fnc_term, symbols.name(name));
 
-    declared_functions.insert(name, Function_declaration(name, std::move(arg_sorts), ret_type));
+    declared_functions.insert(name, Function_declaration(fnc_term, std::move(arg_sorts), ret_type));
 }
 
-term_t Parser_context::mk_numeral(std::string const& numeric_string)
+term_t Parser_context::mk_numeral(std::string_view numeric_string)
 {
     return term_manager.mk_integer_constant(numeric_string);
 }
 
-term_t Parser_context::mk_decimal(std::string const& decimal_string)
+term_t Parser_context::mk_decimal(std::string_view decimal_string)
 {
     return term_manager.mk_rational_constant(decimal_string);
 }
 
-term_t Parser_context::resolve_term(std::string const& name, std::vector<term_t>&& args)
+term_t Parser_context::resolve_term(symbol_t name, std::vector<term_t>&& args)
 {
     if (defined_functions.has(name))
     {
         return resolve_defined_function(name, args);
     } else if (declared_functions.has(name))
     {
-        auto declared_function = declared_functions.get(name);
+        auto const& declared_function = declared_functions.get(name);
         auto expected_count = declared_function.arg_types.size();
         assert(expected_count == args.size()); (void) expected_count;
 
@@ -117,9 +135,10 @@ term_t Parser_context::resolve_term(std::string const& name, std::vector<term_t>
             assert(expected_type == term_manager.get_type(args[i])); (void) expected_type;
         }
 
-        return term_manager.mk_app(name, declared_function.return_type, args);
+        args.insert(args.begin(), declared_function.function_symbol);
+        return term_manager.mk_app(args);
     }
-    return term_manager.mk_term(name, args, true);
+    return term_manager.mk_term(symbols.name(name), args, true);
 }
 
 std::vector<term_t> Parser_context::bind_vars(std::span<Sorted_var> sorted_vars)
@@ -134,10 +153,10 @@ std::vector<term_t> Parser_context::bind_vars(std::span<Sorted_var> sorted_vars)
     }
     return ret;
 }
-void Parser_context::store_defined_fun(std::string const& name, term_t definition,
+void Parser_context::store_defined_fun(symbol_t name, term_t definition,
                                        std::vector<term_t> && formal_args, type_t return_sort)
 {
-    defined_functions.insert(name, Function_template(name, std::move(formal_args), return_sort, definition));
+    defined_functions.insert(name, Function_template(std::string{symbols.name(name)}, std::move(formal_args), return_sort, definition));
 }
 
 void Parser_context::push_binding_scope()
@@ -150,15 +169,15 @@ void Parser_context::pop_binding_scope()
     let_records.pop_frame();
 }
 
-term_t resolve(Function_template const& function_template, std::span<term_t> args, terms::Term_manager& term_manager);
+term_t resolve(Function_template const& function_template, std::span<term_t> args, terms::Variable_substitution& substitute);
 
-term_t Parser_context::resolve_defined_function(std::string const& name, std::span<term_t> args)
+term_t Parser_context::resolve_defined_function(symbol_t name, std::span<term_t> args)
 {
     auto const& function_template = defined_functions.get(name);
-    return resolve(function_template, args, term_manager);
+    return resolve(function_template, args, substitute);
 }
 
-term_t resolve(Function_template const& function_template, std::span<term_t> args, terms::Term_manager& term_manager)
+term_t resolve(Function_template const& function_template, std::span<term_t> args, terms::Variable_substitution& substitute)
 {
     using subst_map_t = std::unordered_map<term_t, term_t>;
     auto size = function_template.signature.args.size();
@@ -168,7 +187,7 @@ term_t resolve(Function_template const& function_template, std::span<term_t> arg
     {
         subst_map.insert({function_template.signature.args[i], args[i]});
     }
-    return terms::simultaneous_variable_substitution(term_manager, subst_map, function_template.body);
+    return substitute(subst_map, function_template.body);
 }
 
 } // namespace yaga::parser
\ No newline at end of file
@@ -5,13 +5,15 @@
 #include <optional>
 #include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "Options.h"
 #include "Solver_answer.h"
 #include "Solver_wrapper.h"
+#include "Symbol_table.h"
+#include "Term_rewriter.h"
 
 namespace yaga::terms {
 class Term_manager;
@@ -21,72 +23,81 @@ namespace yaga::parser {
 
 using term_t = terms::term_t;
 using type_t = terms::type_t;
-using let_bindings_t = std::vector<std::pair<std::string, term_t>>;
+using let_bindings_t = std::vector<std::pair<symbol_t, term_t>>;
 
 struct Sorted_var
 {
-    std::string var_name;
+    symbol_t var_name;
     type_t type;
 };
 
-class Let_binder {
-    term_t current_value;
-    std::vector<term_t> shadowed_values;
+/** Map symbol id -> value stored in a vector indexed by the id.
+ *
+ * @tparam T type of values
+ */
+template <typename T> class Symbol_map {
+    std::vector<std::optional<T>> values;
+
 public:
-    Let_binder(term_t t) : current_value(t) {}
-    Let_binder(Let_binder const&) = delete;
-    Let_binder& operator=(Let_binder const&) = delete;
-    Let_binder(Let_binder&&) = default;
-    Let_binder& operator=(Let_binder&&) = default;
-    term_t get_value() const { return current_value; }
-    bool has_shadow_value() const { return !shadowed_values.empty(); }
-    void restore_shadowed_value() { current_value = shadowed_values.back(); shadowed_values.pop_back(); }
-    void add_value(term_t val) {
-        shadowed_values.push_back(current_value);
-        current_value = val;
+    bool has(symbol_t symbol) const { return symbol < values.size() && values[symbol].has_value(); }
+
+    void insert(symbol_t symbol, T&& value)
+    {
+        assert(not has(symbol));
+        if (symbol >= values.size())
+        {
+            values.resize(symbol + 1);
+        }
+        values[symbol].emplace(std::move(value));
+    }
+
+    T const& get(symbol_t symbol) const
+    {
+        assert(has(symbol));
+        return *values[symbol];
     }
 };
 
+/** Terms bound to symbols by `let` binders and by formal parameters of defined functions.
+ *
+ * Current values are stored in a vector indexed by symbol id. Shadowed values are restored from
+ * an undo log when a frame is popped.
+ */
 class Let_records {
-    std::unordered_map<std::string, Let_binder> let_binders;
-    std::vector<std::string> known_binders;
+    // map symbol id -> bound term or `null_term` if the symbol is not bound
+    std::vector<term_t> values;
+    // bound symbols and their previous values in the order in which they were bound
+    std::vector<std::pair<symbol_t, term_t>> undo_log;
+    // sizes of `undo_log` when frames were pushed
     std::vector<std::size_t> frame_limits;
 
-    bool has(std::string const & name) const { return let_binders.find(name) != let_binders.end(); }
 public:
-    std::optional<term_t> get(std::string const& let_symbol) const {
-        auto it = let_binders.find(let_symbol);
-        if (it != let_binders.end()) {
-            return it->second.get_value();
+    std::optional<term_t> get(symbol_t let_symbol) const {
+        if (let_symbol < values.size() && values[let_symbol] != terms::null_term) {
+            return values[let_symbol];
         }
         return {};
     }
-    void push_frame() { frame_limits.push_back(known_binders.size()); }
+
+    void push_frame() { frame_limits.push_back(undo_log.size()); }
 
     void pop_frame()
     {
         auto limit = frame_limits.back();
         frame_limits.pop_back();
-        while (known_binders.size() > limit) {
-            std::string binder = std::move(known_binders.back());
-            known_binders.pop_back();
-            assert(this->has(binder));
-            auto& values = let_binders.at(binder);
-            if (values.has_shadow_value()) {
-                values.restore_shadowed_value();
-            } else {
-                let_binders.erase(binder);
-            }
+        while (undo_log.size() > limit) {
+            auto [symbol, previous] = undo_log.back();
+            undo_log.pop_back();
+            values[symbol] = previous;
         }
     }
 
-    void add_binding(std::string const& name, term_t term) {
-        if (not this->has(name)) {
-            let_binders.insert({name, Let_binder(term)});
-        } else {
-            let_binders.at(name).add_value(term);
+    void add_binding(symbol_t name, term_t term) {
+        if (name >= values.size()) {
+            values.resize(name + 1, terms::null_term);
         }
-        known_binders.push_back(name);
+        undo_log.emplace_back(name, values[name]);
+        values[name] = term;
     }
 };
 
@@ -105,70 +116,37 @@ struct Function_template {
 };
 
 struct Function_declaration {
-    std::string name;
+    // uninterpreted constant which represents the function symbol
+    term_t function_symbol;
     std::vector<type_t> arg_types;
     type_t return_type;
 
-    Function_declaration(std::string name, std::vector<type_t> arg_types, type_t ret_type)
-    : name(std::move(name)), arg_types(std::move(arg_types)), return_type(ret_type) {}
-};
-
-class Defined_functions {
-    std::unordered_map<std::string, Function_template> defined_functions;
-
-public:
-    bool has(std::string const & name) const
-    {
-        return defined_functions.find(name) != defined_functions.end();
-    }
-
-    void insert(std::string const & name, Function_template && templ)
-    {
-        assert(not has(name));
-        defined_functions.insert({name, std::move(templ)});
-    }
-
-    Function_template const& get(std::string const& name) const
-    {
-        return defined_functions.at(name);
-    }
+    Function_declaration(term_t function_symbol, std::vector<type_t> arg_types, type_t ret_type)
+    : function_symbol(function_symbol), arg_types(std::move(arg_types)), return_type(ret_type) {}
 };
 
-class Declared_functions {
-    std::unordered_map<std::string, Function_declaration> declared_functions;
-
-public:
-    bool has(std::string const & name) const
-    {
-        return declared_functions.find(name) != declared_functions.end();
-    }
-
-    void insert(std::string const & name, Function_declaration && decl)
-    {
-        assert(not has(name));
-        declared_functions.insert({name, std::move(decl)});
-    }
-
-    Function_declaration const& get(std::string const& name) const
-    {
-        return declared_functions.at(name);
-    }
-};
+using Defined_functions = Symbol_map<Function_template>;
+using Declared_functions = Symbol_map<Function_declaration>;
 
 class Parser_context {
 public:
-    Parser_context(terms::Term_manager& term_manager, Options const& options) 
-        : term_manager(term_manager), solver(term_manager, options) {}
+    /** Create a new context
+     *
+     * @param symbols table of symbols interned by the lexer
+     * @param term_manager term manager used to create terms
+     * @param options solver options
+     */
+    Parser_context(Symbol_table& symbols, terms::Term_manager& term_manager, Options const& options);
 
     void add_let_bindings(let_bindings_t&& bindings);
 
     void pop_let_bindings();
 
-    term_t resolve_term(std::string const& name, std::vector<term_t>&& args);
+    term_t resolve_term(symbol_t name, std::vector<term_t>&& args);
 
-    term_t get_term_for_symbol(std::string const& symbol);
+    term_t get_term_for_symbol(symbol_t symbol);
 
-    type_t get_type_for_symbol(std::string const& symbol);
+    type_t get_type_for_symbol(symbol_t symbol);
 
     Solver_answer check_sat(std::vector<term_t> const& assertions);
 
@@ -178,11 +156,11 @@ public:
 
     void model(Default_model_visitor& visitor);
 
-    term_t declare_uninterpreted_constant(terms::type_t sort, std::string const& name);
-    void declare_uninterpreted_function(terms::type_t ret_type, std::vector<terms::type_t> && arg_sorts, std::string const& name);
+    term_t declare_uninterpreted_constant(terms::type_t sort, symbol_t name);
+    void declare_uninterpreted_function(terms::type_t ret_type, std::vector<terms::type_t> && arg_sorts, symbol_t name);
 
-    term_t mk_numeral(std::string const& numeric_string);
-    term_t mk_decimal(std::string const& decimal_string);
+    term_t mk_numeral(std::string_view numeric_string);
+    term_t mk_decimal(std::string_view decimal_string);
 
     /*
      * Bindings
@@ -192,20 +170,29 @@ public:
 
     std::vector<term_t> bind_vars(std::span<Sorted_var> sorted_vars);
 
-    void store_defined_fun(std::string const& name, term_t definition, std::vector<term_t> && formal_args, type_t ret_sort);
+    void store_defined_fun(symbol_t name, term_t definition, std::vector<term_t> && formal_args, type_t ret_sort);
 
 
 private:
+    Symbol_table& symbols;
+    // ids of symbols with a special meaning
+    symbol_t true_symbol;
+    symbol_t false_symbol;
+
     Let_records let_records;
+    // map symbol id -> declared uninterpreted constant or `null_term`
+    std::vector<term_t> constants;
 
     Defined_functions defined_functions;
     Declared_functions declared_functions;
 
     terms::Term_manager& term_manager;
+    // substitution of arguments for formal parameters of defined functions
+    terms::Variable_substitution substitute;
 
     Solver_wrapper solver;
 
-    term_t resolve_defined_function(std::string const& name, std::span<term_t> args);
+    term_t resolve_defined_function(symbol_t name, std::span<term_t> args);
 };
 
 }
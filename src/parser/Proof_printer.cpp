@@ -0,0 +1,290 @@
+#include "Proof_printer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <span>
+#include <string_view>
+
+namespace yaga::parser
+{
+
+using term_t = terms::term_t;
+
+Proof_printer::Proof_printer(terms::Term_manager const& term_manager,
+                             std::unordered_map<term_t, Literal> const& bool_vars,
+                             std::unordered_map<term_t, int> const& rational_vars, Yaga& solver)
+    : term_manager(term_manager), bool_vars(bool_vars), rational_vars(rational_vars),
+      solver(solver)
+{
+}
+
+proof::Atom Proof_printer::atom(int bool_var_ord)
+{
+    proof::Atom result;
+
+    auto lra = solver.linear_arithmetic();
+    if (lra != nullptr)
+    {
+        auto cons = lra->constraint(bool_var_ord);
+        if (!cons.empty())
+        {
+            switch (cons.pred())
+            {
+            case Order_predicate::leq:
+                result.kind = proof::Atom::leq;
+                break;
+            case Order_predicate::lt:
+                result.kind = proof::Atom::lt;
+                break;
+            case Order_predicate::eq:
+                result.kind = proof::Atom::eq;
+                break;
+            }
+
+            // the LRA plugin reorders variables of constraints as it moves watches so they are
+            // sorted to print the same atom every time
+            std::vector<std::size_t> order(cons.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+                return cons.vars()[lhs] < cons.vars()[rhs];
+            });
+
+            auto multiple_vars = cons.size() > 1;
+            if (multiple_vars)
+            {
+                result.lhs += "(+";
+            }
+            for (auto i : order)
+            {
+                if (multiple_vars)
+                {
+                    result.lhs += ' ';
+                }
+                if (cons.coef()[i] == 1)
+                {
+                    print_variable(cons.vars()[i], result.lhs);
+                }
+                else
+                {
+                    result.lhs += "(* ";
+                    print_rational(cons.coef()[i], result.lhs);
+                    result.lhs += ' ';
+                    print_variable(cons.vars()[i], result.lhs);
+                    result.lhs += ')';
+                }
+            }
+            if (multiple_vars)
+            {
+                result.lhs += ')';
+            }
+            print_rational(cons.rhs(), result.rhs);
+            return result;
+        }
+    }
+
+    update_terms();
+    auto t = static_cast<std::size_t>(bool_var_ord) < bool_terms.size() ? bool_terms[bool_var_ord]
+                                                                         : terms::null_term;
+    if (t == terms::null_term)
+    {
+        // variable which does not represent any term
+        result.lhs = "@b" + std::to_string(bool_var_ord);
+    }
+    else if (term_manager.get_kind(t) == terms::Kind::OR_TERM)
+    {
+        result.kind = proof::Atom::disjunction;
+        for (term_t arg : term_manager.get_args(t))
+        {
+            auto lit = bool_vars.at(term_manager.positive_term(arg));
+            result.args.push_back(term_manager.is_negated(arg) ? ~lit : lit);
+        }
+    }
+    else
+    {
+        print_term(t, result.lhs);
+    }
+    return result;
+}
+
+std::string Proof_printer::term(term_t t)
+{
+    std::string result;
+    print_term(t, result);
+    return result;
+}
+
+void Proof_printer::update_terms()
+{
+    if (num_bool_terms != bool_vars.size())
+    {
+        num_bool_terms = bool_vars.size();
+        bool_terms.clear();
+        for (auto const& [t, lit] : bool_vars)
+        {
+            auto ord = static_cast<std::size_t>(lit.var().ord());
+            if (ord >= bool_terms.size())
+            {
+                bool_terms.resize(std::max(ord + 1, bool_vars.size()), terms::null_term);
+            }
+            bool_terms[ord] = t;
+        }
+    }
+
+    if (num_rational_terms != rational_vars.size())
+    {
+        num_rational_terms = rational_vars.size();
+        rational_terms.clear();
+        for (auto const& [t, ord] : rational_vars)
+        {
+            auto index = static_cast<std::size_t>(ord);
+            if (index >= rational_terms.size())
+            {
+                rational_terms.resize(std::max(index + 1, rational_vars.size()), terms::null_term);
+            }
+            rational_terms[index] = t;
+        }
+    }
+}
+
+void Proof_printer::print_variable(int var_ord, std::string& out)
+{
+    update_terms();
+    auto index = static_cast<std::size_t>(var_ord);
+    if (index < rational_terms.size() && rational_terms[index] != terms::null_term)
+    {
+        print_term(rational_terms[index], out);
+    }
+    else
+    {
+        out += "@r" + std::to_string(var_ord);
+    }
+}
+
+void Proof_printer::print_term(term_t t, std::string& out)
+{
+    if (term_manager.is_negated(t))
+    {
+        out += "(not ";
+        print_term(term_manager.positive_term(t), out);
+        out += ')';
+        return;
+    }
+
+    auto print_application = [&](std::string_view op, std::span<term_t const> args) {
+        out += '(';
+        out += op;
+        for (term_t arg : args)
+        {
+            out += ' ';
+            print_term(arg, out);
+        }
+        out += ')';
+    };
+
+    switch (term_manager.get_kind(t))
+    {
+    case terms::Kind::CONSTANT_TERM:
+        out += t == terms::true_term ? "true" : "false";
+        break;
+    case terms::Kind::ARITH_CONSTANT:
+        print_rational(term_manager.arithmetic_constant_value(t), out);
+        break;
+    case terms::Kind::UNINTERPRETED_TERM:
+        if (auto name = term_manager.get_term_name(t))
+        {
+            print_symbol(name.value(), out);
+        }
+        else
+        {
+            out += "@t" + std::to_string(term_manager.index_of(t));
+        }
+        break;
+    case terms::Kind::ARITH_PRODUCT:
+        out += "(* ";
+        print_rational(term_manager.coeff_of_product(t), out);
+        out += ' ';
+        print_term(term_manager.var_of_product(t), out);
+        out += ')';
+        break;
+    case terms::Kind::ARITH_POLY:
+        print_application("+", term_manager.get_args(t));
+        break;
+    case terms::Kind::APP_TERM: {
+        std::string symbol;
+        print_term(term_manager.get_fnc_symbol(t), symbol);
+        print_application(symbol, term_manager.get_args(t));
+        break;
+    }
+    case terms::Kind::ITE_TERM:
+        print_application("ite", term_manager.get_args(t));
+        break;
+    case terms::Kind::OR_TERM:
+        print_application("or", term_manager.get_args(t));
+        break;
+    case terms::Kind::ARITH_GE_ATOM:
+        out += "(>= ";
+        print_term(term_manager.get_args(t)[0], out);
+        out += " 0)";
+        break;
+    case terms::Kind::ARITH_EQ_ATOM:
+        out += "(= ";
+        print_term(term_manager.get_args(t)[0], out);
+        out += " 0)";
+        break;
+    case terms::Kind::ARITH_BINEQ_ATOM:
+        print_application("=", term_manager.get_args(t));
+        break;
+    default:
+        out += "@t" + std::to_string(term_manager.index_of(t));
+        break;
+    }
+}
+
+void Proof_printer::print_symbol(std::string_view name, std::string& out)
+{
+    auto is_simple_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) ||
+               std::string_view{"~!@$%^&*_-+=<>.?/"}.find(c) != std::string_view::npos;
+    };
+    auto is_simple = !name.empty() && !std::isdigit(static_cast<unsigned char>(name.front())) &&
+                     std::ranges::all_of(name, is_simple_char);
+    if (is_simple)
+    {
+        out += name;
+    }
+    else
+    {
+        out += '|';
+        out += name;
+        out += '|';
+    }
+}
+
+void Proof_printer::print_rational(Rational const& value, std::string& out)
+{
+    auto is_negative = value < 0;
+    auto abs = is_negative ? -value : value;
+    if (is_negative)
+    {
+        out += "(- ";
+    }
+    if (abs.denominator() == 1)
+    {
+        out += abs.get_str();
+    }
+    else
+    {
+        out += "(/ ";
+        out += abs.numerator().get_str();
+        out += ' ';
+        out += abs.denominator().get_str();
+        out += ')';
+    }
+    if (is_negative)
+    {
+        out += ')';
+    }
+}
+
+} // namespace yaga::parser
@@ -0,0 +1,90 @@
+#ifndef YAGA_PROOF_PRINTER_H
+#define YAGA_PROOF_PRINTER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Literal.h"
+#include "Rational.h"
+#include "Term_manager.h"
+#include "Term_printer.h"
+#include "Term_types.h"
+#include "Yaga.h"
+
+namespace yaga::parser
+{
+
+/** Prints atoms of solver variables as SMT-LIB terms for proofs.
+ *
+ * Arithmetic atoms are printed in the normalized form of the LRA plugin (e.g., `(<= x 1)`), so
+ * they only refer to the terms which are represented by rational variables. Other boolean
+ * variables are printed as the terms they represent.
+ */
+class Proof_printer final : public proof::Term_printer
+{
+public:
+    /** Create a printer for internalized terms
+     *
+     * @param term_manager term manager which owns the terms
+     * @param bool_vars map positive term -> literal which represents it
+     * @param rational_vars map term -> rational variable which represents it
+     * @param solver solver which owns the variables
+     */
+    Proof_printer(terms::Term_manager const& term_manager,
+                  std::unordered_map<terms::term_t, Literal> const& bool_vars,
+                  std::unordered_map<terms::term_t, int> const& rational_vars, Yaga& solver);
+
+    proof::Atom atom(int bool_var_ord) override;
+
+    std::string term(terms::term_t t) override;
+
+private:
+    terms::Term_manager const& term_manager;
+    std::unordered_map<terms::term_t, Literal> const& bool_vars;
+    std::unordered_map<terms::term_t, int> const& rational_vars;
+    Yaga& solver;
+    // boolean variable -> term it represents (`null_term` if there is none)
+    std::vector<terms::term_t> bool_terms;
+    // rational variable -> term it represents (`null_term` if there is none)
+    std::vector<terms::term_t> rational_terms;
+    // sizes of `bool_vars` and `rational_vars` when the maps above were built
+    std::size_t num_bool_terms = 0;
+    std::size_t num_rational_terms = 0;
+
+    /** Rebuild the maps from variables to terms if new variables have been internalized
+     */
+    void update_terms();
+
+    /** Print a rational variable as the term it represents
+     *
+     * @param var_ord ordinal number of a rational variable
+     * @param out output string
+     */
+    void print_variable(int var_ord, std::string& out);
+
+    /** Print a term in SMT-LIB syntax
+     *
+     * @param t term to print
+     * @param out output string
+     */
+    void print_term(terms::term_t t, std::string& out);
+
+    /** Print a symbol (quoted if necessary)
+     *
+     * @param name name of the symbol
+     * @param out output string
+     */
+    void print_symbol(std::string_view name, std::string& out);
+
+    /** Print a rational constant in SMT-LIB syntax
+     *
+     * @param value constant to print
+     * @param out output string
+     */
+    void print_rational(Rational const& value, std::string& out);
+};
+
+} // namespace yaga::parser
+
+#endif // YAGA_PROOF_PRINTER_H
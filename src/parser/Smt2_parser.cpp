@@ -1,9 +1,10 @@
 #include "Smt2_parser.h"
 
 #include <stdexcept>
-#include <fstream>
+#include <string_view>
 #include <vector>
 
+#include "Input_buffer.h"
 #include "Smt2_term_parser.h"
 #include "Term_manager.h"
 #include "Term_types.h"
@@ -152,7 +153,6 @@ public:
 };
 
 class Smt2_command_context {
-    std::istream& input;
     std::ostream& output;
     smt2_lexer lexer;
 
@@ -169,18 +169,35 @@ class Smt2_command_context {
     void print_answer(Solver_answer answer);
 
 public:
-    Smt2_command_context(std::istream& input, std::ostream& output, terms::Term_manager& term_manager, Options const& opts)
-        : input(input), output(output), term_parser(lexer, parser_context), parser_context(term_manager, opts), term_manager(term_manager)
+    Smt2_command_context(std::ostream& output, terms::Term_manager& term_manager, Options const& opts)
+        : output(output), term_parser(lexer, parser_context), parser_context(lexer.symbols(), term_manager, opts), term_manager(term_manager)
     {}
-    void execute();
+
+    /** Execute all commands from an input stream
+     *
+     * @param input input stream
+     */
+    void execute(std::istream& input);
+
+    /** Execute all commands from memory
+     *
+     * @param input whole input
+     */
+    void execute(std::string_view input);
 };
 
-void Smt2_command_context::execute()
+void Smt2_command_context::execute(std::istream& input)
 {
     lexer.yyrestart(input);
     while(parse_command()) { /* empty */ }
 }
 
+void Smt2_command_context::execute(std::string_view input)
+{
+    lexer.set_input(input);
+    while(parse_command()) { /* empty */ }
+}
+
 bool Smt2_command_context::parse_command()
 {
     if (lexer.eat_token_choice(Token::EOF_TOK, Token::LPAREN_TOK))
@@ -217,7 +234,7 @@ bool Smt2_command_context::parse_command()
     // (declare-const <symbol> <sort>)
     case Token::DECLARE_CONST_TOK:
     {
-        std::string name = term_parser.parse_symbol();
+        auto name = term_parser.parse_symbol();
         terms::type_t t = term_parser.parse_sort();
         parser_context.declare_uninterpreted_constant(t, name);
     }
@@ -226,7 +243,7 @@ bool Smt2_command_context::parse_command()
     // (declare-fun <symbol> (<sort>∗) <sort>)
     case Token::DECLARE_FUN_TOK:
     {
-        std::string name = term_parser.parse_symbol();
+        auto name = term_parser.parse_symbol();
         std::vector<terms::type_t> sorts;
 
         lexer.eat_token(Token::LPAREN_TOK);
@@ -379,7 +396,7 @@ bool Smt2_command_context::parse_command()
     // (set-logic <symbol>)
     case Token::SET_LOGIC_TOK:
     {
-        std::string name = term_parser.parse_symbol();
+        auto name = lexer.symbols().name(term_parser.parse_symbol());
         if (name == "QF_UFLRA") {
             parser_context.set_logic(logic::qf_uflra);
         } else if (name == "QF_LRA") {
@@ -438,18 +455,17 @@ void Smt2_command_context::print_answer(Solver_answer answer)
 
 void Smt2_parser::parse_file(std::string const& file_name)
 {
-    std::ifstream file_stream;
-    file_stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    file_stream.open(file_name);
-
-    parse(file_stream, std::cout);
+    Input_buffer buffer{file_name};
+    terms::Term_manager tm;
+    Smt2_command_context ctx(std::cout, tm, options);
+    ctx.execute(buffer.data());
 }
 
 void Smt2_parser::parse(std::istream& input, std::ostream& output)
 {
     terms::Term_manager tm;
-    Smt2_command_context ctx(input, output, tm, options);
-    ctx.execute();
+    Smt2_command_context ctx(output, tm, options);
+    ctx.execute(input);
 }
 
 } // namespace yaga::parser
\ No newline at end of file
@@ -51,7 +51,7 @@ enum class ParseCtx
 term_t Smt2_term_parser::parse_term() {
     using arg_list_t = std::vector<term_t>;
     std::vector<std::tuple<ParseCtx, OpInfo, arg_list_t>> ctx_stack;
-    std::vector<std::vector<std::pair<std::string, term_t>>> letBinders;
+    std::vector<let_bindings_t> letBinders;
     bool needs_context_update = false;
     std::optional<term_t> ret{};
     do {
@@ -119,20 +119,17 @@ term_t Smt2_term_parser::parse_term() {
         case Token::SYMBOL:
         case Token::QUOTED_SYMBOL:
         {
-            std::string name = token_to_symbol(token);
-            ret = get_term_for_symbol(name);
+            ret = get_term_for_symbol(token_to_symbol(token));
         }
         break;
         case Token::INTEGER_LITERAL:
         {
-            auto numeral_string = lexer.token_string();
-            ret = parser_context.mk_numeral(numeral_string);
+            ret = parser_context.mk_numeral(lexer.token_view());
         }
         break;
         case Token::DECIMAL_LITERAL:
         {
-            auto decimal_string = lexer.token_string();
-            ret = parser_context.mk_decimal(decimal_string);
+            ret = parser_context.mk_decimal(lexer.token_view());
         }
         break;
         case Token::HEX_LITERAL:
@@ -217,21 +214,14 @@ term_t Smt2_term_parser::parse_term() {
     return ret.value();
 }
 
-std::string Smt2_term_parser::token_to_symbol(Token token)
+symbol_t Smt2_term_parser::token_to_symbol(Token token)
 {
     switch (token)
     {
     case Token::SYMBOL:
-        return lexer.token_string();
     case Token::QUOTED_SYMBOL:
-    {
-        std::string symbol = lexer.token_string();
-        assert(symbol[0] == '|' && symbol.back() == '|');
-        // strip off the quotes
-        symbol = symbol.erase(0, 1);
-        symbol = symbol.erase(symbol.size() - 1, 1);
-        return symbol;
-    }
+        // quotes are stripped off by the lexer
+        return lexer.token_symbol();
     default:
         lexer.unexpected_token_error(token);
         break;
@@ -239,11 +229,10 @@ std::string Smt2_term_parser::token_to_symbol(Token token)
     throw std::logic_error("UNREACHABLE!");
 }
 
-std::string Smt2_term_parser::parse_symbol()
+symbol_t Smt2_term_parser::parse_symbol()
 {
     Token tok = lexer.next_token();
-    std::string id = token_to_symbol(tok);
-    return id;
+    return token_to_symbol(tok);
 }
 
 term_t Smt2_term_parser::make_term(OpInfo const& op_info, std::vector<term_t>&& args)
@@ -251,7 +240,7 @@ term_t Smt2_term_parser::make_term(OpInfo const& op_info, std::vector<term_t>&&
     return parser_context.resolve_term(op_info.name, std::move(args));
 }
 
-term_t Smt2_term_parser::get_term_for_symbol(std::string const& symbol)
+term_t Smt2_term_parser::get_term_for_symbol(symbol_t symbol)
 {
     return parser_context.get_term_for_symbol(symbol);
 }
@@ -1,9 +1,11 @@
 #ifndef YAGA_SMT2_TERM_PARSER_H
 #define YAGA_SMT2_TERM_PARSER_H
 
+#include <string>
 #include <vector>
 
 #include "Parser_context.h"
+#include "Symbol_table.h"
 #include "smt2_lexer.h"
 #include "Term_types.h"
 
@@ -15,18 +17,19 @@ using type_t = terms::type_t;
 
 struct OpInfo
 {
-    std::string name;
+    // id of the interned name of the operator
+    symbol_t name = 0;
 };
 
 class Smt2_term_parser {
     smt2_lexer & lexer;
     Parser_context & parser_context;
 
-    std::string token_to_symbol(Token token);
+    symbol_t token_to_symbol(Token token);
 
     term_t make_term(OpInfo const&, std::vector<term_t>&&);
 
-    term_t get_term_for_symbol(std::string const&);
+    term_t get_term_for_symbol(symbol_t);
 
 public:
     explicit Smt2_term_parser(smt2_lexer & lexer, Parser_context & ctx)
@@ -34,7 +37,11 @@ public:
 
     term_t parse_term();
 
-    std::string parse_symbol();
+    /**
+     * Parses a symbol
+     * @return id of the symbol in the symbol table of the lexer
+     */
+    symbol_t parse_symbol();
 
     type_t parse_sort();
 
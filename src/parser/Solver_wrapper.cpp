@@ -1,5 +1,12 @@
 #include "Solver_wrapper.h"
 #include "utils/Utils.h"
+#include "Terms.h"
+#include "Statistics.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
 #include <variant>
 
 namespace yaga::parser
@@ -10,7 +17,13 @@ using term_t = terms::term_t;
 Solver_wrapper::Solver_wrapper(terms::Term_manager& term_manager, Options const& opts)
     : term_manager(term_manager), options(opts), tracer(opts),
       internalizer_config(term_manager, solver), internalizer(term_manager, internalizer_config),
-      solver(term_manager, internalizer_config.rational_vars(), internalizer_config.bool_vars(), tracer) {}
+      solver(term_manager, internalizer_config.rational_vars(), internalizer_config.bool_vars(), tracer),
+      printer(term_manager, internalizer_config.bool_vars().base(),
+              internalizer_config.rational_vars().base(), solver),
+      preprocessor(term_manager)
+{
+    tracer.set_printer(&printer);
+}
 
 void Solver_wrapper::set_logic(Initializer const& init) {
     solver.set_logic(init, options);
@@ -20,31 +33,80 @@ bool Solver_wrapper::has_uf() {
     return solver.has_uf();
 }
 
-Solver_answer Solver_wrapper::check(std::vector<term_t> const& assertions)
+Solver_answer Solver_wrapper::check(std::vector<term_t> const& input_assertions)
 {
-    if (std::ranges::any_of(assertions, [](term_t t) { return t == terms::false_term; }))
+    auto assertions = input_assertions;
+    if (options.preprocess && !options.produce_proofs && !has_uf())
+    {
+        assertions = preprocessor.run(input_assertions);
+    }
+
+    // top-level clauses (disjunctions of terms)
+    std::vector<std::vector<term_t>> clauses;
+    for (term_t assertion : assertions)
+    {
+        if (options.flatten)
+        {
+            flatten(assertion, clauses);
+        }
+        else
+        {
+            clauses.push_back({assertion});
+        }
+    }
+
+    // remove satisfied clauses and false terms
+    std::erase_if(clauses, [](auto const& clause) { return std::ranges::count(clause, terms::true_term) > 0; });
+    for (auto& clause : clauses)
+    {
+        std::erase(clause, terms::false_term);
+    }
+    if (std::ranges::any_of(clauses, [](auto const& clause) { return clause.empty(); }))
     {
         tracer.trivial_proof();
+        write_statistics(/*is_solved=*/false, clauses.size());
         return Solver_answer::UNSAT;
     }
 
+    std::vector<term_t> roots;
+    for (auto const& clause : clauses)
+    {
+        roots.insert(roots.end(), clause.begin(), clause.end());
+    }
+
     // Cnfize and assert clauses to the solver
     solver.init();
 
-    internalizer.visit(assertions);
+    internalizer_config.mark_polarities(roots);
+    internalizer.visit(roots);
 
-    // add top level assertions to the solver
-    for (term_t assertion : assertions)
+    // add top level clauses to the solver
+    for (auto const& clause : clauses)
     {
-        if (assertion == terms::true_term) { continue; }
-        auto possibly_literal = internalizer_config.get_literal_for(term_manager.positive_term(assertion));
-        assert(possibly_literal.has_value());
-        Literal literal = possibly_literal.value();
-        if (term_manager.is_negated(assertion))
+        std::vector<Literal> literals;
+        literals.reserve(clause.size());
+        for (term_t term : clause)
         {
-            literal.negate();
+            auto possibly_literal = internalizer_config.get_literal_for(term_manager.positive_term(term));
+            assert(possibly_literal.has_value());
+            Literal literal = possibly_literal.value();
+            if (term_manager.is_negated(term))
+            {
+                literal.negate();
+            }
+            literals.push_back(literal);
+        }
+
+        // remove duplicate literals and skip tautologies
+        std::ranges::sort(literals);
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+        auto is_tautology = std::adjacent_find(literals.begin(), literals.end(), [](auto lhs, auto rhs) {
+            return lhs.var() == rhs.var();
+        }) != literals.end();
+        if (!is_tautology)
+        {
+            solver.assert_clause(std::move(literals));
         }
-        solver.assert_clause(literal);
     }
 
     // remember term-variable mapping
@@ -65,16 +127,11 @@ Solver_answer Solver_wrapper::check(std::vector<term_t> const& assertions)
         }
     }
 
+    // the SAT preprocessor can change asserted clauses in check()
+    auto num_asserted = solver.solver().db().asserted().size();
     auto res = solver.solver().check();
 
-    if (options.print_stats)
-    {
-        std::cout << "Conflicts = " << solver.solver().num_conflicts() << "\n";
-        std::cout << "Conflict clauses = " << solver.solver().num_conflict_clauses() << "\n";
-        std::cout << "Learned clauses = " << solver.solver().num_learned_clauses() << "\n";
-        std::cout << "Decisions = " << solver.solver().num_decisions() << "\n";
-        std::cout << "Restarts = " << solver.solver().num_restarts() << "\n";
-    }
+    write_statistics(/*is_solved=*/true, clauses.size(), num_asserted);
 
     if (res == Solver::Result::sat)
     {
@@ -84,15 +141,106 @@ Solver_answer Solver_wrapper::check(std::vector<term_t> const& assertions)
     {
         return Solver_answer::UNSAT;
     }
+    else if (res == Solver::Result::unknown)
+    {
+        return Solver_answer::UNKNOWN;
+    }
     assert(false);
     return Solver_answer::UNKNOWN;
 }
 
+void Solver_wrapper::write_statistics(bool is_solved, std::size_t num_clauses,
+                                      std::size_t num_asserted)
+{
+    if (!options.print_stats && options.stats_path.empty())
+    {
+        return;
+    }
+
+    Statistics stats;
+    if (is_solved)
+    {
+        solver.solver().collect_statistics(stats);
+        stats.set("smt.asserted_clauses", num_asserted);
+    }
+    stats.set("smt.top_level_clauses", num_clauses);
+    if (options.preprocess)
+    {
+        stats.set("smt.eliminated_variables", preprocessor.num_eliminated());
+        stats.set("smt.unconstrained_variables", preprocessor.num_unconstrained());
+        stats.set("smt.tightened_bounds", preprocessor.num_tightened());
+    }
+
+    if (options.print_stats)
+    {
+        stats.write_text(std::cout);
+    }
+    // the standard output is reserved for answers of the solver
+    if (options.stats_path == "-")
+    {
+        stats.write_json(std::cerr);
+    }
+    else if (!options.stats_path.empty())
+    {
+        std::ofstream out{options.stats_path};
+        if (!out)
+        {
+            throw std::logic_error{"Failed to open '" + options.stats_path + "'."};
+        }
+        stats.write_json(out);
+    }
+}
+
+void Solver_wrapper::flatten(term_t assertion, std::vector<std::vector<term_t>>& clauses)
+{
+    std::vector<term_t> conjuncts{assertion};
+    std::vector<term_t> disjuncts;
+    while (!conjuncts.empty())
+    {
+        term_t conjunct = conjuncts.back();
+        conjuncts.pop_back();
+        if (term_manager.get_kind(conjunct) != terms::Kind::OR_TERM)
+        {
+            clauses.push_back({conjunct});
+            continue;
+        }
+
+        auto args = term_manager.get_args(conjunct);
+        if (term_manager.is_negated(conjunct)) // conjunction of negated arguments
+        {
+            for (term_t arg : args)
+            {
+                conjuncts.push_back(terms::opposite_term(arg));
+            }
+            continue;
+        }
+
+        // inline arguments which are disjunctions
+        auto& clause = clauses.emplace_back();
+        disjuncts.assign(args.begin(), args.end());
+        while (!disjuncts.empty())
+        {
+            term_t disjunct = disjuncts.back();
+            disjuncts.pop_back();
+            if (term_manager.get_kind(disjunct) == terms::Kind::OR_TERM && !term_manager.is_negated(disjunct))
+            {
+                auto disjunct_args = term_manager.get_args(disjunct);
+                disjuncts.insert(disjuncts.end(), disjunct_args.begin(), disjunct_args.end());
+            }
+            else
+            {
+                clause.push_back(disjunct);
+            }
+        }
+    }
+}
+
 void Solver_wrapper::model(Default_model_visitor& visitor)
 {
     auto& bool_model = solver.solver().trail().model<bool>(Variable::boolean);
     auto& lra_model = solver.solver().trail().model<Rational>(Variable::rational);
 
+    std::unordered_map<term_t, Rational> values;
     for (auto& [term, var] : variables)
     {
         if (term_manager.get_kind(term) != terms::Kind::UNINTERPRETED_TERM)
@@ -105,6 +253,20 @@ void Solver_wrapper::model(Default_model_visitor& visitor)
         else if (var.type() == Variable::rational && lra_model.is_defined(var.ord()))
         {
             visitor.visit(term, lra_model.value(var.ord()));
+            values.emplace(term, lra_model.value(var.ord()));
+        }
+    }
+
+    // assign values to variables removed by preprocessing
+    if (options.preprocess)
+    {
+        preprocessor.extend_model(values);
+        for (auto const& [term, value] : values)
+        {
+            if (!variables.contains(term))
+            {
+                visitor.visit(term, value);
+            }
         }
     }
 
@@ -235,6 +397,15 @@ void Internalizer_config::visit(term_t t)
             break;
         }
 
+        // Boolean arguments are interpreted by the UF plugin
+        for (term_t arg : term_manager.get_args(t))
+        {
+            if (auto arg_lit = get_literal_for(term_manager.positive_term(arg)))
+            {
+                solver.solver().preprocessor().freeze(arg_lit->var());
+            }
+        }
+
         Variable var = solver.make_function_application(var_type, t);
 
         switch (term_type) {
@@ -284,14 +455,26 @@ void Internalizer_config::visit(term_t t)
             }
             arg_literals.push_back(arg_lit);
         }
-        // binary clauses
-        for (auto arg_lit : arg_literals)
+        auto index = term_manager.index_of(t);
+        std::uint8_t polarity = both;
+        if (polarities.contains(index))
+        {
+            polarity = polarities[index];
+        }
+        // binary clauses (the disjunction implies `lit`)
+        if (polarity & negative)
+        {
+            for (auto arg_lit : arg_literals)
+            {
+                solver.assert_clause(lit, ~arg_lit);
+            }
+        }
+        // big clause (`lit` implies the disjunction)
+        if (polarity & positive)
         {
-            solver.assert_clause(lit, ~arg_lit);
+            arg_literals.push_back(~lit);
+            solver.assert_clause(std::move(arg_literals));
         }
-        // big clause
-        arg_literals.push_back(~lit);
-        solver.assert_clause(std::move(arg_literals));
         return;
     }
     case terms::Kind::ITE_TERM:
@@ -342,6 +525,45 @@ void Internalizer_config::visit(term_t t)
     }
 }
 
+void Internalizer_config::mark_polarities(std::span<term_t const> roots)
+{
+    std::vector<std::pair<term_t, std::uint8_t>> worklist;
+    for (term_t root : roots)
+    {
+        worklist.emplace_back(term_manager.positive_term(root), term_manager.is_negated(root) ? negative : positive);
+    }
+
+    polarities.resize(term_manager.num_terms());
+    while (!worklist.empty())
+    {
+        auto [t, polarity] = worklist.back();
+        worklist.pop_back();
+
+        auto index = term_manager.index_of(t);
+        std::uint8_t old_polarity = polarities.contains(index) ? polarities[index] : 0;
+        std::uint8_t new_polarity = polarity & ~old_polarity;
+        if (new_polarity == 0)
+        {
+            continue;
+        }
+        polarities.insert(index, old_polarity | new_polarity);
+
+        // only disjunctions preserve polarity of their arguments
+        bool is_or = term_manager.get_kind(t) == terms::Kind::OR_TERM;
+        auto flipped_polarity = static_cast<std::uint8_t>(((new_polarity & positive) ? negative : 0) |
+                                                          ((new_polarity & negative) ? positive : 0));
+        for (term_t arg : term_manager.get_args(t))
+        {
+            std::uint8_t arg_polarity = both;
+            if (is_or)
+            {
+                arg_polarity = term_manager.is_negated(arg) ? flipped_polarity : new_polarity;
+            }
+            worklist.emplace_back(term_manager.positive_term(arg), arg_polarity);
+        }
+    }
+}
+
 std::optional<Literal> Internalizer_config::get_literal_for(term_t t) const
 {
     auto it = internal_bool_vars.find(t);
@@ -1,12 +1,18 @@
 #ifndef YAGA_SOLVER_WRAPPER_H
 #define YAGA_SOLVER_WRAPPER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <vector>
 #include <ranges>
 
 #include "utils/Linear_polynomial.h"
+#include "Dense_map.h"
 #include "Solver_answer.h"
+#include "Preprocessor.h"
+#include "Proof_printer.h"
 #include "Term_manager.h"
 #include "Term_types.h"
 #include "Term_visitor.h"
@@ -42,9 +48,18 @@ public:
 
 class Internalizer_config : public terms::Default_visitor_config
 {
+    // flags of polarities in which a term occurs in the assertions
+    enum Polarity : std::uint8_t {
+        positive = 1,
+        negative = 2,
+        both = positive | negative,
+    };
+
     terms::Term_manager const& term_manager;
     Yaga& solver;
     std::unordered_map<terms::term_t, int> internal_rational_vars;
+    // map term index -> polarities in which the term occurs in internalized assertions
+    terms::Dense_map<std::uint8_t> polarities;
 
     // HACK: We need to store literals
     // x >= 0 (positive in term representation) is internalized as ~(x < 0), which is negative
@@ -82,6 +97,17 @@ public:
 
     void visit(terms::term_t) override;
 
+    /** Compute polarities in which subterms of @p roots occur.
+     *
+     * Disjunctions which only occur positively (resp. negatively) are encoded only by the clause
+     * which implies the disjunction (resp. the clauses implied by the disjunction) as in the
+     * Plaisted-Greenbaum encoding. Boolean subterms of other terms are treated as if they occurred
+     * in both polarities.
+     *
+     * @param roots top-level assertions which are going to be visited
+     */
+    void mark_polarities(std::span<terms::term_t const> roots);
+
     std::optional<Literal> get_literal_for(terms::term_t t) const;
 
     /** Get a range of boolean variables (pairs of `term_t` and `Literal`)
@@ -134,6 +160,29 @@ class Solver_wrapper
 
     Yaga solver;
 
+    // prints atoms of variables in proofs which refer to terms
+    Proof_printer printer;
+
+    // simplifies assertions before they are internalized
+    terms::Preprocessor preprocessor;
+
+    /** Split top-level conjunctions and flatten nested disjunctions in @p assertion
+     *
+     * @param assertion top-level assertion
+     * @param clauses output: disjunctions of terms which are equisatisfiable with @p assertion
+     */
+    void flatten(terms::term_t assertion, std::vector<std::vector<terms::term_t>>& clauses);
+
+    /** Print or write statistics if they are requested by options
+     *
+     * @param is_solved true iff the solver has been run (otherwise, only counters of the
+     * front-end are reported)
+     * @param num_clauses number of top-level clauses
+     * @param num_asserted number of clauses asserted in the solver (top-level clauses and
+     * definitions of auxiliary literals)
+     */
+    void write_statistics(bool is_solved, std::size_t num_clauses, std::size_t num_asserted = 0);
+
 public:
     Solver_wrapper(terms::Term_manager& term_manager, Options const& options);
 
@@ -141,6 +190,14 @@ public:
 
     bool has_uf();
 
+    /** Check satisfiability of a list of assertions.
+     *
+     * If `Options::preprocess` is set, the assertions are simplified by `terms::Preprocessor`
+     * first.
+     *
+     * @param assertions list of top-level assertions
+     * @return answer of the solver
+     */
     Solver_answer check(std::vector<terms::term_t> const& assertions);
 
     /** Get model generated by the last `check()` call.
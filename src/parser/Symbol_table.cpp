@@ -0,0 +1,18 @@
+#include "Symbol_table.h"
+
+namespace yaga::parser {
+
+symbol_t Symbol_table::intern(std::string_view name)
+{
+    auto it = ids.find(name);
+    if (it != ids.end())
+    {
+        return it->second;
+    }
+
+    auto symbol = static_cast<symbol_t>(names.size());
+    ids.emplace(names.emplace_back(name), symbol);
+    return symbol;
+}
+
+} // namespace yaga::parser
@@ -0,0 +1,52 @@
+#ifndef YAGA_SYMBOL_TABLE_H
+#define YAGA_SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace yaga::parser {
+
+/** Dense identifier of an interned symbol
+ */
+using symbol_t = std::uint32_t;
+
+/** Table of interned symbols.
+ *
+ * Each distinct symbol is stored exactly once and it is assigned a dense id (0, 1, 2, ...).
+ * Names of interned symbols are never moved, so views returned by `name()` remain valid for the
+ * lifetime of the table.
+ */
+class Symbol_table {
+public:
+    /** Find or create an id for @p name
+     *
+     * @param name symbol name
+     * @return id of @p name
+     */
+    symbol_t intern(std::string_view name);
+
+    /** Get name of an interned symbol
+     *
+     * @param symbol id of an interned symbol
+     * @return name of @p symbol
+     */
+    inline std::string_view name(symbol_t symbol) const { return names[symbol]; }
+
+    /**
+     * @return number of interned symbols
+     */
+    inline std::size_t size() const { return names.size(); }
+
+private:
+    // map symbol id -> symbol name (deque does not move its elements when it grows)
+    std::deque<std::string> names;
+    // map symbol name (view of a string in `names`) -> symbol id
+    std::unordered_map<std::string_view, symbol_t> ids;
+};
+
+} // namespace yaga::parser
+
+#endif // YAGA_SYMBOL_TABLE_H
@@ -0,0 +1,698 @@
+#include "Alethe_tracer.h"
+#include <array>
+#include <cassert>
+#include <utility>
+#include <variant>
+
+namespace yaga::proof {
+
+Alethe_tracer::Alethe_tracer(std::string const& output_path, bool in_memory, bool async)
+    : in_memory(in_memory), output(output_path, async)
+{
+}
+
+void Alethe_tracer::trivial_proof()
+{
+    final_step = assume_false();
+    write_proof();
+}
+
+void Alethe_tracer::begin_proof(Database const& db)
+{
+    for (auto const& clause : db.asserted())
+    {
+        if (clause.empty())
+        {
+            clause_step(clause.id()) = assume_false();
+            continue;
+        }
+
+        push_clause(clause);
+        auto id = add_step(Rule::assume);
+        if (clause.size() > 1)
+        {
+            // split the assumed disjunction into a clause
+            push_clause(clause);
+            premises.push_back(id);
+            id = add_step(Rule::or_rule);
+        }
+        clause_step(clause.id()) = id;
+    }
+}
+
+void Alethe_tracer::init_conflict(Clause const& conflict, Conflict_explanation&& explanation)
+{
+    if (!std::holds_alternative<conflict::Boolean>(explanation))
+    {
+        assert(clause_step(conflict.id()) == 0);
+        clause_step(conflict.id()) = theory_lemma(conflict, explanation);
+    }
+    assert(clause_step(conflict.id()) != 0);
+    open_conflicts.push_back(Chain{conflict.id(), chains.size(), chains.size() + 1});
+    chains.push_back(conflict.id());
+}
+
+void Alethe_tracer::resolve_conflict(Clause_id conflict, Clause_id other)
+{
+    auto it = find_conflict(conflict);
+    assert(it != open_conflicts.end());
+    assert(clause_step(other) != 0);
+    auto& chain = *it;
+    if (chain.end != chains.size())
+    {
+        // Another chain was started after this one, move this chain to the end
+        auto begin = chains.size();
+        for (auto i = chain.begin; i < chain.end; ++i)
+        {
+            chains.push_back(chains[i]);
+        }
+        chain.begin = begin;
+        chain.end = chains.size();
+    }
+    chains.push_back(other);
+    ++chain.end;
+}
+
+void Alethe_tracer::rename_conflict(Clause_id from, Clause_id to)
+{
+    auto it = find_conflict(from);
+    assert(it != open_conflicts.end());
+    if (from != to)
+    {
+        assert(find_conflict(to) == open_conflicts.end());
+        it->conflict = to;
+    }
+}
+
+void Alethe_tracer::finish_conflicts()
+{
+    // Unused theory lemmas stay in the proof (they are pruned in memory mode)
+    open_conflicts.clear();
+    chains.clear();
+}
+
+void Alethe_tracer::learn_clause(Clause const& learned)
+{
+    auto it = find_conflict(learned.id());
+    assert(it != open_conflicts.end());
+    auto chain = *it;
+    if (chain.end - chain.begin == 1)
+    {
+        // The conflict clause is learned as-is
+        clause_step(learned.id()) = clause_steps[chains[chain.begin]];
+        return;
+    }
+
+    for (auto i = chain.begin; i < chain.end; ++i)
+    {
+        premises.push_back(clause_steps[chains[i]]);
+    }
+    push_clause(learned);
+    clause_step(learned.id()) = add_step(Rule::resolution);
+}
+
+void Alethe_tracer::delete_clause(Clause const&)
+{
+    // Alethe proofs do not delete clauses
+}
+
+void Alethe_tracer::derive_final(Clause const& empty)
+{
+    learn_clause(empty);
+    final_step = clause_steps[empty.id()];
+}
+
+void Alethe_tracer::end_proof(Database const&)
+{
+    write_proof();
+}
+
+void Alethe_tracer::set_printer(Term_printer* new_printer)
+{
+    printer = new_printer;
+}
+
+void Alethe_tracer::collect_statistics(Statistics& stats) const
+{
+    stats.set("alethe.steps", first_step_id - 1 + steps.size());
+    stats.set("alethe.bytes", output.num_bytes());
+}
+
+std::uint32_t Alethe_tracer::add_step(Rule rule, bool is_disjunction)
+{
+    steps.push_back({rule, is_disjunction, static_cast<std::uint32_t>(literals.size()),
+                     static_cast<std::uint32_t>(premises.size()),
+                     static_cast<std::uint32_t>(args.size())});
+    auto id = first_step_id + static_cast<std::uint32_t>(steps.size() - 1);
+    if (!in_memory)
+    {
+        write_step(0, id, {});
+        first_step_id = id + 1;
+        steps.clear();
+        literals.clear();
+        premises.clear();
+        args.clear();
+    }
+    return id;
+}
+
+std::uint32_t Alethe_tracer::assume_false()
+{
+    literals.push_back({Proof_literal::constant, false, 0, 0});
+    auto assumption = add_step(Rule::assume);
+    literals.push_back({Proof_literal::constant, true, 0, 0});
+    auto negation = add_step(Rule::false_rule);
+    premises.push_back(assumption);
+    premises.push_back(negation);
+    return add_step(Rule::resolution);
+}
+
+std::uint32_t Alethe_tracer::theory_lemma(Clause const& conflict,
+                                          Conflict_explanation const& explanation)
+{
+    std::uint32_t id = 0;
+    if (printer != nullptr)
+    {
+        if (auto bounds = std::get_if<conflict::Lra_bounds>(&explanation))
+        {
+            id = farkas_lemma(conflict, bounds->coefficients, {});
+        }
+        else if (auto disequality = std::get_if<conflict::Lra_disequality>(&explanation))
+        {
+            id = farkas_lemma(conflict, disequality->coefficients,
+                              disequality->upper_coefficients);
+        }
+        else if (auto congruence = std::get_if<conflict::Uf_congruence>(&explanation))
+        {
+            id = congruence_lemma(conflict, *congruence);
+        }
+    }
+
+    if (id == 0)
+    {
+        // The lemma is trusted
+        push_clause(conflict);
+        id = add_step(Rule::hole);
+    }
+    return id;
+}
+
+std::uint32_t Alethe_tracer::farkas_lemma(Clause const& conflict,
+                                          std::vector<Rational> const& first_side,
+                                          std::vector<Rational> const& second_side)
+{
+    if (first_side.size() != conflict.size() ||
+        (!second_side.empty() && second_side.size() != conflict.size()))
+    {
+        return 0;
+    }
+
+    // find the positive equality which is split into strict inequalities
+    auto find_split = [&](std::vector<Rational> const& coefficients) {
+        for (std::size_t i = 0; i < conflict.size(); ++i)
+        {
+            if (!conflict[i].is_negation() && coefficients[i] != 0 &&
+                printer->atom(conflict[i].var().ord()).kind == Atom::eq)
+            {
+                return i;
+            }
+        }
+        return conflict.size();
+    };
+
+    auto split = find_split(first_side);
+    if (split == conflict.size())
+    {
+        if (!second_side.empty())
+        {
+            return 0;
+        }
+        push_clause(conflict);
+        return add_la_generic(first_side);
+    }
+
+    // the other side of a bound lemma only uses equalities, so it is the negation of the first one
+    auto other_side = second_side;
+    if (second_side.empty())
+    {
+        other_side = first_side;
+        for (auto& coef : other_side)
+        {
+            coef = -coef;
+        }
+    }
+    if (find_split(other_side) != split || (first_side[split] > 0) == (other_side[split] > 0))
+    {
+        return 0;
+    }
+
+    // derive the lemma with `lhs <= rhs` or `rhs <= lhs` instead of `lhs = rhs` for each side
+    auto var = conflict[split].var().ord();
+    std::array<std::uint32_t, 2> side_steps{};
+    std::vector<Rational> coefficients;
+    for (auto side : {0, 1})
+    {
+        coefficients = side == 0 ? first_side : other_side;
+        auto& split_coef = coefficients[split];
+        for (std::size_t i = 0; i < conflict.size(); ++i)
+        {
+            if (i != split)
+            {
+                push_literal(conflict[i]);
+            }
+            else if (split_coef > 0) // `lhs < rhs` is the negation of `rhs <= lhs`
+            {
+                literals.push_back({Proof_literal::atom_geq, false, var, 0});
+            }
+            else // `lhs > rhs` is the negation of `lhs <= rhs`
+            {
+                literals.push_back({Proof_literal::atom_leq, false, var, 0});
+                split_coef = -split_coef;
+            }
+        }
+        side_steps[side] = add_la_generic(coefficients);
+    }
+
+    auto split_step = add_la_disequality({Proof_literal::atom, false, var, 0},
+                                         {Proof_literal::atom_leq, false, var, 0},
+                                         {Proof_literal::atom_geq, false, var, 0});
+    premises.push_back(split_step);
+    premises.insert(premises.end(), side_steps.begin(), side_steps.end());
+    push_clause(conflict);
+    return add_step(Rule::resolution);
+}
+
+std::uint32_t Alethe_tracer::congruence_lemma(Clause const& conflict,
+                                              conflict::Uf_congruence const& explanation)
+{
+    auto const& equalities = explanation.equalities;
+    if (equalities.empty() || equalities.back().atom_var < 0)
+    {
+        return 0;
+    }
+    for (std::size_t i = 0; i < equalities.size(); ++i)
+    {
+        if (equalities[i].atom_var >= 0)
+        {
+            Literal lit{equalities[i].atom_var};
+            if (i + 1 < equalities.size())
+            {
+                lit = ~lit;
+            }
+            if (std::find(conflict.begin(), conflict.end(), lit) == conflict.end())
+            {
+                return 0;
+            }
+        }
+    }
+
+    auto term_literal = [](Proof_literal::Kind kind, bool is_negation, terms::term_t lhs,
+                           terms::term_t rhs) -> Proof_literal {
+        return {kind, is_negation, lhs.x, rhs.x};
+    };
+
+    // link each equality of terms to its arithmetic atom
+    std::vector<std::uint32_t> links;
+    for (std::size_t i = 0; i < equalities.size(); ++i)
+    {
+        auto const& [lhs, rhs, var, scale] = equalities[i];
+        auto is_duplicate = std::any_of(equalities.begin(), equalities.begin() + i,
+                                        [&](auto const& other) {
+                                            return other.lhs == lhs && other.rhs == rhs;
+                                        });
+        if (is_duplicate) // the equality is resolved by the link of its first occurrence
+        {
+            continue;
+        }
+
+        auto term_eq = term_literal(Proof_literal::term_eq, false, lhs, rhs);
+        if (lhs == rhs)
+        {
+            literals.push_back(term_eq);
+            links.push_back(add_step(Rule::eq_reflexive));
+            continue;
+        }
+
+        auto lhs_leq = term_literal(Proof_literal::term_leq, false, lhs, rhs);
+        auto rhs_leq = term_literal(Proof_literal::term_leq, false, rhs, lhs);
+        Proof_literal atom{Proof_literal::atom, false, var, 0};
+
+        std::array<std::uint32_t, 3> steps_to_resolve{};
+        if (var < 0) // `lhs - rhs` is 0
+        {
+            steps_to_resolve[0] = add_la_disequality(term_eq, lhs_leq, rhs_leq);
+            literals.push_back(lhs_leq);
+            steps_to_resolve[1] = add_la_generic(std::array{Rational{1}});
+            literals.push_back(rhs_leq);
+            steps_to_resolve[2] = add_la_generic(std::array{Rational{1}});
+            literals.push_back(term_eq);
+        }
+        else if (i + 1 < equalities.size()) // `atom` implies `lhs = rhs`
+        {
+            steps_to_resolve[0] = add_la_disequality(term_eq, lhs_leq, rhs_leq);
+            atom.is_negation = true;
+            literals.push_back(lhs_leq);
+            literals.push_back(atom);
+            steps_to_resolve[1] = add_la_generic(std::array{Rational{1}, Rational{1} / scale});
+            literals.push_back(rhs_leq);
+            literals.push_back(atom);
+            steps_to_resolve[2] = add_la_generic(std::array{Rational{1}, -Rational{1} / scale});
+            literals.push_back(term_eq);
+            literals.push_back(atom);
+        }
+        else // `lhs = rhs` implies `atom`
+        {
+            steps_to_resolve[0] = add_la_disequality(atom, {Proof_literal::atom_leq, false, var, 0},
+                                                     {Proof_literal::atom_geq, false, var, 0});
+            term_eq.is_negation = true;
+            literals.push_back({Proof_literal::atom_leq, false, var, 0});
+            literals.push_back(term_eq);
+            steps_to_resolve[1] = add_la_generic(std::array{Rational{1}, scale});
+            literals.push_back({Proof_literal::atom_geq, false, var, 0});
+            literals.push_back(term_eq);
+            steps_to_resolve[2] = add_la_generic(std::array{Rational{1}, -scale});
+            literals.push_back(atom);
+            literals.push_back(term_eq);
+        }
+        premises.insert(premises.end(), steps_to_resolve.begin(), steps_to_resolve.end());
+        links.push_back(add_step(Rule::resolution));
+    }
+
+    // equal arguments imply equal function applications
+    for (std::size_t i = 0; i < equalities.size(); ++i)
+    {
+        auto is_app = i + 1 == equalities.size();
+        literals.push_back(
+            term_literal(Proof_literal::term_eq, !is_app, equalities[i].lhs, equalities[i].rhs));
+    }
+    premises.push_back(add_step(Rule::eq_congruent));
+    premises.insert(premises.end(), links.begin(), links.end());
+    push_clause(conflict);
+    return add_step(Rule::resolution);
+}
+
+std::uint32_t Alethe_tracer::add_la_generic(std::span<Rational const> coefficients)
+{
+    Rational mult{1};
+    for (auto const& coef : coefficients)
+    {
+        if (coef != 0)
+        {
+            mult = lcm(mult, coef.denominator());
+        }
+    }
+    for (auto const& coef : coefficients)
+    {
+        args.push_back(coef * mult);
+    }
+    return add_step(Rule::la_generic);
+}
+
+std::uint32_t Alethe_tracer::add_la_disequality(Proof_literal equality, Proof_literal leq,
+                                                Proof_literal geq)
+{
+    leq.is_negation = true;
+    geq.is_negation = true;
+    literals.insert(literals.end(), {equality, leq, geq});
+    auto id = add_step(Rule::la_disequality, true);
+    literals.insert(literals.end(), {equality, leq, geq});
+    premises.push_back(id);
+    return add_step(Rule::or_rule);
+}
+
+void Alethe_tracer::write_proof()
+{
+    if (in_memory && final_step != 0)
+    {
+        // find steps needed to derive the empty clause
+        auto last = final_step - first_step_id;
+        std::vector<std::uint32_t> step_ids(last + 1, 0);
+        step_ids[last] = 1;
+        for (auto i = last + 1; i-- > 0;)
+        {
+            if (step_ids[i] == 0)
+            {
+                continue;
+            }
+            auto begin = i == 0 ? 0 : steps[i - 1].premises_end;
+            for (auto j = begin; j < steps[i].premises_end; ++j)
+            {
+                step_ids[premises[j] - first_step_id] = 1;
+            }
+        }
+
+        // renumber and write the needed steps
+        std::uint32_t next_id = 1;
+        for (auto& id : step_ids)
+        {
+            if (id != 0)
+            {
+                id = next_id++;
+            }
+        }
+        for (std::size_t i = 0; i <= last; ++i)
+        {
+            if (step_ids[i] != 0)
+            {
+                write_step(i, step_ids[i], step_ids);
+            }
+        }
+
+        first_step_id += static_cast<std::uint32_t>(steps.size());
+        steps.clear();
+        literals.clear();
+        premises.clear();
+        args.clear();
+    }
+    output.flush();
+}
+
+void Alethe_tracer::write_step(std::size_t index, std::uint32_t id,
+                               std::span<std::uint32_t const> step_ids)
+{
+    auto const& step = steps[index];
+    auto const* prev = index == 0 ? nullptr : &steps[index - 1];
+    std::span step_literals{literals.begin() + (prev ? prev->literals_end : 0),
+                            literals.begin() + step.literals_end};
+
+    if (step.rule == Rule::assume)
+    {
+        output.write("(assume t");
+        output.write_decimal(id);
+        output.put(' ');
+        if (step_literals.size() == 1)
+        {
+            write_literal(step_literals.front());
+        }
+        else
+        {
+            output.write("(or");
+            for (auto lit : step_literals)
+            {
+                output.put(' ');
+                write_literal(lit);
+            }
+            output.put(')');
+        }
+        output.write(")\n");
+        return;
+    }
+
+    output.write("(step t");
+    output.write_decimal(id);
+    output.write(step.is_disjunction ? " (cl (or" : " (cl");
+    for (auto lit : step_literals)
+    {
+        output.put(' ');
+        write_literal(lit);
+    }
+    output.write(step.is_disjunction ? ")) :rule " : ") :rule ");
+    output.write(rule_name(step.rule));
+
+    auto premises_begin = prev ? prev->premises_end : 0;
+    if (premises_begin < step.premises_end)
+    {
+        output.write(" :premises (");
+        for (auto i = premises_begin; i < step.premises_end; ++i)
+        {
+            auto premise = premises[i];
+            if (!step_ids.empty())
+            {
+                premise = step_ids[premise - first_step_id];
+            }
+            output.write(i == premises_begin ? "t" : " t");
+            output.write_decimal(premise);
+        }
+        output.put(')');
+    }
+
+    auto args_begin = prev ? prev->args_end : 0;
+    if (args_begin < step.args_end)
+    {
+        output.write(" :args (");
+        for (auto i = args_begin; i < step.args_end; ++i)
+        {
+            if (i != args_begin)
+            {
+                output.put(' ');
+            }
+            write_rational(args[i]);
+        }
+        output.put(')');
+    }
+    output.write(")\n");
+}
+
+void Alethe_tracer::write_literal(Proof_literal lit)
+{
+    if (lit.is_negation)
+    {
+        output.write("(not ");
+    }
+
+    switch (lit.kind)
+    {
+    case Proof_literal::atom:
+        write_atom(lit.first);
+        break;
+    case Proof_literal::atom_leq:
+    case Proof_literal::atom_geq: {
+        auto atom = printer->atom(lit.first);
+        assert(atom.kind == Atom::eq);
+        if (lit.kind == Proof_literal::atom_geq)
+        {
+            std::swap(atom.lhs, atom.rhs);
+        }
+        output.write("(<= ");
+        output.write(atom.lhs);
+        output.put(' ');
+        output.write(atom.rhs);
+        output.put(')');
+        break;
+    }
+    case Proof_literal::term_eq:
+    case Proof_literal::term_leq:
+        output.write(lit.kind == Proof_literal::term_eq ? "(= " : "(<= ");
+        output.write(printer->term({lit.first}));
+        output.put(' ');
+        output.write(printer->term({lit.second}));
+        output.put(')');
+        break;
+    case Proof_literal::constant:
+        output.write("false");
+        break;
+    }
+
+    if (lit.is_negation)
+    {
+        output.put(')');
+    }
+}
+
+void Alethe_tracer::write_atom(int bool_var_ord)
+{
+    if (printer == nullptr)
+    {
+        output.put('b');
+        output.write_decimal(bool_var_ord);
+        return;
+    }
+
+    auto index = static_cast<std::size_t>(bool_var_ord);
+    if (index < named_atoms.size() && named_atoms[index])
+    {
+        output.write("@p");
+        output.write_decimal(bool_var_ord);
+        return;
+    }
+    if (index >= named_atoms.size())
+    {
+        named_atoms.resize(std::max(index + 1, 2 * named_atoms.size()));
+    }
+    named_atoms[index] = true;
+
+    auto atom = printer->atom(bool_var_ord);
+    output.write("(! ");
+    switch (atom.kind)
+    {
+    case Atom::boolean:
+        output.write(atom.lhs);
+        break;
+    case Atom::disjunction:
+        output.write("(or");
+        for (auto arg : atom.args)
+        {
+            output.put(' ');
+            write_literal({Proof_literal::atom, arg.is_negation(), arg.var().ord(), 0});
+        }
+        output.put(')');
+        break;
+    case Atom::leq:
+    case Atom::lt:
+    case Atom::eq:
+        output.write(atom.kind == Atom::leq ? "(<= " : atom.kind == Atom::lt ? "(< " : "(= ");
+        output.write(atom.lhs);
+        output.put(' ');
+        output.write(atom.rhs);
+        output.put(')');
+        break;
+    }
+    output.write(" :named @p");
+    output.write_decimal(bool_var_ord);
+    output.put(')');
+}
+
+std::string_view Alethe_tracer::rule_name(Rule rule)
+{
+    switch (rule)
+    {
+    case Rule::assume:
+        return "assume";
+    case Rule::or_rule:
+        return "or";
+    case Rule::resolution:
+        return "resolution";
+    case Rule::la_generic:
+        return "la_generic";
+    case Rule::la_disequality:
+        return "la_disequality";
+    case Rule::eq_congruent:
+        return "eq_congruent";
+    case Rule::eq_reflexive:
+        return "eq_reflexive";
+    case Rule::false_rule:
+        return "false";
+    case Rule::hole:
+        return "hole";
+    }
+    assert(false);
+    return "hole";
+}
+
+void Alethe_tracer::write_rational(Rational const& value)
+{
+    auto is_negative = value < 0;
+    auto abs = is_negative ? -value : value;
+    if (is_negative)
+    {
+        output.write("(- ");
+    }
+    if (abs.denominator() == 1)
+    {
+        output.write(abs.get_str());
+    }
+    else
+    {
+        output.write("(/ ");
+        output.write(abs.numerator().get_str());
+        output.put(' ');
+        output.write(abs.denominator().get_str());
+        output.put(')');
+    }
+    if (is_negative)
+    {
+        output.put(')');
+    }
+}
+
+} // namespace yaga::proof
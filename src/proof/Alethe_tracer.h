@@ -0,0 +1,295 @@
+#ifndef YAGA_ALETHE_TRACER_H
+#define YAGA_ALETHE_TRACER_H
+
+#include "Proof_output.h"
+#include "Term_printer.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yaga::proof {
+
+/** Tracer that produces proofs in the Alethe format.
+ *
+ * Asserted clauses are assumptions of the proof: `(assume tN (or l...))` followed by a step with
+ * the `or` rule. Learned clauses are derived by the `resolution` rule from their resolution
+ * chain. Theory lemmas are derived from the witnesses in `Conflict_explanation`:
+ * - LRA conflicts by `la_generic` with the Farkas coefficients. Lemmas which contain an equality
+ *   are split on the strict sides of the equality by `la_disequality`.
+ * - UF conflicts by `eq_congruent`. Equalities of terms are linked to arithmetic atoms by LRA
+ *   steps (or derived by `eq_reflexive` if both sides are the same term).
+ * Lemmas without a witness (or without a term printer) are introduced by the `hole` rule.
+ *
+ * Atoms are printed by a `Term_printer` (boolean variable `bN` if there is none). Arithmetic atoms
+ * are printed in the normalized form of the solver. The first occurrence of an atom in the proof
+ * is named `@pN` by the `:named` attribute and later occurrences use the name.
+ *
+ * In memory mode, steps are kept in compact arrays until the end of the proof. Only steps needed
+ * for the empty clause are written (and renumbered). In stream mode, steps are written as soon as
+ * they are created so the memory usage does not grow with the length of the run, but the proof is
+ * not pruned.
+ */
+class Alethe_tracer : public Tracer {
+public:
+    /** Create a tracer which writes a proof to a file
+     *
+     * @param output_path path to the proof file (compressed if it ends with `.gz` or `.xz`)
+     * @param in_memory if true, the proof is pruned in memory before it is written
+     * @param async if true, the proof is written by a background thread
+     */
+    Alethe_tracer(std::string const& output_path, bool in_memory = true, bool async = false);
+    ~Alethe_tracer() override = default;
+
+    void trivial_proof() override;
+    void begin_proof(Database const&) override;
+    void init_conflict(Clause const&, Conflict_explanation&&) override;
+    void resolve_conflict(Clause_id conflict, Clause_id other) override;
+    void rename_conflict(Clause_id from, Clause_id to) override;
+    void finish_conflicts() override;
+    void learn_clause(Clause const&) override;
+    void delete_clause(Clause const& deleted) override;
+    void derive_final(Clause const& empty) override;
+    void end_proof(Database const&) override;
+    void set_printer(Term_printer* printer) override;
+    void collect_statistics(Statistics& stats) const override;
+
+    bool supports_lra() const override { return true; }
+    bool supports_uf() const override { return true; }
+
+private:
+    enum class Rule : std::uint8_t {
+        assume,
+        or_rule,
+        resolution,
+        la_generic,
+        la_disequality,
+        eq_congruent,
+        eq_reflexive,
+        false_rule,
+        hole,
+    };
+
+    /** Literal in a conclusion of a proof step
+     */
+    struct Proof_literal {
+        enum Kind : std::uint8_t {
+            atom,      // atom of boolean variable `first`
+            atom_leq,  // `lhs <= rhs` where `lhs = rhs` is the atom of boolean variable `first`
+            atom_geq,  // `rhs <= lhs` where `lhs = rhs` is the atom of boolean variable `first`
+            term_eq,   // `first = second` where `first` and `second` are terms
+            term_leq,  // `first <= second` where `first` and `second` are terms
+            constant,  // `false`
+        };
+
+        Kind kind;
+        bool is_negation;
+        std::int32_t first;
+        std::int32_t second;
+    };
+
+    /** Proof step. Literals, premises, and arguments of a step are stored in shared arrays. Each
+     * step occupies a range which starts at the end of the range of the previous step.
+     */
+    struct Step {
+        Rule rule;
+        // true iff the conclusion is a single disjunction of `literals` (`(cl (or ...))`)
+        bool is_disjunction;
+        // position after the last literal in `literals`
+        std::uint32_t literals_end;
+        // position after the last premise in `premises`
+        std::uint32_t premises_end;
+        // position after the last argument in `args`
+        std::uint32_t args_end;
+    };
+
+    /** Linear resolution chain of an open conflict
+     */
+    struct Chain {
+        // id of the conflict clause
+        Clause_id conflict;
+        // first position of the chain in `chains`
+        std::size_t begin;
+        // position after the last clause of the chain in `chains`
+        std::size_t end;
+    };
+
+    // Resolution chains of open conflicts (conflicts are analyzed one at a time, so there are
+    // only a few of them and they are searched linearly)
+    std::vector<Chain> open_conflicts;
+    // Resolution chains of open conflicts (see `Frat_tracer`)
+    std::vector<Clause_id> chains;
+    // Clause id -> id of the step which concludes the clause (0 if there is no such step)
+    std::vector<std::uint32_t> clause_steps;
+
+    // steps which have not been written yet
+    std::vector<Step> steps;
+    // literals of conclusions of `steps`
+    std::vector<Proof_literal> literals;
+    // premises (step ids) of `steps`
+    std::vector<std::uint32_t> premises;
+    // arguments of `steps`
+    std::vector<Rational> args;
+    // id of the first step in `steps` (ids of written steps are smaller)
+    std::uint32_t first_step_id = 1;
+    // id of the step which derives the empty clause (0 if there is none)
+    std::uint32_t final_step = 0;
+
+    // if true, steps are kept in memory and pruned at the end of the proof
+    bool in_memory;
+    Proof_output output;
+    // translation of atoms to terms (optional)
+    Term_printer* printer = nullptr;
+    // boolean variable -> true iff its atom has been named in the output
+    std::vector<bool> named_atoms;
+
+    /** Find an open conflict
+     *
+     * @param conflict id of the conflict clause
+     * @return iterator to the chain of @p conflict or `open_conflicts.end()`
+     */
+    inline std::vector<Chain>::iterator find_conflict(Clause_id conflict)
+    {
+        return std::find_if(open_conflicts.begin(), open_conflicts.end(),
+                            [&](auto const& chain) { return chain.conflict == conflict; });
+    }
+
+    /** Get id of the step which concludes a clause (resize the map if necessary)
+     *
+     * @param id clause id
+     * @return reference to the step id (0 if the clause is not concluded by any step)
+     */
+    inline std::uint32_t& clause_step(Clause_id id)
+    {
+        if (static_cast<std::size_t>(id) >= clause_steps.size())
+        {
+            clause_steps.resize(std::max<std::size_t>(id + 1, 2 * clause_steps.size()));
+        }
+        return clause_steps[id];
+    }
+
+    /** Add a literal of a solver clause to the step which is being built
+     *
+     * @param lit literal to add
+     */
+    inline void push_literal(Literal lit)
+    {
+        literals.push_back({Proof_literal::atom, lit.is_negation(), lit.var().ord(), 0});
+    }
+
+    /** Add all literals of a solver clause to the step which is being built
+     *
+     * @param clause literals to add
+     */
+    inline void push_clause(Literals const& clause)
+    {
+        for (auto lit : clause)
+        {
+            push_literal(lit);
+        }
+    }
+
+    /** Finish the step which is being built from the literals, premises, and arguments added
+     * since the last step
+     *
+     * @param rule rule of the step
+     * @param is_disjunction if true, the conclusion is a single disjunction of the literals
+     * @return id of the new step
+     */
+    std::uint32_t add_step(Rule rule, bool is_disjunction = false);
+
+    /** Derive the empty clause from the assumption `false`
+     *
+     * @return id of the step which concludes the empty clause
+     */
+    std::uint32_t assume_false();
+
+    /** Add steps which derive a theory lemma
+     *
+     * @param conflict theory lemma
+     * @param explanation witness of @p conflict
+     * @return id of the step which concludes @p conflict
+     */
+    std::uint32_t theory_lemma(Clause const& conflict, Conflict_explanation const& explanation);
+
+    /** Add steps which derive an arithmetic lemma by `la_generic`
+     *
+     * @param conflict arithmetic lemma
+     * @param first_side Farkas coefficients aligned with @p conflict
+     * @param second_side Farkas coefficients of the other side of a split (derived from
+     * @p first_side if it is empty)
+     * @return id of the step which concludes @p conflict or 0 if the witness is invalid
+     */
+    std::uint32_t farkas_lemma(Clause const& conflict, std::vector<Rational> const& first_side,
+                               std::vector<Rational> const& second_side);
+
+    /** Add steps which derive a congruence lemma by `eq_congruent`
+     *
+     * @param conflict congruence lemma
+     * @param explanation equalities of arguments and function applications
+     * @return id of the step which concludes @p conflict or 0 if the witness is invalid
+     */
+    std::uint32_t congruence_lemma(Clause const& conflict,
+                                   conflict::Uf_congruence const& explanation);
+
+    /** Add a `la_generic` step with coefficients scaled to integers
+     *
+     * @param coefficients Farkas coefficients of literals added to the step
+     * @return id of the new step
+     */
+    std::uint32_t add_la_generic(std::span<Rational const> coefficients);
+
+    /** Add a `la_disequality` step followed by an `or` step which concludes
+     * `lhs = rhs, not lhs <= rhs, not rhs <= lhs`
+     *
+     * @param equality equality literal
+     * @param leq literal `lhs <= rhs`
+     * @param geq literal `rhs <= lhs`
+     * @return id of the `or` step
+     */
+    std::uint32_t add_la_disequality(Proof_literal equality, Proof_literal leq,
+                                     Proof_literal geq);
+
+    /** Write all steps needed for the empty clause (in memory mode) and flush the output
+     */
+    void write_proof();
+
+    /** Write a step
+     *
+     * @param index index of the step in `steps`
+     * @param id id of the step in the output
+     * @param step_ids map step id - `first_step_id` -> output id (identity if empty)
+     */
+    void write_step(std::size_t index, std::uint32_t id, std::span<std::uint32_t const> step_ids);
+
+    /** Write a literal of a conclusion
+     *
+     * @param lit literal to write
+     */
+    void write_literal(Proof_literal lit);
+
+    /** Write atom of a boolean variable (name it on its first occurrence)
+     *
+     * @param bool_var_ord ordinal number of a boolean variable
+     */
+    void write_atom(int bool_var_ord);
+
+    /**
+     * @param rule proof rule
+     * @return name of @p rule in Alethe
+     */
+    static std::string_view rule_name(Rule rule);
+
+    /** Write a rational number in SMT-LIB syntax
+     *
+     * @param value number to write
+     */
+    void write_rational(Rational const& value);
+};
+
+} // namespace yaga::proof
+
+#endif // YAGA_ALETHE_TRACER_H
@@ -2,6 +2,7 @@
 #define YAGA_CONFLICT_EXPLANATION_H
 
 #include "Rational.h"
+#include "Term_types.h"
 #include <variant>
 #include <vector>
 
@@ -12,16 +13,37 @@ namespace conflict {
 struct Boolean {};
 // Lower and upper bounds in conflict
 struct Lra_bounds {
-    // Farkas coefficients
+    // Farkas coefficients aligned with literals of the conflict clause. Each coefficient
+    // multiplies the polynomial `lhs - rhs` of the constraint of the literal's variable. The
+    // clause contains at most one positive equality. Its coefficient is signed (the lemma is split
+    // on the two strict sides of the equality) and the remaining coefficients are on equalities.
     std::vector<Rational> coefficients;
 };
 // Non-strict bounds determine a value prohibited by a disequality
 struct Lra_disequality {
-    // Farkas coefficients
+    // Farkas coefficients of the derivation from the lower bound (see `Lra_bounds`). Coefficient
+    // of the disequality selects the side of the split: `lhs < rhs` if it is positive, and
+    // `lhs > rhs` otherwise.
     std::vector<Rational> coefficients;
+    // Farkas coefficients of the derivation from the upper bound
+    std::vector<Rational> upper_coefficients;
 };
 // x... == y... but f(x...) != f(y...)
-struct Uf_congruence {};
+struct Uf_congruence {
+    /** Equality of two real terms which is represented by the arithmetic atom
+     * `scale * (lhs - rhs) = 0`
+     */
+    struct Equality {
+        terms::term_t lhs;
+        terms::term_t rhs;
+        // boolean variable of the atom or -1 if `lhs - rhs` is a constant (i.e., 0)
+        int atom_var;
+        Rational scale;
+    };
+
+    // equalities of arguments `a_i = b_i` followed by the equality `f(a...) = f(b...)`
+    std::vector<Equality> equalities;
+};
 } // namespace conflict
 
 /** Explains conflict clause origin (along with a proof / witness if necessary.)
@@ -31,4 +53,4 @@ using Conflict_explanation = std::variant<conflict::Boolean, conflict::Lra_bound
 
 } // namespace yaga::proof
 
-#endif
\ No newline at end of file
+#endif
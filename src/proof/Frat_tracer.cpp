@@ -1,22 +1,13 @@
 #include "Frat_tracer.h"
 #include <cassert>
 #include <format>
-#include <unordered_set>
+#include <utility>
 
 namespace yaga::proof {
 
-Frat_tracer::Frat_tracer(std::string const& output_path, bool binary_mode)
-    : binary_mode(binary_mode)
+Frat_tracer::Frat_tracer(std::string const& output_path, bool binary_mode, bool async)
+    : binary_mode(binary_mode), output(output_path, async)
 {
-    output.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-    if (binary_mode)
-    {
-        output.open(output_path, std::ios::binary);
-    }
-    else
-    {
-        output.open(output_path);
-    }
 }
 
 void Frat_tracer::trivial_proof()
@@ -25,6 +16,13 @@ void Frat_tracer::trivial_proof()
     write_comment("False asserted, proof trivial");
     original_clause(empty);
     final_clause(empty);
+    output.flush();
+}
+
+void Frat_tracer::collect_statistics(Statistics& stats) const
+{
+    stats.set("frat.steps", next_step_id - 1);
+    stats.set("frat.bytes", output.num_bytes());
 }
 
 void Frat_tracer::begin_proof(Database const& db)
@@ -42,35 +40,48 @@ void Frat_tracer::init_conflict(Clause const& conflict, Conflict_explanation&& e
     if (!std::holds_alternative<conflict::Boolean>(explanation))
     {
         // Theory conflict
-        assert(!clause_definitions.contains(conflict.id()));
+        assert(!is_defined(conflict.id()));
         if (!binary_mode)
         {
             theory_comment(explanation);
         }
         original_clause(conflict);
-        open_theory_conflicts.emplace(clause_definitions[conflict.id()], conflict);
+        open_theory_conflicts.emplace(definition(conflict.id()), conflict);
     }
-    assert(clause_definitions.contains(conflict.id()));
-    open_conflicts[conflict.id()] =
-        Proof_node{node::Conflict_intro{conflict.id(), std::move(explanation)}};
+    assert(is_defined(conflict.id()));
+    open_conflicts.push_back(Chain{conflict.id(), chains.size(), chains.size() + 1});
+    chains.push_back(conflict.id());
 }
 
 void Frat_tracer::resolve_conflict(Clause_id conflict, Clause_id other)
 {
-    assert(open_conflicts.contains(conflict));
-    assert(clause_definitions.contains(other));
-    open_conflicts[conflict] =
-        node::Resolution{std::make_unique<Proof_node>(std::move(open_conflicts[conflict])), other};
+    auto it = find_conflict(conflict);
+    assert(it != open_conflicts.end());
+    assert(is_defined(other));
+    auto& chain = *it;
+    if (chain.end != chains.size())
+    {
+        // Another chain was started after this one, move this chain to the end
+        auto begin = chains.size();
+        for (auto i = chain.begin; i < chain.end; ++i)
+        {
+            chains.push_back(chains[i]);
+        }
+        chain.begin = begin;
+        chain.end = chains.size();
+    }
+    chains.push_back(other);
+    ++chain.end;
 }
 
 void Frat_tracer::rename_conflict(Clause_id from, Clause_id to)
 {
-    assert(open_conflicts.contains(from));
+    auto it = find_conflict(from);
+    assert(it != open_conflicts.end());
     if (from != to)
     {
-        assert(!open_conflicts.contains(to));
-        open_conflicts[to] = std::move(open_conflicts[from]);
-        open_conflicts.erase(from);
+        assert(find_conflict(to) == open_conflicts.end());
+        it->conflict = to;
     }
 }
 
@@ -84,47 +95,49 @@ void Frat_tracer::finish_conflicts()
     }
     open_theory_conflicts.clear();
     open_conflicts.clear();
+    chains.clear();
 }
 
 void Frat_tracer::learn_clause(Clause const& learned)
 {
-    assert(open_conflicts.contains(learned.id()));
+    auto it = find_conflict(learned.id());
+    assert(it != open_conflicts.end());
     // TODO: move theory conflict introduction here?
-    auto proof = collect_resolvents(open_conflicts[learned.id()]);
-    if (proof.size() == 1 && open_theory_conflicts.contains(clause_definitions[proof.front()]))
+    auto chain = *it;
+    auto conflict_id = definition(chains[chain.begin]);
+    if (chain.end - chain.begin == 1 && open_theory_conflicts.contains(conflict_id))
     {
         // Trivial conflict analysis of theory conflict with no resolution steps
-        write_comment(
-            std::format("Theory clause {} learned as-is", clause_definitions[proof.front()]));
-        clause_definitions[learned.id()] = clause_definitions[proof.front()];
+        if (!binary_mode)
+        {
+            write_comment(std::format("Theory clause {} learned as-is", conflict_id));
+        }
+        definition(learned.id()) = conflict_id;
         // The original explanation clause is added to the database, so we don't need to clean it up
-        open_theory_conflicts.erase(clause_definitions[proof.front()]);
+        open_theory_conflicts.erase(conflict_id);
         return;
     }
     auto proof_id = next_step_id++;
-    assert(!clause_definitions.contains(learned.id()));
-    clause_definitions[learned.id()] = proof_id;
+    assert(!is_defined(learned.id()));
+    definition(learned.id()) = proof_id;
     write_command('a');
     write_unsigned(proof_id);
     write_clause(learned);
-    if (!proof.empty())
+    write_zero();
+    write_command('l');
+    // Hints are ordered from the last resolved clause to the conflict clause
+    for (auto i = chain.end; i-- > chain.begin;)
     {
-        write_zero();
-        write_command('l');
-        for (auto const& clause : proof)
-        {
-            // Signed because negative values are used in RAT steps
-            write_signed(clause_definitions[clause]);
-        }
+        // Signed because negative values are used in RAT steps
+        write_signed(clause_definitions[chains[i]]);
     }
     end_command();
 }
 
 void Frat_tracer::delete_clause(Clause const& deleted)
 {
-    assert(clause_definitions.contains(deleted.id()));
-    auto proof_id = clause_definitions.at(deleted.id());
-    clause_definitions.erase(deleted.id()); // this should be safe?
+    assert(is_defined(deleted.id()));
+    auto proof_id = std::exchange(clause_definitions[deleted.id()], 0);
     write_command('d');
     write_unsigned(proof_id);
     write_clause(deleted);
@@ -151,13 +164,14 @@ void Frat_tracer::end_proof(Database const& db)
     {
         final_clause(*it);
     }
+    output.flush();
 }
 
 void Frat_tracer::original_clause(Clause const& clause)
 {
     auto proof_id = next_step_id++;
-    assert(!clause_definitions.contains(clause.id()));
-    clause_definitions[clause.id()] = proof_id;
+    assert(!is_defined(clause.id()));
+    definition(clause.id()) = proof_id;
     write_command('o');
     write_unsigned(proof_id);
     write_clause(clause);
@@ -166,8 +180,8 @@ void Frat_tracer::original_clause(Clause const& clause)
 
 void Frat_tracer::final_clause(Clause const& clause)
 {
-    assert(clause_definitions.contains(clause.id()));
-    auto proof_id = clause_definitions.at(clause.id());
+    assert(is_defined(clause.id()));
+    auto proof_id = clause_definitions[clause.id()];
     write_command('f');
     write_unsigned(proof_id);
     write_clause(clause);
@@ -182,61 +196,46 @@ void Frat_tracer::theory_comment(Conflict_explanation const& /*explanation*/)
 
 void Frat_tracer::write_command(char cmd)
 {
-    assert(!binary_mode); // TODO: test binary mode support
     assert(cmd >= 0);
-    if (binary_mode)
-    {
-        output << cmd;
-    }
-    else
+    output.put(cmd);
+    if (!binary_mode)
     {
-        output << cmd << ' ';
+        output.put(' ');
     }
 }
 
-void Frat_tracer::write_unsigned(std::size_t value)
+void Frat_tracer::write_unsigned(std::uint64_t value)
 {
     if (binary_mode)
     {
-        while (true)
-        {
-            unsigned char byte = value & 0x7F; // take last 7 bits
-            value >>= 7;
-            if (value)
-            {
-                output << (byte | 0x80); // continuation bit
-            }
-            else
-            {
-                output << byte;
-                break;
-            }
-        }
+        output.write_varint(value);
     }
     else
     {
-        output << value << ' ';
+        output.write_decimal(static_cast<std::int64_t>(value));
+        output.put(' ');
     }
 }
 
-void Frat_tracer::write_signed(int value)
+void Frat_tracer::write_signed(std::int64_t value)
 {
     if (binary_mode)
     {
         if (value >= 0)
         {
             // n => 2n
-            write_unsigned(2 * static_cast<std::size_t>(value));
+            output.write_varint(2 * static_cast<std::uint64_t>(value));
         }
         else
         {
             // -n => 2n + 1
-            write_unsigned(2 * static_cast<std::size_t>(-value) + 1);
+            output.write_varint(2 * static_cast<std::uint64_t>(-value) + 1);
         }
     }
     else
     {
-        output << value << ' ';
+        output.write_decimal(value);
+        output.put(' ');
     }
 }
 
@@ -244,11 +243,11 @@ void Frat_tracer::write_zero()
 {
     if (binary_mode)
     {
-        output << '\0';
+        output.put('\0');
     }
     else
     {
-        output << "0 ";
+        output.write("0 ");
     }
 }
 
@@ -256,11 +255,11 @@ void Frat_tracer::end_command()
 {
     if (binary_mode)
     {
-        output << '\0';
+        output.put('\0');
     }
     else
     {
-        output << "0\n";
+        output.write("0\n");
     }
 }
 
@@ -268,7 +267,7 @@ void Frat_tracer::write_clause(Literals const& args)
 {
     for (auto const& arg : args)
     {
-        auto lit = arg.var().ord() + 1;
+        std::int64_t lit = arg.var().ord() + 1;
         if (arg.is_negation())
         {
             lit *= -1;
@@ -281,8 +280,10 @@ void Frat_tracer::write_comment(std::string const& comment)
 {
     if (!binary_mode)
     {
-        output << "c " << comment << " .\n";
+        output.write("c ");
+        output.write(comment);
+        output.write(" .\n");
     }
 }
 
-} // namespace yaga::proof
\ No newline at end of file
+} // namespace yaga::proof
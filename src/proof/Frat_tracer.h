@@ -1,13 +1,12 @@
 #ifndef YAGA_FRAT_TRACER_H
 #define YAGA_FRAT_TRACER_H
 
-#include "Proof_node.h"
+#include "Proof_output.h"
 #include "Tracer.h"
-#include <fstream>
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
 #include <map>
-#include <optional>
-#include <unordered_map>
+#include <vector>
 
 namespace yaga::proof {
 
@@ -15,11 +14,21 @@ namespace yaga::proof {
  *
  * As FRAT was made for SAT solvers, theory conflicts are modelled as assertions
  * and their correctness is not checked.
+ *
+ * In binary mode, each command is a single character followed by numbers encoded as
+ * variable-length integers (signed numbers are mapped to unsigned numbers as n => 2n and
+ * -n => 2n + 1). Comments are omitted in binary mode.
  */
 class Frat_tracer : public Tracer {
 
 public:
-    Frat_tracer(std::string const& output_path, bool binary_mode = false);
+    /** Create a tracer which writes a proof to a file
+     *
+     * @param output_path path to the proof file (compressed if it ends with `.gz` or `.xz`)
+     * @param binary_mode if true, the proof is written in the binary format
+     * @param async if true, the proof is written by a background thread
+     */
+    Frat_tracer(std::string const& output_path, bool binary_mode = false, bool async = false);
     ~Frat_tracer() override = default;
 
     void trivial_proof() override;
@@ -32,21 +41,71 @@ public:
     void delete_clause(Clause const& deleted) override;
     void derive_final(Clause const& empty) override;
     void end_proof(Database const&) override;
+    void collect_statistics(Statistics& stats) const override;
 
     bool supports_lra() const override { return true; }
     bool supports_uf() const override { return true; }
 
 private:
-    // Conflict clause id -> proof node
-    std::map<Clause_id, Proof_node> open_conflicts;
+    /** Linear resolution chain of an open conflict
+     */
+    struct Chain {
+        // id of the conflict clause
+        Clause_id conflict;
+        // first position of the chain in `chains`
+        std::size_t begin;
+        // position after the last clause of the chain in `chains`
+        std::size_t end;
+    };
+
+    // Resolution chains of open conflicts (conflicts are analyzed one at a time, so there are
+    // only a few of them and they are searched linearly)
+    std::vector<Chain> open_conflicts;
+    // Resolution chains of open conflicts. Each chain is a range which starts with the conflict
+    // clause followed by the clauses it was resolved with. The storage is reused for all conflicts.
+    std::vector<Clause_id> chains;
     // keeps track of theory conflicts for cleanup if not learned
     std::map<std::size_t, Clause> open_theory_conflicts;
-    // Clause id -> proof step id
-    std::unordered_map<Clause_id, std::size_t> clause_definitions;
+    // Clause id -> proof step id (0 if the clause is not defined in the proof)
+    std::vector<std::size_t> clause_definitions;
     bool binary_mode = false;
-    std::ofstream output;
+    Proof_output output;
     std::size_t next_step_id = 1;
 
+    /**
+     * @param id clause id
+     * @return true iff the clause is defined in the proof
+     */
+    inline bool is_defined(Clause_id id) const
+    {
+        return static_cast<std::size_t>(id) < clause_definitions.size() &&
+               clause_definitions[id] != 0;
+    }
+    /** Find an open conflict
+     *
+     * @param conflict id of the conflict clause
+     * @return iterator to the chain of @p conflict or `open_conflicts.end()`
+     */
+    inline std::vector<Chain>::iterator find_conflict(Clause_id conflict)
+    {
+        return std::find_if(open_conflicts.begin(), open_conflicts.end(),
+                            [&](auto const& chain) { return chain.conflict == conflict; });
+    }
+
+    /** Get proof step id of a clause (resize the map if necessary)
+     *
+     * @param id clause id
+     * @return reference to proof step id of the clause (0 if it is not defined)
+     */
+    inline std::size_t& definition(Clause_id id)
+    {
+        if (static_cast<std::size_t>(id) >= clause_definitions.size())
+        {
+            clause_definitions.resize(std::max<std::size_t>(id + 1, 2 * clause_definitions.size()));
+        }
+        return clause_definitions[id];
+    }
+
     /** Add an original (asserted / theory) clause
      *
      * @param clause original clause
@@ -67,17 +126,17 @@ private:
      *
      * @param cmd command character (e.g. 'o' for original clause)
      */
-    void write_command(char);
+    void write_command(char cmd);
     /** Write an unsigned integer to the output
      *
      * @param value value to write
      */
-    void write_unsigned(std::size_t);
+    void write_unsigned(std::uint64_t value);
     /** Write a signed integer to the output (encoded if in binary mode)
      *
      * @param value value to write
      */
-    void write_signed(int);
+    void write_signed(std::int64_t value);
     /** Separate command parts with a zero
      */
     void write_zero();
@@ -98,4 +157,4 @@ private:
 
 } // namespace yaga::proof
 
-#endif
\ No newline at end of file
+#endif // YAGA_FRAT_TRACER_H
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "Proof_output.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#ifdef YAGA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef YAGA_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+namespace yaga::proof {
+
+namespace {
+
+// size of blocks of compressed output
+constexpr std::size_t compressed_block_size = 1 << 16;
+
+/** Uncompressed output to a C stream
+ */
+class File_sink final : public Proof_output::Sink {
+public:
+    explicit File_sink(std::string const& path) : file(std::fopen(path.c_str(), "wb"))
+    {
+        if (file == nullptr)
+        {
+            throw std::logic_error{"Failed to open '" + path + "'."};
+        }
+        // output is already buffered by `Proof_output`
+        std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+
+    ~File_sink() override
+    {
+        if (file != nullptr)
+        {
+            std::fclose(file);
+        }
+    }
+
+    void write(std::string_view data) override
+    {
+        if (std::fwrite(data.data(), 1, data.size(), file) != data.size())
+        {
+            throw std::logic_error{"Failed to write proof output."};
+        }
+    }
+
+    void finish() override
+    {
+        auto ret = std::fclose(file);
+        file = nullptr;
+        if (ret != 0)
+        {
+            throw std::logic_error{"Failed to write proof output."};
+        }
+    }
+
+private:
+    std::FILE* file;
+};
+
+#ifdef YAGA_HAVE_ZLIB
+/** Output compressed by gzip
+ */
+class Gzip_sink final : public Proof_output::Sink {
+public:
+    explicit Gzip_sink(std::unique_ptr<Proof_output::Sink> target)
+        : target(std::move(target)), block(compressed_block_size)
+    {
+        // 16 writes a gzip header, the fastest level is enough for proofs
+        if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+            Z_OK)
+        {
+            throw std::logic_error{"Failed to initialize gzip encoder."};
+        }
+    }
+
+    ~Gzip_sink() override { deflateEnd(&stream); }
+
+    void write(std::string_view data) override
+    {
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        encode(Z_NO_FLUSH);
+    }
+
+    void finish() override
+    {
+        encode(Z_FINISH);
+        target->finish();
+    }
+
+private:
+    std::unique_ptr<Proof_output::Sink> target;
+    z_stream stream{};
+    std::vector<char> block;
+
+    // compress all input of `stream` and pass it to `target`
+    void encode(int flush)
+    {
+        int ret = Z_OK;
+        do
+        {
+            stream.next_out = reinterpret_cast<Bytef*>(block.data());
+            stream.avail_out = static_cast<uInt>(block.size());
+            ret = deflate(&stream, flush);
+            if (ret == Z_STREAM_ERROR)
+            {
+                throw std::logic_error{"Failed to compress proof output."};
+            }
+            target->write({block.data(), block.size() - stream.avail_out});
+        } while (stream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+    }
+};
+#endif // YAGA_HAVE_ZLIB
+
+#ifdef YAGA_HAVE_LZMA
+/** Output compressed by xz
+ */
+class Xz_sink final : public Proof_output::Sink {
+public:
+    explicit Xz_sink(std::unique_ptr<Proof_output::Sink> target)
+        : target(std::move(target)), block(compressed_block_size)
+    {
+        if (lzma_easy_encoder(&stream, 1, LZMA_CHECK_CRC64) != LZMA_OK)
+        {
+            throw std::logic_error{"Failed to initialize xz encoder."};
+        }
+    }
+
+    ~Xz_sink() override { lzma_end(&stream); }
+
+    void write(std::string_view data) override
+    {
+        stream.next_in = reinterpret_cast<std::uint8_t const*>(data.data());
+        stream.avail_in = data.size();
+        encode(LZMA_RUN);
+    }
+
+    void finish() override
+    {
+        encode(LZMA_FINISH);
+        target->finish();
+    }
+
+private:
+    std::unique_ptr<Proof_output::Sink> target;
+    lzma_stream stream = LZMA_STREAM_INIT;
+    std::vector<char> block;
+
+    // compress all input of `stream` and pass it to `target`
+    void encode(lzma_action action)
+    {
+        lzma_ret ret = LZMA_OK;
+        do
+        {
+            stream.next_out = reinterpret_cast<std::uint8_t*>(block.data());
+            stream.avail_out = block.size();
+            ret = lzma_code(&stream, action);
+            if (ret != LZMA_OK && ret != LZMA_STREAM_END)
+            {
+                throw std::logic_error{"Failed to compress proof output."};
+            }
+            target->write({block.data(), block.size() - stream.avail_out});
+        } while (stream.avail_out == 0 || (action == LZMA_FINISH && ret != LZMA_STREAM_END));
+    }
+};
+#endif // YAGA_HAVE_LZMA
+
+/** Open a file sink and select compression by the file extension
+ *
+ * @param path path to the output file
+ * @return sink which writes to @p path
+ */
+std::unique_ptr<Proof_output::Sink> make_sink(std::string const& path)
+{
+    std::unique_ptr<Proof_output::Sink> sink = std::make_unique<File_sink>(path);
+    if (path.ends_with(".gz"))
+    {
+#ifdef YAGA_HAVE_ZLIB
+        sink = std::make_unique<Gzip_sink>(std::move(sink));
+#else
+        throw std::logic_error{"Writing gzip output requires yaga built with zlib."};
+#endif
+    }
+    else if (path.ends_with(".xz"))
+    {
+#ifdef YAGA_HAVE_LZMA
+        sink = std::make_unique<Xz_sink>(std::move(sink));
+#else
+        throw std::logic_error{"Writing xz output requires yaga built with liblzma."};
+#endif
+    }
+    return sink;
+}
+
+} // namespace
+
+Proof_output::Proof_output(std::string const& path, bool async, std::size_t buffer_size)
+    : Proof_output(make_sink(path), async, buffer_size)
+{
+}
+
+Proof_output::Proof_output(std::unique_ptr<Sink> sink, bool async, std::size_t buffer_size)
+    : sink(std::move(sink)), buffer(std::max(buffer_size, 2 * max_decimal_length)), async(async)
+{
+    if (async)
+    {
+        pending.resize(buffer.size());
+        worker = std::thread{&Proof_output::run, this};
+    }
+}
+
+Proof_output::~Proof_output()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+        // errors cannot be reported from a destructor
+    }
+    stop();
+}
+
+void Proof_output::write(std::string_view data)
+{
+    while (!data.empty())
+    {
+        reserve(1);
+        auto count = std::min(data.size(), buffer.size() - size);
+        std::copy_n(data.data(), count, buffer.data() + size);
+        size += count;
+        data.remove_prefix(count);
+    }
+}
+
+void Proof_output::flush()
+{
+    submit();
+    if (async)
+    {
+        wait();
+    }
+}
+
+void Proof_output::close()
+{
+    if (is_closed)
+    {
+        return;
+    }
+    flush();
+    is_closed = true;
+    stop();
+    sink->finish();
+}
+
+void Proof_output::submit()
+{
+    if (is_closed && size > 0)
+    {
+        throw std::logic_error{"Proof output is closed."};
+    }
+    if (size == 0)
+    {
+        return;
+    }
+    submitted += size;
+
+    if (!async)
+    {
+        sink->write({buffer.data(), size});
+        size = 0;
+        return;
+    }
+
+    wait();
+    {
+        std::lock_guard lock{mutex};
+        std::swap(buffer, pending);
+        pending_size = size;
+        has_pending = true;
+    }
+    changed.notify_all();
+    size = 0;
+}
+
+void Proof_output::wait()
+{
+    std::unique_lock lock{mutex};
+    changed.wait(lock, [&] { return !has_pending; });
+    if (error)
+    {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+void Proof_output::stop()
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard lock{mutex};
+        is_stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+void Proof_output::run()
+{
+    std::unique_lock lock{mutex};
+    while (true)
+    {
+        changed.wait(lock, [&] { return has_pending || is_stopping; });
+        if (!has_pending)
+        {
+            break;
+        }
+
+        lock.unlock();
+        std::exception_ptr write_error;
+        try
+        {
+            sink->write({pending.data(), pending_size});
+        }
+        catch (...)
+        {
+            write_error = std::current_exception();
+        }
+        lock.lock();
+
+        if (write_error && !error)
+        {
+            error = write_error;
+        }
+        has_pending = false;
+        changed.notify_all();
+    }
+}
+
+} // namespace yaga::proof
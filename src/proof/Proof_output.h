@@ -0,0 +1,202 @@
+#ifndef YAGA_PROOF_OUTPUT_H
+#define YAGA_PROOF_OUTPUT_H
+
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace yaga::proof {
+
+/** Buffered output of proof files.
+ *
+ * Bytes are collected in a large user-space buffer which is passed to a sink when it is full. If
+ * asynchronous flushing is enabled, full buffers are written (and compressed) by a background
+ * thread while the solver fills the other buffer. Output is compressed by gzip or xz if the path
+ * ends with `.gz` or `.xz` and yaga is built with zlib or liblzma, respectively.
+ *
+ * Errors are reported by throwing `std::logic_error`.
+ */
+class Proof_output {
+public:
+    /** Destination of output bytes
+     */
+    class Sink {
+    public:
+        virtual ~Sink() = default;
+
+        /** Write a block of output
+         *
+         * @param data bytes to write
+         */
+        virtual void write(std::string_view data) = 0;
+
+        /** Write all pending data (called once after the last block)
+         */
+        virtual void finish() = 0;
+    };
+
+    // default size of the output buffer in bytes
+    static constexpr std::size_t default_buffer_size = 1 << 20;
+
+    /** Open a proof file
+     *
+     * @param path path to the output file (compressed if it ends with `.gz` or `.xz`)
+     * @param async if true, full buffers are written by a background thread
+     * @param buffer_size size of the output buffer in bytes
+     */
+    Proof_output(std::string const& path, bool async = false,
+                 std::size_t buffer_size = default_buffer_size);
+
+    /** Create buffered output to a custom sink
+     *
+     * @param sink destination of output bytes
+     * @param async if true, full buffers are written by a background thread
+     * @param buffer_size size of the output buffer in bytes
+     */
+    Proof_output(std::unique_ptr<Sink> sink, bool async = false,
+                 std::size_t buffer_size = default_buffer_size);
+
+    Proof_output(Proof_output const&) = delete;
+    Proof_output& operator=(Proof_output const&) = delete;
+
+    /** Close the output (errors are ignored, call `close()` to observe them)
+     */
+    ~Proof_output();
+
+    /** Write one byte
+     *
+     * @param c byte to write
+     */
+    inline void put(char c)
+    {
+        reserve(1);
+        buffer[size++] = c;
+    }
+
+    /** Write a sequence of bytes
+     *
+     * @param data bytes to write
+     */
+    void write(std::string_view data);
+
+    /** Write a signed integer in decimal notation
+     *
+     * @param value integer to write
+     */
+    inline void write_decimal(std::int64_t value)
+    {
+        reserve(max_decimal_length);
+        auto result = std::to_chars(buffer.data() + size, buffer.data() + buffer.size(), value);
+        size = static_cast<std::size_t>(result.ptr - buffer.data());
+    }
+
+    /** Write an unsigned integer as a variable-length sequence of bytes.
+     *
+     * Each byte contains 7 bits of the value starting with the least significant bits. The
+     * highest bit is set in all bytes except for the last one.
+     *
+     * @param value integer to write
+     */
+    inline void write_varint(std::uint64_t value)
+    {
+        reserve(max_varint_length);
+        while (value >= 0x80)
+        {
+            buffer[size++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buffer[size++] = static_cast<char>(value);
+    }
+
+    /** Pass all buffered bytes to the sink and wait until they are written
+     */
+    void flush();
+
+    /** Get number of bytes written to this output so far (including buffered bytes)
+     *
+     * @return total number of bytes
+     */
+    inline std::uint64_t num_bytes() const { return submitted + size; }
+
+    /** Flush the buffer, finish the sink, and stop the background thread.
+     *
+     * No bytes can be written after the output is closed.
+     */
+    void close();
+
+private:
+    // maximal length of a 64-bit integer in decimal notation (including sign)
+    static constexpr std::size_t max_decimal_length = 20;
+    // maximal length of a 64-bit integer encoded by `write_varint`
+    static constexpr std::size_t max_varint_length = 10;
+
+    // destination of the output
+    std::unique_ptr<Sink> sink;
+    // buffer which is being filled
+    std::vector<char> buffer;
+    // number of bytes in `buffer`
+    std::size_t size = 0;
+    // number of bytes passed to the sink (or to `worker`)
+    std::uint64_t submitted = 0;
+    // true iff `close()` has been called
+    bool is_closed = false;
+
+    // true iff full buffers are written by `worker`
+    bool async;
+    // buffer which is being written by `worker`
+    std::vector<char> pending;
+    // number of bytes in `pending`
+    std::size_t pending_size = 0;
+    // true iff `pending` contains bytes which have not been written yet
+    bool has_pending = false;
+    // true iff `worker` should stop after writing `pending`
+    bool is_stopping = false;
+    // first error thrown by `worker`
+    std::exception_ptr error;
+    // protects the state shared with `worker`
+    std::mutex mutex;
+    // signals changes of `has_pending` and `is_stopping`
+    std::condition_variable changed;
+    // background thread which writes `pending`
+    std::thread worker;
+
+    /** Make sure there is space for at least @p count bytes in the buffer
+     *
+     * @param count number of bytes
+     */
+    inline void reserve(std::size_t count)
+    {
+        if (size + count > buffer.size())
+        {
+            submit();
+        }
+    }
+
+    /** Pass the buffer to the sink (or to the background thread) and start a new buffer
+     */
+    void submit();
+
+    /** Wait until the background thread writes the pending buffer and rethrow its error
+     */
+    void wait();
+
+    /** Stop the background thread
+     */
+    void stop();
+
+    /** Main loop of the background thread
+     */
+    void run();
+};
+
+} // namespace yaga::proof
+
+#endif // YAGA_PROOF_OUTPUT_H
@@ -0,0 +1,56 @@
+#ifndef YAGA_TERM_PRINTER_H
+#define YAGA_TERM_PRINTER_H
+
+#include "Literal.h"
+#include "Term_types.h"
+#include <string>
+#include <vector>
+
+namespace yaga::proof {
+
+/** Atom of a boolean variable as it is printed in a proof
+ */
+struct Atom {
+    enum Kind {
+        boolean,     // boolean term `lhs`
+        disjunction, // disjunction of `args`
+        leq,         // arithmetic atom `lhs <= rhs`
+        lt,          // arithmetic atom `lhs < rhs`
+        eq,          // arithmetic atom `lhs = rhs`
+    };
+
+    Kind kind = boolean;
+    // term of a boolean atom or the left-hand-side of an arithmetic atom (in SMT-LIB syntax)
+    std::string lhs;
+    // right-hand-side of an arithmetic atom (in SMT-LIB syntax)
+    std::string rhs;
+    // literals of a disjunction
+    std::vector<Literal> args;
+};
+
+/** Translates solver variables and terms to SMT-LIB syntax for proofs which refer to terms.
+ *
+ * Implemented by the front-end which knows the mapping between terms and variables.
+ */
+class Term_printer {
+public:
+    virtual ~Term_printer() = default;
+
+    /** Describe atom of a boolean variable
+     *
+     * @param bool_var_ord ordinal number of a boolean variable
+     * @return atom represented by the variable
+     */
+    virtual Atom atom(int bool_var_ord) = 0;
+
+    /** Print a term in SMT-LIB syntax
+     *
+     * @param t term to print
+     * @return SMT-LIB representation of @p t
+     */
+    virtual std::string term(terms::term_t t) = 0;
+};
+
+} // namespace yaga::proof
+
+#endif // YAGA_TERM_PRINTER_H
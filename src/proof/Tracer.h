@@ -4,6 +4,8 @@
 #include "Clause.h"
 #include "Conflict_explanation.h"
 #include "Database.h"
+#include "Statistics.h"
+#include "Term_printer.h"
 
 namespace yaga::proof {
 
@@ -74,6 +76,18 @@ public:
      */
     virtual void end_proof(Database const& db) = 0;
 
+    /** Set translation of solver variables to terms (used by tracers which print terms)
+     *
+     * @param printer term printer which outlives the tracer or nullptr
+     */
+    virtual void set_printer(Term_printer*) {}
+
+    /** Copy counters of this tracer to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    virtual void collect_statistics(Statistics&) const {}
+
     virtual bool supports_lra() const = 0;
     virtual bool supports_uf() const = 0;
 };
@@ -1,4 +1,5 @@
 #include "Tracer_wrapper.h"
+#include "Alethe_tracer.h"
 #include "Frat_tracer.h"
 
 yaga::proof::Tracer_wrapper::Tracer_wrapper(Options const& opts)
@@ -13,18 +14,24 @@ yaga::proof::Tracer_wrapper::Tracer_wrapper(Options const& opts)
             {
                 path = opts.input_path + ".frat";
             }
-            tracer = std::make_unique<Frat_tracer>(path);
+            tracer = std::make_unique<Frat_tracer>(path, false, opts.proof_async);
             break;
         case Options::Proof_format::frat_binary:
             if (path.empty())
             {
                 path = opts.input_path + ".bfrat";
             }
-            tracer = std::make_unique<Frat_tracer>(path, true);
+            tracer = std::make_unique<Frat_tracer>(path, true, opts.proof_async);
             break;
         case Options::Proof_format::alethe_stream:
         case Options::Proof_format::alethe_memory:
-            throw std::runtime_error("Alethe proofs TBI");
+            if (path.empty())
+            {
+                path = opts.input_path + ".alethe";
+            }
+            tracer = std::make_unique<Alethe_tracer>(
+                path, opts.proof_format == Options::Proof_format::alethe_memory, opts.proof_async);
+            break;
         default:
             throw std::runtime_error("Unknown proof format");
         }
@@ -4,6 +4,7 @@
 #include "Options.h"
 #include "Tracer.h"
 #include <memory>
+#include <utility>
 
 namespace yaga::proof {
 
@@ -18,6 +19,7 @@ class Tracer_wrapper : public Tracer {
 public:
     Tracer_wrapper() = default;
     Tracer_wrapper(Options const& opts);
+    explicit Tracer_wrapper(std::shared_ptr<Tracer> tracer) : tracer(std::move(tracer)) {}
     Tracer_wrapper(Tracer_wrapper const& other) : tracer(other.tracer) {};
     ~Tracer_wrapper() override = default;
     Tracer_wrapper& operator=(Tracer_wrapper const&) = default;
@@ -94,6 +96,20 @@ public:
             tracer->end_proof(db);
         }
     }
+    void set_printer(Term_printer* printer) override
+    {
+        if (tracer)
+        {
+            tracer->set_printer(printer);
+        }
+    }
+    void collect_statistics(Statistics& stats) const override
+    {
+        if (tracer)
+        {
+            tracer->collect_statistics(stats);
+        }
+    }
     bool supports_lra() const override { return tracer ? tracer->supports_lra() : true; }
     bool supports_uf() const override { return tracer ? tracer->supports_uf() : true; }
 
@@ -1,22 +1,24 @@
 #include <algorithm>
 #include <chrono>
-#include <cctype>
-#include <fstream>
+#include <cstdlib>
+#include <deque>
+#include <exception>
 #include <iostream>
-#include <sstream>
+#include <optional>
 #include <string>
 
 #include "Bool_theory.h"
+#include "Cube_and_conquer.h"
+#include "Dimacs_reader.h"
 #include "Evsids.h"
 #include "Restart.h"
 #include "Solver.h"
 
 using namespace yaga;
 
-bool is_satisfying(Trail const& trail, Database const& db)
+bool is_satisfying(Model<bool> const& model, std::deque<Clause> const& clauses)
 {
-    auto const& model = trail.model<bool>(Variable::boolean);
-    return std::all_of(db.asserted().begin(), db.asserted().end(), [&](auto const& clause) {
+    return std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
         return std::any_of(clause.begin(), clause.end(), [&](auto lit) {
             return model.is_defined(lit.var().ord()) &&
                    model.value(lit.var().ord()) == !lit.is_negation();
@@ -24,113 +26,103 @@ bool is_satisfying(Trail const& trail, Database const& db)
     });
 }
 
-int main(int argc, char** argv)
+void setup(Solver& solver)
 {
-    if (argc != 2)
-    {
-        std::cerr << "Usage: ./sat [input-path.cnf]" << std::endl;
-        return -1;
-    }
-
-    Solver solver;
     solver.set_theory<Bool_theory>();
     solver.set_variable_order<Evsids>();
     solver.set_restart_policy<Glucose_restart>();
+}
 
-    std::string path{argv[1]};
-    std::ifstream input{path};
-    bool is_initialized = false;
-    int num_vars = 0;
-    int num_clauses = 0;
-    Clause buffer;
-    std::string line;
-    while (std::getline(input, line))
+int main(int argc, char** argv)
+{
+    bool preprocess = false;
+    Cube_and_conquer::Options parallel_options;
+    std::string path;
+    bool is_valid = true;
+    for (int i = 1; i < argc && is_valid; ++i)
     {
-        line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](auto c) {
-            return !std::isspace(c);
-        }));
-
-        std::istringstream stream{line};
-        if (line.starts_with('c'))
+        std::string arg{argv[i]};
+        if (arg == "--preprocess")
         {
-            continue;
+            preprocess = true;
         }
-        else if (line.starts_with("p cnf"))
+        else if (arg == "--workers" && i + 1 < argc)
         {
-            if (is_initialized)
-            {
-                std::cerr << "Error: duplicate DIMACS problem line 'p cnf ...'\n";
-                return -1;
-            }
-            is_initialized = true;
-            stream.seekg(5);
-            if (!(stream >> num_vars >> num_clauses))
-            {
-                std::cerr << "Error: failed to parse the DIMACS problem line." 
-                    << " Expected: 'p cnf [num_vars] [num_clauses]'\n";
-                return -1;
-            }
-            solver.trail().set_model<bool>(Variable::boolean, num_vars);
+            parallel_options.num_workers = std::atoi(argv[++i]);
+            is_valid = parallel_options.num_workers > 0;
+        }
+        else if (arg == "--share" && i + 1 < argc)
+        {
+            parallel_options.max_shared_size = std::atoi(argv[++i]);
+            is_valid = parallel_options.max_shared_size >= 0;
+        }
+        else if (path.empty())
+        {
+            path = arg;
         }
         else
         {
-            int var;
-            while (stream >> var)
-            {
-                if (!is_initialized)
-                {
-                    std::cerr << "Error: clause before DIMACS problem line.\n";
-                    return -1;
-                }
-                else if (var > num_vars || var < -num_vars)
-                {
-                    std::cerr << "Error: unkown literal " << var << "\n";
-                    return -1;
-                }
-
-                if (var == 0)
-                {
-                    if (num_clauses > 0 && buffer.empty())
-                    {
-                        std::cout << "UNSAT\n";
-                        return 0;
-                    }
-
-                    if (num_clauses > 0)
-                    {
-                        solver.db().assert_clause(std::move(buffer));
-                    }
-                    buffer.clear();
-                    --num_clauses;
-                }
-                else
-                {
-                    buffer.emplace_back(var < 0 ? ~Literal{-var - 1} : Literal{var - 1});
-                }
-            }
+            is_valid = false;
         }
     }
 
-    if (!is_initialized)
+    bool is_parallel = parallel_options.num_workers > 1;
+    if (!is_valid || path.empty() || (is_parallel && preprocess))
     {
-        std::cerr << "Error: missing DIMANCS problem line. " 
-            << "Expected 'p cnf [num_vars] [num_clauses]'\n";
+        std::cerr << "Usage: ./sat [--preprocess | --workers N [--share N]] [input-path.cnf]"
+                  << std::endl;
         return -1;
     }
 
-    if (num_clauses > 0)
+    Solver solver;
+    setup(solver);
+    solver.set_preprocessing(preprocess);
+
+    try
+    {
+        Dimacs_reader reader;
+        if (reader.read_file(path, solver).has_empty_clause)
+        {
+            std::cout << "UNSAT\n";
+            return 0;
+        }
+    }
+    catch (std::exception const& e)
     {
-        std::cerr << "Error: insufficient number of clauses.\n";
+        std::cerr << "Error: " << e.what() << "\n";
         return -1;
     }
 
+    // preprocessing modifies asserted clauses so the model is checked against a copy
+    std::optional<std::deque<Clause>> input_copy;
+    if (preprocess)
+    {
+        input_copy = solver.db().asserted();
+    }
+    auto const& input_clauses = input_copy ? input_copy.value() : solver.db().asserted();
+
+    // each worker copies clauses of the solver which has read the input
+    Cube_and_conquer parallel{
+        [&](Solver& worker) {
+            setup(worker);
+            auto num_vars = solver.trail().model<bool>(Variable::boolean).num_vars();
+            worker.trail().set_model<bool>(Variable::boolean, static_cast<int>(num_vars));
+            for (auto const& clause : solver.db().asserted())
+            {
+                worker.db().assert_clause(clause);
+            }
+        },
+        parallel_options};
+
     auto begin = std::chrono::steady_clock::now();
-    auto result = solver.check();
+    auto result = is_parallel ? parallel.solve() : solver.check();
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
     if (result == Solver::Result::sat)
     {
-        if (is_satisfying(solver.trail(), solver.db()))
+        auto const& model =
+            is_parallel ? parallel.model() : solver.trail().model<bool>(Variable::boolean);
+        if (is_satisfying(model, input_clauses))
         {
             std::cout << "SAT\n";
         }
@@ -140,16 +132,35 @@ int main(int argc, char** argv)
             return -2;
         }
     }
-    else
+    else if (result == Solver::Result::unsat)
     {
         std::cout << "UNSAT\n";
     }
+    else
+    {
+        std::cout << "UNKNOWN\n";
+    }
 
     std::cout << "\n";
     std::cout << "time[s] = " << (duration.count() / 1e9) << "\n";
-    std::cout << "conflicts = " << solver.num_conflicts() << "\n";
-    std::cout << "decisions = " << solver.num_decisions() << "\n";
-    std::cout << "restarts = " << solver.num_restarts() << "\n";
+    if (is_parallel)
+    {
+        std::cout << "cubes = " << parallel.num_cubes() << "\n";
+        std::cout << "splits = " << parallel.num_splits() << "\n";
+        std::cout << "shared clauses = " << parallel.num_shared_clauses() << "\n";
+    }
+    else
+    {
+        std::cout << "conflicts = " << solver.num_conflicts() << "\n";
+        std::cout << "decisions = " << solver.num_decisions() << "\n";
+        std::cout << "restarts = " << solver.num_restarts() << "\n";
+    }
+    if (preprocess)
+    {
+        std::cout << "eliminated = " << solver.preprocessor().num_eliminated() << "\n";
+        std::cout << "substituted = " << solver.preprocessor().num_substituted() << "\n";
+        std::cout << "failed literals = " << solver.preprocessor().num_failed() << "\n";
+    }
 
     return result == Solver::Result::sat ? 1 : 0;
 }
\ No newline at end of file
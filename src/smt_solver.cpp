@@ -1,7 +1,9 @@
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -10,15 +12,47 @@
 
 using namespace yaga;
 
+// parse a non-negative number of an option (e.g., `--time-limit 1.5`)
+std::optional<double> parse_limit(std::string const& value)
+{
+    char* end = nullptr;
+    auto result = std::strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || !(result >= 0))
+    {
+        return {};
+    }
+    return result;
+}
+
 void print_help()
 {
     std::cerr << "Usage: ./smt [options] [input-path.smt2]" << std::endl;
     std::cerr << "Options:\n";
     std::cerr << "   --print-stats: print solver counters like the number of conflicts.\n";
+    std::cerr << "   --stats-json <path>: write solver counters and timers as JSON (- for stderr).\n";
     std::cerr << "   --prop-rational: decide rational variables with only one allowed value first.\n";
     std::cerr << "   --deduce-bounds: derive new bounds in LRA using Fourier-Motzkin elimination.\n";
-    std::cerr << "   --phase [positive|negative|cache]: value selection strategy for Boolean variables.\n";
-    // TODO: add help for proof production options
+    std::cerr << "   --gc-derived: remove unused derived LRA constraints at restart.\n";
+    std::cerr << "   --simplex: check feasibility of asserted LRA constraints using simplex.\n";
+    std::cerr << "   --preprocess: eliminate equalities and propagate bounds before solving.\n";
+    std::cerr << "   --sat-preprocess: eliminate Boolean variables and probe literals before solving.\n";
+    std::cerr << "   --vivify: strengthen learned clauses with a low LBD on restart.\n";
+    std::cerr << "   --flatten: assert top-level conjunctions and nested disjunctions as flat clauses.\n";
+    std::cerr << "   --phase [positive|negative|cache|target]: value selection strategy for Boolean variables.\n";
+    std::cerr << "   --restart [glucose|luby|reluctant|geometric]: restart policy.\n";
+    std::cerr << "   --reuse-trail: keep decisions which would be repeated after a restart.\n";
+    std::cerr << "   --mode-switch: alternate between focused (VMTF) and stable (VSIDS) search modes.\n";
+    std::cerr << "   --conflict-limit <n>: answer unknown after n conflicts.\n";
+    std::cerr << "   --decision-limit <n>: answer unknown after n decisions.\n";
+    std::cerr << "   --propagation-limit <n>: answer unknown after n propagated variables.\n";
+    std::cerr << "   --time-limit <seconds>: answer unknown if check-sat takes longer.\n";
+    std::cerr << "   --memory-limit <MiB>: answer unknown if the process uses more memory.\n";
+    std::cerr << "   --frat: write a FRAT proof if the formula is unsatisfiable.\n";
+    std::cerr << "   --frat-binary: write a binary FRAT proof if the formula is unsatisfiable.\n";
+    std::cerr << "   --alethe: write an Alethe proof (pruned in memory) if the formula is unsatisfiable.\n";
+    std::cerr << "   --alethe-stream: write an Alethe proof as it is produced (not pruned).\n";
+    std::cerr << "   --proof-path <path>: proof file path (compressed if it ends with .gz or .xz).\n";
+    std::cerr << "   --proof-async: write the proof in a background thread.\n";
 }
 
 int main(int argc, char** argv)
@@ -35,10 +69,72 @@ int main(int argc, char** argv)
         {
             options.deduce_bounds = true;
         }
+        else if (arg == "--gc-derived")
+        {
+            options.collect_derived = true;
+        }
+        else if (arg == "--simplex")
+        {
+            options.simplex = true;
+        }
+        else if (arg == "--preprocess")
+        {
+            options.preprocess = true;
+        }
+        else if (arg == "--sat-preprocess")
+        {
+            options.sat_preprocess = true;
+        }
+        else if (arg == "--vivify")
+        {
+            options.vivify = true;
+        }
+        else if (arg == "--flatten")
+        {
+            options.flatten = true;
+        }
+        else if (arg == "--restart")
+        {
+            if (i + 1 < argc)
+            {
+                std::string value{argv[++i]};
+                if (value == "glucose")
+                {
+                    options.restart = Options::Restart_policy::glucose;
+                }
+                else if (value == "luby")
+                {
+                    options.restart = Options::Restart_policy::luby;
+                }
+                else if (value == "reluctant")
+                {
+                    options.restart = Options::Restart_policy::reluctant_doubling;
+                }
+                else if (value == "geometric")
+                {
+                    options.restart = Options::Restart_policy::geometric;
+                }
+            }
+        }
+        else if (arg == "--reuse-trail")
+        {
+            options.trail_reuse = true;
+        }
+        else if (arg == "--mode-switch")
+        {
+            options.mode_switch = true;
+        }
         else if (arg == "--print-stats")
         {
             options.print_stats = true;
         }
+        else if (arg == "--stats-json")
+        {
+            if (i + 1 < argc)
+            {
+                options.stats_path = argv[++i];
+            }
+        }
         else if (arg == "--phase")
         {
             if (i + 1 < argc)
@@ -56,6 +152,10 @@ int main(int argc, char** argv)
                 {
                     options.phase = Phase::cache;
                 }
+                else if (value == "target")
+                {
+                    options.phase = Phase::target;
+                }
             }
         }
         else if (arg == "--frat")
@@ -64,6 +164,65 @@ int main(int argc, char** argv)
             options.produce_proofs = true;
             options.proof_format = Options::Proof_format::frat_ascii;
         }
+        else if (arg == "--frat-binary")
+        {
+            options.produce_proofs = true;
+            options.proof_format = Options::Proof_format::frat_binary;
+        }
+        else if (arg == "--alethe")
+        {
+            options.produce_proofs = true;
+            options.proof_format = Options::Proof_format::alethe_memory;
+        }
+        else if (arg == "--alethe-stream")
+        {
+            options.produce_proofs = true;
+            options.proof_format = Options::Proof_format::alethe_stream;
+        }
+        else if (arg == "--proof-path")
+        {
+            if (i + 1 < argc)
+            {
+                options.proof_path = argv[++i];
+            }
+        }
+        else if (arg == "--proof-async")
+        {
+            options.proof_async = true;
+        }
+        else if (arg == "--conflict-limit" || arg == "--decision-limit" ||
+                 arg == "--propagation-limit" || arg == "--time-limit" ||
+                 arg == "--memory-limit")
+        {
+            auto value = i + 1 < argc ? parse_limit(argv[++i]) : std::nullopt;
+            if (!value)
+            {
+                std::cerr << "Invalid value of option '" << arg << "'\n";
+                print_help();
+                return -1;
+            }
+
+            if (arg == "--conflict-limit")
+            {
+                options.conflict_limit = static_cast<std::uint64_t>(value.value());
+            }
+            else if (arg == "--decision-limit")
+            {
+                options.decision_limit = static_cast<std::uint64_t>(value.value());
+            }
+            else if (arg == "--propagation-limit")
+            {
+                options.propagation_limit = static_cast<std::uint64_t>(value.value());
+            }
+            else if (arg == "--time-limit")
+            {
+                options.time_limit = value.value();
+            }
+            else
+            {
+                options.memory_limit = static_cast<std::uint64_t>(value.value());
+            }
+        }
         else if (arg.starts_with("-"))
         {
             std::cerr << "Unrecognized option: '" << arg << "'\n";
@@ -1,6 +1,7 @@
 #ifndef YAGA_ARITHMETIC_POLYNOMIAL_H
 #define YAGA_ARITHMETIC_POLYNOMIAL_H
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <functional>
@@ -40,8 +41,14 @@ private:
 
 public:
     void add_term(TVar var, Rational coeff);
+
+    /* Append a monomial in any order. The polynomial has to be normalized by `normalize()` before it is used */
+    void append_term(TVar var, Rational coeff);
+
+    /* Sort monomials by variable, combine monomials with the same variable and remove zero monomials */
+    void normalize();
     std::size_t size() const;
-    Rational & get_coeff(TVar var) const;
+    Rational const& get_coeff(TVar var) const;
     Rational remove_var(TVar var);
     void negate();
     void divide_by(Rational const& r);
@@ -187,9 +194,44 @@ template <typename TVar> void Polynomial<TVar>::add_term(TVar var, Rational coef
     poly.insert(it, std::move(term));
 }
 
+template <typename TVar> void Polynomial<TVar>::append_term(TVar var, Rational coeff)
+{
+    poly.emplace_back(var, std::move(coeff));
+}
+
+template <typename TVar> void Polynomial<TVar>::normalize()
+{
+    std::sort(poly.begin(), poly.end(), Term_comparator{});
+
+    // combine monomials with the same variable in place
+    std::size_t size = 0;
+    for (auto& term : poly)
+    {
+        if (size > 0 && poly[size - 1].var == term.var)
+        {
+            poly[size - 1].coeff += term.coeff;
+            continue;
+        }
+        if (size > 0 && is_zero(poly[size - 1].coeff))
+        {
+            --size; // overwrite the cancelled monomial
+        }
+        if (&poly[size] != &term)
+        {
+            poly[size] = std::move(term);
+        }
+        ++size;
+    }
+    if (size > 0 && is_zero(poly[size - 1].coeff))
+    {
+        --size;
+    }
+    poly.erase(poly.begin() + size, poly.end());
+}
+
 template <typename TVar> unsigned long Polynomial<TVar>::size() const { return poly.size(); }
 
-template <typename TVar> Rational& Polynomial<TVar>::get_coeff(TVar var) const
+template <typename TVar> Rational const& Polynomial<TVar>::get_coeff(TVar var) const
 {
     assert(contains(var));
     return find_term_for_var(var)->coeff;
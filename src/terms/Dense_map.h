@@ -0,0 +1,140 @@
+#ifndef YAGA_DENSE_MAP_H
+#define YAGA_DENSE_MAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace yaga::terms {
+
+/**
+ * Set of small non-negative integers (e.g., term indices) stored as a dense array of stamps.
+ *
+ * A key is in the set iff its stamp is equal to the current epoch, so the set is cleared in O(1)
+ * by incrementing the epoch.
+ */
+class Dense_set {
+public:
+    /**
+     * @param key key to look up
+     * @return true iff @p key is in the set
+     */
+    inline bool contains(std::size_t key) const
+    {
+        return key < stamps.size() && stamps[key] == epoch;
+    }
+
+    /** Add @p key to the set
+     *
+     * @param key key to add
+     */
+    inline void insert(std::size_t key)
+    {
+        if (key >= stamps.size())
+        {
+            resize(std::max(key + 1, 2 * stamps.size()));
+        }
+        stamps[key] = epoch;
+    }
+
+    /** Remove all keys from the set
+     */
+    inline void clear()
+    {
+        if (++epoch == 0) // wrap around
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    /** Make sure keys `0, ..., size - 1` can be inserted without allocation
+     *
+     * @param size number of keys
+     */
+    inline void resize(std::size_t size)
+    {
+        if (size > stamps.size())
+        {
+            stamps.resize(size, 0);
+        }
+    }
+
+private:
+    // map key -> epoch in which it was inserted
+    std::vector<std::uint32_t> stamps;
+    // current epoch (keys with a different stamp are not in the set)
+    std::uint32_t epoch = 1;
+};
+
+/**
+ * Map from small non-negative integers (e.g., term indices) to values stored in dense arrays.
+ *
+ * Like `Dense_set`, each entry is stamped with the epoch in which it was written so that the map
+ * can be cleared in O(1).
+ *
+ * @tparam T type of values
+ */
+template <typename T> class Dense_map {
+public:
+    /**
+     * @param key key to look up
+     * @return true iff there is a value for @p key
+     */
+    inline bool contains(std::size_t key) const { return keys.contains(key); }
+
+    /**
+     * @param key key in the map
+     * @return value of @p key
+     */
+    inline T const& operator[](std::size_t key) const
+    {
+        assert(contains(key));
+        return values[key];
+    }
+
+    /** Set value of @p key
+     *
+     * @param key key to change
+     * @param value new value of @p key
+     */
+    inline void insert(std::size_t key, T value)
+    {
+        keys.insert(key);
+        if (key >= values.size())
+        {
+            values.resize(std::max(key + 1, 2 * values.size()));
+        }
+        values[key] = std::move(value);
+    }
+
+    /** Remove all values from the map
+     */
+    inline void clear() { keys.clear(); }
+
+    /** Make sure keys `0, ..., size - 1` can be inserted without allocation
+     *
+     * @param size number of keys
+     */
+    inline void resize(std::size_t size)
+    {
+        keys.resize(size);
+        if (size > values.size())
+        {
+            values.resize(size);
+        }
+    }
+
+private:
+    // keys which have a value in the current epoch
+    Dense_set keys;
+    // map key -> value (only valid for keys in `keys`)
+    std::vector<T> values;
+};
+
+} // namespace yaga::terms
+
+#endif // YAGA_DENSE_MAP_H
@@ -0,0 +1,589 @@
+#include "Preprocessor.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "Term_rewriter.h"
+#include "Terms.h"
+
+namespace yaga::terms {
+
+namespace {
+
+// linear constraint `poly >= 0` or `poly > 0` used in bound propagation
+struct Propagated_constraint {
+    poly_t poly;
+    bool is_strict;
+    // true iff the constraint can be removed if it is implied by bounds
+    bool is_removable;
+    // index of the conjunct of this constraint
+    std::size_t index;
+};
+
+} // namespace
+
+std::vector<term_t> Preprocessor::run(std::vector<term_t> const& assertions)
+{
+    stack.clear();
+    eliminated = 0;
+    unconstrained = 0;
+    tightened = 0;
+
+    auto is_false = [](std::vector<term_t> const& conjuncts) {
+        return conjuncts.size() == 1 && conjuncts[0] == false_term;
+    };
+
+    auto conjuncts = flatten(assertions);
+    input_vars.clear();
+    for (auto const& [var, _] : count_occurrences(conjuncts))
+    {
+        input_vars.push_back(var);
+    }
+
+    for (int round = 0; round < max_rounds && !is_false(conjuncts); ++round)
+    {
+        bool changed = false;
+        for (auto step : {&Preprocessor::eliminate_equalities, &Preprocessor::remove_unconstrained,
+                          &Preprocessor::propagate_bounds})
+        {
+            changed |= (this->*step)(conjuncts);
+            conjuncts = flatten(conjuncts);
+            if (is_false(conjuncts))
+            {
+                break;
+            }
+        }
+
+        if (!changed)
+        {
+            break;
+        }
+    }
+    return conjuncts;
+}
+
+void Preprocessor::extend_model(std::unordered_map<term_t, Rational>& values)
+{
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+    {
+        auto value = evaluate(it->value, values);
+        values.insert_or_assign(it->var, std::move(value));
+    }
+
+    // variables which do not occur in the simplified assertions can have any value
+    for (term_t var : input_vars)
+    {
+        values.try_emplace(var, Rational{0});
+    }
+}
+
+std::vector<term_t> Preprocessor::flatten(std::vector<term_t> const& assertions) const
+{
+    std::vector<term_t> conjuncts;
+    std::vector<term_t> worklist{assertions.rbegin(), assertions.rend()};
+    while (!worklist.empty())
+    {
+        term_t t = worklist.back();
+        worklist.pop_back();
+
+        if (t == true_term)
+        {
+            continue;
+        }
+
+        if (t == false_term)
+        {
+            return {false_term};
+        }
+
+        // (not (or a b ...)) is (and (not a) (not b) ...)
+        if (is_negated(t) && term_manager.get_kind(t) == Kind::OR_TERM)
+        {
+            auto args = term_manager.get_args(t);
+            for (auto it = args.rbegin(); it != args.rend(); ++it)
+            {
+                worklist.push_back(opposite_term(*it));
+            }
+            continue;
+        }
+        conjuncts.push_back(t);
+    }
+    return conjuncts;
+}
+
+std::optional<Preprocessor::Linear_atom> Preprocessor::linear_atom(term_t t)
+{
+    using Predicate = Linear_atom::Predicate;
+
+    auto kind = term_manager.get_kind(t);
+    if (kind == Kind::ARITH_GE_ATOM)
+    {
+        auto poly = term_manager.term_to_poly(term_manager.get_args(t)[0]);
+        if (is_negated(t)) // p < 0 iff -p > 0
+        {
+            poly.negate();
+            return Linear_atom{std::move(poly), Predicate::gt};
+        }
+        return Linear_atom{std::move(poly), Predicate::geq};
+    }
+
+    if (kind == Kind::ARITH_EQ_ATOM || kind == Kind::ARITH_BINEQ_ATOM)
+    {
+        auto args = term_manager.get_args(t);
+        auto poly = term_manager.term_to_poly(args[0]);
+        if (kind == Kind::ARITH_BINEQ_ATOM)
+        {
+            poly.merge(term_manager.term_to_poly(args[1]), Rational{-1});
+        }
+        return Linear_atom{std::move(poly), is_negated(t) ? Predicate::neq : Predicate::eq};
+    }
+    return {};
+}
+
+bool Preprocessor::is_plain(poly_t const& poly) const
+{
+    return std::all_of(poly.begin(), poly.end(), [&](auto const& mono) {
+        return mono.var == term_t::Undef ||
+               term_manager.get_kind(mono.var) == Kind::UNINTERPRETED_TERM;
+    });
+}
+
+std::unordered_map<term_t, int>
+Preprocessor::count_occurrences(std::vector<term_t> const& conjuncts) const
+{
+    std::unordered_map<term_t, int> occurrences;
+    for (term_t conjunct : conjuncts)
+    {
+        std::unordered_set<int32_t> visited{term_manager.index_of(conjunct)};
+        std::vector<term_t> worklist{conjunct};
+        while (!worklist.empty())
+        {
+            term_t t = worklist.back();
+            worklist.pop_back();
+
+            if (term_manager.get_kind(t) == Kind::UNINTERPRETED_TERM &&
+                term_manager.get_type(t) == types::real_type)
+            {
+                ++occurrences[t];
+            }
+
+            for (term_t arg : term_manager.get_args(t))
+            {
+                if (visited.insert(term_manager.index_of(arg)).second)
+                {
+                    worklist.push_back(arg);
+                }
+            }
+        }
+    }
+    return occurrences;
+}
+
+term_t Preprocessor::solve(poly_t poly, term_t var, Rational const& target)
+{
+    auto coef = poly.remove_var(var);
+    poly.negate();
+    if (target != Rational{0})
+    {
+        poly_t constant;
+        constant.add_term(term_t::Undef, target);
+        poly.merge(constant, Rational{1});
+    }
+    poly.divide_by(coef);
+    return term_manager.poly_to_term(poly);
+}
+
+bool Preprocessor::eliminate_equalities(std::vector<term_t>& conjuncts)
+{
+    using Predicate = Linear_atom::Predicate;
+
+    auto occurrences = count_occurrences(conjuncts);
+    subst_map_t subst;
+    for (auto& conjunct : conjuncts)
+    {
+        auto atom = linear_atom(conjunct);
+        if (!atom || atom->pred != Predicate::eq)
+        {
+            continue;
+        }
+
+        // apply definitions from this round
+        if (!subst.empty())
+        {
+            conjunct = substitute(subst, conjunct);
+            atom = linear_atom(conjunct);
+            if (!atom || atom->pred != Predicate::eq)
+            {
+                continue;
+            }
+        }
+
+        if (!is_plain(atom->poly))
+        {
+            continue;
+        }
+
+        // eliminate the variable with the least number of occurrences
+        std::optional<term_t> var;
+        int size = 0;
+        for (auto const& mono : atom->poly)
+        {
+            if (mono.var == term_t::Undef)
+            {
+                continue;
+            }
+
+            ++size;
+            if (!var || occurrences[mono.var] < occurrences[*var])
+            {
+                var = mono.var;
+            }
+        }
+
+        if (!var || size - 1 > max_definition_size)
+        {
+            continue;
+        }
+
+        auto value = solve(std::move(atom->poly), *var, Rational{0});
+
+        // keep definitions of this round in terms of the remaining variables
+        subst_map_t single{{*var, value}};
+        for (auto& [_, other_value] : subst)
+        {
+            other_value = substitute(single, other_value);
+        }
+        subst.emplace(*var, value);
+
+        stack.push_back({*var, value});
+        conjunct = true_term;
+        ++eliminated;
+    }
+
+    if (subst.empty())
+    {
+        return false;
+    }
+
+    for (auto& conjunct : conjuncts)
+    {
+        conjunct = substitute(subst, conjunct);
+    }
+    return true;
+}
+
+bool Preprocessor::remove_unconstrained(std::vector<term_t>& conjuncts)
+{
+    using Predicate = Linear_atom::Predicate;
+
+    auto occurrences = count_occurrences(conjuncts);
+    bool changed = false;
+    for (auto& conjunct : conjuncts)
+    {
+        auto atom = linear_atom(conjunct);
+        if (!atom || !is_plain(atom->poly))
+        {
+            continue;
+        }
+
+        auto it = std::find_if(atom->poly.begin(), atom->poly.end(), [&](auto const& mono) {
+            return mono.var != term_t::Undef && occurrences[mono.var] == 1;
+        });
+        if (it == atom->poly.end())
+        {
+            continue;
+        }
+
+        for (auto const& mono : atom->poly)
+        {
+            if (mono.var != term_t::Undef)
+            {
+                --occurrences[mono.var];
+            }
+        }
+
+        // choose a value of the polynomial which satisfies the atom
+        Rational target{atom->pred == Predicate::geq || atom->pred == Predicate::eq ? 0 : 1};
+        term_t var = it->var;
+        stack.push_back({var, solve(std::move(atom->poly), var, target)});
+        conjunct = true_term;
+        ++unconstrained;
+        changed = true;
+    }
+    return changed;
+}
+
+bool Preprocessor::propagate_bounds(std::vector<term_t>& conjuncts)
+{
+    using Predicate = Linear_atom::Predicate;
+
+    // bounds of variables (`is_derived` marks bounds tightened by propagation)
+    struct Tracked_bound {
+        Bound bound;
+        bool is_derived;
+    };
+    struct Tracked_bounds {
+        std::optional<Tracked_bound> lower;
+        std::optional<Tracked_bound> upper;
+    };
+
+    std::unordered_map<term_t, Tracked_bounds> bounds;
+    // variables in `bounds` in the order in which they have been added
+    std::vector<term_t> bounded;
+    std::vector<Propagated_constraint> constraints;
+    bool is_conflict = false;
+
+    auto bounds_of = [&](term_t var) -> Tracked_bounds& {
+        auto [it, is_new] = bounds.try_emplace(var);
+        if (is_new)
+        {
+            bounded.push_back(var);
+        }
+        return it->second;
+    };
+
+    // set a new bound of `var` if it is stronger than the current one
+    auto tighten = [&](term_t var, bool is_lower, Bound bound, bool is_derived) {
+        auto& var_bounds = bounds_of(var);
+        auto& current = is_lower ? var_bounds.lower : var_bounds.upper;
+        if (current)
+        {
+            auto const& old = current->bound;
+            if ((is_lower ? bound.value < old.value : bound.value > old.value) ||
+                (bound.value == old.value && (old.is_strict || !bound.is_strict)))
+            {
+                return false;
+            }
+        }
+        current = Tracked_bound{std::move(bound), is_derived};
+
+        auto const& lower = var_bounds.lower;
+        auto const& upper = var_bounds.upper;
+        if (lower && upper &&
+            (lower->bound.value > upper->bound.value ||
+             (lower->bound.value == upper->bound.value &&
+              (lower->bound.is_strict || upper->bound.is_strict))))
+        {
+            is_conflict = true;
+        }
+        return true;
+    };
+
+    // derive bounds of variables in `poly >= 0` (`poly > 0` if `is_strict`)
+    auto propagate = [&](poly_t const& poly, bool is_strict, bool is_derived) {
+        Rational constant{0};
+        Rational max_sum{0};
+        int num_unbounded = 0;
+        int num_strict = 0;
+        // maximal value of each monomial (none if it is unbounded)
+        std::vector<std::optional<Bound>> max_value;
+        for (auto const& mono : poly)
+        {
+            if (mono.var == term_t::Undef)
+            {
+                constant = mono.coeff;
+                max_value.emplace_back();
+                continue;
+            }
+
+            auto const& var_bounds = bounds_of(mono.var);
+            auto const& bound = mono.coeff > Rational{0} ? var_bounds.upper : var_bounds.lower;
+            if (!bound)
+            {
+                ++num_unbounded;
+                max_value.emplace_back();
+                continue;
+            }
+
+            auto value = mono.coeff * bound->bound.value;
+            max_sum += value;
+            num_strict += bound->bound.is_strict ? 1 : 0;
+            max_value.push_back(Bound{std::move(value), bound->bound.is_strict});
+        }
+
+        if (num_unbounded > 1)
+        {
+            return false;
+        }
+
+        bool changed = false;
+        std::size_t i = 0;
+        for (auto const& mono : poly)
+        {
+            auto const& mono_max = max_value[i++];
+            if (mono.var == term_t::Undef || (num_unbounded == 1 && mono_max))
+            {
+                continue;
+            }
+
+            // coef * var >= -constant - (sum of the other monomials) >= -constant - rest
+            auto rest = mono_max ? max_sum - mono_max->value : max_sum;
+            auto rest_strict = num_strict - (mono_max && mono_max->is_strict ? 1 : 0) > 0;
+            auto value = (-constant - rest) / mono.coeff;
+            changed |= tighten(mono.var, mono.coeff > Rational{0},
+                               Bound{std::move(value), is_strict || rest_strict}, is_derived);
+        }
+        return changed;
+    };
+
+    // collect unit constraints and other linear constraints
+    for (std::size_t i = 0; i < conjuncts.size(); ++i)
+    {
+        auto atom = linear_atom(conjuncts[i]);
+        if (!atom || atom->pred == Predicate::neq)
+        {
+            continue;
+        }
+
+        std::vector<std::pair<poly_t, bool>> parts;
+        if (atom->pred == Predicate::eq)
+        {
+            auto negated = atom->poly;
+            negated.negate();
+            parts.emplace_back(std::move(atom->poly), false);
+            parts.emplace_back(std::move(negated), false);
+        }
+        else
+        {
+            parts.emplace_back(std::move(atom->poly), atom->pred == Predicate::gt);
+        }
+
+        for (auto& [poly, is_strict] : parts)
+        {
+            auto num_vars = std::count_if(poly.begin(), poly.end(), [](auto const& mono) {
+                return mono.var != term_t::Undef;
+            });
+            if (num_vars == 1)
+            {
+                propagate(poly, is_strict, /*is_derived=*/false);
+            }
+            else if (num_vars > 1)
+            {
+                constraints.push_back({std::move(poly), is_strict,
+                                       /*is_removable=*/atom->pred != Predicate::eq, i});
+            }
+        }
+    }
+
+    if (constraints.empty() && !is_conflict)
+    {
+        return false;
+    }
+
+    for (int round = 0; round < max_rounds && !is_conflict; ++round)
+    {
+        bool changed = false;
+        for (auto const& cons : constraints)
+        {
+            changed |= propagate(cons.poly, cons.is_strict, /*is_derived=*/true);
+            if (is_conflict)
+            {
+                break;
+            }
+        }
+
+        if (!changed)
+        {
+            break;
+        }
+    }
+
+    if (is_conflict)
+    {
+        conjuncts.assign(1, false_term);
+        return true;
+    }
+
+    // remove constraints implied by the bounds
+    bool changed = false;
+    for (auto const& cons : constraints)
+    {
+        if (!cons.is_removable)
+        {
+            continue;
+        }
+
+        Rational min_sum{0};
+        bool is_min_strict = false;
+        bool is_bounded = true;
+        for (auto const& mono : cons.poly)
+        {
+            if (mono.var == term_t::Undef)
+            {
+                min_sum += mono.coeff;
+                continue;
+            }
+
+            auto const& var_bounds = bounds_of(mono.var);
+            auto const& bound = mono.coeff > Rational{0} ? var_bounds.lower : var_bounds.upper;
+            if (!bound)
+            {
+                is_bounded = false;
+                break;
+            }
+            min_sum += mono.coeff * bound->bound.value;
+            is_min_strict |= bound->bound.is_strict;
+        }
+
+        if (is_bounded && (min_sum > Rational{0} ||
+                           (min_sum == Rational{0} && (!cons.is_strict || is_min_strict))))
+        {
+            conjuncts[cons.index] = true_term;
+            changed = true;
+        }
+    }
+
+    // assert derived bounds (variables with a single allowed value are eliminated next round)
+    for (term_t var : bounded)
+    {
+        auto const& [lower, upper] = bounds.at(var);
+        if (lower && upper && lower->bound.value == upper->bound.value &&
+            term_manager.get_kind(var) == Kind::UNINTERPRETED_TERM)
+        {
+            auto value = term_manager.mk_arithmetic_constant(lower->bound.value);
+            conjuncts.push_back(term_manager.mk_arithmetic_eq(var, value));
+            changed = true;
+            continue;
+        }
+
+        if (lower && lower->is_derived)
+        {
+            auto value = term_manager.mk_arithmetic_constant(lower->bound.value);
+            conjuncts.push_back(lower->bound.is_strict
+                                    ? term_manager.mk_arithmetic_gt(var, value)
+                                    : term_manager.mk_arithmetic_geq(var, value));
+            ++tightened;
+            changed = true;
+        }
+
+        if (upper && upper->is_derived)
+        {
+            auto value = term_manager.mk_arithmetic_constant(upper->bound.value);
+            conjuncts.push_back(upper->bound.is_strict
+                                    ? term_manager.mk_arithmetic_lt(var, value)
+                                    : term_manager.mk_arithmetic_leq(var, value));
+            ++tightened;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+Rational Preprocessor::evaluate(term_t t, std::unordered_map<term_t, Rational>& values)
+{
+    Rational result{0};
+    for (auto const& mono : term_manager.term_to_poly(t))
+    {
+        if (mono.var == term_t::Undef)
+        {
+            result += mono.coeff;
+        }
+        else
+        {
+            result += mono.coeff * values.try_emplace(mono.var, Rational{0}).first->second;
+        }
+    }
+    return result;
+}
+
+} // namespace yaga::terms
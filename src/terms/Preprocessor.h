@@ -0,0 +1,218 @@
+#ifndef YAGA_PREPROCESSOR_H
+#define YAGA_PREPROCESSOR_H
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Rational.h"
+#include "Term_manager.h"
+#include "Term_rewriter.h"
+#include "Term_types.h"
+
+namespace yaga::terms {
+
+/**
+ * Simplification of top-level assertions in linear real arithmetic before they are internalized.
+ *
+ * The preprocessor repeats the following steps until the assertions do not change:
+ * 1. Gaussian elimination: a top-level linear equality `c*x + p = 0` is removed and `x` is
+ *    replaced with `-p/c` everywhere.
+ * 2. Removal of unconstrained variables: a top-level linear atom with a variable `x` which does
+ *    not occur in any other assertion can always be satisfied by choosing a value of `x`, so it is
+ *    removed.
+ * 3. Bound propagation: bounds from unit constraints (e.g., `x <= 5`) are propagated through
+ *    top-level linear constraints to a fixpoint. Tightened bounds are asserted, constraints
+ *    implied by the bounds are removed, and variables with equal lower and upper bound are
+ *    eliminated in the next round.
+ *
+ * Each removed variable is recorded with a definition over the remaining variables. Definitions
+ * are evaluated in reverse order by `extend_model()` to extend a model of the reduced assertions to
+ * a model of the original assertions.
+ *
+ * Only uninterpreted real constants are eliminated. Assertions are expected to be free of
+ * uninterpreted functions.
+ */
+class Preprocessor {
+public:
+    /**
+     * Variable removed by the preprocessor
+     */
+    struct Definition {
+        // removed variable
+        term_t var;
+        // linear term over variables removed later or not at all
+        term_t value;
+    };
+
+    explicit Preprocessor(Term_manager& term_manager) : term_manager(term_manager), substitute(term_manager) {}
+
+    /**
+     * Simplify a list of assertions.
+     *
+     * Definitions from the previous call are discarded.
+     *
+     * @param assertions list of top-level assertions
+     * @return list of simplified assertions which is equisatisfiable with @p assertions
+     * (`{false_term}` if the assertions are found to be unsatisfiable)
+     */
+    std::vector<term_t> run(std::vector<term_t> const& assertions);
+
+    /**
+     * Assign values to variables removed by the last `run()`.
+     *
+     * Variables which occur in definitions or in the original assertions but which have no value in
+     * @p values are assigned 0.
+     *
+     * @param values model of the simplified assertions (map uninterpreted real constant -> value)
+     * which is extended to a model of the original assertions
+     */
+    void extend_model(std::unordered_map<term_t, Rational>& values);
+
+    /**
+     * Get definitions of removed variables (the model-reconstruction stack)
+     *
+     * @return definitions in the order in which the variables have been removed
+     */
+    inline std::vector<Definition> const& definitions() const { return stack; }
+
+    /**
+     * Set maximal number of preprocessing rounds and maximal number of bound propagation rounds
+     *
+     * @param rounds maximal number of rounds
+     */
+    inline void set_max_rounds(int rounds) { max_rounds = rounds; }
+
+    /**
+     * Set maximal number of variables in a definition of an eliminated variable
+     *
+     * Longer equalities are not used for elimination to limit growth of the assertions.
+     *
+     * @param size maximal number of variables
+     */
+    inline void set_max_definition_size(int size) { max_definition_size = size; }
+
+    /**
+     * @return number of variables eliminated using equalities by the last `run()`
+     */
+    inline int num_eliminated() const { return eliminated; }
+
+    /**
+     * @return number of unconstrained variables removed by the last `run()`
+     */
+    inline int num_unconstrained() const { return unconstrained; }
+
+    /**
+     * @return number of bounds tightened by bound propagation in the last `run()`
+     */
+    inline int num_tightened() const { return tightened; }
+
+private:
+    // linear atom `poly pred 0`
+    struct Linear_atom {
+        enum class Predicate { geq, gt, eq, neq };
+
+        poly_t poly;
+        Predicate pred;
+    };
+
+    struct Bound {
+        Rational value;
+        bool is_strict;
+    };
+
+    Term_manager& term_manager;
+    // substitution of definitions of eliminated variables
+    Variable_substitution substitute;
+    // model-reconstruction stack
+    std::vector<Definition> stack;
+    // uninterpreted real constants in the original assertions
+    std::vector<term_t> input_vars;
+    // maximal number of preprocessing (and bound propagation) rounds
+    int max_rounds = 8;
+    // maximal number of variables in a definition
+    int max_definition_size = 16;
+    // statistics of the last run
+    int eliminated = 0;
+    int unconstrained = 0;
+    int tightened = 0;
+
+    /**
+     * Split top-level conjunctions and remove `true` terms.
+     *
+     * @param assertions list of assertions
+     * @return list of conjuncts or `{false_term}` if some conjunct is `false`
+     */
+    std::vector<term_t> flatten(std::vector<term_t> const& assertions) const;
+
+    /**
+     * Convert a term to a linear atom
+     *
+     * @param t boolean term
+     * @return linear atom equivalent to @p t or none if @p t is not an arithmetic atom
+     */
+    std::optional<Linear_atom> linear_atom(term_t t);
+
+    /**
+     * Check whether all variables of a polynomial are uninterpreted real constants
+     *
+     * @param poly polynomial
+     * @return true iff @p poly does not contain other variable-like terms (e.g., ITE)
+     */
+    bool is_plain(poly_t const& poly) const;
+
+    /**
+     * Count the number of conjuncts in which each uninterpreted real constant occurs
+     *
+     * @param conjuncts list of conjuncts
+     * @return map uninterpreted real constant -> number of conjuncts
+     */
+    std::unordered_map<term_t, int> count_occurrences(std::vector<term_t> const& conjuncts) const;
+
+    /**
+     * Solve `poly + c*var = target` for @p var
+     *
+     * @param poly linear polynomial
+     * @param var variable in @p poly
+     * @param target constant on the right-hand side
+     * @return term equal to `(target - (poly - c*var)) / c`
+     */
+    term_t solve(poly_t poly, term_t var, Rational const& target);
+
+    /**
+     * Eliminate variables using top-level equalities
+     *
+     * @param conjuncts list of conjuncts which is modified in place
+     * @return true iff some variable has been eliminated
+     */
+    bool eliminate_equalities(std::vector<term_t>& conjuncts);
+
+    /**
+     * Remove top-level atoms with a variable which does not occur anywhere else
+     *
+     * @param conjuncts list of conjuncts which is modified in place
+     * @return true iff some atom has been removed
+     */
+    bool remove_unconstrained(std::vector<term_t>& conjuncts);
+
+    /**
+     * Propagate bounds from unit constraints through top-level linear constraints
+     *
+     * @param conjuncts list of conjuncts which is modified in place
+     * @return true iff some conjunct has been added or removed
+     */
+    bool propagate_bounds(std::vector<term_t>& conjuncts);
+
+    /**
+     * Evaluate a linear term
+     *
+     * @param t linear term
+     * @param values values of variables (missing variables are assigned 0)
+     * @return value of @p t
+     */
+    Rational evaluate(term_t t, std::unordered_map<term_t, Rational>& values);
+};
+
+} // namespace yaga::terms
+
+#endif // YAGA_PREPROCESSOR_H
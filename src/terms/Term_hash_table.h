@@ -3,8 +3,9 @@
 
 #include "Term_types.h"
 
+#include <cstddef>
 #include <span>
-#include <unordered_set>
+#include <vector>
 
 #include <Rational.h>
 
@@ -47,36 +48,57 @@ struct Rational_proxy : public Term_hash_proxy
         Term_hash_proxy(Kind::ARITH_CONSTANT, types::real_type, hash, termTable), value(value) {}
 };
 
+/**
+ * Hash table of all terms in a term table which is used for hash consing.
+ *
+ * Terms are stored in a flat open-addressing table with linear probing. Each slot stores the lower
+ * 32 bits of the hash of the term, so most mismatches are resolved without looking at the term.
+ * Terms are never removed from the table.
+ */
 class Term_hash_table {
 public:
     [[nodiscard]] term_t get_composite_term(Composite_term_proxy const& proxy);
     [[nodiscard]] term_t get_rational_term(Rational_proxy const& proxy);
     [[nodiscard]] term_t get_constant_term(Constant_term_proxy const& proxy);
 
+    /**
+     * @return number of terms in the table
+     */
+    [[nodiscard]] std::size_t size() const { return num_terms; }
+
 private:
     struct Entry {
-        uint64_t hash;
-        term_t term;
-    };
-
-    struct Hash {
-        using is_transparent = void;
-        uint64_t operator()(Entry const& entry) const { return entry.hash; }
-        uint64_t operator()(Term_hash_proxy const& proxy) const { return proxy.hash; }
-    };
-
-    struct KeyEqual {
-        using is_transparent = void;
-        bool operator()(Entry const& proxy, Entry const& entry) const;
-        bool operator()(Composite_term_proxy const& proxy, Entry const& entry) const;
-        bool operator()(Constant_term_proxy const& proxy, Entry const& entry) const;
-        bool operator()(Rational_proxy const& proxy, Entry const& entry) const;
-        bool operator()(Entry const& entry, Composite_term_proxy const& proxy) const { return this->operator()(proxy, entry); }
-        bool operator()(Entry const& entry, Constant_term_proxy const& proxy) const { return this->operator()(proxy, entry); }
-        bool operator()(Entry const& entry, Rational_proxy const& proxy) const { return this->operator()(proxy, entry); }
+        // lower 32 bits of the hash of `term`
+        uint32_t hash;
+        // term in this slot or `null_term` if the slot is empty
+        term_t term = null_term;
     };
 
-    std::unordered_set<Entry, Hash, KeyEqual> terms;
+    // minimal number of slots
+    static constexpr std::size_t min_capacity = 1 << 10;
+
+    // slots of the table (the number of slots is a power of 2)
+    std::vector<Entry> slots;
+    // number of non-empty slots
+    std::size_t num_terms = 0;
+
+    /**
+     * Find a term which is equal to @p proxy or create it if there is no such term in the table
+     *
+     * @param proxy description of the term
+     * @param construct function which creates a new term equal to @p proxy
+     * @return term equal to @p proxy
+     */
+    template <typename Proxy, typename Construct>
+    term_t get_term(Proxy const& proxy, Construct&& construct);
+
+    // Double the number of slots (or allocate the initial table)
+    void grow();
+
+    // Check whether @p term is equal to the term described by @p proxy
+    static bool equal(Composite_term_proxy const& proxy, term_t term);
+    static bool equal(Constant_term_proxy const& proxy, term_t term);
+    static bool equal(Rational_proxy const& proxy, term_t term);
 };
 
 } // namespace yaga::terms
@@ -17,7 +17,7 @@ Term_manager::Term_manager()
 
 Term_manager::~Term_manager() = default;
 
-void Term_manager::set_term_name(term_t t, std::string const& name)
+void Term_manager::set_term_name(term_t t, std::string_view name)
 {
     term_table->set_term_name(t, name);
 }
@@ -27,7 +27,7 @@ std::optional<std::string_view> Term_manager::get_term_name(term_t t) const
     return term_table->get_term_name(t);
 }
 
-std::optional<term_t> Term_manager::get_term_by_name(std::string const& name)
+std::optional<term_t> Term_manager::get_term_by_name(std::string_view name)
 {
     return term_table->get_term_by_name(name);
 }
@@ -57,6 +57,11 @@ int32_t Term_manager::index_of(term_t term) const
     return terms::index_of(term);
 }
 
+std::size_t Term_manager::num_terms() const
+{
+    return term_table->size();
+}
+
 term_t Term_manager::positive_term(term_t term) const
 {
     return terms::positive_term(term);
@@ -159,7 +164,7 @@ term_t Term_manager::mk_term(Kind kind, std::span<term_t> args)
     }
 }
 
-term_t Term_manager::mk_term(std::string const& op, std::span<term_t> args, bool not_app /* = false */)
+term_t Term_manager::mk_term(std::string_view op, std::span<term_t> args, bool not_app /* = false */)
 {
     if (op == ">=")
     {
@@ -253,7 +258,7 @@ term_t Term_manager::mk_term(std::string const& op, std::span<term_t> args, bool
     }
     else if (not_app)
     {
-        throw std::logic_error("unknown function symbol: " + op);
+        throw std::logic_error("unknown function symbol: " + std::string{op});
     }
     else
     {
@@ -262,7 +267,7 @@ term_t Term_manager::mk_term(std::string const& op, std::span<term_t> args, bool
     UNIMPLEMENTED;
 }
 
-term_t Term_manager::mk_app(std::string const& name, type_t ret_type, std::span<term_t> args)
+term_t Term_manager::mk_app(std::string_view name, type_t ret_type, std::span<term_t> args)
 {
     auto fnc_symbol = get_term_by_name(name);
     assert(fnc_symbol.has_value());
@@ -378,36 +383,20 @@ term_t Term_manager::mk_xor(term_t t1, term_t t2)
 }
 
 
-term_t Term_manager::mk_integer_constant(std::string const& str)
+term_t Term_manager::mk_integer_constant(std::string_view str)
 {
-    Rational rat(str.c_str());
-    assert(rat.isInteger());
-    return term_table->arithmetic_constant(rat);
+    assert(str.find('.') == std::string_view::npos);
+    return term_table->arithmetic_constant(Rational::from_decimal(str));
 }
 
-term_t Term_manager::mk_rational_constant(std::string const& str)
+term_t Term_manager::mk_rational_constant(std::string_view str)
 {
-    // TODO: This should be revisited and checked if it can be improved
-    auto separator_position = str.find('.');
-    if (separator_position == std::string::npos)
-    {
-        return mk_integer_constant(str);
-    }
-    auto integral_part = str.substr(0, separator_position);
-    auto integral_value = Rational(integral_part.c_str()); // TODO: Make Rational accept string_view
-    std::string fractional_part = str.substr(separator_position + 1);
-    auto precision = Rational(1);
-    for (auto i = 0u; i < fractional_part.size(); ++i)
-    {
-        precision *= 10;
-    }
+    return term_table->arithmetic_constant(Rational::from_decimal(str));
+}
 
-    auto fractional_value = Rational(fractional_part.c_str());
-    auto gcd_value = gcd(precision, fractional_value);
-    auto num = fractional_value / gcd_value;
-    auto den = precision / gcd_value;
-    num = integral_value * den + num;
-    return term_table->arithmetic_constant(num / den);
+term_t Term_manager::mk_arithmetic_constant(Rational const& value)
+{
+    return term_table->arithmetic_constant(value);
 }
 
 bool Term_manager::is_var_like(term_t t) const
@@ -529,32 +518,38 @@ term_t Term_manager::mk_unary_minus(term_t t)
 poly_t Term_manager::term_to_poly(term_t term)
 {
     poly_t poly;
+    append_monomials(term, poly);
+    poly.normalize();
+    return poly;
+}
+
+void Term_manager::append_monomials(term_t term, poly_t& poly)
+{
     if (term_table->is_arithmetic_constant(term))
     {
         if (term != zero_term)
         {
-            poly.add_term(term_t::Undef, term_table->arithmetic_constant_value(term));
+            poly.append_term(term_t::Undef, term_table->arithmetic_constant_value(term));
         }
-        return poly;
+        return;
     }
     if (term_table->is_uninterpreted_constant(term) || term_table->is_ite(term) || term_table->is_app(term))
     {
-        poly.add_term(term, Rational(1));
-        return poly;
+        poly.append_term(term, Rational(1));
+        return;
     }
     if (term_table->is_arithmetic_product(term))
     {
-        poly.add_term(term_table->var_of_product(term), term_table->coeff_of_product(term));
-        return poly;
+        poly.append_term(term_table->var_of_product(term), term_table->coeff_of_product(term));
+        return;
     }
     if (term_table->is_arithmetic_polynomial(term))
     {
-        auto const& children = term_table->monomials_of(term);
-        for (term_t child : children)
+        for (term_t child : term_table->monomials_of(term))
         {
-            poly.merge(term_to_poly(child), Rational(1));
+            append_monomials(child, poly);
         }
-        return poly;
+        return;
     }
     assert(false);
     throw std::logic_error("UNREACHABLE");
@@ -595,11 +590,12 @@ term_t Term_manager::poly_to_term(poly_t const& poly)
 
 term_t Term_manager::mk_arithmetic_plus(std::span<term_t> args)
 {
-    // TODO: Can we do something more efficient?
+    // collect all monomials and combine them at once
     poly_t res;
     for (term_t arg : args) {
-        res.merge(term_to_poly(arg), 1);
+        append_monomials(arg, res);
     }
+    res.normalize();
     return poly_to_term(res);
 }
 
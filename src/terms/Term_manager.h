@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string_view>
 
 #include "Arithmetic_polynomial.h"
 #include "Term_types.h"
@@ -36,7 +37,7 @@ public:
      * @param args argument list
      * @return handle to the corresponding composite term
      */
-    term_t mk_term(std::string const& op, std::span<term_t> args, bool not_app = false);
+    term_t mk_term(std::string_view op, std::span<term_t> args, bool not_app = false);
 
     /**
      * Gets the term of the specified kind with the given list of argument terms
@@ -75,7 +76,7 @@ public:
      */
     term_t mk_uninterpreted_constant(type_t type);
 
-    term_t mk_app(std::string const& name, type_t ret_type, std::span<term_t> args);
+    term_t mk_app(std::string_view name, type_t ret_type, std::span<term_t> args);
     term_t mk_app(std::span<term_t> args);
 
     /*
@@ -96,9 +97,26 @@ public:
      * Arithmetic terms
      */
 
-    term_t mk_integer_constant(std::string const& str);
+    /**
+     * Gets the arithmetic constant of an SMT-LIB numeral
+     * @param str decimal digits
+     * @return term representation of the numeral
+     */
+    term_t mk_integer_constant(std::string_view str);
 
-    term_t mk_rational_constant(std::string const& str);
+    /**
+     * Gets the arithmetic constant of an SMT-LIB numeral or decimal
+     * @param str decimal digits optionally followed by a decimal point and more digits
+     * @return term representation of the decimal
+     */
+    term_t mk_rational_constant(std::string_view str);
+
+    /**
+     * Gets the arithmetic constant with the given value
+     * @param value value of the constant
+     * @return term representation of @p value
+     */
+    term_t mk_arithmetic_constant(Rational const& value);
 
     term_t mk_arithmetic_eq(term_t t1, term_t t2);
 
@@ -125,9 +143,9 @@ public:
     /*
      * term names
      */
-    void set_term_name(term_t t, std::string const& name);
+    void set_term_name(term_t t, std::string_view name);
     std::optional<std::string_view> get_term_name(term_t t) const;
-    std::optional<term_t> get_term_by_name(std::string const& name);
+    std::optional<term_t> get_term_by_name(std::string_view name);
 
     /*
      * term queries
@@ -143,6 +161,11 @@ public:
 
     [[nodiscard]] int32_t index_of(term_t term) const;
 
+    /**
+     * @return number of terms created so far (all term indices are smaller than this number)
+     */
+    [[nodiscard]] std::size_t num_terms() const;
+
     [[nodiscard]] term_t positive_term(term_t) const;
 
     [[nodiscard]] bool is_negated(term_t) const;
@@ -167,15 +190,34 @@ public:
 
     [[nodiscard]] Rational const& coeff_of_product(term_t arithmetic_product) const;
 
-private:
+    /*
+     * conversion between arithmetic terms and polynomials
+     */
+
+    /**
+     * Gets the normalized arithmetic term of a polynomial
+     * @param poly polynomial whose variables are variable-like terms (constant has `term_t::Undef`)
+     * @return term equal to @p poly
+     */
     term_t poly_to_term(poly_t const& poly);
+
+    /**
+     * Gets the polynomial of an arithmetic term
+     * @param term arithmetic term
+     * @return polynomial equal to @p term
+     */
     poly_t term_to_poly(term_t term);
 
+private:
+
     term_t mk_bool_ite(term_t i, term_t t, term_t e);
     term_t mk_arithmetic_ite(term_t i, term_t t, term_t e);
 
     term_t direct_arithmetic_binary_equality(term_t t1, term_t t2);
 
+    // Append monomials of an arithmetic term to a polynomial which is not normalized yet
+    void append_monomials(term_t term, poly_t& poly);
+
     // Helper method for polynomials, determines if a term can be treated as a variable
     // This includes variables (KIND::UNINTERPRETED_TERM) and ITEs
     [[nodiscard]] bool is_var_like(term_t t) const;
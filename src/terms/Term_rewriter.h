@@ -1,10 +1,12 @@
 #ifndef YAGA_TERM_REWRITER_H
 #define YAGA_TERM_REWRITER_H
 
-#include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
+#include "Dense_map.h"
 #include "Term_manager.h"
+#include "Terms.h"
 
 namespace yaga::terms {
 
@@ -14,21 +16,27 @@ protected:
     Term_manager & tm;
     TConfig & cfg;
 
+    struct DFSEntry {
+        explicit DFSEntry(term_t term) : term(term) {}
+        term_t term;
+        unsigned int next_child = 0;
+    };
+
+    // map term handle -> rewritten term for terms processed in the current call of `rewrite`
+    // (negated terms are rewritten separately, so the map is indexed by the handle, not the index)
+    Dense_map<term_t> substitutions;
+    std::vector<DFSEntry> toProcess;
+    std::vector<term_t> aux_args;
+
 public:
     Rewriter(Term_manager & tm, TConfig & cfg) : tm(tm), cfg(cfg) {}
 
     term_t rewrite(term_t root) {
-        struct DFSEntry {
-            explicit DFSEntry(term_t term) : term(term) {}
-            term_t term;
-            unsigned int next_child = 0;
-        };
-
-        std::unordered_map<term_t, term_t> substitutions;
-        std::unordered_set<term_t> processed;
-        std::vector<DFSEntry> toProcess;
-        std::vector<term_t> aux_args;
-        auto is_processed = [&processed](term_t term) { return processed.find(term) != processed.end(); };
+        substitutions.clear();
+        substitutions.resize(2 * tm.num_terms());
+        toProcess.clear();
+        aux_args.clear();
+        auto is_processed = [this](term_t term) { return substitutions.contains(term.x); };
 
         toProcess.emplace_back(root);
         while (not toProcess.empty())
@@ -41,34 +49,33 @@ public:
             {
                 term_t next_child = children[current_entry.next_child];
                 ++current_entry.next_child;
-                if (is_processed(next_child)) { toProcess.emplace_back(next_child); }
+                if (not is_processed(next_child)) { toProcess.emplace_back(next_child); }
                 continue;
             }
             // If we are here, we have already processed all children
-            assert(substitutions.count(current_term) == 0);
             bool needs_change = false;
             for (term_t child : children)
             {
-                auto it = substitutions.find(child);
-                bool child_changed = it != substitutions.end();
-                needs_change |= child_changed;
-                term_t newChild = child_changed ? it->second : child;
+                term_t newChild = substitutions[child.x];
+                needs_change |= newChild != child;
                 assert(tm.get_type(child) == tm.get_type(newChild));
                 aux_args.push_back(newChild);
             }
-            term_t newTerm = needs_change ? tm.mk_term(tm.get_kind(current_term), aux_args) : current_term;
+            term_t newTerm = current_term;
+            if (needs_change)
+            {
+                // arguments of a negated term are arguments of the positive term
+                newTerm = tm.mk_term(tm.get_kind(current_term), aux_args);
+                if (is_negated(current_term)) { newTerm = opposite_term(newTerm); }
+            }
             aux_args.clear();
             term_t rewritten = cfg.rewrite(newTerm);
-            if (rewritten != newTerm or needs_change) {
-                assert(tm.get_type(current_term) == tm.get_type(rewritten));
-                substitutions.insert({current_term, rewritten});
-            }
-            processed.insert(current_term);
+            assert(tm.get_type(current_term) == tm.get_type(rewritten));
+            substitutions.insert(current_term.x, rewritten);
             toProcess.pop_back();
         }
 
-        auto it = substitutions.find(root);
-        return it == substitutions.end() ? root : it->second;
+        return substitutions[root.x];
     }
 };
 
@@ -83,16 +90,18 @@ using subst_map_t = std::unordered_map<term_t, term_t>;
 class VarSubstituteConfig : public DefaultRewriterConfig
 {
     Term_manager& tm;
-    subst_map_t const& subst_map;
+    subst_map_t const* subst_map;
 
 public:
-    VarSubstituteConfig(Term_manager& tm, subst_map_t const& subst_map) : tm(tm), subst_map(subst_map) {}
+    VarSubstituteConfig(Term_manager& tm, subst_map_t const& subst_map) : tm(tm), subst_map(&subst_map) {}
+
+    void set_map(subst_map_t const& map) { subst_map = &map; }
 
     term_t rewrite(term_t term) override
     {
         if (not is_negated(term) and tm.get_kind(term) == Kind::UNINTERPRETED_TERM)
         {
-            if (auto it = subst_map.find(term); it != subst_map.end())
+            if (auto it = subst_map->find(term); it != subst_map->end())
             {
                 return it->second;
             }
@@ -101,7 +110,39 @@ public:
     }
 };
 
-term_t simultaneous_variable_substitution(Term_manager& tm, subst_map_t const& map, term_t term)
+/**
+ * Simultaneous substitution of terms for variables which can be applied repeatedly.
+ *
+ * Unlike `simultaneous_variable_substitution`, memory of the rewriter is reused by subsequent
+ * substitutions.
+ */
+class Variable_substitution
+{
+    // empty map used before the first substitution
+    subst_map_t const empty_map;
+    VarSubstituteConfig config;
+    Rewriter<VarSubstituteConfig> rewriter;
+
+public:
+    explicit Variable_substitution(Term_manager& tm) : config(tm, empty_map), rewriter(tm, config) {}
+
+    Variable_substitution(Variable_substitution const&) = delete;
+    Variable_substitution& operator=(Variable_substitution const&) = delete;
+
+    /** Replace variables in @p term by terms in @p map
+     *
+     * @param map map variable -> term which replaces the variable
+     * @param term term in which variables are replaced
+     * @return @p term with all occurrences of variables in @p map replaced
+     */
+    term_t operator()(subst_map_t const& map, term_t term)
+    {
+        config.set_map(map);
+        return rewriter.rewrite(term);
+    }
+};
+
+inline term_t simultaneous_variable_substitution(Term_manager& tm, subst_map_t const& map, term_t term)
 {
     VarSubstituteConfig config(tm, map);
     Rewriter<VarSubstituteConfig> rewriter(tm, config);
@@ -1,8 +1,9 @@
 #ifndef YAGA_TERM_VISITOR_H
 #define YAGA_TERM_VISITOR_H
 
-#include <unordered_set>
+#include <vector>
 
+#include "Dense_map.h"
 #include "Term_manager.h"
 
 namespace yaga::terms
@@ -12,7 +13,15 @@ template<typename TConfig> class Visitor
 {
     Term_manager const& term_manager;
     TConfig& config;
-    std::unordered_set<int32_t> processed;
+    // indices of terms which have been visited since the last reset
+    Dense_set processed;
+    // stack of the depth-first search
+    struct DFSEntry {
+        explicit DFSEntry(term_t term) : term(term) {}
+        term_t term;
+        unsigned int next_child = 0;
+    };
+    std::vector<DFSEntry> worklist;
 
 public:
     Visitor(Term_manager const& term_manager, TConfig& config) : term_manager(term_manager), config(config) {}
@@ -25,9 +34,10 @@ public:
 
     void visit(std::span<const term_t> roots)
     {
+        processed.resize(term_manager.num_terms());
         for (term_t root : roots)
         {
-            if (processed.count(term_manager.index_of(root)) == 0)
+            if (!processed.contains(term_manager.index_of(root)))
             {
                 visit(root);
             }
@@ -36,14 +46,8 @@ public:
 
     void visit(term_t root)
     {
-        struct DFSEntry {
-            explicit DFSEntry(term_t term) : term(term) {}
-            term_t term;
-            unsigned int next_child = 0;
-        };
-
-        std::vector<DFSEntry> worklist;
-
+        processed.resize(term_manager.num_terms());
+        worklist.clear();
         worklist.emplace_back(root);
         while (!worklist.empty())
         {
@@ -53,13 +57,13 @@ public:
             if (current_entry.next_child < children.size()) {
                 term_t next_child = children[current_entry.next_child];
                 ++current_entry.next_child;
-                if (processed.find(term_manager.index_of(next_child)) == processed.end()) {
+                if (!processed.contains(term_manager.index_of(next_child))) {
                     worklist.emplace_back(next_child);
                 }
                 continue;
             }
             // If we are here, we have already processed all children
-            assert(processed.count(term_manager.index_of(current)) == 0);
+            assert(!processed.contains(term_manager.index_of(current)));
             config.visit(current);
             processed.insert(term_manager.index_of(current));
             worklist.pop_back();
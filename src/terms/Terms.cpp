@@ -1,30 +1,34 @@
 #include "Terms.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include "Hash.h"
+
 namespace yaga::terms {
 
-namespace { // Hash functions. TODO: Improve
-uint64_t hash_composite_term(Kind kind, std::span<term_t> args) {
-    std::hash<int32_t> hasher;
-    uint64_t result = hasher(static_cast<std::underlying_type<Kind>::type>(kind));
-    for (term_t arg : args) {
-        result = result * 31 + hasher(arg.x);
+namespace { // Hash functions
+uint64_t hash_composite_term(Kind kind, type_t tau, std::span<term_t const> args) {
+    utils::Hasher hasher{static_cast<uint64_t>(kind)};
+    hasher.add(static_cast<uint32_t>(tau), static_cast<uint32_t>(args.size()));
+    std::size_t i = 0;
+    for (; i + 1 < args.size(); i += 2) {
+        hasher.add(static_cast<uint32_t>(args[i].x), static_cast<uint32_t>(args[i + 1].x));
+    }
+    if (i < args.size()) {
+        hasher.add(static_cast<uint32_t>(args[i].x));
     }
-    return result;
+    return hasher.value();
 }
 
 uint64_t hash_integer_term(Kind kind, type_t tau, int32_t index) {
-    std::hash<int32_t> hasher;
-    uint64_t result = hasher(static_cast<std::underlying_type<Kind>::type>(kind));
-    result = result * 31 + hasher(tau);
-    result = result * 31 + hasher(index);
-    return result;
+    utils::Hasher hasher{static_cast<uint64_t>(kind)};
+    hasher.add(static_cast<uint32_t>(tau), static_cast<uint32_t>(index));
+    return hasher.value();
 }
 
 uint64_t hash_rational(Rational const& value) {
-    // TODO: Implement hashing in Rationals to return 64-bit hash
-    return value.getHashValue();
+    return value.hash();
 }
 }
 
@@ -33,74 +37,74 @@ Term_table::Term_table()
     add_primitive_terms();
 }
 
-composite_term_descriptor_t::composite_term_descriptor_t(std::span<term_t> args)
-    : m_args(args.begin(), args.end())
+std::span<term_t const> Term_arena::allocate(std::span<term_t const> args)
 {
-}
+    if (args.empty())
+    {
+        return {};
+    }
 
-std::unique_ptr<composite_term_descriptor_t>
-composite_term_descriptor_t::make(std::span<term_t> args)
-{
-    return std::unique_ptr<composite_term_descriptor_t>(new composite_term_descriptor_t(args));
+    term_t* data = nullptr;
+    if (args.size() > block_size)
+    {
+        large_blocks.push_back(std::make_unique<term_t[]>(args.size()));
+        data = large_blocks.back().get();
+    }
+    else
+    {
+        if (used + args.size() > block_size)
+        {
+            blocks.push_back(std::make_unique<term_t[]>(block_size));
+            used = 0;
+        }
+        data = blocks.back().get() + used;
+        used += args.size();
+    }
+    std::copy(args.begin(), args.end(), data);
+    return {data, args.size()};
 }
 
-std::unique_ptr<rational_term_descriptor_t>
-rational_term_descriptor_t::make(Rational const& val)
-{
-    return std::unique_ptr<rational_term_descriptor_t>(new rational_term_descriptor_t(val));
-}
+Kind Term_table::get_kind(term_t t) const { return kinds[index_of(t)]; }
+
+type_t Term_table::get_type(term_t t) const { return types[index_of(t)]; }
 
-std::unique_ptr<constant_term_descriptor_t>
-constant_term_descriptor_t::make(int32_t index)
+term_t Term_table::push_term(Kind kind, type_t type, std::span<term_t const> term_args,
+                             int32_t payload)
 {
-    return std::unique_ptr<constant_term_descriptor_t>(new constant_term_descriptor_t(index));
+    auto index = static_cast<int32_t>(kinds.size()); // TODO: Check Max term count
+    kinds.push_back(kind);
+    types.push_back(type);
+    args.push_back(arena.allocate(term_args));
+    payloads.push_back(payload);
+    return positive_term(index);
 }
 
-
-
-
-Kind Term_table::get_kind(term_t t) const { return inner_table[index_of(t)].kind; }
-
-type_t Term_table::get_type(term_t t) const { return inner_table[index_of(t)].type; }
-
-term_descriptor_t const& Term_table::get_descriptor(term_t t) const { return *inner_table[index_of(t)].descriptor; }
-
 term_t Term_table::construct_composite(Kind kind, type_t type, std::span<term_t> args)
 {
-    auto term = composite_term_descriptor_t::make(args);
-    auto index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(index);
+    return push_term(kind, type, args, 0);
 }
 
 term_t Term_table::construct_rational(Kind kind, type_t type, Rational const& value)
 {
-    auto term = rational_term_descriptor_t::make(value);
-    auto index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(index);
+    auto pool_index = static_cast<int32_t>(constant_pool.size());
+    constant_pool.push_back(value);
+    return push_term(kind, type, {}, pool_index);
 }
 
 term_t Term_table::construct_constant(Kind kind, type_t type, int32_t index)
 {
-    auto term = constant_term_descriptor_t::make(index);
-    auto term_index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(term_index);
+    return push_term(kind, type, {}, index);
 }
 
 term_t Term_table::construct_uninterpreted_constant(type_t type)
 {
-    auto term_descriptor = std::unique_ptr<term_descriptor_t>();
-    auto term_index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{Kind::UNINTERPRETED_TERM, type, std::move(term_descriptor)});
-    return positive_term(term_index);
+    return push_term(Kind::UNINTERPRETED_TERM, type, {}, 0);
 }
 
 void Term_table::add_primitive_terms()
 {
-    assert(inner_table.empty());
-    inner_table.push_back(Term{Kind::RESERVED_TERM, types::null_type, nullptr});
+    assert(kinds.empty());
+    push_term(Kind::RESERVED_TERM, types::null_type, {}, 0);
 
     term_t allocated_true_term = constant_term(types::bool_type, 0);
     assert(allocated_true_term == true_term);
@@ -125,7 +129,7 @@ term_t Term_table::arithmetic_constant(Rational const& value)
 
 term_t Term_table::or_term(std::span<term_t> args)
 {
-    Composite_term_proxy proxy{Kind::OR_TERM, types::bool_type, hash_composite_term(Kind::OR_TERM, args), *this, args};
+    Composite_term_proxy proxy{Kind::OR_TERM, types::bool_type, hash_composite_term(Kind::OR_TERM, types::bool_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -136,14 +140,14 @@ term_t Term_table::arithmetic_product(Rational const& coeff, term_t var)
         ((is_ite(var) or is_app(var)) and get_type(var) == types::real_type));
     term_t coeff_term = arithmetic_constant(coeff);
     std::array<term_t, 2> args{coeff_term, var};
-    Composite_term_proxy proxy{Kind::ARITH_PRODUCT, types::real_type, hash_composite_term(Kind::ARITH_PRODUCT, args), *this, args};
+    Composite_term_proxy proxy{Kind::ARITH_PRODUCT, types::real_type, hash_composite_term(Kind::ARITH_PRODUCT, types::real_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
 term_t Term_table::arithmetic_polynomial(std::span<term_t> args)
 {
     assert(args.size() >= 2);
-    Composite_term_proxy proxy{Kind::ARITH_POLY, types::real_type, hash_composite_term(Kind::ARITH_POLY, args), *this, args};
+    Composite_term_proxy proxy{Kind::ARITH_POLY, types::real_type, hash_composite_term(Kind::ARITH_POLY, types::real_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -151,7 +155,7 @@ term_t Term_table::arithmetic_geq_zero(term_t t)
 {
     assert(get_type(t) == types::real_type);
     std::array<term_t, 1> args{t};
-    Composite_term_proxy proxy{Kind::ARITH_GE_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_GE_ATOM, args), *this, args};
+    Composite_term_proxy proxy{Kind::ARITH_GE_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_GE_ATOM, types::bool_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -159,7 +163,7 @@ term_t Term_table::arithmetic_eq_zero(term_t t)
 {
     assert(get_type(t) == types::real_type);
     std::array<term_t, 1> args{t};
-    Composite_term_proxy proxy{Kind::ARITH_EQ_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_EQ_ATOM, args), *this, args};
+    Composite_term_proxy proxy{Kind::ARITH_EQ_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_EQ_ATOM, types::bool_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -170,7 +174,7 @@ term_t Term_table::arithmetic_binary_eq(term_t t1, term_t t2)
     assert(get_kind(t1) == Kind::UNINTERPRETED_TERM or get_kind(t1) == Kind::ITE_TERM or get_kind(t1) == Kind::APP_TERM);
     assert(get_kind(t2) != Kind::ARITH_PRODUCT and get_kind(t2) != Kind::ARITH_POLY);
     std::array<term_t, 2> args{t1, t2};
-    Composite_term_proxy proxy{Kind::ARITH_BINEQ_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_BINEQ_ATOM, args), *this, args};
+    Composite_term_proxy proxy{Kind::ARITH_BINEQ_ATOM, types::bool_type, hash_composite_term(Kind::ARITH_BINEQ_ATOM, types::bool_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -180,12 +184,12 @@ term_t Term_table::arithmetic_ite(term_t c, term_t t, term_t e)
     assert(get_type(t) == types::real_type);
     assert(get_type(e) == types::real_type);
     std::array<term_t, 3> args{c,t,e};
-    Composite_term_proxy proxy{Kind::ITE_TERM, types::real_type, hash_composite_term(Kind::ITE_TERM, args), *this, args};
+    Composite_term_proxy proxy{Kind::ITE_TERM, types::real_type, hash_composite_term(Kind::ITE_TERM, types::real_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
 term_t Term_table::app_term(type_t ret_type, std::span<term_t> args) {
-    Composite_term_proxy proxy{Kind::APP_TERM, ret_type, hash_composite_term(Kind::APP_TERM, args), *this, args};
+    Composite_term_proxy proxy{Kind::APP_TERM, ret_type, hash_composite_term(Kind::APP_TERM, ret_type, args), *this, args};
     return known_terms.get_composite_term(proxy);
 }
 
@@ -199,16 +203,16 @@ term_t Term_table::new_uninterpreted_constant(type_t tau)
     return construct_uninterpreted_constant(tau);
 }
 
-void Term_table::set_term_name(term_t t, std::string const& name)
+void Term_table::set_term_name(term_t t, std::string_view name)
 {
     {
-        auto [it, inserted] = symbol_table.insert({name, t});
+        auto [it, inserted] = symbol_table.emplace(name, t);
         assert(inserted);
         (void)inserted;
     }
 
     {
-        auto [it, inserted] = name_table.insert({t, name});
+        auto [it, inserted] = name_table.emplace(t, name);
         assert(inserted);
         (void)inserted;
     }
@@ -224,7 +228,7 @@ std::optional<std::string_view> Term_table::get_term_name(term_t t) const
     return std::nullopt;
 }
 
-std::optional<term_t> Term_table::get_term_by_name(std::string const& name) const
+std::optional<term_t> Term_table::get_term_by_name(std::string_view name) const
 {
     auto it = symbol_table.find(name);
     return it != symbol_table.end() ? std::make_optional(it->second) : std::nullopt;
@@ -236,14 +240,13 @@ std::optional<term_t> Term_table::get_term_by_name(std::string const& name) cons
 
 bool Term_table::is_arithmetic_constant(term_t t) const
 {
-    return this->inner_table[index_of(t)].kind == Kind::ARITH_CONSTANT;
+    return get_kind(t) == Kind::ARITH_CONSTANT;
 }
 
 Rational const& Term_table::arithmetic_constant_value(term_t t) const
 {
     assert(is_arithmetic_constant(t));
-    auto const& descriptor = static_cast<rational_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    return descriptor.value();
+    return constant_pool[payloads[index_of(t)]];
 }
 
 bool Term_table::is_uninterpreted_constant(term_t t) const
@@ -274,34 +277,28 @@ bool Term_table::is_app(term_t t) const
 term_t Term_table::var_of_product(term_t t) const
 {
     assert(is_arithmetic_product(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    assert(descriptor.size() == 2);
-    return descriptor.args()[1];
+    assert(stored_args(t).size() == 2);
+    return stored_args(t)[1];
 }
 
 Rational const& Term_table::coeff_of_product(term_t t) const
 {
     assert(is_arithmetic_product(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    assert(descriptor.size() == 2);
-    return arithmetic_constant_value(descriptor.args()[0]);
+    assert(stored_args(t).size() == 2);
+    return arithmetic_constant_value(stored_args(t)[0]);
 }
 
 std::span<const term_t> Term_table::monomials_of(term_t t) const
 {
     assert(is_arithmetic_polynomial(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    return descriptor.args();
+    return stored_args(t);
 }
 
 term_t Term_table::get_fnc_symbol(term_t t) const {
     assert(get_kind(t) == Kind::APP_TERM);
 
-    term_descriptor_t const& descriptor = get_descriptor(t);
-    auto const& composite_descriptor = dynamic_cast<composite_term_descriptor_t const&>(descriptor);
-    assert(composite_descriptor.size() != 0);
-
-    return composite_descriptor.args()[0];
+    assert(!stored_args(t).empty());
+    return stored_args(t)[0];
 }
 
 std::span<const term_t> Term_table::get_args(term_t t) const
@@ -315,14 +312,13 @@ std::span<const term_t> Term_table::get_args(term_t t) const
     case Kind::UNINTERPRETED_TERM:
         return {};
     default:
-        term_descriptor_t const& descriptor = get_descriptor(t);
-        auto const& composite_descriptor = dynamic_cast<composite_term_descriptor_t const&>(descriptor);
-        assert(composite_descriptor.size() != 0);
+        auto term_args = stored_args(t);
+        assert(!term_args.empty());
 
         if (kind == Kind::APP_TERM) {
-            return composite_descriptor.args().last(composite_descriptor.size() - 1);
+            return term_args.subspan(1);
         } else {
-            return composite_descriptor.args();
+            return term_args;
         }
     }
 }
@@ -1,9 +1,12 @@
 #ifndef YAGA_TERMS_H
 #define YAGA_TERMS_H
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -15,62 +18,33 @@
 namespace yaga::terms {
 
 /**
- * Term descriptor contains additional information for different kinds of terms.
+ * Storage of arguments of composite terms.
  *
- * Each kind uses a specialized subclass of this base class.
+ * Arguments are bump-allocated in large blocks, so creating a term does not allocate in steady
+ * state and spans of arguments of existing terms stay valid when new terms are created.
  */
-struct term_descriptor_t
-{
-    virtual ~term_descriptor_t() = default;
-};
-
-/**
- * A term descriptor for any composite term, i.e., a term with an operator and arguments.
- * It stores the arguments of the composite term.
- *
- */
-class composite_term_descriptor_t : public term_descriptor_t {
-    std::vector<term_t> m_args;
-
-    explicit composite_term_descriptor_t(std::span<term_t> args);
-
-public:
-    [[nodiscard]] std::size_t size() const noexcept { return m_args.size(); }
-    [[nodiscard]] std::span<term_t const> args() const noexcept { return m_args; }
-
-    static std::unique_ptr<composite_term_descriptor_t> make(std::span<term_t> args);
-};
-
-/**
- * A descriptor for terms representing rational numbers.
- * It stores the rational value of the corresponding term.
- */
-class rational_term_descriptor_t : public term_descriptor_t {
-    Rational m_value;
-
-    explicit rational_term_descriptor_t(Rational const& val) : m_value(val) {}
-
-public:
-    static std::unique_ptr<rational_term_descriptor_t> make(Rational const& val);
-
-    [[nodiscard]] Rational const& value() const { return m_value; }
-};
-
-/**
- * A descriptor for terms representing constant of a finite type.
- */
-class constant_term_descriptor_t : public term_descriptor_t {
-    int32_t m_index;
-
-    explicit constant_term_descriptor_t(int32_t index) : m_index(index) {}
-
+class Term_arena {
 public:
-    static std::unique_ptr<constant_term_descriptor_t> make(int32_t index);
-
-    [[nodiscard]] int32_t index() const { return m_index; }
+    /**
+     * Copy @p args to the arena
+     *
+     * @param args arguments of a new term
+     * @return view of the copy of @p args which is valid for the lifetime of the arena
+     */
+    std::span<term_t const> allocate(std::span<term_t const> args);
+
+private:
+    // number of arguments in each block (longer argument lists get a dedicated block)
+    static constexpr std::size_t block_size = 1 << 16;
+
+    // blocks of arguments, the last block is the one currently used for allocation
+    std::vector<std::unique_ptr<term_t[]>> blocks;
+    // dedicated blocks for argument lists longer than `block_size`
+    std::vector<std::unique_ptr<term_t[]>> large_blocks;
+    // number of used elements in the last block of `blocks`
+    std::size_t used = block_size;
 };
 
-
 /*
  * Helper methods for simple queries on term handles
  */
@@ -126,23 +100,35 @@ inline constexpr term_t negative_term(term_t t) { return negative_term(index_of(
  * If it does, the existing terms is returned instead of creating new one.
  */
 class Term_table {
-    /**
-     * Internal representation of terms.
-     *
-     * It stores the kind of the term, its type and additional information in the term descriptor.
-     */
-    struct Term {
-        Kind kind;
-        type_t type;
-        std::unique_ptr<term_descriptor_t> descriptor;
+    // hash of names which allows lookups by `std::string_view`
+    struct Name_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
     };
 
-    using inner_table_t = std::vector<Term>;
-    using symbol_table_t = std::unordered_map<std::string, term_t>;
+    using symbol_table_t = std::unordered_map<std::string, term_t, Name_hash, std::equal_to<>>;
     using name_table_t = std::unordered_map<term_t, std::string>;
 
-    // The actual storage of terms
-    inner_table_t inner_table;
+    /*
+     * The actual storage of terms. Terms are stored as a structure of arrays indexed by the term
+     * index.
+     */
+
+    // Kind of each term
+    std::vector<Kind> kinds;
+    // Type of each term
+    std::vector<type_t> types;
+    // Arguments of each term (stored in `arena`, empty for atomic terms)
+    std::vector<std::span<term_t const>> args;
+    // Index of a constant of a finite type or index of the value of a rational constant in
+    // `constant_pool` (unused for other terms)
+    std::vector<int32_t> payloads;
+
+    // Storage of arguments of composite terms
+    Term_arena arena;
+
+    // Values of rational constants (deque does not move its elements when it grows)
+    std::deque<Rational> constant_pool;
 
     // Hash table to implement hash consing
     Term_hash_table known_terms;
@@ -156,6 +142,15 @@ class Term_table {
     // Necessary initialization
     void add_primitive_terms();
 
+    // Append a new term to the table
+    term_t push_term(Kind kind, type_t type, std::span<term_t const> term_args, int32_t payload);
+
+    // All stored arguments of a term (including the function symbol of applications)
+    std::span<term_t const> stored_args(term_t t) const { return args[index_of(t)]; }
+
+    // Index of a constant of a finite type
+    int32_t constant_index(term_t t) const { return payloads[index_of(t)]; }
+
     // Actual construction of terms. These methods always create new terms!
     friend class Term_hash_table;
     term_t construct_composite(Kind kind, type_t type, std::span<term_t> args);
@@ -165,10 +160,15 @@ class Term_table {
 public:
     Term_table();
 
+    /**
+     * @return number of terms in the table (all term indices are smaller than this number)
+     */
+    std::size_t size() const { return kinds.size(); }
+
     /**
      * Associate a term with the given name
      */
-    void set_term_name(term_t, std::string const&);
+    void set_term_name(term_t, std::string_view);
 
     /**
      * Get name associated with a term
@@ -182,7 +182,7 @@ public:
      *
      * @return Term associated with the name, or nothing if no term is associated with the name
      */
-    std::optional<term_t> get_term_by_name(std::string const& name) const;
+    std::optional<term_t> get_term_by_name(std::string_view name) const;
 
     /**
      *
@@ -196,13 +196,6 @@ public:
      */
     type_t get_type(term_t) const;
 
-    /**
-     *
-     * @return The term descriptor of the given term
-     */
-    term_descriptor_t const& get_descriptor(term_t) const;
-
-
     /**
      * Retrieves the arguments (children) of the given term
      * @return the arguments of the given term
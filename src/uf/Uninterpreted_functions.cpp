@@ -47,9 +47,11 @@ std::vector<Clause> Uninterpreted_functions::propagate(Database&, Trail& trail)
 
         for (Assignment_watchlist& w_list : watchlists) {
             if (assignment.var == w_list.get_watched_var()) {
+                ++num_watch_visits;
                 w_list.on_assign(trail);
 
                 if (w_list.all_assigned(trail)) {
+                    ++num_applications;
                     std::vector<Clause> function_conflict = add_function_value(w_list.get_term(), trail);
                     result.insert(result.end(), function_conflict.begin(), function_conflict.end());
                 }
@@ -151,6 +153,13 @@ void Uninterpreted_functions::on_before_backtrack(Database&, Trail&, int new_lvl
     }
 }
 
+void Uninterpreted_functions::collect_statistics(Statistics& stats) const {
+    stats.set("uf.watch_visits", num_watch_visits);
+    stats.set("uf.applications", num_applications);
+    stats.set("uf.propagated_literals", num_propagated_literals);
+    stats.set("uf.congruence_conflicts", num_congruence_conflicts);
+}
+
 Uninterpreted_functions::Term_evaluation Uninterpreted_functions::evaluate(const terms::term_t t, Trail& trail) {
     Term_evaluation result;
 
@@ -309,6 +318,7 @@ void Uninterpreted_functions::assert_equality(terms::term_t t, terms::term_t u,
             int propagation_level = std::max<int>(t_eval.decision_level, u_eval.decision_level);
             trail.propagate(lit.var(), nullptr, propagation_level);
             trail_model.set_value(lit.var().ord(), are_equal);
+            ++num_propagated_literals;
         }
 
         result_clause.push_back(lit);
@@ -355,6 +365,7 @@ std::vector<Clause> Uninterpreted_functions::add_function_value(terms::term_t t,
     std::span<const terms::term_t> const& current_args = term_manager.get_args(current_app_term);
     std::span<const terms::term_t> const& conflict_args = term_manager.get_args(t);
 
+    ++num_congruence_conflicts;
     auto result = Clause();
     for (std::size_t i = 0; i < current_args.size(); ++i)
     {
@@ -363,10 +374,34 @@ std::vector<Clause> Uninterpreted_functions::add_function_value(terms::term_t t,
 
     assert_equality(t, current_app_term, trail, result);
 
-    tracer.init_conflict(result, proof::conflict::Uf_congruence{});
+    proof::conflict::Uf_congruence explanation;
+    auto is_real = [&](terms::term_t arg) { return term_manager.get_type(arg) == terms::types::real_type; };
+    if (tracer && is_real(t) && std::ranges::all_of(current_args, is_real))
+    {
+        for (std::size_t i = 0; i < current_args.size(); ++i)
+        {
+            explanation.equalities.push_back(explain_equality(current_args[i], conflict_args[i]));
+        }
+        explanation.equalities.push_back(explain_equality(current_app_term, t));
+    }
+    tracer.init_conflict(result, std::move(explanation));
     return {result};
 }
 
+proof::conflict::Uf_congruence::Equality Uninterpreted_functions::explain_equality(terms::term_t t, terms::term_t u) {
+    utils::Linear_polynomial p = term_to_poly(t);
+    p.sub(term_to_poly(u));
+    if (p.vars.empty()) {
+        return {t, u, -1, 1};
+    }
+
+    // the atom is normalized so that the variable with the lowest ordinal has coefficient 1
+    auto min_it = std::ranges::min_element(p.vars);
+    Rational scale = Rational{1} / p.coef[min_it - p.vars.begin()];
+    Literal lit = solver->linear_constraint(p.vars, p.coef, Order_predicate::Type::eq, -p.constant);
+    return {t, u, lit.var().ord(), scale};
+}
+
 std::unordered_map<terms::term_t, Uninterpreted_functions::function_value_map_t> Uninterpreted_functions::get_model() {
     for (const auto& [term, function] : functions) {
         function_value_map_t function_values;
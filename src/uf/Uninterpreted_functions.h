@@ -2,6 +2,7 @@
 #define YAGA_UNINTERPRETED_FUNCTIONS_H
 
 #include <algorithm>
+#include <cstdint>
 #include <map>
 #include <ranges>
 #include <span>
@@ -50,6 +51,12 @@ public:
      */
     void on_before_backtrack(Database& db, Trail& trail, int new_level) override;
 
+    /** Copy counters of this plugin to @p stats
+     *
+     * @param stats registry of statistics
+     */
+    void collect_statistics(Statistics& stats) const override;
+
     /** Notify UF plugin of the existence of a function application term
      *
      * @param var variable mapped to this application term
@@ -132,6 +139,14 @@ private:
     std::unordered_map<terms::term_t, function_value_map_t> model;
     Yaga* solver;
     proof::Tracer_wrapper tracer;
+    // total number of watchlists checked for an assigned variable
+    std::uint64_t num_watch_visits = 0;
+    // total number of function applications whose arguments and value have been assigned
+    std::uint64_t num_applications = 0;
+    // total number of equalities and disequalities propagated to the trail
+    std::uint64_t num_propagated_literals = 0;
+    // total number of detected congruence conflicts
+    std::uint64_t num_congruence_conflicts = 0;
 
     /** Evaluate term @p t with respect to current @p trail
      *
@@ -176,6 +191,14 @@ private:
      */
     void assert_equality(terms::term_t t, terms::term_t u, Trail& trail, Clause& result_clause, bool make_equal = true);
 
+    /** Find the arithmetic atom which represents the equality of real terms @p t and @p u
+     *
+     * @param t term to compare
+     * @param u term to compare
+     * @return equality for the proof of a congruence conflict
+     */
+    proof::conflict::Uf_congruence::Equality explain_equality(terms::term_t t, terms::term_t u);
+
     /** Create a linear polynomial that represents term @p t
      *
      * @param t term to convert
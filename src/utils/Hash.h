@@ -0,0 +1,70 @@
+#ifndef YAGA_HASH_H
+#define YAGA_HASH_H
+
+#include <cstdint>
+
+namespace yaga::utils {
+
+// 128-bit unsigned integer (a GCC and Clang extension)
+__extension__ using uint128_t = unsigned __int128;
+
+/** Mix two 64-bit values into a 64-bit hash.
+ *
+ * The values are multiplied as 128-bit numbers and the high and the low halves of the product are
+ * combined (the mixing step of wyhash). Each bit of the result depends on all bits of the input.
+ *
+ * @param a first value
+ * @param b second value
+ * @return hash of @p a and @p b
+ */
+inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b)
+{
+    auto product = static_cast<uint128_t>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+}
+
+/** Incremental 64-bit hash of a sequence of values.
+ */
+class Hasher {
+public:
+    explicit Hasher(std::uint64_t seed = 0) : state(seed ^ secret[0]) {}
+
+    /** Add a 64-bit value to the hash
+     *
+     * @param value next value in the sequence
+     */
+    inline void add(std::uint64_t value)
+    {
+        state = hash_mix(state ^ secret[1], value ^ secret[2]);
+        ++length;
+    }
+
+    /** Add two 32-bit values to the hash at once
+     *
+     * @param first first value
+     * @param second second value
+     */
+    inline void add(std::uint32_t first, std::uint32_t second)
+    {
+        add((static_cast<std::uint64_t>(first) << 32) | second);
+    }
+
+    /**
+     * @return hash of all values added so far
+     */
+    inline std::uint64_t value() const { return hash_mix(state ^ secret[3], length ^ secret[1]); }
+
+private:
+    // odd constants with balanced bits (the default secret of wyhash)
+    static constexpr std::uint64_t secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                                0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+    // current state of the hash
+    std::uint64_t state;
+    // number of 64-bit values added so far
+    std::uint64_t length = 0;
+};
+
+} // namespace yaga::utils
+
+#endif // YAGA_HASH_H
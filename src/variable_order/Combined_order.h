@@ -62,6 +62,20 @@ public:
         }
     }
 
+    /** Call the event on all managed heuristics
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map, int num_vars) override
+    {
+        for (auto& heuristic : heuristics)
+        {
+            heuristic->on_variable_remap(type, map, num_vars);
+        }
+    }
+
     /** Call the event on all managed heuristics
      *
      * @param db clause database
@@ -10,6 +10,14 @@ void Evsids::on_variable_resize(Variable::Type type, int num_vars)
     }
 }
 
+void Evsids::on_variable_remap(Variable::Type type, std::vector<int> const& map, int num_vars)
+{
+    if (type == Variable::boolean)
+    {
+        remap_values(vsids, map, num_vars, 0.0f);
+    }
+}
+
 void Evsids::on_init(Database& db, Trail&)
 {
     for (auto& score : vsids)
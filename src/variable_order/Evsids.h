@@ -29,6 +29,15 @@ public:
      */
     void on_variable_resize(Variable::Type type, int num_vars) override;
 
+    /** Move VSIDS scores of renumbered variables.
+     *
+     * @param type type of variable
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                           int num_vars) override;
+
     /** Bump variables in @p learned and decay VSIDS scores.
      *
      * @param db clause database
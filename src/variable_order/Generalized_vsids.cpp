@@ -1,31 +1,88 @@
 #include "Generalized_vsids.h"
 
+#include <algorithm>
+
 namespace yaga {
 
-void Generalized_vsids::on_variable_resize(Variable::Type type, int num_vars)
+void Generalized_vsids::on_variable_resize(Variable::Type type, int new_num_vars)
 {
-    if (vsids.size() <= static_cast<std::size_t>(type))
+    if (num_vars.size() <= static_cast<std::size_t>(type))
+    {
+        num_vars.resize(type + 1, 0);
+    }
+
+    int var_ord = num_vars[type];
+    num_vars[type] = new_num_vars;
+    if (new_num_vars > 0)
     {
-        vsids.resize(type + 1);
+        auto size = Variable_priority_queue::index(Variable{new_num_vars - 1, type}) + 1;
+        if (vsids.size() < size)
+        {
+            vsids.resize(size, 0.0f);
+            is_bumped.resize(size, false);
+        }
     }
-    int var_ord = static_cast<int>(vsids[type].size());
-    vsids[type].resize(num_vars, 0.0f);
 
-    for (; var_ord < num_vars; ++var_ord)
+    for (; var_ord < new_num_vars; ++var_ord)
     {
-        variables.push(Variable{var_ord, type}, 0.0f);
+        variables.push(Variable{var_ord, type});
     }
 }
 
-void Generalized_vsids::on_init(Database& db, Trail&)
+void Generalized_vsids::on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                                          int new_num_vars)
 {
-    for (auto& scores : vsids)
+    if (num_vars.size() <= static_cast<std::size_t>(type))
+    {
+        num_vars.resize(type + 1, 0);
+    }
+
+    // move scores of variables of this type
+    std::vector<Score> type_scores;
+    type_scores.reserve(num_vars[type]);
+    for (int var_ord = 0; var_ord < num_vars[type]; ++var_ord)
+    {
+        type_scores.push_back(score(Variable{var_ord, type}));
+    }
+    remap_values(type_scores, map, new_num_vars, 0.0f);
+    num_vars[type] = new_num_vars;
+
+    std::size_t size = 0;
+    for (std::size_t other_type = 0; other_type < num_vars.size(); ++other_type)
+    {
+        if (num_vars[other_type] > 0)
+        {
+            Variable last{num_vars[other_type] - 1, static_cast<Variable::Type>(other_type)};
+            size = std::max(size, Variable_priority_queue::index(last) + 1);
+        }
+    }
+    vsids.resize(size, 0.0f);
+    is_bumped.resize(size, false);
+    for (int var_ord = 0;; ++var_ord)
+    {
+        auto var_index = Variable_priority_queue::index(Variable{var_ord, type});
+        if (var_index >= vsids.size())
+        {
+            break;
+        }
+        vsids[var_index] = var_ord < new_num_vars ? type_scores[var_ord] : 0.0f;
+    }
+
+    // the trail is empty so all variables are in the queue
+    variables.clear();
+    effectively_decided.clear();
+    for (std::size_t other_type = 0; other_type < num_vars.size(); ++other_type)
     {
-        for (auto& score : scores)
+        for (int var_ord = 0; var_ord < num_vars[other_type]; ++var_ord)
         {
-            score = 0.0f;
+            variables.push(Variable{var_ord, static_cast<Variable::Type>(other_type)});
         }
     }
+}
+
+void Generalized_vsids::on_init(Database& db, Trail&)
+{
+    std::fill(vsids.begin(), vsids.end(), 0.0f);
 
     for (auto clause_list : {&db.asserted(), &db.learned()})
     {
@@ -37,6 +94,46 @@ void Generalized_vsids::on_init(Database& db, Trail&)
             }
         }
     }
+
+    // all scores have changed so it is faster to rebuild the queues
+    for (auto var : bumped)
+    {
+        is_bumped[Variable_priority_queue::index(var)] = false;
+    }
+    bumped.clear();
+    if (overflow)
+    {
+        overflow = false;
+        rescale();
+    }
+    else
+    {
+        variables.rebuild();
+        effectively_decided.rebuild();
+    }
+}
+
+void Generalized_vsids::fix_bumped()
+{
+    for (auto var : bumped)
+    {
+        is_bumped[Variable_priority_queue::index(var)] = false;
+    }
+
+    if (overflow)
+    {
+        overflow = false;
+        rescale();
+    }
+    else
+    {
+        for (auto var : bumped)
+        {
+            variables.increase(var);
+            effectively_decided.increase(var);
+        }
+    }
+    bumped.clear();
 }
 
 void Generalized_vsids::on_before_backtrack(Database&, Trail& trail, int level)
@@ -47,7 +144,7 @@ void Generalized_vsids::on_before_backtrack(Database&, Trail& trail, int level)
         {
             if (!variables.contains(var) && trail.decision_level(var).value() > level)
             {
-                variables.push(var, score(var));
+                variables.push(var);
             }
         }
     }
@@ -59,6 +156,7 @@ void Generalized_vsids::on_learned_clause(Database&, Trail&, Clause const& learn
     {
         bump(lit.var().ord());
     }
+    fix_bumped();
     decay();
 }
 
@@ -82,7 +180,10 @@ std::optional<Variable> Generalized_vsids::pick_effectively_decided(Trail& trail
     for (int var_ord : lra->effectively_decided())
     {
         Variable var{var_ord, Variable::rational};
-        effectively_decided.push(var, score(var));
+        if (!effectively_decided.contains(var))
+        {
+            effectively_decided.push(var);
+        }
     }
 
     // decide effectively decided variables first
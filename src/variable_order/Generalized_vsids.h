@@ -27,6 +27,10 @@ public:
 
     inline Generalized_vsids(Linear_arithmetic& lra) : lra(&lra) {}
 
+    // priority queues refer to `vsids` of this object
+    Generalized_vsids(Generalized_vsids const&) = delete;
+    Generalized_vsids& operator=(Generalized_vsids const&) = delete;
+
     /** Allocate memory for variable VSIDS scores
      *
      * @param type type of a variable
@@ -34,6 +38,15 @@ public:
      */
     void on_variable_resize(Variable::Type type, int num_vars) override;
 
+    /** Move VSIDS scores of renumbered variables and rebuild the priority queues.
+     *
+     * @param type type of a variable
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                           int num_vars) override;
+
     /** Reset VSIDS of all variables to 0 and bump all asserted/learned variables.
      *
      * @param db clause database
@@ -89,19 +102,24 @@ public:
      */
     inline Score score(Variable var) const 
     { 
-        if (vsids.size() <= var.type() || vsids[var.type()].size() <= static_cast<std::size_t>(var.ord()))
-        {
-            return 0.f;
-        }
-        return vsids[var.type()][var.ord()]; 
+        auto var_index = Variable_priority_queue::index(var);
+        return var_index < vsids.size() ? vsids[var_index] : 0.f;
     }
 private:
-    // map variable type -> variable ordinal -> VSIDS score
-    std::vector<std::vector<Score>> vsids;
+    // map variable index (`Variable_priority_queue::index()`) -> VSIDS score
+    std::vector<Score> vsids;
+    // map variable type -> number of variables of that type
+    std::vector<int> num_vars;
     // priority queue of variables sorted by VSIDS score
-    Variable_priority_queue variables;
+    Variable_priority_queue variables{vsids};
     // priority queue of effectively decided variables sorted by the VSIDS score
-    Variable_priority_queue effectively_decided;
+    Variable_priority_queue effectively_decided{vsids};
+    // variables bumped in the current conflict whose position in the queues has to be fixed
+    std::vector<Variable> bumped;
+    // map variable index -> true iff the variable is in `bumped`
+    std::vector<bool> is_bumped;
+    // true iff a score has exceeded `score_threshold` in the current conflict
+    bool overflow = false;
     // score grow factor (inverse decay factor)
     Score grow = 1.05;
     // current amount by which a variable VSIDS is increased in `bump()`
@@ -128,21 +146,18 @@ private:
     std::optional<Variable> pick_effectively_decided(Trail& trail);
 
     // get VSIDS score of a variable
-    inline Score& score(Variable var) { return vsids[var.type()][var.ord()]; }
+    inline Score& score(Variable var) { return vsids[Variable_priority_queue::index(var)]; }
 
-    // divide all scores by `score_threshold`
+    // divide all scores by `score_threshold` and rebuild the priority queues
     inline void rescale()
     {
-        for (auto& scores : vsids)
+        for (auto& score : vsids)
         {
-            for (auto& score : scores)
-            {
-                score /= score_threshold;
-            }
+            score /= score_threshold;
         }
         inc /= score_threshold;
-        variables.rescale(score_threshold);
-        effectively_decided.rescale(score_threshold);
+        variables.rebuild();
+        effectively_decided.rebuild();
     }
 
     // decay all VSIDS scores (by increasing the amount by which VSIDS scores are increased)
@@ -157,22 +172,23 @@ private:
         }
     }
 
-    // bump VSIDS score of `var`
+    // bump VSIDS score of `var`. The priority queues are fixed later in `fix_bumped()`.
     inline void bump(Variable var)
     {
-        score(var) += inc;
-        if (score(var) >= score_threshold)
+        auto var_index = Variable_priority_queue::index(var);
+        vsids[var_index] += inc;
+        overflow |= vsids[var_index] >= score_threshold;
+        if (!is_bumped[var_index])
         {
-            rescale();
-        }
-        else
-        {
-            variables.update(var, score(var));
-            effectively_decided.update(var, score(var));
+            is_bumped[var_index] = true;
+            bumped.push_back(var);
         }
     }
+
+    // restore the heap invariant for all variables bumped since the last call
+    void fix_bumped();
 };
 
 } // namespace yaga
 
-#endif // YAGA_GENERALIZED_VSIDS_H
\ No newline at end of file
+#endif // YAGA_GENERALIZED_VSIDS_H
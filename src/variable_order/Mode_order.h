@@ -0,0 +1,191 @@
+#ifndef YAGA_MODE_ORDER_H
+#define YAGA_MODE_ORDER_H
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Mode_switch.h"
+#include "Trail.h"
+#include "Variable_order.h"
+
+namespace yaga {
+
+/** Uses a different variable order heuristic in focused and stable search mode.
+ *
+ * Both heuristics keep track of assigned variables but only the heuristic of the current mode
+ * bumps variables in conflicts and picks decision variables.
+ */
+class Mode_order final : public Variable_order {
+public:
+    virtual ~Mode_order() = default;
+
+    /** Create a new variable order which follows the mode of @p modes
+     *
+     * @param modes restart policy which determines the current search mode
+     */
+    inline explicit Mode_order(Mode_switch const& modes) : modes(&modes) {}
+
+    /** Create a new variable order heuristic used in focused mode.
+     *
+     * @tparam T type of a variable order heuristic
+     * @tparam Args types of arguments passed to a constructor of T
+     * @param args arguments passed to a constructor of T
+     * @return reference to the new heuristic in this object.
+     */
+    template <class T, typename... Args>
+        requires std::is_base_of_v<Variable_order, T>
+    inline T& set_focused(Args&&... args)
+    {
+        return set<T>(focused, std::forward<Args>(args)...);
+    }
+
+    /** Create a new variable order heuristic used in stable mode.
+     *
+     * @tparam T type of a variable order heuristic
+     * @tparam Args types of arguments passed to a constructor of T
+     * @param args arguments passed to a constructor of T
+     * @return reference to the new heuristic in this object.
+     */
+    template <class T, typename... Args>
+        requires std::is_base_of_v<Variable_order, T>
+    inline T& set_stable(Args&&... args)
+    {
+        return set<T>(stable, std::forward<Args>(args)...);
+    }
+
+    /** Call the event on both heuristics
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_init(Database& db, Trail& trail) override
+    {
+        focused->on_init(db, trail);
+        stable->on_init(db, trail);
+    }
+
+    /** Call the event on both heuristics
+     *
+     * @param type type of variables
+     * @param num_vars new number of variables
+     */
+    void on_variable_resize(Variable::Type type, int num_vars) override
+    {
+        focused->on_variable_resize(type, num_vars);
+        stable->on_variable_resize(type, num_vars);
+    }
+
+    /** Call the event on both heuristics
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map, int num_vars) override
+    {
+        focused->on_variable_remap(type, map, num_vars);
+        stable->on_variable_remap(type, map, num_vars);
+    }
+
+    /** Call the event on both heuristics
+     *
+     * @param db clause database
+     * @param trail current solver trail before backtracking
+     * @param level decision level to backtrack to
+     */
+    void on_before_backtrack(Database& db, Trail& trail, int level) override
+    {
+        focused->on_before_backtrack(db, trail, level);
+        stable->on_before_backtrack(db, trail, level);
+    }
+
+    /** Call the event on the heuristic of the current mode
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned reference to the newly learned clause in @p db
+     */
+    void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override
+    {
+        active().on_learned_clause(db, trail, learned);
+    }
+
+    /** Call the event on the heuristic of the current mode
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param other clause that is resolved with current conflict clause
+     */
+    void on_conflict_resolved(Database& db, Trail& trail, Clause const& other) override
+    {
+        active().on_conflict_resolved(db, trail, other);
+    }
+
+    /** Call the event on both heuristics
+     *
+     * @param db clause database
+     * @param trail current solver trail after restart
+     */
+    void on_restart(Database& db, Trail& trail) override
+    {
+        focused->on_restart(db, trail);
+        stable->on_restart(db, trail);
+    }
+
+    /** Pick an unassigned variable using the heuristic of the current mode
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @return unassigned variable or none if all variables are assigned
+     */
+    std::optional<Variable> pick(Database& db, Trail& trail) override
+    {
+        return active().pick(db, trail);
+    }
+
+    /** Compare variables using the heuristic of the current mode
+     *
+     * @param lhs first variable
+     * @param rhs second variable
+     * @return true iff @p lhs should be decided before @p rhs in the current mode
+     */
+    bool is_before(Variable lhs, Variable rhs) const override
+    {
+        return active().is_before(lhs, rhs);
+    }
+
+private:
+    // restart policy which determines the current search mode
+    Mode_switch const* modes;
+    // heuristic used in focused mode
+    std::unique_ptr<Variable_order> focused;
+    // heuristic used in stable mode
+    std::unique_ptr<Variable_order> stable;
+
+    template <class T, typename... Args>
+    inline T& set(std::unique_ptr<Variable_order>& heuristic, Args&&... args)
+    {
+        auto obj_ptr = std::make_unique<T>(std::forward<Args>(args)...);
+        auto actual_ptr = obj_ptr.get();
+        heuristic = std::move(obj_ptr);
+        return *actual_ptr;
+    }
+
+    inline Variable_order& active()
+    {
+        return modes->mode() == Mode_switch::Mode::focused ? *focused : *stable;
+    }
+
+    inline Variable_order const& active() const
+    {
+        return modes->mode() == Mode_switch::Mode::focused ? *focused : *stable;
+    }
+};
+
+} // namespace yaga
+
+#endif // YAGA_MODE_ORDER_H
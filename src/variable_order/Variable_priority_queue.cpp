@@ -2,119 +2,102 @@
 
 namespace yaga {
 
-void Variable_priority_queue::push(Variable var, Score score)
+void Variable_priority_queue::push(Variable var)
 {
-    if (position.size() <= var.type())
+    auto var_index = index(var);
+    assert(var_index < scores->size());
+    if (position.size() <= var_index)
     {
-        position.resize(var.type() + 1);
+        position.resize(var_index + 1, missing);
     }
-
-    if (position[var.type()].size() <= static_cast<std::size_t>(var.ord()))
-    {
-        position[var.type()].resize(var.ord() + 1, missing);
-    }
-    assert(position[var.type()][var.ord()] == missing);
+    assert(position[var_index] == missing);
 
     // add the variable to the priority queue
-    position[var.type()][var.ord()] = pq.size();
-    fix_up(pq.insert(pq.end(), {var, score}));
+    pq.push_back(var_index);
+    position[var_index] = static_cast<int>(pq.size() - 1);
+    fix_up(pq.size() - 1);
 }
 
 void Variable_priority_queue::pop()
 {
     assert(!empty());
 
-    auto var = pq.front().first;
-
-    swap(pq.begin(), pq.begin() + (pq.size() - 1));
+    auto var_index = pq.front();
+    auto last = pq.back();
     pq.pop_back();
+    position[var_index] = missing;
 
     if (!pq.empty())
     {
-        fix_down(pq.begin());
+        place(0, last);
+        fix_down(0);
     }
-
-    position[var.type()][var.ord()] = missing;
 }
 
-void Variable_priority_queue::update(Variable var, Score score)
+void Variable_priority_queue::increase(Variable var)
 {
-    auto it = find(var);
-    if (it == pq.end())
-    {
-        return;
-    }
-
-    assert(it != pq.end());
-    auto old_score = it->second;
-    it->second = score;
-
-    if (old_score <= score)
-    {
-        fix_up(it);
-    }
-    else // old_score > score
+    if (contains(var))
     {
-        fix_down(it);
+        fix_up(position[index(var)]);
     }
 }
 
-void Variable_priority_queue::rescale(Score factor)
+void Variable_priority_queue::rebuild()
 {
-    for (auto& [_, score] : pq)
+    if (pq.size() <= 1)
     {
-        score /= factor;
+        return;
     }
 
-    // Some scores may become equal in which case the heap invariant is broken (since we use
-    // an ordering induced by `is_before()` which is not solely based on score).
-    if (!pq.empty())
+    // Floyd's bottom-up construction of the heap
+    for (auto node = parent(pq.size() - 1) + 1; node-- > 0;)
     {
-        for (auto it = pq.begin() + (pq.size() - 1) / arity; it != pq.begin(); --it)
-        {
-            fix_down(it);
-        }
-        fix_down(pq.begin());
+        fix_down(node);
     }
 }
 
-void Variable_priority_queue::fix_up(Iterator it)
+void Variable_priority_queue::fix_up(std::size_t node)
 {
-    for (; it != pq.begin(); it = parent(it))
+    auto var_index = pq[node];
+    while (node > 0 && is_before(var_index, pq[parent(node)]))
     {
-        auto parent_it = parent(it);
-        if (is_before(*it, *parent_it))
-        {
-            swap(it, parent_it);
-        }
+        place(node, pq[parent(node)]);
+        node = parent(node);
     }
+    place(node, var_index);
 }
 
-void Variable_priority_queue::fix_down(Iterator it)
+void Variable_priority_queue::fix_down(std::size_t node)
 {
-    for (auto nodes = children(it); !nodes.empty(); nodes = children(it))
+    auto var_index = pq[node];
+    for (;;)
     {
+        auto begin = node * arity + 1;
+        if (begin >= pq.size())
+        {
+            break;
+        }
+        auto end = std::min(begin + arity, pq.size());
+
         // find child with the maximum score
-        auto max_it = nodes.begin();
-        for (auto child_it = ++nodes.begin(); child_it != nodes.end(); ++child_it)
+        auto max_child = begin;
+        for (auto child = begin + 1; child < end; ++child)
         {
-            if (is_before(*child_it, *max_it))
+            if (is_before(pq[child], pq[max_child]))
             {
-                max_it = child_it;
+                max_child = child;
             }
         }
 
-        // if the heap invariant is broken
-        if (is_before(*max_it, *it))
-        {
-            swap(max_it, it);
-            it = max_it;
-        }
-        else // the heap invariant is fixed
+        // if the heap invariant is fixed
+        if (!is_before(pq[max_child], var_index))
         {
             break;
         }
+        place(node, pq[max_child]);
+        node = max_child;
     }
+    place(node, var_index);
 }
 
-} // namespace yaga
\ No newline at end of file
+} // namespace yaga
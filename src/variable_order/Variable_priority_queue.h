@@ -3,15 +3,21 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <ranges>
-#include <tuple>
 #include <vector>
 
 #include "Variable.h"
 
 namespace yaga {
 
-/** Implementation of a d-ary (max) heap which supports increasing variable scores.
+/** Implementation of a d-ary (max) heap of variables ordered by an external array of scores.
+ *
+ * Scores are not stored in the heap. They are stored in a vector owned by the user of this class
+ * which is indexed by `index()` of a variable. The vector has to outlive the priority queue. If
+ * the user increases score of a variable in the queue, it has to call `increase()` to restore the
+ * heap invariant. If the user changes all scores at once (e.g., when scores are rescaled), it
+ * should call `rebuild()` which restores the heap invariant in linear time.
  *
  * To disambiguate cases in which two scores are equal, we also use variable type and ordinal
  * to sort variables.
@@ -20,14 +26,33 @@ class Variable_priority_queue {
 public:
     using Score = float;
 
+    /** Create an empty priority queue
+     *
+     * @param scores map `index()` of a variable -> score of the variable
+     */
+    inline explicit Variable_priority_queue(std::vector<Score> const& scores) : scores(&scores) {}
+
+    /** Get index of @p var in a flat array of all variables
+     *
+     * Variables of different types are interleaved so that the index of an existing variable
+     * does not change when new variables are added.
+     *
+     * @param var variable
+     * @return index of @p var
+     */
+    inline static std::size_t index(Variable var)
+    {
+        return static_cast<std::size_t>(var.ord()) * num_types + var.type();
+    }
+
     /** Add a new variable to the priority queue
      *
-     * Precondition: @p var is not in this priority queue
+     * Precondition: @p var is not in this priority queue and the score vector contains a score
+     * of @p var
      *
      * @param var new variable to add to the queue
-     * @param score initial score of @p var
      */
-    void push(Variable var, Score score);
+    void push(Variable var);
 
     /** Remove variable with the maximal score (`top()`) from the priority queue.
      *
@@ -42,25 +67,29 @@ public:
      */
     inline bool contains(Variable var) const
     {
-        return position.size() > var.type() &&
-               position[var.type()].size() > static_cast<std::size_t>(var.ord()) &&
-               position[var.type()][var.ord()] != missing;
+        auto var_index = index(var);
+        return var_index < position.size() && position[var_index] != missing;
     }
 
-    /** Update score of @p var to @p score
+    /** Restore the heap invariant after score of @p var has been increased.
      *
      * If @p var is not in the priority queue, this method does nothing.
      *
-     * @param var variable to update
-     * @param score new score of @p var
+     * @param var variable whose score has been increased
      */
-    void update(Variable var, Score score);
+    void increase(Variable var);
 
-    /** Divide all scores by @p factor
-     *
-     * @param factor constant by which all scores in the queue will be divided
+    /** Restore the heap invariant after an arbitrary change of scores in linear time.
      */
-    void rescale(Score factor);
+    void rebuild();
+
+    /** Remove all variables from the priority queue
+     */
+    inline void clear()
+    {
+        pq.clear();
+        position.clear();
+    }
 
     /** Get variable with the highest score in this priority queue
      *
@@ -71,7 +100,7 @@ public:
     inline Variable top()
     {
         assert(!empty());
-        return pq.front().first;
+        return variable(pq.front());
     }
 
     /** Check whether this priority queue is empty
@@ -81,129 +110,94 @@ public:
     inline bool empty() const { return pq.empty(); }
 
     /** Get number of variables in the priority queue.
-     * 
+     *
      * @return number of variables in the priority queue.
      */
     inline std::size_t size() const { return pq.size(); }
 
     /** Get view of all variables in the priority queue
-     * 
+     *
      * @return range of all variables in the priority queue
      */
-    inline std::ranges::view auto vars() { 
-        return pq | std::views::transform([](auto&& node) { 
-            return node.first; 
-        }); 
+    inline std::ranges::view auto vars() {
+        return pq | std::views::transform([](auto var_index) {
+            return variable(var_index);
+        });
     }
 private:
-    using Node = std::pair<Variable, Score>;
-    using Iterator = std::vector<Node>::iterator;
-
-    // priority queue
-    std::vector<Node> pq;
-    // position of a variable in the queue
-    std::vector<std::vector<int>> position;
-
+    // map variable index -> score of the variable
+    std::vector<Score> const* scores;
+    // priority queue of variable indices
+    std::vector<std::size_t> pq;
+    // map variable index -> position of the variable in the queue
+    std::vector<int> position;
+
+    // number of variable types
+    inline static std::size_t constexpr num_types = 2;
     // maximum number of children of a node
     inline static std::size_t constexpr arity = 4;
     // position of a variable which is not in the priority queue
     inline static int constexpr missing = -1;
 
-    /** Check whether @p lhs is ordered before @p rhs
-     *
-     * @param lhs first variable
-     * @param rhs second variable
-     * @return true iff @p lhs is ordered before @p rhs
-     */
-    inline bool is_before(Variable lhs, Variable rhs) const
+    // convert variable index to a variable
+    inline static Variable variable(std::size_t var_index)
     {
-        return lhs.type() < rhs.type() || (lhs.type() == rhs.type() && lhs.ord() < rhs.ord());
+        return Variable{static_cast<int>(var_index / num_types),
+                        static_cast<Variable::Type>(var_index % num_types)};
     }
 
-    /** Check whether @p lhs is ordered before @p rhs
+    /** Check whether variable with index @p lhs is ordered before variable with index @p rhs
      *
-     * @param lhs first node
-     * @param rhs second node
+     * @param lhs index of the first variable
+     * @param rhs index of the second variable
      * @return true iff @p lhs is ordered before @p rhs
      */
-    inline bool is_before(Node lhs, Node rhs) const
-    {
-        return lhs.second > rhs.second ||
-               (lhs.second == rhs.second && is_before(lhs.first, rhs.first));
-    }
-
-    /** Find position of @p var in this priority queue
-     *
-     * @param var queried variable
-     * @return position of @p var in this priority queue or end iterator if @p var is not in this
-     * queue
-     */
-    inline Iterator find(Variable var)
+    inline bool is_before(std::size_t lhs, std::size_t rhs) const
     {
-        if (position.size() <= var.type() ||
-            position[var.type()].size() <= static_cast<std::size_t>(var.ord()) ||
-            position[var.type()][var.ord()] < 0)
+        auto lhs_score = (*scores)[lhs];
+        auto rhs_score = (*scores)[rhs];
+        if (lhs_score != rhs_score)
         {
-            return pq.end();
+            return lhs_score > rhs_score;
         }
-        return pq.begin() + position[var.type()][var.ord()];
+        auto lhs_type = lhs % num_types;
+        auto rhs_type = rhs % num_types;
+        return lhs_type < rhs_type || (lhs_type == rhs_type && lhs < rhs);
     }
 
-    /** Get iterator pointing at the parent of node at @p it
+    /** Get position of the parent of node at position @p node
      *
-     * @param it iterator pointing at a node
-     * @return iterator pointing at the parent of node at @p it or @p it itself if @p it is the root
+     * @param node position of a node other than the root
+     * @return position of the parent of @p node
      */
-    inline Iterator parent(Iterator it)
-    {
-        auto node_index = std::distance(pq.begin(), it);
-        return node_index > 0 ? pq.begin() + (node_index - 1) / arity : pq.begin();
-    }
+    inline static std::size_t parent(std::size_t node) { return (node - 1) / arity; }
 
-    /** Get range of children of a node
+    /** Move variable index @p var_index to position @p node
      *
-     * @param it iterator of a node
-     * @return range of children of @p it
+     * @param node position in the priority queue
+     * @param var_index index of a variable
      */
-    inline auto children(Iterator it)
+    inline void place(std::size_t node, std::size_t var_index)
     {
-        auto node_index = std::distance(pq.begin(), it);
-        auto begin_index = std::min<std::size_t>(node_index * arity + 1, pq.size());
-        auto end_index = std::min<std::size_t>(begin_index + arity, pq.size());
-        return std::ranges::subrange{pq.begin() + begin_index, pq.begin() + end_index};
-    }
-
-    /** Swap two nodes and variable positions
-     *
-     * @param first_node_it iterator pointing at the first node
-     * @param second_node_it iterator pointing at the second node
-     */
-    inline void swap(Iterator first_node_it, Iterator second_node_it)
-    {
-        // swap nodes
-        std::iter_swap(first_node_it, second_node_it);
-
-        // update variable positions
-        auto var = first_node_it->first;
-        auto other_var = second_node_it->first;
-        std::swap(position[var.type()][var.ord()], position[other_var.type()][other_var.ord()]);
+        pq[node] = var_index;
+        position[var_index] = static_cast<int>(node);
     }
 
-    /** Fix the heap invariant on the way up from @p it
+    /** Fix the heap invariant on the way up from @p node
      *
-     * @param it iterator pointing at a node which (possibly) breaks the heap invariant on the way
-     * to the root
+     * @param node position of a node which (possibly) breaks the heap invariant on the way to
+     * the root
      */
-    void fix_up(Iterator it);
+    void fix_up(std::size_t node);
 
-    /** Fix the heap invariant on the way from @p it to a leaf node
+    /** Fix the heap invariant on the way from @p node to a leaf node
      *
-     * @param it iterator pointing at a node which (possibly) breaks the heap invariant on a way
-     * to a leaf
+     * @param node position of a node which (possibly) breaks the heap invariant on a way to
+     * a leaf
      */
-    void fix_down(Iterator it);
+    void fix_down(std::size_t node);
 };
 
 } // namespace yaga
 
-#endif // YAGA_VARIABLE_PRIORITY_QUEUE_H
\ No newline at end of file
+#endif // YAGA_VARIABLE_PRIORITY_QUEUE_H
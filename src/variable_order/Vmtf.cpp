@@ -0,0 +1,255 @@
+#include "Vmtf.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace yaga {
+
+void Vmtf::dequeue(Variable var)
+{
+    auto& var_node = node(var);
+    if (is_none(var_node.prev))
+    {
+        first = var_node.next;
+    }
+    else
+    {
+        node(var_node.prev).next = var_node.next;
+    }
+
+    if (is_none(var_node.next))
+    {
+        last = var_node.prev;
+    }
+    else
+    {
+        node(var_node.next).prev = var_node.prev;
+    }
+}
+
+void Vmtf::enqueue(Variable var)
+{
+    auto& var_node = node(var);
+    var_node.prev = last;
+    var_node.next = none;
+    var_node.stamp = ++current_stamp;
+    if (is_none(last))
+    {
+        first = var;
+    }
+    else
+    {
+        node(last).next = var;
+    }
+    last = var;
+}
+
+void Vmtf::on_variable_resize(Variable::Type type, int num_vars)
+{
+    if (nodes.size() <= static_cast<std::size_t>(type))
+    {
+        nodes.resize(type + 1);
+    }
+
+    int var_ord = static_cast<int>(nodes[type].size());
+    nodes[type].resize(num_vars, Node{none, none, 0});
+    for (; var_ord < num_vars; ++var_ord)
+    {
+        enqueue(Variable{var_ord, type});
+    }
+    search = last;
+    if (type == Variable::rational)
+    {
+        is_collected.resize(num_vars, false);
+    }
+}
+
+void Vmtf::on_variable_remap(Variable::Type type, std::vector<int> const& map, int num_vars)
+{
+    if (nodes.size() <= static_cast<std::size_t>(type))
+    {
+        nodes.resize(type + 1);
+    }
+
+    // move stamps of renumbered variables (new variables will be moved to the front)
+    std::vector<Stamp> stamps;
+    stamps.reserve(nodes[type].size());
+    for (auto const& var_node : nodes[type])
+    {
+        stamps.push_back(var_node.stamp);
+    }
+    remap_values(stamps, map, num_vars, std::numeric_limits<Stamp>::max());
+    nodes[type].assign(num_vars, Node{none, none, 0});
+    for (int var_ord = 0; var_ord < num_vars; ++var_ord)
+    {
+        nodes[type][var_ord].stamp = stamps[var_ord];
+    }
+
+    // link all variables again in the order of their stamps
+    std::vector<Variable> queue;
+    for (std::size_t var_type = 0; var_type < nodes.size(); ++var_type)
+    {
+        for (int var_ord = 0; var_ord < static_cast<int>(nodes[var_type].size()); ++var_ord)
+        {
+            queue.emplace_back(var_ord, static_cast<Variable::Type>(var_type));
+        }
+    }
+    std::stable_sort(queue.begin(), queue.end(),
+                     [&](auto lhs, auto rhs) { return stamp(lhs) < stamp(rhs); });
+
+    first = last = none;
+    for (auto var : queue)
+    {
+        enqueue(var);
+    }
+    search = last;
+    if (type == Variable::rational)
+    {
+        is_collected.assign(num_vars, false);
+    }
+    else
+    {
+        for (auto var : effectively_decided)
+        {
+            is_collected[var.ord()] = false;
+        }
+    }
+    effectively_decided.clear();
+}
+
+void Vmtf::on_init(Database&, Trail&)
+{
+    to_bump.clear();
+    for (auto var : effectively_decided)
+    {
+        is_collected[var.ord()] = false;
+    }
+    effectively_decided.clear();
+    search = last;
+}
+
+void Vmtf::on_before_backtrack(Database&, Trail& trail, int level)
+{
+    for (int i = trail.decision_level(); i > level; --i)
+    {
+        for (auto [var, _] : trail.assigned(i))
+        {
+            if (trail.decision_level(var).value() > level &&
+                (is_none(search) || stamp(var) > stamp(search)))
+            {
+                search = var;
+            }
+        }
+    }
+}
+
+void Vmtf::collect(int bool_var_ord)
+{
+    to_bump.emplace_back(bool_var_ord, Variable::boolean);
+    if (lra != nullptr)
+    {
+        for (auto lra_var_ord : lra->constraint(bool_var_ord).vars())
+        {
+            to_bump.emplace_back(lra_var_ord, Variable::rational);
+        }
+    }
+}
+
+void Vmtf::on_conflict_resolved(Database&, Trail&, Clause const& other)
+{
+    for (auto lit : other)
+    {
+        collect(lit.var().ord());
+    }
+}
+
+void Vmtf::on_learned_clause(Database&, Trail& trail, Clause const& learned)
+{
+    for (auto lit : learned)
+    {
+        collect(lit.var().ord());
+    }
+
+    // move variables to the front in the order of their current position in the queue
+    std::sort(to_bump.begin(), to_bump.end(), [&](auto lhs, auto rhs) {
+        return stamp(lhs) < stamp(rhs);
+    });
+    to_bump.erase(std::unique(to_bump.begin(), to_bump.end()), to_bump.end());
+
+    for (auto var : to_bump)
+    {
+        if (var == search)
+        {
+            search = is_none(node(var).prev) ? node(var).next : node(var).prev;
+        }
+        dequeue(var);
+        enqueue(var);
+        if (!trail.decision_level(var))
+        {
+            search = var;
+        }
+    }
+    to_bump.clear();
+}
+
+bool Vmtf::is_before(Variable lhs, Variable rhs) const { return stamp(lhs) > stamp(rhs); }
+
+std::optional<Variable> Vmtf::pick_effectively_decided(Trail& trail)
+{
+    for (int var_ord : lra->effectively_decided())
+    {
+        if (!is_collected[var_ord])
+        {
+            is_collected[var_ord] = true;
+            effectively_decided.emplace_back(var_ord, Variable::rational);
+        }
+    }
+
+    // remove variables which are assigned or which are not effectively decided anymore
+    auto models = lra->relevant_models(trail);
+    std::erase_if(effectively_decided, [&](auto var) {
+        if (trail.decision_level(var) || !lra->is_effectively_decided(models, var.ord()))
+        {
+            is_collected[var.ord()] = false;
+            return true;
+        }
+        return false;
+    });
+
+    auto it = std::max_element(effectively_decided.begin(), effectively_decided.end(),
+                               [&](auto lhs, auto rhs) { return stamp(lhs) < stamp(rhs); });
+    if (it == effectively_decided.end())
+    {
+        return {};
+    }
+    return *it;
+}
+
+std::optional<Variable> Vmtf::pick_front(Trail& trail)
+{
+    while (!is_none(search) && trail.decision_level(search))
+    {
+        search = node(search).prev;
+    }
+
+    if (is_none(search))
+    {
+        search = last; // restart the search after the next backtrack
+        return {};
+    }
+    return search;
+}
+
+std::optional<Variable> Vmtf::pick(Database&, Trail& trail)
+{
+    if (lra)
+    {
+        if (auto var = pick_effectively_decided(trail))
+        {
+            return var;
+        }
+    }
+    return pick_front(trail);
+}
+
+} // namespace yaga
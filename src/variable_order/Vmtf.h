@@ -0,0 +1,173 @@
+#ifndef YAGA_VMTF_H
+#define YAGA_VMTF_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Linear_arithmetic.h"
+#include "Trail.h"
+#include "Variable.h"
+#include "Variable_order.h"
+
+namespace yaga {
+
+/** Variable-move-to-front heuristic.
+ *
+ * Variables of all types are kept in a doubly linked queue ordered by the time they were last
+ * bumped. Variables involved in conflict derivation are moved to the front of the queue. If
+ * the LRA plugin is set, bumping a boolean variable which implements a linear constraint also
+ * bumps all rational variables in the constraint (similarly to `Generalized_vsids`).
+ */
+class Vmtf final : public Variable_order {
+public:
+    using Stamp = std::uint64_t;
+
+    virtual ~Vmtf() = default;
+
+    /** Create a queue without the LRA plugin (rational variables are not bumped).
+     */
+    inline Vmtf() : lra(nullptr) {}
+
+    /** Create a queue which bumps rational variables in linear constraints.
+     *
+     * @param lra LRA plugin with linear constraints
+     */
+    inline explicit Vmtf(Linear_arithmetic& lra) : lra(&lra) {}
+
+    /** Add new variables to the front of the queue
+     *
+     * @param type type of variables
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_resize(Variable::Type type, int num_vars) override;
+
+    /** Rebuild the queue after variables of type @p type have been renumbered.
+     *
+     * The relative order of the remaining variables is preserved. New variables are added to
+     * the front of the queue.
+     *
+     * @param type type of variables
+     * @param map map old ordinal number -> new ordinal number or -1
+     * @param num_vars new number of variables of type @p type
+     */
+    void on_variable_remap(Variable::Type type, std::vector<int> const& map,
+                           int num_vars) override;
+
+    /** Start searching for unassigned variables from the front of the queue.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     */
+    void on_init(Database& db, Trail& trail) override;
+
+    /** Move the search position to unassigned variables which are closer to the front of
+     * the queue.
+     *
+     * @param db clause database
+     * @param trail solver trail before backtracking
+     * @param level decision level to backtrack to
+     */
+    void on_before_backtrack(Database& db, Trail& trail, int level) override;
+
+    /** Move all variables collected in this conflict and variables in @p learned to the front
+     * of the queue.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param learned reference to the newly learned clause in @p db
+     */
+    void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override;
+
+    /** Collect variables in @p other so that they are bumped once the clause is learned.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @param other clause that has just been resolved with conflict clause in conflict analysis
+     */
+    void on_conflict_resolved(Database& db, Trail& trail, Clause const& other) override;
+
+    /** Pick an effectively decided rational variable (see
+     * `Linear_arithmetic::effectively_decided()`) closest to the front of the queue. If there is
+     * no such variable, pick the unassigned variable closest to the front of the queue.
+     *
+     * @param db clause database
+     * @param trail current solver trail
+     * @return unassigned variable or none if all variables are assigned
+     */
+    std::optional<Variable> pick(Database& db, Trail& trail) override;
+
+    /** Check whether @p lhs has been bumped more recently than @p rhs
+     *
+     * @param lhs first variable
+     * @param rhs second variable
+     * @return true iff @p lhs is closer to the front of the queue than @p rhs
+     */
+    bool is_before(Variable lhs, Variable rhs) const override;
+
+    /** Get time when @p var was last moved to the front of the queue
+     *
+     * @param var queried variable
+     * @return timestamp of @p var
+     */
+    inline Stamp stamp(Variable var) const { return node(var).stamp; }
+
+private:
+    struct Node {
+        // previous variable in the queue (closer to the back) or `none`
+        Variable prev;
+        // next variable in the queue (closer to the front) or `none`
+        Variable next;
+        // time when the variable was last moved to the front
+        Stamp stamp;
+    };
+
+    // placeholder for a missing variable in the queue
+    inline static Variable const none{-1, Variable::boolean};
+
+    // map variable type -> variable ordinal -> node in the queue
+    std::vector<std::vector<Node>> nodes;
+    // the least recently bumped variable
+    Variable first = none;
+    // the most recently bumped variable
+    Variable last = none;
+    // all variables closer to the front of the queue than `search` are assigned
+    Variable search = none;
+    // current timestamp
+    Stamp current_stamp = 0;
+    // variables collected in the current conflict
+    std::vector<Variable> to_bump;
+    // LRA plugin with linear constraints or nullptr
+    Linear_arithmetic* lra;
+    // rational variables reported as effectively decided by `lra`
+    std::vector<Variable> effectively_decided;
+    // map rational variable ordinal -> true iff it is in `effectively_decided`
+    std::vector<bool> is_collected;
+
+    inline static bool is_none(Variable var) { return var.ord() < 0; }
+
+    inline Node& node(Variable var) { return nodes[var.type()][var.ord()]; }
+
+    inline Node const& node(Variable var) const { return nodes[var.type()][var.ord()]; }
+
+    // remove `var` from the queue
+    void dequeue(Variable var);
+
+    // add `var` to the front of the queue
+    void enqueue(Variable var);
+
+    // add variables which implement the boolean variable `bool_var_ord` to `to_bump`
+    void collect(int bool_var_ord);
+
+    // pick the most recently bumped effectively decided variable or none
+    std::optional<Variable> pick_effectively_decided(Trail& trail);
+
+    // pick the unassigned variable closest to the front of the queue
+    std::optional<Variable> pick_front(Trail& trail);
+};
+
+} // namespace yaga
+
+#endif // YAGA_VMTF_H
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "test.h"
+#include "Solver_answer.h"
+
+namespace {
+
+/** Solve the input of @p test and read the Alethe proof
+ *
+ * @param test test with a formula in its input
+ * @param format Alethe proof format (in memory or streamed)
+ * @return content of the proof file
+ */
+std::string alethe_proof(yaga::test::Yaga_test& test, yaga::Options::Proof_format format)
+{
+    auto path = std::filesystem::temp_directory_path() / "yaga_alethe_test.alethe";
+    std::filesystem::remove(path);
+
+    yaga::Options options;
+    options.produce_proofs = true;
+    options.proof_format = format;
+    options.proof_path = path.string();
+    test.set_options(options);
+    test.run();
+    REQUIRE(test.answer() == yaga::Solver_answer::UNSAT);
+
+    std::stringstream proof;
+    {
+        std::ifstream in{path};
+        REQUIRE(in.is_open());
+        proof << in.rdbuf();
+    }
+    std::filesystem::remove(path);
+    return proof.str();
+}
+
+} // namespace
+
+TEST_CASE("Derive LRA bound conflicts in Alethe proofs", "[alethe]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Yaga_test test;
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun p () Bool)\n";
+    test.input() << "(declare-fun q () Bool)\n";
+    test.input() << "(assert (or p q))\n";
+    test.input() << "(assert (<= (+ (* 2 x) (* 3 y)) 1))\n";
+    test.input() << "(assert (>= x 1))\n";
+    test.input() << "(assert (>= y 0))\n";
+
+    SECTION("in memory")
+    {
+        // the disjunction is not needed so its steps are pruned and the rest is renumbered
+        auto proof = alethe_proof(test, Options::Proof_format::alethe_memory);
+        REQUIRE(proof ==
+                "(assume t1 (! (<= (+ x (* (/ 3 2) y)) (/ 1 2)) :named @p3))\n"
+                "(assume t2 (not (! (< x 1) :named @p4)))\n"
+                "(assume t3 (not (! (< y 0) :named @p5)))\n"
+                "(step t4 (cl (not @p3) @p5 (! (<= x (/ 1 2)) :named @p6)) :rule la_generic "
+                ":args (2 3 2))\n"
+                "(step t5 (cl @p6) :rule resolution :premises (t4 t1 t3))\n"
+                "(step t6 (cl @p4 (not @p6)) :rule la_generic :args (1 1))\n"
+                "(step t7 (cl) :rule resolution :premises (t6 t5 t2))\n");
+    }
+
+    SECTION("streamed")
+    {
+        auto proof = alethe_proof(test, Options::Proof_format::alethe_stream);
+        REQUIRE(proof ==
+                "(assume t1 (or (! p :named @p0) (! q :named @p1) "
+                "(not (! (or @p0 @p1) :named @p2))))\n"
+                "(step t2 (cl @p0 @p1 (not @p2)) :rule or :premises (t1))\n"
+                "(assume t3 @p2)\n"
+                "(assume t4 (! (<= (+ x (* (/ 3 2) y)) (/ 1 2)) :named @p3))\n"
+                "(assume t5 (not (! (< x 1) :named @p4)))\n"
+                "(assume t6 (not (! (< y 0) :named @p5)))\n"
+                "(step t7 (cl (not @p3) @p5 (! (<= x (/ 1 2)) :named @p6)) :rule la_generic "
+                ":args (2 3 2))\n"
+                "(step t8 (cl @p6) :rule resolution :premises (t7 t4 t6))\n"
+                "(step t9 (cl @p4 (not @p6)) :rule la_generic :args (1 1))\n"
+                "(step t10 (cl) :rule resolution :premises (t9 t8 t5))\n");
+    }
+}
+
+TEST_CASE("Split LRA disequality conflicts in Alethe proofs", "[alethe]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Yaga_test test;
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(assert (<= x y))\n";
+    test.input() << "(assert (>= x y))\n";
+    test.input() << "(assert (not (= x y)))\n";
+
+    // each side of the split is derived by `la_generic` and the sides are joined by
+    // `la_disequality`
+    auto proof = alethe_proof(test, Options::Proof_format::alethe_memory);
+    REQUIRE(proof ==
+            "(assume t1 (! (<= (+ x (* (- 1) y)) 0) :named @p0))\n"
+            "(assume t2 (not (! (< (+ x (* (- 1) y)) 0) :named @p1)))\n"
+            "(assume t3 (not (! (= (+ x (* (- 1) y)) 0) :named @p2)))\n"
+            "(step t4 (cl (not @p0) @p1 (<= (+ x (* (- 1) y)) 0)) :rule la_generic "
+            ":args (1 0 1))\n"
+            "(step t5 (cl (not @p0) @p1 (<= 0 (+ x (* (- 1) y)))) :rule la_generic "
+            ":args (0 1 1))\n"
+            "(step t6 (cl (or @p2 (not (<= (+ x (* (- 1) y)) 0)) "
+            "(not (<= 0 (+ x (* (- 1) y)))))) :rule la_disequality)\n"
+            "(step t7 (cl @p2 (not (<= (+ x (* (- 1) y)) 0)) (not (<= 0 (+ x (* (- 1) y))))) "
+            ":rule or :premises (t6))\n"
+            "(step t8 (cl (not @p0) @p1 @p2) :rule resolution :premises (t7 t4 t5))\n"
+            "(step t9 (cl) :rule resolution :premises (t8 t1 t2 t3))\n");
+}
+
+TEST_CASE("Derive UF congruence conflicts in Alethe proofs", "[alethe]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Yaga_test test;
+    test.input() << "(set-logic QF_UFLRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun f (Real) Real)\n";
+    test.input() << "(assert (= x y))\n";
+    test.input() << "(assert (not (= (f x) (f y))))\n";
+
+    // equalities of terms are linked to the arithmetic atoms of the solver
+    auto proof = alethe_proof(test, Options::Proof_format::alethe_memory);
+    REQUIRE(proof ==
+            "(assume t1 (! (= (+ x (* (- 1) y)) 0) :named @p0))\n"
+            "(assume t2 (not (! (= (+ (f x) (* (- 1) (f y))) 0) :named @p1)))\n"
+            "(step t3 (cl (or (= x y) (not (<= x y)) (not (<= y x)))) :rule la_disequality)\n"
+            "(step t4 (cl (= x y) (not (<= x y)) (not (<= y x))) :rule or :premises (t3))\n"
+            "(step t5 (cl (<= x y) (not @p0)) :rule la_generic :args (1 1))\n"
+            "(step t6 (cl (<= y x) (not @p0)) :rule la_generic :args (1 (- 1)))\n"
+            "(step t7 (cl (= x y) (not @p0)) :rule resolution :premises (t4 t5 t6))\n"
+            "(step t8 (cl (or @p1 (not (<= (+ (f x) (* (- 1) (f y))) 0)) "
+            "(not (<= 0 (+ (f x) (* (- 1) (f y))))))) :rule la_disequality)\n"
+            "(step t9 (cl @p1 (not (<= (+ (f x) (* (- 1) (f y))) 0)) "
+            "(not (<= 0 (+ (f x) (* (- 1) (f y)))))) :rule or :premises (t8))\n"
+            "(step t10 (cl (<= (+ (f x) (* (- 1) (f y))) 0) (not (= (f x) (f y)))) "
+            ":rule la_generic :args (1 1))\n"
+            "(step t11 (cl (<= 0 (+ (f x) (* (- 1) (f y)))) (not (= (f x) (f y)))) "
+            ":rule la_generic :args (1 (- 1)))\n"
+            "(step t12 (cl @p1 (not (= (f x) (f y)))) :rule resolution "
+            ":premises (t9 t10 t11))\n"
+            "(step t13 (cl (not (= x y)) (= (f x) (f y))) :rule eq_congruent)\n"
+            "(step t14 (cl (not @p0) @p1) :rule resolution :premises (t13 t7 t12))\n"
+            "(step t15 (cl) :rule resolution :premises (t14 t1 t2))\n");
+}
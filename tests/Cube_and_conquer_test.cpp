@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Cube_and_conquer.h"
+#include "Cuber.h"
+#include "Evsids.h"
+#include "Solver.h"
+
+namespace {
+
+// initialize a boolean solver with the pigeonhole principle for `pigeons` pigeons and `holes` holes
+void setup_pigeonhole(yaga::Solver& solver, int pigeons, int holes)
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<Glucose_restart>();
+
+    assert_pigeonhole(solver, pigeons, holes);
+}
+
+} // namespace
+
+TEST_CASE("Split a formula into cubes", "[cube_and_conquer][lookahead]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    setup_pigeonhole(solver, 5, 5);
+    Cuber cuber{25};
+
+    SECTION("cubes are consistent and distinct")
+    {
+        auto cubes = cuber.split(solver, {}, 3);
+        REQUIRE(!cubes.empty());
+        REQUIRE(cubes.size() <= 8);
+        REQUIRE(cuber.num_probes() > 0);
+        for (auto const& cube : cubes)
+        {
+            REQUIRE(cube.size() <= 3);
+            for (auto lit : cube)
+            {
+                REQUIRE(std::find(cube.begin(), cube.end(), ~lit) == cube.end());
+            }
+        }
+        std::sort(cubes.begin(), cubes.end());
+        REQUIRE(std::adjacent_find(cubes.begin(), cubes.end()) == cubes.end());
+        REQUIRE(solver.trail().empty());
+    }
+
+    SECTION("cubes extend a prefix")
+    {
+        std::vector<Literal> prefix{lit(0)};
+        auto cubes = cuber.split(solver, prefix, 1);
+        REQUIRE(!cubes.empty());
+        for (auto const& cube : cubes)
+        {
+            REQUIRE(cube.size() == 2);
+            REQUIRE(cube[0] == lit(0));
+        }
+    }
+
+    SECTION("refuted prefix")
+    {
+        // pigeons 0 and 1 cannot be in hole 0 together
+        std::vector<Literal> prefix{lit(0), lit(5)};
+        REQUIRE(cuber.split(solver, prefix, 2).empty());
+    }
+}
+
+TEST_CASE("Solve cubes in parallel", "[cube_and_conquer][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Cube_and_conquer::Options options;
+    options.num_workers = 4;
+    options.conflicts_per_cube = 20;
+
+    SECTION("unsatisfiable formula")
+    {
+        Cube_and_conquer solver{[](Solver& worker) { setup_pigeonhole(worker, 7, 6); }, options};
+        REQUIRE(solver.solve() == Solver::Result::unsat);
+        REQUIRE(solver.num_cubes() >= 16);
+        REQUIRE(solver.num_splits() > 0);
+        REQUIRE(solver.num_shared_clauses() == 0);
+    }
+
+    SECTION("unsatisfiable formula with clause sharing")
+    {
+        options.max_shared_size = 8;
+        Cube_and_conquer solver{[](Solver& worker) { setup_pigeonhole(worker, 7, 6); }, options};
+        REQUIRE(solver.solve() == Solver::Result::unsat);
+        REQUIRE(solver.num_shared_clauses() > 0);
+    }
+
+    SECTION("satisfiable formula")
+    {
+        options.max_shared_size = 8;
+        Solver input;
+        setup_pigeonhole(input, 8, 8);
+        Cube_and_conquer solver{[](Solver& worker) { setup_pigeonhole(worker, 8, 8); }, options};
+        REQUIRE(solver.solve() == Solver::Result::sat);
+        auto const& model = solver.model();
+        for (auto const& clause : input.db().asserted())
+        {
+            REQUIRE(eval(model, clause) == true);
+        }
+    }
+
+    SECTION("exception in a worker")
+    {
+        Cube_and_conquer solver{[](Solver&) { throw std::logic_error{"setup failed"}; }, options};
+        REQUIRE_THROWS_AS(solver.solve(), std::logic_error);
+    }
+}
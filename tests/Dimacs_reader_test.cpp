@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.h"
+#include "Dimacs_reader.h"
+
+namespace {
+
+// formula `p cnf 3 2 / 1 -2 0 / 2 3 0` compressed by `gzip -9 -n`
+[[maybe_unused]] std::vector<unsigned char> const gzip_formula{
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x2B, 0x50,
+    0x48, 0xCE, 0x4B, 0x53, 0x30, 0x56, 0x30, 0xE2, 0x32, 0x54, 0xD0, 0x35,
+    0x52, 0x30, 0xE0, 0x32, 0x02, 0x72, 0x0C, 0xB8, 0x00, 0x9E, 0xAA, 0x51,
+    0x9F, 0x17, 0x00, 0x00, 0x00,
+};
+
+// formula `p cnf 3 2 / 1 -2 0 / 2 3 0` compressed by `xz -9`
+[[maybe_unused]] std::vector<unsigned char> const xz_formula{
+    0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x04, 0xE6, 0xD6, 0xB4, 0x46,
+    0x04, 0xC0, 0x1B, 0x17, 0x21, 0x01, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x26, 0x02, 0x80, 0x23, 0x01, 0x00, 0x16, 0x70,
+    0x20, 0x63, 0x6E, 0x66, 0x20, 0x33, 0x20, 0x32, 0x0A, 0x31, 0x20, 0x2D,
+    0x32, 0x20, 0x30, 0x0A, 0x32, 0x20, 0x33, 0x20, 0x30, 0x0A, 0x00, 0x00,
+    0x81, 0xB7, 0x72, 0xBB, 0xC8, 0x73, 0xAA, 0x8C, 0x00, 0x01, 0x37, 0x17,
+    0xD8, 0x90, 0x52, 0x33, 0x1F, 0xB6, 0xF3, 0x7D, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x59, 0x5A,
+};
+
+// view bytes of a compressed formula as characters
+[[maybe_unused]] std::string_view chars(std::vector<unsigned char> const& bytes)
+{
+    return {reinterpret_cast<char const*>(bytes.data()), bytes.size()};
+}
+
+// write `data` to a temporary file `name` and return its path
+std::filesystem::path write_temporary(std::string const& name, std::string_view data)
+{
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out{path, std::ios::binary};
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("Read a CNF formula in the DIMACS format", "[dimacs_reader]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    Dimacs_reader reader;
+    std::stringstream input;
+    input << "c example formula\n";
+    input << "p cnf 3 4\n";
+    input << "1 -2 0\n";
+    input << "c comment between clauses\n";
+    input << "2 3\n";
+    input << "  -1 0 -3 0\r\n";
+    input << "1 2 3 0\n";
+
+    SECTION("large blocks")
+    {
+        reader.set_block_size(1 << 20);
+    }
+
+    SECTION("small blocks")
+    {
+        reader.set_block_size(3);
+    }
+
+    auto problem = reader.read(input, solver);
+    REQUIRE(problem.num_vars == 3);
+    REQUIRE(problem.num_clauses == 4);
+    REQUIRE(!problem.has_empty_clause);
+    REQUIRE(solver.trail().model<bool>(Variable::boolean).num_vars() == 3);
+
+    auto const& clauses = solver.db().asserted();
+    REQUIRE(clauses.size() == 4);
+    REQUIRE(clauses[0] == clause(lit(0), ~lit(1)));
+    REQUIRE(clauses[1] == clause(lit(1), lit(2), ~lit(0)));
+    REQUIRE(clauses[2] == clause(~lit(2)));
+    REQUIRE(clauses[3] == clause(lit(0), lit(1), lit(2)));
+}
+
+TEST_CASE("Detect an empty clause in DIMACS input", "[dimacs_reader]")
+{
+    using namespace yaga;
+
+    Solver solver;
+    Dimacs_reader reader;
+    std::stringstream input{"p cnf 2 3\n1 2 0\n0\n-1 0\n"};
+    auto problem = reader.read(input, solver);
+    REQUIRE(problem.has_empty_clause);
+    REQUIRE(solver.db().asserted().size() == 1);
+}
+
+TEST_CASE("Ignore clauses after the declared number of clauses", "[dimacs_reader]")
+{
+    using namespace yaga;
+
+    Solver solver;
+    Dimacs_reader reader;
+    std::stringstream input{"p cnf 2 1\n1 2 0\n-1 0\n%\n0\n"};
+    auto problem = reader.read(input, solver);
+    REQUIRE(!problem.has_empty_clause);
+    REQUIRE(solver.db().asserted().size() == 1);
+}
+
+TEST_CASE("Reject malformed DIMACS input", "[dimacs_reader]")
+{
+    using namespace yaga;
+
+    Solver solver;
+    Dimacs_reader reader;
+    std::stringstream input;
+
+    SECTION("missing problem line")
+    {
+        input << "1 2 0\n";
+    }
+
+    SECTION("duplicate problem line")
+    {
+        input << "p cnf 2 1\np cnf 2 1\n1 2 0\n";
+    }
+
+    SECTION("invalid problem line")
+    {
+        input << "p dnf 2 1\n1 2 0\n";
+    }
+
+    SECTION("unknown literal")
+    {
+        input << "p cnf 2 1\n1 3 0\n";
+    }
+
+    SECTION("unexpected character")
+    {
+        input << "p cnf 2 1\n1 x 0\n";
+    }
+
+    SECTION("number out of range")
+    {
+        input << "p cnf 2 1\n1 99999999999 0\n";
+    }
+
+    SECTION("insufficient number of clauses")
+    {
+        input << "p cnf 2 2\n1 2 0\n";
+    }
+
+    REQUIRE_THROWS_AS(reader.read(input, solver), std::logic_error);
+}
+
+TEST_CASE("Read a CNF formula from a file", "[dimacs_reader]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    Dimacs_reader reader;
+    std::filesystem::path path;
+
+    SECTION("uncompressed")
+    {
+        path = write_temporary("yaga_dimacs_test.cnf", "p cnf 3 2\n1 -2 0\n2 3 0\n");
+    }
+
+#ifdef YAGA_HAVE_ZLIB
+    SECTION("compressed by gzip")
+    {
+        path = write_temporary("yaga_dimacs_test.cnf.gz", chars(gzip_formula));
+    }
+
+    SECTION("compressed by gzip in small blocks")
+    {
+        reader.set_block_size(3);
+        path = write_temporary("yaga_dimacs_test.cnf.gz", chars(gzip_formula));
+    }
+#endif
+
+#ifdef YAGA_HAVE_LZMA
+    SECTION("compressed by xz")
+    {
+        path = write_temporary("yaga_dimacs_test.cnf.xz", chars(xz_formula));
+    }
+#endif
+
+    auto problem = reader.read_file(path.string(), solver);
+    std::filesystem::remove(path);
+    REQUIRE(problem.num_vars == 3);
+    REQUIRE(problem.num_clauses == 2);
+    REQUIRE(!problem.has_empty_clause);
+
+    auto const& clauses = solver.db().asserted();
+    REQUIRE(clauses.size() == 2);
+    REQUIRE(clauses[0] == clause(lit(0), ~lit(1)));
+    REQUIRE(clauses[1] == clause(lit(1), lit(2)));
+}
+
+TEST_CASE("Report a missing DIMACS file", "[dimacs_reader]")
+{
+    using namespace yaga;
+
+    Solver solver;
+    Dimacs_reader reader;
+    auto path = std::filesystem::temp_directory_path() / "yaga_missing_dimacs_test.cnf";
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(reader.read_file(path.string(), solver), std::logic_error);
+}
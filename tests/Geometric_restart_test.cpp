@@ -0,0 +1,31 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test.h"
+#include "Restart.h"
+#include "Trail.h"
+
+TEST_CASE("Increase restart interval geometrically", "[geometric]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Geometric_restart restart;
+    restart.set_initial(4).set_factor(1.5);
+
+    Database db;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&restart);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+
+    for (int limit : {4, 6, 9, 13})
+    {
+        for (int i = 0; i < limit; ++i)
+        {
+            REQUIRE(!restart.should_restart());
+            dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+        }
+        REQUIRE(restart.should_restart());
+        dispatcher.on_restart(db, trail);
+    }
+}
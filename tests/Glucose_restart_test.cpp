@@ -125,4 +125,41 @@ TEST_CASE("Compute clause LBD if decision levels of literals are not consecutive
     restart.on_learned_clause(db, trail, learned);
     REQUIRE_THAT(restart.fast(), Catch::Matchers::WithinRel(2.f / 4));
     REQUIRE_THAT(restart.slow(), Catch::Matchers::WithinRel(2.f / 8));
-}
\ No newline at end of file
+}
+TEST_CASE("Block restart if the trail is longer than usual", "[glucose]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Glucose_restart restart;
+    restart.set_min_conflicts(2);
+    restart.set_block_min_conflicts(0);
+    restart.set_trail_exp(2);
+    restart.set_slow_exp(3);
+    restart.set_fast_exp(2);
+
+    Database db;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&restart);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 9);
+    trail.decide(bool_var(0));
+
+    // short trail at conflicts
+    for (int i = 0; i < 100; ++i)
+    {
+        restart.on_learned_clause(db, trail, clause(lit(0)));
+    }
+    restart.on_restart(db, trail);
+    auto num_blocked = restart.num_blocked();
+
+    // long trail at conflict
+    for (int i = 1; i < 9; ++i)
+    {
+        trail.decide(bool_var(i));
+    }
+    restart.on_learned_clause(db, trail, clause(lit(0)));
+    restart.on_learned_clause(db, trail, clause(lit(0)));
+    REQUIRE(!restart.should_restart());
+    REQUIRE(restart.num_blocked() == num_blocked + 1);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test.h"
+#include "Mode_switch.h"
+#include "Trail.h"
+
+TEST_CASE("Switch between focused and stable mode", "[mode_switch]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Mode_switch modes;
+    modes.set_focused<No_restart>();
+    modes.set_stable<No_restart>();
+    modes.set_interval(2);
+
+    Database db;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&modes);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+
+    auto conflict = [&]() {
+        dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+        dispatcher.on_before_backtrack(db, trail, 0);
+    };
+
+    REQUIRE(modes.mode() == Mode_switch::Mode::focused);
+    REQUIRE(!modes.should_restart());
+
+    conflict();
+    REQUIRE(!modes.should_restart());
+    // backtracking without a learned clause (e.g., restart) is not a conflict
+    dispatcher.on_before_backtrack(db, trail, 0);
+    REQUIRE(!modes.should_restart());
+    conflict();
+    REQUIRE(modes.should_restart());
+    dispatcher.on_restart(db, trail);
+    REQUIRE(modes.mode() == Mode_switch::Mode::stable);
+    REQUIRE(modes.num_switches() == 1);
+
+    conflict();
+    REQUIRE(!modes.should_restart());
+    conflict();
+    REQUIRE(modes.should_restart());
+    dispatcher.on_restart(db, trail);
+    REQUIRE(modes.mode() == Mode_switch::Mode::focused);
+    REQUIRE(modes.num_switches() == 2);
+
+    // the second round is twice as long
+    for (int i = 0; i < 3; ++i)
+    {
+        conflict();
+        REQUIRE(!modes.should_restart());
+    }
+    conflict();
+    REQUIRE(modes.should_restart());
+    dispatcher.on_restart(db, trail);
+    REQUIRE(modes.mode() == Mode_switch::Mode::stable);
+}
+
+TEST_CASE("Use restart policy of the current mode", "[mode_switch]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Mode_switch modes;
+    modes.set_focused<No_restart>();
+    modes.set_stable<Luby_restart>();
+    modes.set_interval(1);
+
+    Database db;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&modes);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+
+    dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+    dispatcher.on_before_backtrack(db, trail, 0);
+    dispatcher.on_restart(db, trail);
+    REQUIRE(modes.mode() == Mode_switch::Mode::stable);
+
+    modes.set_interval(1'000'000);
+    for (int i = 0; i < 549; ++i)
+    {
+        dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+        dispatcher.on_before_backtrack(db, trail, 0);
+        REQUIRE(!modes.should_restart());
+    }
+    dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+    dispatcher.on_before_backtrack(db, trail, 0);
+    REQUIRE(modes.should_restart());
+}
@@ -0,0 +1,250 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "test.h"
+#include "Preprocessor.h"
+#include "Term_manager.h"
+#include "Terms.h"
+
+TEST_CASE("Eliminate variables using top-level equalities", "[preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::terms;
+
+    Term_manager tm;
+    auto x = tm.mk_uninterpreted_constant(types::real_type);
+    auto y = tm.mk_uninterpreted_constant(types::real_type);
+    auto z = tm.mk_uninterpreted_constant(types::real_type);
+    auto one = tm.mk_arithmetic_constant(Rational{1});
+    auto three = tm.mk_arithmetic_constant(Rational{3});
+
+    Preprocessor preprocessor{tm};
+
+    SECTION("substitute the definition in other assertions")
+    {
+        // x - y = 1 and x + y + z >= 3 and z <= x
+        std::array<term_t, 3> sum{x, y, z};
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_eq(tm.mk_arithmetic_minus(x, y), one),
+            tm.mk_arithmetic_geq(tm.mk_arithmetic_plus(sum), three),
+            tm.mk_arithmetic_leq(z, x),
+        };
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(preprocessor.num_eliminated() == 1);
+        REQUIRE(preprocessor.definitions().size() >= 1);
+        auto eliminated = preprocessor.definitions()[0].var;
+        REQUIRE((eliminated == x || eliminated == y));
+        for (auto t : result)
+        {
+            REQUIRE(tm.get_kind(t) != Kind::ARITH_EQ_ATOM);
+            REQUIRE(tm.get_kind(t) != Kind::ARITH_BINEQ_ATOM);
+        }
+
+        // any model of the result is extended to a model of the assertions
+        std::unordered_map<term_t, Rational> values;
+        values[eliminated == x ? y : x] = Rational{2};
+        values[z] = Rational{0};
+        preprocessor.extend_model(values);
+        REQUIRE(values[x] - values[y] == Rational{1});
+    }
+
+    SECTION("detect inconsistent equalities")
+    {
+        // x = y + 1 and x = y
+        std::array<term_t, 2> sum{y, one};
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_eq(x, tm.mk_arithmetic_plus(sum)),
+            tm.mk_arithmetic_eq(x, y),
+        };
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(result == std::vector<term_t>{false_term});
+    }
+
+    SECTION("eliminate equalities inside of top-level conjunctions")
+    {
+        // (and (= x 3) (or (< x y) (< x z)))
+        std::array<term_t, 2> disjuncts{tm.mk_arithmetic_lt(x, y), tm.mk_arithmetic_lt(x, z)};
+        std::array<term_t, 2> conjuncts{tm.mk_arithmetic_eq(x, three), tm.mk_or(disjuncts)};
+        std::vector<term_t> assertions{tm.mk_and(conjuncts)};
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(preprocessor.definitions()[0].var == x);
+        REQUIRE(preprocessor.definitions()[0].value == three);
+        REQUIRE(result.size() == 1);
+        REQUIRE(tm.get_kind(result[0]) == Kind::OR_TERM);
+    }
+}
+
+TEST_CASE("Remove unconstrained variables", "[preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::terms;
+
+    Term_manager tm;
+    auto x = tm.mk_uninterpreted_constant(types::real_type);
+    auto y = tm.mk_uninterpreted_constant(types::real_type);
+    auto b = tm.mk_uninterpreted_constant(types::bool_type);
+    auto one = tm.mk_arithmetic_constant(Rational{1});
+
+    Preprocessor preprocessor{tm};
+
+    // (x + y < 1) and (b or x > 0) and (b or x < -1)
+    std::array<term_t, 2> sum{x, y};
+    std::array<term_t, 2> first{b, tm.mk_arithmetic_gt(x, zero_term)};
+    std::array<term_t, 2> second{b, tm.mk_arithmetic_lt(x, tm.mk_unary_minus(one))};
+    std::vector<term_t> assertions{
+        tm.mk_arithmetic_lt(tm.mk_arithmetic_plus(sum), one),
+        tm.mk_or(first),
+        tm.mk_or(second),
+    };
+    auto result = preprocessor.run(assertions);
+
+    REQUIRE(preprocessor.num_unconstrained() == 1);
+    REQUIRE(preprocessor.definitions().size() == 1);
+    REQUIRE(preprocessor.definitions()[0].var == y);
+    REQUIRE(result.size() == 2);
+
+    std::unordered_map<term_t, Rational> values{{x, Rational{5}}};
+    preprocessor.extend_model(values);
+    REQUIRE(values[x] + values[y] < Rational{1});
+}
+
+TEST_CASE("Propagate bounds through linear constraints", "[preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::terms;
+
+    Term_manager tm;
+    auto x = tm.mk_uninterpreted_constant(types::real_type);
+    auto y = tm.mk_uninterpreted_constant(types::real_type);
+    auto z = tm.mk_uninterpreted_constant(types::real_type);
+    auto one = tm.mk_arithmetic_constant(Rational{1});
+    auto two = tm.mk_arithmetic_constant(Rational{2});
+
+    // x and y occur in two constraints so they are not unconstrained
+    auto z_bound = tm.mk_arithmetic_geq(tm.mk_arithmetic_minus(z, x), y);
+    auto z_upper = tm.mk_arithmetic_leq(z, two);
+
+    Preprocessor preprocessor{tm};
+
+    SECTION("detect a conflict")
+    {
+        // x >= 1 and y > 1 and x + y <= 2
+        std::array<term_t, 2> sum{x, y};
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_geq(x, one),
+            tm.mk_arithmetic_gt(y, one),
+            tm.mk_arithmetic_leq(tm.mk_arithmetic_plus(sum), two),
+            z_bound,
+            z_upper,
+        };
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(result == std::vector<term_t>{false_term});
+    }
+
+    SECTION("assert tightened bounds")
+    {
+        // x >= 1 and x + y <= 1 implies y <= 0
+        std::array<term_t, 2> sum{x, y};
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_geq(x, one),
+            tm.mk_arithmetic_leq(tm.mk_arithmetic_plus(sum), one),
+            z_bound,
+            z_upper,
+        };
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(preprocessor.num_tightened() > 0);
+        REQUIRE(std::find(result.begin(), result.end(), tm.mk_arithmetic_leq(y, zero_term)) !=
+                result.end());
+    }
+
+    SECTION("remove constraints implied by bounds")
+    {
+        // x >= 1 and y >= 1 implies x + y > 1
+        std::array<term_t, 2> sum{x, y};
+        auto implied = tm.mk_arithmetic_gt(tm.mk_arithmetic_plus(sum), one);
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_geq(x, one),
+            tm.mk_arithmetic_geq(y, one),
+            implied,
+            z_bound,
+            z_upper,
+        };
+        auto result = preprocessor.run(assertions);
+
+        REQUIRE(std::find(result.begin(), result.end(), implied) == result.end());
+    }
+
+    SECTION("eliminate variables with a single allowed value")
+    {
+        // x >= 1 and x + y <= 1 and y >= 0 implies x = 1 and y = 0
+        std::array<term_t, 2> sum{x, y};
+        std::vector<term_t> assertions{
+            tm.mk_arithmetic_geq(x, one),
+            tm.mk_arithmetic_leq(tm.mk_arithmetic_plus(sum), one),
+            tm.mk_arithmetic_geq(y, zero_term),
+            z_bound,
+            z_upper,
+        };
+        auto result = preprocessor.run(assertions);
+
+        std::unordered_map<term_t, Rational> values{{z, Rational{2}}};
+        preprocessor.extend_model(values);
+        REQUIRE(values[x] == Rational{1});
+        REQUIRE(values[y] == Rational{0});
+    }
+}
+
+TEST_CASE("Extend model of preprocessed assertions", "[preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Options options;
+    options.preprocess = true;
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun z () Real)\n";
+    test.input() << "(declare-fun w () Real)\n";
+
+    SECTION("sat")
+    {
+        test.input() << "(assert (= (+ x y) 4))\n";
+        test.input() << "(assert (= (- x z) 1))\n";
+        test.input() << "(assert (or (< z 0) (> y 10)))\n";
+        test.input() << "(assert (>= x z))\n";
+        test.input() << "(assert (< (+ w x) 3))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        auto x = test.real("x").value();
+        auto y = test.real("y").value();
+        auto z = test.real("z").value();
+        auto w = test.real("w").value();
+        REQUIRE(x + y == Rational{4});
+        REQUIRE(x - z == Rational{1});
+        REQUIRE((z < Rational{0} || y > Rational{10}));
+        REQUIRE(w + x < Rational{3});
+    }
+
+    SECTION("unsat")
+    {
+        test.input() << "(assert (= (+ x y) 4))\n";
+        test.input() << "(assert (= (- x y) 2))\n";
+        test.input() << "(assert (or (< x 0) (> y 10)))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::UNSAT);
+    }
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "Proof_output.h"
+
+namespace {
+
+// sink which appends all output to a string
+class String_sink final : public yaga::proof::Proof_output::Sink {
+public:
+    String_sink(std::string& output, bool& is_finished)
+        : output(output), is_finished(is_finished)
+    {
+    }
+
+    void write(std::string_view data) override { output += data; }
+
+    void finish() override { is_finished = true; }
+
+private:
+    std::string& output;
+    bool& is_finished;
+};
+
+// sink which fails on every write
+class Failing_sink final : public yaga::proof::Proof_output::Sink {
+public:
+    void write(std::string_view) override { throw std::logic_error{"write failed"}; }
+
+    void finish() override {}
+};
+
+} // namespace
+
+TEST_CASE("Write buffered proof output", "[proof_output]")
+{
+    using namespace yaga::proof;
+    using namespace std::string_literals;
+
+    std::string result;
+    bool is_finished = false;
+    bool async = false;
+    std::size_t buffer_size = Proof_output::default_buffer_size;
+
+    SECTION("synchronous output with a large buffer")
+    {
+    }
+
+    SECTION("synchronous output with a small buffer")
+    {
+        buffer_size = 1;
+    }
+
+    SECTION("asynchronous output with a small buffer")
+    {
+        async = true;
+        buffer_size = 1;
+    }
+
+    SECTION("asynchronous output with a large buffer")
+    {
+        async = true;
+    }
+
+    std::string expected;
+    {
+        Proof_output output{std::make_unique<String_sink>(result, is_finished), async,
+                            buffer_size};
+        for (int i = 0; i < 1000; ++i)
+        {
+            output.put('a');
+            output.write_decimal(-i);
+            output.write(" 0\n");
+            expected += "a" + std::to_string(-i) + " 0\n";
+
+            output.write_varint(i);
+            if (i < 0x80)
+            {
+                expected += static_cast<char>(i);
+            }
+            else
+            {
+                expected += static_cast<char>((i & 0x7F) | 0x80);
+                expected += static_cast<char>(i >> 7);
+            }
+        }
+
+        output.write_varint(0);
+        output.write_varint(~0ull);
+        expected += "\0"s + std::string(9, '\xFF') + '\x01';
+
+        output.flush();
+        REQUIRE(result == expected);
+        REQUIRE(!is_finished);
+        output.close();
+        REQUIRE(is_finished);
+    }
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("Report errors of proof output", "[proof_output]")
+{
+    using namespace yaga::proof;
+
+    bool async = false;
+
+    SECTION("synchronous output")
+    {
+    }
+
+    SECTION("asynchronous output")
+    {
+        async = true;
+    }
+
+    Proof_output output{std::make_unique<Failing_sink>(), async, 64};
+    output.write("some proof");
+    REQUIRE_THROWS_AS(output.flush(), std::logic_error);
+}
@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test.h"
+#include "Restart.h"
+#include "Trail.h"
+
+TEST_CASE("Reluctant doubling generates the luby sequence", "[reluctant_doubling]")
+{
+    using namespace yaga;
+
+    Database db;
+    Event_dispatcher dispatcher;
+    Trail trail{dispatcher};
+
+    Luby_restart luby;
+    Reluctant_doubling_restart restart;
+    for (std::uint32_t i = 1; i < 100; ++i)
+    {
+        REQUIRE(restart.current() == luby.luby(i));
+        restart.on_restart(db, trail);
+    }
+}
+
+TEST_CASE("Restart after a number of conflicts given by reluctant doubling", "[reluctant_doubling]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Reluctant_doubling_restart restart;
+    restart.set_base(2);
+
+    Database db;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&restart);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+
+    for (int limit : {2, 2, 4, 2, 2, 4, 8})
+    {
+        for (int i = 0; i < limit; ++i)
+        {
+            REQUIRE(!restart.should_restart());
+            dispatcher.on_learned_clause(db, trail, clause(lit(0)));
+        }
+        REQUIRE(restart.should_restart());
+        dispatcher.on_restart(db, trail);
+    }
+}
@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <deque>
+
+#include "test.h"
+#include "Sat_preprocessor.h"
+
+namespace {
+
+// check that all `clauses` are satisfied in `model`
+bool is_satisfied(yaga::Model<bool> const& model, std::deque<yaga::Clause> const& clauses)
+{
+    return std::all_of(clauses.begin(), clauses.end(),
+                       [&](auto const& clause) { return yaga::eval(model, clause) == true; });
+}
+
+} // namespace
+
+TEST_CASE("Eliminate variables using resolution", "[sat_preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Sat_preprocessor preprocessor;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&preprocessor);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 4);
+    trail.resize(Variable::boolean, 4);
+
+    Database db;
+    db.assert_clause(lit(0), lit(1));
+    db.assert_clause(~lit(1), lit(2));
+    db.assert_clause(~lit(1), lit(3));
+    db.assert_clause(~lit(2), ~lit(3));
+
+    SECTION("variables which are not frozen are eliminated")
+    {
+        auto original = db.asserted();
+        REQUIRE(preprocessor.run(db, trail));
+        REQUIRE(preprocessor.num_eliminated() > 0);
+        REQUIRE(preprocessor.is_removed(bool_var(1)));
+
+        // any model of the result is extended to a model of the original clauses
+        for (int ord = 0; ord < 4; ++ord)
+        {
+            if (!preprocessor.is_removed(bool_var(ord)))
+            {
+                model.set_value(ord, true);
+            }
+        }
+        REQUIRE(is_satisfied(model, db.asserted()));
+        preprocessor.extend_model(model);
+        REQUIRE(is_satisfied(model, original));
+    }
+
+    SECTION("frozen variables are kept")
+    {
+        for (int ord = 0; ord < 4; ++ord)
+        {
+            preprocessor.freeze(bool_var(ord));
+        }
+        REQUIRE(preprocessor.run(db, trail));
+        REQUIRE(preprocessor.num_eliminated() == 0);
+        REQUIRE(preprocessor.witnesses().empty());
+        for (int ord = 0; ord < 4; ++ord)
+        {
+            REQUIRE(!preprocessor.is_removed(bool_var(ord)));
+        }
+    }
+}
+
+TEST_CASE("Substitute equivalent literals", "[sat_preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Sat_preprocessor preprocessor;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&preprocessor);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 4);
+    trail.resize(Variable::boolean, 4);
+    preprocessor.freeze(bool_var(1));
+    preprocessor.freeze(bool_var(2));
+    preprocessor.freeze(bool_var(3));
+
+    // x0 <=> ~x1
+    Database db;
+    db.assert_clause(lit(0), lit(1));
+    db.assert_clause(~lit(0), ~lit(1));
+    db.assert_clause(lit(0), lit(2), lit(3));
+    db.assert_clause(~lit(0), lit(2), ~lit(3));
+    auto original = db.asserted();
+
+    REQUIRE(preprocessor.run(db, trail));
+    REQUIRE(preprocessor.num_substituted() == 1);
+    REQUIRE(preprocessor.is_removed(bool_var(0)));
+    for (auto const& clause : db.asserted())
+    {
+        REQUIRE(std::none_of(clause.begin(), clause.end(),
+                             [](auto lit) { return lit.var() == bool_var(0); }));
+    }
+
+    model.set_value(1, false);
+    model.set_value(2, false);
+    model.set_value(3, false);
+    REQUIRE(is_satisfied(model, db.asserted()));
+    preprocessor.extend_model(model);
+    REQUIRE(model.value(0) == true);
+    REQUIRE(is_satisfied(model, original));
+}
+
+TEST_CASE("Probe failed literals", "[sat_preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Sat_preprocessor preprocessor;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&preprocessor);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 4);
+    trail.resize(Variable::boolean, 4);
+    for (int ord = 0; ord < 4; ++ord)
+    {
+        preprocessor.freeze(bool_var(ord));
+    }
+
+    Database db;
+    SECTION("assert negation of a failed literal")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(0), lit(2));
+        db.assert_clause(~lit(1), ~lit(2), lit(3));
+        db.assert_clause(~lit(1), ~lit(2), ~lit(3));
+
+        REQUIRE(preprocessor.run(db, trail));
+        REQUIRE(preprocessor.num_failed() > 0);
+        REQUIRE(std::find(db.asserted().begin(), db.asserted().end(), clause(~lit(0))) !=
+                db.asserted().end());
+    }
+
+    SECTION("assert literals implied by both polarities")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(lit(0), lit(2));
+        db.assert_clause(~lit(2), lit(1));
+        db.assert_clause(lit(1), lit(3), lit(0));
+        db.assert_clause(~lit(1), ~lit(3), lit(2));
+
+        REQUIRE(preprocessor.run(db, trail));
+        REQUIRE(std::find(db.asserted().begin(), db.asserted().end(), clause(lit(1))) !=
+                db.asserted().end());
+    }
+
+    SECTION("detect a conflict")
+    {
+        db.assert_clause(lit(0), lit(1));
+        db.assert_clause(lit(0), ~lit(1));
+        db.assert_clause(~lit(0), lit(2));
+        db.assert_clause(~lit(0), ~lit(2));
+
+        REQUIRE(!preprocessor.run(db, trail));
+    }
+}
+
+TEST_CASE("Preprocess clauses of a formula with theory atoms", "[sat_preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Options options;
+    options.sat_preprocess = true;
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun a () Bool)\n";
+    test.input() << "(declare-fun b () Bool)\n";
+
+    SECTION("sat")
+    {
+        test.input() << "(assert (or a (< x 0)))\n";
+        test.input() << "(assert (or (not a) (> y 1)))\n";
+        test.input() << "(assert (= b (and a (< x y))))\n";
+        test.input() << "(assert (or b (>= x 0)))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        auto x = test.real("x").value();
+        auto y = test.real("y").value();
+        auto a = test.boolean("a").value();
+        auto b = test.boolean("b").value();
+        REQUIRE((a || x < Rational{0}));
+        REQUIRE((!a || y > Rational{1}));
+        REQUIRE(b == (a && x < y));
+        REQUIRE((b || x >= Rational{0}));
+    }
+
+    SECTION("unsat")
+    {
+        test.input() << "(assert (or a (< x 0)))\n";
+        test.input() << "(assert (or (not a) (< x 0)))\n";
+        test.input() << "(assert (or b (> x 1)))\n";
+        test.input() << "(assert (not b))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::UNSAT);
+    }
+}
@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
+#include <thread>
+
 #include "test.h"
 #include "Solver.h"
 #include "Evsids.h"
@@ -57,4 +60,229 @@ TEST_CASE("Check an unsatisfiable boolean formula", "[unsat][integration]")
 
     auto result = solver.check();
     REQUIRE(result == Solver::Result::unsat);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Reuse trail on restart", "[unsat][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<Geometric_restart>().set_initial(1).set_factor(1);
+    assert_pigeonhole(solver, 4, 3);
+
+    SECTION("with trail reuse")
+    {
+        solver.set_trail_reuse(true);
+        REQUIRE(solver.check() == Solver::Result::unsat);
+        REQUIRE(solver.num_restarts() == solver.num_conflicts());
+        REQUIRE(solver.num_partial_restarts() > 0);
+    }
+
+    SECTION("without trail reuse")
+    {
+        // restarts clear the trail even if the conflict is resolved at decision level 0
+        REQUIRE(solver.check() == Solver::Result::unsat);
+        REQUIRE(solver.num_restarts() == solver.num_conflicts());
+        REQUIRE(solver.num_partial_restarts() == 0);
+    }
+}
+
+TEST_CASE("Stop the search when a limit is exceeded", "[unsat][integration][limits]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<Glucose_restart>();
+    assert_pigeonhole(solver, 6, 5);
+
+    SECTION("conflicts")
+    {
+        Solver::Limits limits;
+        limits.conflicts = 10;
+        solver.set_limits(limits);
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_conflicts() == 10);
+        REQUIRE(solver.trail().decision_level() == 0);
+        REQUIRE(!solver.db().learned().empty());
+
+        // the search resumes with learned clauses and the limit applies to each check
+        auto num_learned = solver.db().learned().size();
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.db().learned().size() >= num_learned);
+        REQUIRE(solver.num_conflicts() == 20);
+
+        solver.set_limits({});
+        REQUIRE(solver.check() == Solver::Result::unsat);
+    }
+
+    SECTION("decisions")
+    {
+        Solver::Limits limits;
+        limits.decisions = 5;
+        solver.set_limits(limits);
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_decisions() == 5);
+    }
+
+    SECTION("propagations")
+    {
+        Solver::Limits limits;
+        limits.propagations = 20;
+        solver.set_limits(limits);
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_propagations() >= 20);
+    }
+
+    SECTION("time")
+    {
+        Solver::Limits limits;
+        limits.time = std::chrono::milliseconds{0};
+        solver.set_limits(limits);
+        REQUIRE(solver.check() == Solver::Result::unknown);
+    }
+
+    SECTION("limits which are not exceeded")
+    {
+        Solver::Limits limits;
+        limits.conflicts = 1'000'000;
+        limits.time = std::chrono::hours{1};
+        solver.set_limits(limits);
+        REQUIRE(solver.check() == Solver::Result::unsat);
+    }
+}
+
+TEST_CASE("Keep the state of a stopped search in lookahead", "[unsat][integration][lookahead]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<Glucose_restart>();
+    assert_pigeonhole(solver, 6, 5);
+
+    Solver::Limits limits;
+    limits.conflicts = 10;
+    solver.set_limits(limits);
+    REQUIRE(solver.check() == Solver::Result::unknown);
+
+    REQUIRE(solver.begin_lookahead());
+    solver.end_lookahead();
+
+    // counters are not reset so the search is resumed rather than started again
+    REQUIRE(solver.check() == Solver::Result::unknown);
+    REQUIRE(solver.num_conflicts() == 20);
+}
+
+TEST_CASE("Terminate the search", "[unsat][integration][limits]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<Glucose_restart>();
+
+    SECTION("before check")
+    {
+        assert_pigeonhole(solver, 4, 3);
+        // the request is kept until a check stops and then it is cleared
+        solver.terminate();
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.check() == Solver::Result::unsat);
+    }
+
+    SECTION("from another thread")
+    {
+        // the formula is too hard to be solved before it is terminated
+        assert_pigeonhole(solver, 12, 11);
+        std::thread thread{[&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            solver.terminate();
+        }};
+        auto result = solver.check();
+        thread.join();
+        REQUIRE(result == Solver::Result::unknown);
+    }
+}
+
+TEST_CASE("Check a boolean formula under assumptions", "[sat][integration][assumptions]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    // the only model is 0 = false, 1 = true, 2 = false
+    solver.trail().set_model<bool>(Variable::boolean, 3);
+    solver.db().assert_clause(lit(0), lit(1), lit(2));
+    solver.db().assert_clause(lit(0), lit(1), ~lit(2));
+    solver.db().assert_clause(lit(0), ~lit(1), ~lit(2));
+    solver.db().assert_clause(~lit(0), lit(1), lit(2));
+    solver.db().assert_clause(~lit(0), lit(1), ~lit(2));
+    solver.db().assert_clause(~lit(0), ~lit(1), lit(2));
+    solver.db().assert_clause(~lit(0), ~lit(1), ~lit(2));
+
+    std::vector<Literal> assumptions{lit(0)};
+    REQUIRE(solver.check(assumptions) == Solver::Result::unsat);
+    REQUIRE(solver.failed_assumption() == lit(0));
+    REQUIRE(solver.trail().decision_level() == 0);
+
+    assumptions = {~lit(2), ~lit(1)};
+    REQUIRE(solver.check(assumptions) == Solver::Result::unsat);
+    REQUIRE(solver.failed_assumption() == ~lit(1));
+
+    assumptions = {~lit(2)};
+    REQUIRE(solver.check(assumptions) == Solver::Result::sat);
+    REQUIRE(!solver.failed_assumption());
+    auto const& model = solver.trail().model<bool>(Variable::boolean);
+    REQUIRE(model.value(0) == false);
+    REQUIRE(model.value(1) == true);
+    REQUIRE(model.value(2) == false);
+}
+
+TEST_CASE("Propagate decisions in lookahead", "[integration][lookahead]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, 4);
+    solver.db().assert_clause(lit(0));
+    solver.db().assert_clause(~lit(0), ~lit(1), lit(2));
+    solver.db().assert_clause(~lit(2), lit(3));
+    solver.db().assert_clause(~lit(2), ~lit(3));
+
+    REQUIRE(solver.begin_lookahead());
+    auto const& model = solver.trail().model<bool>(Variable::boolean);
+    REQUIRE(model.is_defined(0));
+    REQUIRE(solver.trail().num_assigned() == 1);
+
+    REQUIRE(!solver.push(lit(1)));
+    solver.pop();
+    REQUIRE(solver.trail().decision_level() == 0);
+    REQUIRE(!model.is_defined(1));
+
+    REQUIRE(solver.push(~lit(1)));
+    REQUIRE(solver.trail().num_assigned() == 2);
+    solver.pop();
+    solver.end_lookahead();
+    REQUIRE(solver.trail().empty());
+
+    // lookahead does not affect the search
+    REQUIRE(solver.check() == Solver::Result::sat);
+    REQUIRE(model.value(1) == false);
+}
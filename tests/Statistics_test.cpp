@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Statistics.h"
+#include "test.h"
+
+TEST_CASE("Set and find statistics", "[statistics]")
+{
+    using namespace yaga;
+
+    Statistics stats;
+    REQUIRE(!stats.counter("bool.propagations"));
+    REQUIRE(!stats.timer("solver.propagate"));
+
+    stats.set("bool.propagations", 42);
+    stats.set("lra.propagations", 7);
+    stats.set("bool.propagations", 43);
+    stats.set("solver.propagate", Statistics::Timer{.ticks = 100, .calls = 3});
+
+    REQUIRE(stats.counter("bool.propagations") == 43);
+    REQUIRE(stats.counter("lra.propagations") == 7);
+    REQUIRE(!stats.counter("solver.propagate"));
+    REQUIRE(stats.timer("solver.propagate")->ticks == 100);
+    REQUIRE(stats.timer("solver.propagate")->calls == 3);
+}
+
+TEST_CASE("Measure time spent in a scope", "[statistics]")
+{
+    using namespace yaga;
+
+    Statistics::Timer timer;
+    {
+        Scoped_timer scope{timer};
+    }
+    {
+        Scoped_timer scope{timer};
+    }
+    REQUIRE(timer.calls == 2);
+    REQUIRE(Statistics::seconds(0) == 0);
+}
+
+TEST_CASE("Write statistics", "[statistics]")
+{
+    using namespace yaga;
+
+    Statistics stats;
+
+    SECTION("empty registry")
+    {
+        std::stringstream out;
+        stats.write_json(out);
+        REQUIRE(out.str() == "{\n  \"counters\": {},\n  \"timers\": {}\n}\n");
+    }
+
+    SECTION("counters are written in the order in which they were first set")
+    {
+        stats.set("solver.conflicts", 5);
+        stats.set("bool.propagations", 10);
+        stats.set("solver.conflicts", 6);
+
+        std::stringstream text;
+        stats.write_text(text);
+        REQUIRE(text.str() == "solver.conflicts = 6\nbool.propagations = 10\n");
+
+        std::stringstream json;
+        stats.write_json(json);
+        REQUIRE(json.str() == "{\n"
+                              "  \"counters\": {\n"
+                              "    \"solver.conflicts\": 6,\n"
+                              "    \"bool.propagations\": 10\n"
+                              "  },\n"
+                              "  \"timers\": {}\n"
+                              "}\n");
+    }
+
+    SECTION("timers")
+    {
+        stats.set("solver.decide", Statistics::Timer{.ticks = 0, .calls = 2});
+
+        std::stringstream json;
+        stats.write_json(json);
+        REQUIRE(json.str() == "{\n"
+                              "  \"counters\": {},\n"
+                              "  \"timers\": {\n"
+                              "    \"solver.decide\": {\"seconds\": 0.000000, \"calls\": 2}\n"
+                              "  }\n"
+                              "}\n");
+    }
+}
+
+TEST_CASE("Write statistics of trivially unsatisfiable input", "[statistics]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    auto path = std::filesystem::temp_directory_path() / "yaga_statistics_test.json";
+    std::filesystem::remove(path);
+
+    Options options;
+    options.stats_path = path.string();
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(assert (< x 0))\n";
+    test.input() << "(assert false)\n";
+    test.run();
+    REQUIRE(test.answer() == Solver_answer::UNSAT);
+
+    std::ifstream in{path};
+    REQUIRE(in.is_open());
+    std::stringstream json;
+    json << in.rdbuf();
+    REQUIRE(json.str().find("\"smt.top_level_clauses\": 2") != std::string::npos);
+    in.close();
+    std::filesystem::remove(path);
+}
@@ -1,7 +1,38 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include <memory>
+#include <vector>
 
 #include "test.h"
 #include "Subsumption.h"
+#include "Tracer_wrapper.h"
+
+namespace {
+
+// tracer which records resolution steps of conflict derivation
+class Resolution_recorder final : public yaga::proof::Tracer {
+public:
+    std::vector<yaga::Clause_id> resolved;
+
+    void trivial_proof() override {}
+    void begin_proof(yaga::Database const&) override {}
+    void init_conflict(yaga::Clause const&, yaga::proof::Conflict_explanation&&) override {}
+    void resolve_conflict(yaga::Clause_id, yaga::Clause_id other) override
+    {
+        resolved.push_back(other);
+    }
+    void rename_conflict(yaga::Clause_id, yaga::Clause_id) override {}
+    void finish_conflicts() override {}
+    void learn_clause(yaga::Clause const&) override {}
+    void delete_clause(yaga::Clause const&) override {}
+    void derive_final(yaga::Clause const&) override {}
+    void end_proof(yaga::Database const&) override {}
+    bool supports_lra() const override { return true; }
+    bool supports_uf() const override { return true; }
+};
+
+} // namespace
 
 TEST_CASE("Remove subsumed learned clauses", "[subsumption]")
 {
@@ -53,4 +84,37 @@ TEST_CASE("Strengthen conflict clause", "[self-subsumption]")
 
     s.minimize(trail, conflict);
     REQUIRE(conflict == clause(lit(2), lit(3)));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Trace resolution with reasons of removed literals", "[self-subsumption]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    auto& first_reason = db.learn_clause(lit(2), ~lit(0));
+    auto& second_reason = db.learn_clause(lit(3), ~lit(0));
+
+    auto recorder = std::make_shared<Resolution_recorder>();
+    Subsumption s{proof::Tracer_wrapper{recorder}};
+    Event_dispatcher dispatcher;
+    dispatcher.add(&s);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 4);
+
+    model.set_value(0, true);
+    trail.decide(bool_var(0));
+    model.set_value(2, true);
+    trail.propagate(bool_var(2), &first_reason, trail.decision_level());
+    model.set_value(1, true);
+    trail.decide(bool_var(1));
+    // propagated at level 1 so it is in the lists of both decision levels
+    model.set_value(3, true);
+    trail.propagate(bool_var(3), &second_reason, /*level=*/1);
+
+    auto conflict = clause(~lit(0), ~lit(1), ~lit(2), ~lit(3));
+    s.minimize(trail, conflict);
+    REQUIRE(conflict == clause(~lit(0), ~lit(1)));
+    REQUIRE_THAT(recorder->resolved, Catch::Matchers::UnorderedEquals(std::vector<Clause_id>{
+                                         first_reason.id(), second_reason.id()}));
+}
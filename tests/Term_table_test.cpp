@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <vector>
+
+#include "Term_manager.h"
+#include "Terms.h"
+
+TEST_CASE("Hash consing of terms", "[terms]")
+{
+    using namespace yaga;
+    using namespace yaga::terms;
+
+    Term_table table;
+    auto x = table.new_uninterpreted_constant(types::real_type);
+    auto y = table.new_uninterpreted_constant(types::real_type);
+
+    SECTION("equal terms are represented by the same handle")
+    {
+        REQUIRE(table.arithmetic_constant(Rational{0}) == zero_term);
+        REQUIRE(table.arithmetic_constant(Rational{3, 4}) ==
+                table.arithmetic_constant(Rational{6, 8}));
+        REQUIRE(table.arithmetic_product(Rational{2}, x) ==
+                table.arithmetic_product(Rational{2}, x));
+        REQUIRE(table.arithmetic_product(Rational{2}, x) !=
+                table.arithmetic_product(Rational{2}, y));
+        REQUIRE(table.arithmetic_geq_zero(x) != table.arithmetic_eq_zero(x));
+    }
+
+    SECTION("rational constants which do not fit in a machine word are hashed by value")
+    {
+        Rational big = Rational{1 << 30} * Rational{1 << 30} * Rational{1 << 30};
+        auto c = table.arithmetic_constant(big);
+        REQUIRE(table.arithmetic_constant(big + Rational{1} - Rational{1}) == c);
+        REQUIRE(table.arithmetic_constant(-big) != c);
+        REQUIRE(table.arithmetic_constant_value(c) == big);
+    }
+
+    SECTION("order of arguments matters")
+    {
+        std::array<term_t, 2> args{x, y};
+        std::array<term_t, 2> swapped{y, x};
+        REQUIRE(table.or_term(args) != table.or_term(swapped));
+        REQUIRE(table.or_term(args) == table.or_term(args));
+    }
+
+    SECTION("terms are found after the table grows")
+    {
+        std::vector<term_t> products;
+        for (int i = 0; i < 10'000; ++i)
+        {
+            products.push_back(table.arithmetic_product(Rational{i + 1}, x));
+        }
+        for (int i = 0; i < 10'000; ++i)
+        {
+            REQUIRE(table.arithmetic_product(Rational{i + 1}, x) == products[i]);
+            REQUIRE(table.coeff_of_product(products[i]) == Rational{i + 1});
+        }
+    }
+}
+
+TEST_CASE("Build sums of many terms", "[terms]")
+{
+    using namespace yaga;
+    using namespace yaga::terms;
+
+    Term_manager tm;
+    std::vector<term_t> vars;
+    for (int i = 0; i < 1000; ++i)
+    {
+        vars.push_back(tm.mk_uninterpreted_constant(types::real_type));
+    }
+
+    SECTION("like terms are combined")
+    {
+        // sum of (i + 1) * x_i, x_i and 1 for all i in reverse order
+        std::vector<term_t> addends;
+        for (int i = 999; i >= 0; --i)
+        {
+            addends.push_back(vars[i]);
+            addends.push_back(tm.mk_arithmetic_constant(Rational{1}));
+            std::array<term_t, 2> product{tm.mk_arithmetic_constant(Rational{i + 1}), vars[i]};
+            addends.push_back(tm.mk_arithmetic_times(product));
+        }
+        auto sum = tm.mk_arithmetic_plus(addends);
+        auto poly = tm.term_to_poly(sum);
+        REQUIRE(poly.size() == 1001);
+        REQUIRE(poly.get_coeff(term_t::Undef) == Rational{1000});
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(poly.get_coeff(vars[i]) == Rational{i + 2});
+        }
+    }
+
+    SECTION("cancelled terms are removed")
+    {
+        std::vector<term_t> addends;
+        for (int i = 0; i < 1000; ++i)
+        {
+            addends.push_back(vars[i]);
+            addends.push_back(tm.mk_unary_minus(vars[999 - i]));
+        }
+        REQUIRE(tm.mk_arithmetic_plus(addends) == zero_term);
+
+        addends.push_back(vars[0]);
+        REQUIRE(tm.mk_arithmetic_plus(addends) == vars[0]);
+    }
+
+    SECTION("sum does not depend on the order of addends")
+    {
+        std::vector<term_t> addends{vars[2], tm.mk_arithmetic_constant(Rational{3}), vars[0]};
+        std::vector<term_t> reversed{addends.rbegin(), addends.rend()};
+        auto sum = tm.mk_arithmetic_plus(addends);
+        REQUIRE(sum == tm.mk_arithmetic_plus(reversed));
+
+        // sum of polynomials
+        std::array<term_t, 2> sums{sum, tm.mk_unary_minus(sum)};
+        REQUIRE(tm.mk_arithmetic_plus(sums) == zero_term);
+    }
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+#include "test.h"
+#include "Vivification.h"
+
+TEST_CASE("Remove implied literals from learned clauses", "[vivification]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Vivification vivification;
+    vivification.set_enabled(true);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&vivification);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 4);
+    trail.resize(Variable::boolean, 4);
+
+    // x0 => x1
+    Database db;
+    db.assert_clause(~lit(0), lit(1));
+
+    SECTION("literal which is not needed to derive the clause is removed")
+    {
+        // learn (~x0 or x2 or x1) at two decision levels
+        trail.decide(bool_var(0));
+        trail.propagate(bool_var(1), nullptr, trail.decision_level());
+        trail.decide(bool_var(2));
+        auto& learned = db.learn_clause(~lit(0), lit(2), lit(1));
+        dispatcher.on_learned_clause(db, trail, learned);
+        trail.clear();
+
+        vivification.vivify(db, trail);
+        REQUIRE(vivification.num_strengthened() == 1);
+        REQUIRE(vivification.num_removed_literals() == 1);
+        REQUIRE(db.learned().size() == 1);
+        auto const& result = db.learned().front();
+        REQUIRE(result.size() == 2);
+        REQUIRE(std::find(result.begin(), result.end(), ~lit(0)) != result.end());
+        REQUIRE(std::find(result.begin(), result.end(), lit(1)) != result.end());
+    }
+
+    SECTION("clause without implied literals is kept")
+    {
+        trail.decide(bool_var(2));
+        trail.decide(bool_var(3));
+        auto& learned = db.learn_clause(lit(2), lit(3));
+        dispatcher.on_learned_clause(db, trail, learned);
+        trail.clear();
+
+        vivification.vivify(db, trail);
+        REQUIRE(vivification.num_strengthened() == 0);
+        REQUIRE(db.learned().front().size() == 2);
+    }
+}
+
+TEST_CASE("Vivify learned clauses with theory literals", "[vivification]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Vivification vivification;
+    vivification.set_enabled(true);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&vivification);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 3);
+    trail.set_model<Rational>(Variable::rational, 1);
+    trail.resize(Variable::boolean, 3);
+    trail.resize(Variable::rational, 1);
+
+    // x0 is `x < 0`, x1 is `x < 1` and x2 is a boolean variable. The theory lemma `x < 0 => x < 1`
+    // is a clause in the database.
+    Database db;
+    db.assert_clause(~lit(0), lit(1));
+
+    // learn (~x0 or x2 or x1) at decision levels separated by a semantic decision of `x`
+    trail.decide(bool_var(0));
+    trail.propagate(bool_var(1), nullptr, trail.decision_level());
+    trail.decide(real_var(0));
+    trail.decide(bool_var(2));
+    auto& learned = db.learn_clause(~lit(0), lit(2), lit(1));
+    dispatcher.on_learned_clause(db, trail, learned);
+    trail.clear();
+
+    // x2 is removed since x1 is implied by the theory lemma
+    vivification.vivify(db, trail);
+    REQUIRE(vivification.num_strengthened() == 1);
+    REQUIRE(vivification.num_removed_literals() == 1);
+    REQUIRE(db.learned().size() == 1);
+    auto const& result = db.learned().front();
+    REQUIRE(result.size() == 2);
+    REQUIRE(std::find(result.begin(), result.end(), lit(2)) == result.end());
+    REQUIRE(trail.empty());
+}
@@ -239,4 +239,102 @@ TEST_CASE("Maintain watched literals invariants", "[bool_theory][bcp]")
         conflicts = theory.propagate(db, trail);
         REQUIRE(conflicts.empty());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Track target phase of the longest conflict-free trail", "[bool_theory][phase]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Bool_theory theory;
+    theory.set_phase(Phase::target);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&theory);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 4);
+
+    model.set_value(0, false);
+    trail.decide(bool_var(0));
+    model.set_value(1, false);
+    trail.propagate(bool_var(1), nullptr, 1);
+    model.set_value(2, false);
+    trail.decide(bool_var(2));
+    model.set_value(3, false);
+    trail.decide(bool_var(3));
+
+    // conflict at level 3
+    theory.on_before_backtrack(db, trail, 1);
+    trail.backtrack(1);
+
+    REQUIRE(theory.target_phase(0) == false);
+    REQUIRE(theory.target_phase(1) == false);
+    REQUIRE(theory.target_phase(2) == false);
+    REQUIRE(theory.target_phase(3) == true);
+    REQUIRE(theory.best_phase(2) == false);
+    REQUIRE(theory.best_phase(3) == true);
+
+    // shorter conflict-free trail does not change the target phase
+    model.set_value(2, true);
+    trail.decide(bool_var(2));
+    theory.on_before_backtrack(db, trail, 0);
+    trail.backtrack(0);
+
+    REQUIRE(theory.target_phase(2) == false);
+
+    // decide uses the target phase
+    theory.decide(db, trail, bool_var(2));
+    REQUIRE(model.is_defined(2));
+    REQUIRE(model.value(2) == false);
+}
+
+TEST_CASE("Rephase on restart", "[bool_theory][phase]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Bool_theory theory;
+    theory.set_phase(Phase::target);
+    theory.set_rephase_interval(1);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&theory);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 2);
+    // conflicts are counted by learned clauses
+    auto conflict = [&] {
+        auto& learned = db.learn_clause(lit(0), lit(1));
+        theory.on_learned_clause(db, trail, learned);
+    };
+
+    model.set_value(0, false);
+    trail.decide(bool_var(0));
+    model.set_value(1, false);
+    trail.decide(bool_var(1));
+    theory.on_before_backtrack(db, trail, 0);
+    trail.clear();
+    conflict();
+
+    // the first rephase resets cached phases to the original phase
+    REQUIRE(theory.saved_phase(0) == false);
+    theory.on_restart(db, trail);
+    REQUIRE(theory.saved_phase(0) == true);
+    REQUIRE(theory.saved_phase(1) == true);
+    REQUIRE(theory.target_phase(0) == true);
+
+    // restarts without conflicts do not count
+    theory.on_before_backtrack(db, trail, 0);
+    theory.on_before_backtrack(db, trail, 0);
+    theory.on_restart(db, trail);
+    REQUIRE(theory.saved_phase(0) == true);
+
+    // the next rephase is due after 2 more conflicts and it uses the best phase
+    conflict();
+    theory.on_restart(db, trail);
+    REQUIRE(theory.saved_phase(0) == true);
+
+    conflict();
+    theory.on_restart(db, trail);
+    REQUIRE(theory.saved_phase(0) == false);
+    REQUIRE(theory.saved_phase(1) == true);
+}
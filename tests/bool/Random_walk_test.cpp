@@ -0,0 +1,46 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "test.h"
+#include "Random_walk.h"
+
+TEST_CASE("Find a satisfying assignment using random walk", "[random_walk]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    db.assert_clause(lit(0), lit(1));
+    db.assert_clause(~lit(0), lit(2));
+    db.assert_clause(~lit(1), ~lit(2));
+    db.assert_clause(~lit(2), lit(3));
+    db.assert_clause(lit(1), ~lit(3));
+
+    std::vector<bool> assignment(4, false);
+    Random_walk walk;
+    REQUIRE(walk.run(db, assignment) == 0);
+
+    auto value = [&](Literal lit) { return assignment[lit.var().ord()] == !lit.is_negation(); };
+    for (auto const& clause : db.asserted())
+    {
+        REQUIRE(std::any_of(clause.begin(), clause.end(), value));
+    }
+}
+
+TEST_CASE("Return the best assignment if the formula is unsatisfiable", "[random_walk]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    db.assert_clause(lit(0));
+    db.assert_clause(~lit(0));
+    db.assert_clause(lit(1), lit(0));
+
+    std::vector<bool> assignment(2, false);
+    Random_walk walk;
+    walk.set_max_flips(100);
+    REQUIRE(walk.run(db, assignment) == 1);
+    REQUIRE(assignment.size() == 2);
+}
@@ -57,6 +57,26 @@ TEST_CASE("Arithmetic operations with fractions", "[fraction]")
     }
 }
 
+TEST_CASE("Normalize fractions on construction", "[fraction]")
+{
+    using namespace yaga;
+    using namespace yaga::literals;
+
+    SECTION("positive numerator")
+    {
+        REQUIRE(Rational{6, 4}.numerator() == 3);
+        REQUIRE(Rational{6, 4}.denominator() == 2);
+    }
+
+    SECTION("negative numerator")
+    {
+        REQUIRE(Rational{-6, 4}.numerator() == -3);
+        REQUIRE(Rational{-6, 4}.denominator() == 2);
+        REQUIRE(Rational{-6, 4} == -3_r / 2);
+        REQUIRE(Rational{-5, 7} == -5_r / 7);
+    }
+}
+
 TEST_CASE("Compare fractions", "[fraction]")
 {
     using namespace yaga;
@@ -79,4 +99,31 @@ TEST_CASE("Compare fractions", "[fraction]")
         REQUIRE(1_r / 2 > Rational{std::numeric_limits<int>::lowest()});
         REQUIRE(1_r / 2 >= Rational{std::numeric_limits<int>::lowest()});
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Parse decimal numbers", "[fraction]")
+{
+    using namespace yaga;
+    using namespace yaga::literals;
+
+    SECTION("numerals")
+    {
+        REQUIRE(Rational::from_decimal("0") == 0_r);
+        REQUIRE(Rational::from_decimal("42") == 42_r);
+        REQUIRE(Rational::from_decimal("2147483647") == Rational{"2147483647"});
+        REQUIRE(Rational::from_decimal("2147483648") == Rational{"2147483648"});
+        REQUIRE(Rational::from_decimal("123456789012345678901234567890") ==
+                Rational{"123456789012345678901234567890"});
+    }
+
+    SECTION("decimals")
+    {
+        REQUIRE(Rational::from_decimal("0.0") == 0_r);
+        REQUIRE(Rational::from_decimal("0.5") == 1_r / 2);
+        REQUIRE(Rational::from_decimal("3.25") == 13_r / 4);
+        REQUIRE(Rational::from_decimal("10.10") == 101_r / 10);
+        REQUIRE(Rational::from_decimal("0.0000000001") == Rational{"1/10000000000"});
+        REQUIRE(Rational::from_decimal("12345678901234567890.125") ==
+                Rational{"98765431209876543121/8"});
+    }
+}
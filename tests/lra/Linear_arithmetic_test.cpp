@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
+#include "Bool_theory.h"
 #include "Clause.h"
 #include "Linear_arithmetic.h"
 #include "Literal.h"
@@ -874,4 +875,206 @@ TEST_CASE("Decide variable", "[linear_arithmetic]")
         REQUIRE(models.owned().value(x.ord()) > 8_r / 10);
         REQUIRE(models.owned().value(x.ord()) < 9_r / 10);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Decide best values of rational variables", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.best_values = true;
+    lra.set_options(options);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto models = lra.relevant_models(trail);
+    auto [x, y, z] = real_vars<3>();
+
+    SECTION("prefer values from the longest conflict-free trail")
+    {
+        decide(trail, x, 5);
+        decide(trail, y, 7);
+        REQUIRE(lra.propagate(db, trail).empty());
+
+        // conflict at level 2
+        lra.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        REQUIRE(lra.best_model().is_defined(x.ord()));
+        REQUIRE(lra.best_model().value(x.ord()) == 5);
+        REQUIRE(!lra.best_model().is_defined(y.ord()));
+
+        lra.decide(db, trail, x);
+        REQUIRE(models.owned().value(x.ord()) == 5);
+    }
+
+    SECTION("forget best values when boolean phases are reset")
+    {
+        Bool_theory bool_theory;
+        bool_theory.set_phase(Phase::target);
+        bool_theory.set_rephase_interval(0);
+        lra.set_rephase_schedule(&bool_theory);
+
+        decide(trail, x, 5);
+        decide(trail, y, 7);
+        REQUIRE(lra.propagate(db, trail).empty());
+        lra.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        REQUIRE(lra.best_model().is_defined(x.ord()));
+
+        // restart without a rephase keeps the values
+        lra.on_restart(db, trail);
+        REQUIRE(lra.best_model().is_defined(x.ord()));
+
+        // the first rephase is due immediately
+        bool_theory.on_restart(db, trail);
+        REQUIRE(bool_theory.num_rephases() == 1);
+        lra.on_restart(db, trail);
+        REQUIRE(!lra.best_model().is_defined(x.ord()));
+    }
+
+    SECTION("prefer values of other variables in bound constraints")
+    {
+        decide(trail, y, 3);
+        propagate(trail, linear(x <= y));
+        REQUIRE(lra.propagate(db, trail).empty());
+
+        lra.decide(db, trail, x);
+        REQUIRE(models.owned().value(x.ord()) == 3);
+    }
+}
+
+TEST_CASE("Remove unused derived constraints on restart", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.collect_derived = true;
+    lra.set_options(options);
+    lra.set_gc_interval(1);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto derived = [&]<std::convertible_to<Rational> T>(Linear_predicate<T> const& val) {
+        auto poly = val.lhs - val.rhs;
+        auto cons = lra.derived_constraint(trail, poly.vars, poly.coef, val.pred,
+                                           val.rhs.constant - val.lhs.constant);
+        return val.is_negation ? ~cons : cons;
+    };
+    auto [x, y, z] = real_vars<3>();
+
+    auto input = linear(x + y <= 1);
+    auto unused = derived(x <= 0);
+    auto used = derived(y < z);
+    REQUIRE(input.lit().var().ord() == 1);
+    REQUIRE(unused.lit().var().ord() == 2);
+    REQUIRE(used.lit().var().ord() == 3);
+    db.learn_clause(~input.lit(), used.lit());
+
+    SECTION("derived constraints are moved to the removed boolean variables")
+    {
+        lra.on_restart(db, trail);
+
+        REQUIRE(lra.num_collected() == 1);
+        REQUIRE(trail.model<bool>(Variable::boolean).num_vars() == 3);
+        REQUIRE(lra.constraint(1).lit() == Literal{1});
+        REQUIRE(std::ranges::equal(lra.constraint(1).vars(), std::vector{x.ord(), y.ord()}));
+
+        auto moved = lra.constraint(2);
+        REQUIRE(moved.lit() == Literal{2});
+        REQUIRE(std::ranges::equal(moved.vars(), std::vector{y.ord(), z.ord()}));
+        REQUIRE(moved.pred() == used.pred());
+        REQUIRE(moved.rhs() == used.rhs());
+
+        Literal moved_lit = used.lit().is_negation() ? ~Literal{2} : Literal{2};
+        REQUIRE_THAT(db.learned().front(),
+                     Catch::Matchers::UnorderedEquals(clause(~input.lit(), moved_lit)));
+
+        // removed constraints get a new boolean variable
+        REQUIRE(derived(x <= 0).lit().var().ord() == 3);
+        REQUIRE(derived(y < z).lit() == moved_lit);
+    }
+
+    SECTION("constraints created by the user are never removed")
+    {
+        REQUIRE(linear(x <= 0).lit() == unused.lit());
+        lra.on_restart(db, trail);
+
+        REQUIRE(lra.num_collected() == 0);
+        REQUIRE(trail.model<bool>(Variable::boolean).num_vars() == 4);
+    }
+
+    SECTION("nothing is removed if the trail is not empty")
+    {
+        decide(trail, y, 0);
+        lra.on_restart(db, trail);
+
+        REQUIRE(lra.num_collected() == 0);
+        REQUIRE(trail.model<bool>(Variable::boolean).num_vars() == 4);
+    }
+}
+
+TEST_CASE("Detect infeasible constraints using simplex", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.simplex = true;
+    lra.set_options(options);
+    lra.set_simplex_frequency(1);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto models = lra.relevant_models(trail);
+    auto [x, y, z] = real_vars<3>();
+
+    SECTION("infeasible constraints")
+    {
+        decide(trail, linear(x + y < 1));
+        REQUIRE(lra.propagate(db, trail).empty());
+        decide(trail, linear(x - z >= 1));
+        REQUIRE(lra.propagate(db, trail).empty());
+        decide(trail, linear(z + y >= 0));
+
+        auto conflicts = lra.propagate(db, trail);
+        REQUIRE(conflicts.size() == 1);
+        REQUIRE_THAT(conflicts.front(), Catch::Matchers::UnorderedEquals(clause(
+            ~linear(x + y < 1), ~linear(x - z >= 1), ~linear(z + y >= 0))));
+        REQUIRE(lra.num_simplex_conflicts() == 1);
+    }
+
+    SECTION("prefer values from simplex")
+    {
+        decide(trail, linear(x + y >= 4));
+        REQUIRE(lra.propagate(db, trail).empty());
+        decide(trail, linear(x - y >= 2));
+        REQUIRE(lra.propagate(db, trail).empty());
+
+        lra.decide(db, trail, x);
+        REQUIRE(lra.propagate(db, trail).empty());
+        lra.decide(db, trail, y);
+        REQUIRE(lra.propagate(db, trail).empty());
+        REQUIRE(models.owned().value(x.ord()) + models.owned().value(y.ord()) >= 4);
+        REQUIRE(models.owned().value(x.ord()) - models.owned().value(y.ord()) >= 2);
+    }
+}
@@ -6,6 +6,7 @@
 #include "Solver.h"
 #include "Bool_theory.h"
 #include "Combined_order.h"
+#include "Cube_and_conquer.h"
 #include "Generalized_vsids.h"
 #include "Linear_arithmetic.h"
 #include "Theory_combination.h"
@@ -220,4 +221,46 @@ TEST_CASE("Formula which forces the solver to generate duplicate constraints and
         REQUIRE(*test.real("z") + *test.real("y") < 0);
         REQUIRE(*test.real("z") > 0);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Solve cubes of a formula in LRA in parallel", "[lra][integration][cube_and_conquer]")
+{
+    // x, y in {0} or [2, inf) and x + y = 1
+    auto setup = [](Solver& solver, bool is_bounded) {
+        solver.trail().set_model<bool>(Variable::boolean, 0);
+        solver.trail().set_model<Rational>(Variable::rational, 2);
+        solver.set_restart_policy<No_restart>();
+        solver.set_variable_order<First_unassigned>();
+        auto& theories = solver.set_theory<Theory_combination>();
+        theories.add_theory<Bool_theory>();
+        auto& lra = theories.add_theory<Linear_arithmetic>();
+        auto linear = factory(lra, solver.trail());
+        auto [x, y] = real_vars<2>();
+
+        solver.db().assert_clause(clause(linear(x <= 0), linear(x >= 2)));
+        solver.db().assert_clause(clause(linear(y <= 0), linear(y >= 2)));
+        solver.db().assert_clause(clause(linear(x + y <= 1)));
+        solver.db().assert_clause(clause(linear(x + y >= 1)));
+        if (is_bounded)
+        {
+            solver.db().assert_clause(clause(linear(x >= 0)));
+            solver.db().assert_clause(clause(linear(y >= 0)));
+        }
+    };
+
+    Cube_and_conquer::Options options;
+    options.num_workers = 2;
+    options.max_shared_size = 4;
+
+    SECTION("satisfiable")
+    {
+        Cube_and_conquer solver{[&](Solver& worker) { setup(worker, false); }, options};
+        REQUIRE(solver.solve() == Solver::Result::sat);
+    }
+
+    SECTION("unsatisfiable")
+    {
+        Cube_and_conquer solver{[&](Solver& worker) { setup(worker, true); }, options};
+        REQUIRE(solver.solve() == Solver::Result::unsat);
+    }
+}
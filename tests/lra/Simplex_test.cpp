@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include <vector>
+
+#include "Literal.h"
+#include "Rational.h"
+#include "Simplex.h"
+
+TEST_CASE("Find a feasible assignment", "[simplex]")
+{
+    using namespace yaga;
+
+    Simplex simplex;
+    auto y = simplex.variable(1);
+    auto sum = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1});
+    auto diff = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, -1});
+
+    REQUIRE(simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1}) == sum);
+
+    // x + y <= 2, x - y >= 1, y >= 0
+    REQUIRE(simplex.assert_upper(sum, Delta_rational{Rational{2}}, Literal{0}));
+    REQUIRE(simplex.assert_lower(diff, Delta_rational{Rational{1}}, Literal{1}));
+    REQUIRE(simplex.assert_lower(y, Delta_rational{Rational{0}}, Literal{2}));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+
+    auto x_value = simplex.value(0).value();
+    auto y_value = simplex.value(1).value();
+    REQUIRE(x_value + y_value <= 2);
+    REQUIRE(x_value - y_value >= 1);
+    REQUIRE(y_value >= 0);
+    REQUIRE(!simplex.value(2));
+}
+
+TEST_CASE("Satisfy strict bounds", "[simplex]")
+{
+    using namespace yaga;
+
+    Simplex simplex;
+    auto x = simplex.variable(0);
+    auto sum = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1});
+
+    // 0 < x, x + y < 1, y >= 1/2
+    REQUIRE(simplex.assert_lower(x, Delta_rational{Rational{0}, Rational{1}}, Literal{0}));
+    REQUIRE(simplex.assert_upper(sum, Delta_rational{Rational{1}, Rational{-1}}, Literal{1}));
+    REQUIRE(simplex.assert_lower(simplex.variable(1), Delta_rational{Rational{1, 2}}, Literal{2}));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+
+    auto x_value = simplex.value(0).value();
+    auto y_value = simplex.value(1).value();
+    REQUIRE(x_value > 0);
+    REQUIRE(x_value + y_value < 1);
+    REQUIRE(y_value >= Rational{1, 2});
+}
+
+TEST_CASE("Explain infeasible bounds", "[simplex]")
+{
+    using namespace yaga;
+
+    Simplex simplex;
+    auto x = simplex.variable(0);
+    auto y = simplex.variable(1);
+    auto z = simplex.variable(2);
+    auto sum = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1});
+
+    SECTION("bounds of a single variable")
+    {
+        REQUIRE(simplex.assert_upper(x, Delta_rational{Rational{0}}, Literal{0}));
+        REQUIRE(!simplex.assert_lower(x, Delta_rational{Rational{0}, Rational{1}}, Literal{1}));
+        REQUIRE_THAT(simplex.conflict(),
+                     Catch::Matchers::UnorderedEquals(std::vector{Literal{0}, Literal{1}}));
+    }
+
+    SECTION("bounds of a linear form")
+    {
+        // x + y < 1, x >= 1, y >= 0, z >= 0 (z is irrelevant)
+        REQUIRE(simplex.assert_upper(sum, Delta_rational{Rational{1}, Rational{-1}}, Literal{0}));
+        REQUIRE(simplex.assert_lower(x, Delta_rational{Rational{1}}, ~Literal{1}));
+        REQUIRE(simplex.assert_lower(y, Delta_rational{Rational{0}}, Literal{2}));
+        REQUIRE(simplex.assert_lower(z, Delta_rational{Rational{0}}, Literal{3}));
+        REQUIRE(simplex.check() == Simplex::Result::infeasible);
+        REQUIRE_THAT(simplex.conflict(), Catch::Matchers::UnorderedEquals(std::vector{
+                                             Literal{0}, ~Literal{1}, Literal{2}}));
+    }
+
+    SECTION("conflict after pivoting")
+    {
+        auto diff = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, -1});
+
+        // x + y <= 1, x - y >= 2, y >= 0
+        REQUIRE(simplex.assert_upper(sum, Delta_rational{Rational{1}}, Literal{0}));
+        REQUIRE(simplex.check() == Simplex::Result::feasible);
+        REQUIRE(simplex.assert_lower(diff, Delta_rational{Rational{2}}, Literal{1}));
+        REQUIRE(simplex.check() == Simplex::Result::feasible);
+        REQUIRE(simplex.assert_lower(y, Delta_rational{Rational{0}}, Literal{2}));
+        REQUIRE(simplex.check() == Simplex::Result::infeasible);
+        REQUIRE_THAT(simplex.conflict(), Catch::Matchers::UnorderedEquals(std::vector{
+                                             Literal{0}, Literal{1}, Literal{2}}));
+    }
+}
+
+TEST_CASE("Retract bounds on backtrack", "[simplex]")
+{
+    using namespace yaga;
+
+    Simplex simplex;
+    auto x = simplex.variable(0);
+    auto y = simplex.variable(1);
+    auto sum = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1});
+
+    // x + y <= 1 at level 1, x >= 1 at level 2, y >= 0 at level 1 (propagated out of order)
+    REQUIRE(simplex.assert_upper(sum, Delta_rational{Rational{1}}, Literal{0}, 1));
+    REQUIRE(simplex.assert_lower(x, Delta_rational{Rational{1}}, Literal{1}, 2));
+    REQUIRE(simplex.assert_lower(y, Delta_rational{Rational{0}}, Literal{2}, 1));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+
+    // y >= 1 at level 3 is infeasible
+    REQUIRE(simplex.assert_lower(y, Delta_rational{Rational{1}}, Literal{3}, 3));
+    REQUIRE(simplex.check() == Simplex::Result::infeasible);
+
+    // y >= 1 is retracted but y >= 0 is kept
+    simplex.backtrack(2);
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+    REQUIRE(simplex.value(1).value() == 0);
+
+    // x >= 1 is retracted but y >= 0 from level 1 is kept
+    simplex.backtrack(1);
+    REQUIRE(!simplex.assert_upper(y, Delta_rational{Rational{0}, Rational{-1}}, Literal{4}, 1));
+    REQUIRE_THAT(simplex.conflict(),
+                 Catch::Matchers::UnorderedEquals(std::vector{Literal{4}, Literal{2}}));
+    REQUIRE(simplex.assert_upper(x, Delta_rational{Rational{0}}, Literal{5}, 1));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+
+    simplex.backtrack(0);
+    REQUIRE(simplex.assert_lower(sum, Delta_rational{Rational{5}}, Literal{6}, 0));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+}
+
+TEST_CASE("Reuse rows of unused linear forms", "[simplex]")
+{
+    using namespace yaga;
+
+    Simplex simplex;
+    auto x = simplex.variable(0);
+    auto sum = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, 1});
+    auto diff = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, -1});
+
+    // make `sum` nonbasic
+    REQUIRE(simplex.assert_lower(sum, Delta_rational{Rational{2}}, Literal{0}));
+    REQUIRE(simplex.assert_upper(x, Delta_rational{Rational{0}}, Literal{1}));
+    REQUIRE(simplex.check() == Simplex::Result::feasible);
+    simplex.clear_bounds();
+
+    std::vector<bool> is_used(diff + 1, false);
+    is_used[diff] = true;
+    simplex.remove_unused_forms(is_used);
+
+    // the removed slack variable is reused
+    auto other = simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{2, 1});
+    REQUIRE(other == sum);
+    REQUIRE(simplex.linear_form(std::vector{0, 1}, std::vector<Rational>{1, -1}) == diff);
+
+    // 2x + y <= 1, x - y >= 1, y >= 0
+    REQUIRE(simplex.assert_upper(other, Delta_rational{Rational{1}}, Literal{2}));
+    REQUIRE(simplex.assert_lower(diff, Delta_rational{Rational{1}}, Literal{3}));
+    REQUIRE(simplex.assert_lower(simplex.variable(1), Delta_rational{Rational{0}}, Literal{4}));
+    REQUIRE(simplex.check() == Simplex::Result::infeasible);
+    REQUIRE_THAT(simplex.conflict(), Catch::Matchers::UnorderedEquals(std::vector{
+                                         Literal{2}, Literal{3}, Literal{4}}));
+}
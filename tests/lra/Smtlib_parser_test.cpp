@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -393,4 +395,197 @@ TEST_CASE("Parse if-then-else with real output", "[test_parser]")
         REQUIRE(test.real("x").has_value());
         REQUIRE(*test.real("x") < Rational{0});
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Parse nested let binders", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Yaga_test test;
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+
+    SECTION("inner binder shadows an outer binder")
+    {
+        test.input() << "(assert (let ((a x)) (and (let ((a y)) (< a 0)) (> a 0))))";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        REQUIRE(*test.real("x") > Rational{0});
+        REQUIRE(*test.real("y") < Rational{0});
+    }
+
+    SECTION("binder shadows a declared constant")
+    {
+        test.input() << "(assert (let ((x y)) (< x 0)))";
+        test.input() << "(assert (> x 0))";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        REQUIRE(*test.real("x") > Rational{0});
+        REQUIRE(*test.real("y") < Rational{0});
+    }
+
+    SECTION("binder shadows a formal parameter of a defined function")
+    {
+        test.input() << "(define-fun f ((a Real)) Bool (let ((a (+ a 1))) (< a 0)))";
+        test.input() << "(assert (f x))";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        REQUIRE(*test.real("x") < Rational{-1});
+    }
+}
+
+TEST_CASE("Flatten nested conjunctions and disjunctions", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Options options;
+    options.flatten = true;
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun a () Bool)\n";
+    test.input() << "(declare-fun b () Bool)\n";
+
+    SECTION("sat")
+    {
+        test.input() << "(assert (and (or a (< x 0) (or b (> y 1))) (or (not a) (not b))))\n";
+        test.input() << "(assert (not (or (and a b) (>= x 0))))\n";
+        test.input() << "(assert (or (not (and a (> y 0))) (=> b (< y 0))))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        auto x = test.real("x").value_or(Rational{0});
+        auto y = test.real("y").value_or(Rational{0});
+        auto a = test.boolean("a").value_or(false);
+        auto b = test.boolean("b").value_or(false);
+        REQUIRE((a || x < Rational{0} || b || y > Rational{1}));
+        REQUIRE((!a || !b));
+        REQUIRE(!(a && b));
+        REQUIRE(x < Rational{0});
+        REQUIRE((!(a && y > Rational{0}) || !b || y < Rational{0}));
+    }
+
+    SECTION("unsat")
+    {
+        test.input() << "(assert (and (or a (< x 0)) (or (not a) (< x 0))))\n";
+        test.input() << "(assert (not (or (and b (< x 1)) (and (not b) (< x 2)))))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::UNSAT);
+    }
+}
+
+TEST_CASE("Answer unknown if the conflict limit is exceeded", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Options options;
+    options.conflict_limit = 1;
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    // 5 pigeons in 4 holes
+    for (int ord = 0; ord < 5 * 4; ++ord)
+    {
+        test.input() << "(declare-fun b" << ord << " () Bool)\n";
+    }
+    for (auto const& clause : pigeonhole(5, 4))
+    {
+        test.input() << "(assert (or";
+        for (auto lit : clause)
+        {
+            if (lit.is_negation())
+            {
+                test.input() << " (not b" << lit.var().ord() << ")";
+            }
+            else
+            {
+                test.input() << " b" << lit.var().ord();
+            }
+        }
+        test.input() << "))\n";
+    }
+    test.run();
+    REQUIRE(test.answer() == Solver_answer::UNKNOWN);
+}
+
+TEST_CASE("Encode disjunctions by polarity of their occurrences", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    auto path = std::filesystem::temp_directory_path() / "yaga_polarity_test.json";
+    std::filesystem::remove(path);
+
+    Options options;
+    options.stats_path = path.string();
+
+    Yaga_test test;
+    test.set_options(options);
+    test.input() << "(set-logic QF_LRA)\n";
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun a () Bool)\n";
+    test.input() << "(declare-fun b () Bool)\n";
+    test.input() << "(declare-fun c () Bool)\n";
+
+    SECTION("sat")
+    {
+        test.input() << "(assert (or a (and b (< x 0))))\n";
+        test.input() << "(assert (not (or (and a c) (>= x 1))))\n";
+        test.input() << "(assert (or (not (or b c)) (> x (- 5))))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        auto x = test.real("x").value_or(Rational{0});
+        auto a = test.boolean("a").value_or(false);
+        auto b = test.boolean("b").value_or(false);
+        auto c = test.boolean("c").value_or(false);
+        REQUIRE((a || (b && x < Rational{0})));
+        REQUIRE(!((a && c) || x >= Rational{1}));
+        REQUIRE((!(b || c) || x > Rational{-5}));
+
+        // each assertion needs a unit clause and one definition of its positive disjunction
+        // plus two definitions of the nested disjunction with the opposite polarity (full
+        // Tseitin encoding needs 21 clauses)
+        std::ifstream in{path};
+        REQUIRE(in.is_open());
+        std::stringstream json;
+        json << in.rdbuf();
+        REQUIRE(json.str().find("\"smt.asserted_clauses\": 12") != std::string::npos);
+    }
+
+    SECTION("sat with a disjunction in both polarities")
+    {
+        test.input() << "(define-fun t () Bool (or a b))\n";
+        test.input() << "(assert (or t (< x 0)))\n";
+        test.input() << "(assert (or (not t) (> x 3)))\n";
+        test.input() << "(assert (not a))\n";
+        test.input() << "(assert (not b))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::SAT);
+        REQUIRE(test.real("x").value_or(Rational{0}) < Rational{0});
+    }
+
+    SECTION("unsat")
+    {
+        test.input() << "(assert (or (and a (< x 0)) (and (not a) (< x 1))))\n";
+        test.input() << "(assert (not (or (< x 5) (and b c))))\n";
+        test.run();
+
+        REQUIRE(test.answer() == Solver_answer::UNSAT);
+    }
+
+    std::filesystem::remove(path);
+}
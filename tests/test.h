@@ -15,6 +15,7 @@
 #include "test_expr.h"
 #include "Literal.h"
 #include "Clause.h"
+#include "Solver.h"
 #include "Linear_constraints.h"
 #include "Rational.h"
 #include "Solver_answer.h"
@@ -64,6 +65,43 @@ inline Clause clause(Linear_constraint<Value> cons, Linear_constraint<Tail>... t
     return clause(cons.lit(), tail.lit()...);
 }
 
+// create clauses of the pigeonhole principle for `pigeons` pigeons and `holes` holes (boolean
+// variable `pigeon * holes + hole` is true iff the pigeon is in the hole)
+inline std::vector<std::vector<yaga::Literal>> pigeonhole(int pigeons, int holes)
+{
+    auto var = [&](int pigeon, int hole) { return lit(pigeon * holes + hole); };
+    std::vector<std::vector<yaga::Literal>> clauses;
+    for (int p = 0; p < pigeons; ++p)
+    {
+        auto& clause = clauses.emplace_back();
+        for (int h = 0; h < holes; ++h)
+        {
+            clause.push_back(var(p, h));
+        }
+    }
+    for (int h = 0; h < holes; ++h)
+    {
+        for (int p = 0; p < pigeons; ++p)
+        {
+            for (int q = p + 1; q < pigeons; ++q)
+            {
+                clauses.push_back({~var(p, h), ~var(q, h)});
+            }
+        }
+    }
+    return clauses;
+}
+
+// assert clauses of the pigeonhole principle (see `pigeonhole()`) in `solver`
+inline void assert_pigeonhole(yaga::Solver& solver, int pigeons, int holes)
+{
+    solver.trail().set_model<bool>(Variable::boolean, pigeons * holes);
+    for (auto& clause : pigeonhole(pigeons, holes))
+    {
+        solver.db().assert_clause(std::move(clause));
+    }
+}
+
 /** Parse formula in LRA and run the solver.
  */
 class Yaga_test {
@@ -411,6 +449,12 @@ public:
      */
     inline yaga::Solver_answer answer() const { return last_answer; }
 
+    /** Set solver options used by the next `run()`
+     *
+     * @param opts new solver options
+     */
+    inline void set_options(Options const& opts) { parser.set_options(opts); }
+
     /** Run the parser with `input()`.
      */
     inline void run()
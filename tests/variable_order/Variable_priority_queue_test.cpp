@@ -4,11 +4,56 @@
 
 #include "Variable_priority_queue.h"
 
+namespace {
+
+// priority queue with its own score vector
+struct Scored_queue {
+    std::vector<float> scores;
+    yaga::Variable_priority_queue pq{scores};
+
+    inline void set_score(yaga::Variable var, float score)
+    {
+        auto index = yaga::Variable_priority_queue::index(var);
+        if (scores.size() <= index)
+        {
+            scores.resize(index + 1, 0.f);
+        }
+        scores[index] = score;
+    }
+
+    inline void push(yaga::Variable var, float score)
+    {
+        set_score(var, score);
+        pq.push(var);
+    }
+
+    inline void update(yaga::Variable var, float score)
+    {
+        set_score(var, score);
+        pq.increase(var);
+    }
+
+    inline void rescale(float factor)
+    {
+        for (auto& score : scores)
+        {
+            score /= factor;
+        }
+        pq.rebuild();
+    }
+
+    inline bool empty() const { return pq.empty(); }
+    inline yaga::Variable top() { return pq.top(); }
+    inline void pop() { pq.pop(); }
+};
+
+} // namespace
+
 TEST_CASE("Insert variables to the priority queue", "[variable_priority_queue]")
 {
     using namespace yaga;
 
-    Variable_priority_queue pq;
+    Scored_queue pq;
     REQUIRE(pq.empty());
 
     SECTION("in ascending order")
@@ -66,7 +111,7 @@ TEST_CASE("Increase score of variables in the priority queue", "[variable_priori
 {
     using namespace yaga;
 
-    Variable_priority_queue pq;
+    Scored_queue pq;
     REQUIRE(pq.empty());
 
     pq.push(Variable{1, Variable::boolean}, 1.f);
@@ -102,7 +147,7 @@ TEST_CASE("Replace a range of values", "[variable_priority_queue]")
 {
     using namespace yaga;
 
-    Variable_priority_queue pq;
+    Scored_queue pq;
     REQUIRE(pq.empty());
 
     pq.push(Variable{1, Variable::boolean}, 1);
@@ -140,7 +185,7 @@ TEST_CASE("Add a large number of variables to the queue", "[variable_priority_qu
 {
     using namespace yaga;
 
-    Variable_priority_queue pq;
+    Scored_queue pq;
     REQUIRE(pq.empty());
 
     int constexpr num_vars = 20;
@@ -163,7 +208,7 @@ TEST_CASE("Reorder variables after rescale resets scores to 0", "[variable_prior
 {
     using namespace yaga;
 
-    Variable_priority_queue pq;
+    Scored_queue pq;
     REQUIRE(pq.empty());
 
     int constexpr num_vars = 50;
@@ -179,4 +224,51 @@ TEST_CASE("Reorder variables after rescale resets scores to 0", "[variable_prior
         REQUIRE(pq.top() == Variable{i, Variable::boolean});
         pq.pop();
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Increase score of a variable which is not in the queue", "[variable_priority_queue]")
+{
+    using namespace yaga;
+
+    Scored_queue pq;
+    pq.push(Variable{0, Variable::boolean}, 1.f);
+    pq.push(Variable{0, Variable::rational}, 2.f);
+    pq.push(Variable{1, Variable::boolean}, 3.f);
+    pq.pop();
+    REQUIRE(!pq.pq.contains(Variable{1, Variable::boolean}));
+
+    pq.update(Variable{1, Variable::boolean}, 4.f);
+    REQUIRE(pq.top() == Variable{0, Variable::rational});
+
+    pq.pq.push(Variable{1, Variable::boolean});
+    REQUIRE(pq.top() == Variable{1, Variable::boolean});
+}
+
+TEST_CASE("Rebuild the queue after all scores change", "[variable_priority_queue]")
+{
+    using namespace yaga;
+
+    Scored_queue pq;
+
+    int constexpr num_vars = 30;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        pq.push(Variable{i, Variable::boolean}, i);
+        pq.push(Variable{i, Variable::rational}, i + 0.5f);
+    }
+
+    // reverse the order
+    for (auto& score : pq.scores)
+    {
+        score = -score;
+    }
+    pq.pq.rebuild();
+
+    for (int i = 0; i < num_vars; ++i)
+    {
+        REQUIRE(pq.top() == Variable{i, Variable::boolean});
+        pq.pop();
+        REQUIRE(pq.top() == Variable{i, Variable::rational});
+        pq.pop();
+    }
+    REQUIRE(pq.empty());
+}
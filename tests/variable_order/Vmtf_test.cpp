@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test.h"
+#include "Vmtf.h"
+
+TEST_CASE("Pick the most recently added variable first", "[vmtf]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Vmtf vmtf;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&vmtf);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 3);
+
+    dispatcher.on_init(db, trail);
+
+    auto res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == bool_var(2));
+
+    trail.propagate(res.value(), nullptr, 0);
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == bool_var(1));
+
+    trail.propagate(res.value(), nullptr, 0);
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == bool_var(0));
+
+    trail.propagate(res.value(), nullptr, 0);
+    res = vmtf.pick(db, trail);
+    REQUIRE(!res);
+}
+
+TEST_CASE("Move variables in conflict to the front of the queue", "[vmtf]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Vmtf vmtf;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&vmtf);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 5);
+
+    dispatcher.on_init(db, trail);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        trail.decide(bool_var(i));
+    }
+
+    auto other = clause(lit(1), ~lit(3));
+    auto learned = clause(~lit(0), lit(1));
+    vmtf.on_conflict_resolved(db, trail, other);
+    vmtf.on_learned_clause(db, trail, learned);
+    // bumped variables keep their relative order
+    REQUIRE(vmtf.is_before(bool_var(3), bool_var(1)));
+    REQUIRE(vmtf.is_before(bool_var(1), bool_var(0)));
+    REQUIRE(vmtf.is_before(bool_var(0), bool_var(4)));
+
+    vmtf.on_before_backtrack(db, trail, 0);
+    trail.backtrack(0);
+
+    std::vector<Variable> order;
+    while (auto var = vmtf.pick(db, trail))
+    {
+        order.push_back(var.value());
+        trail.decide(var.value());
+    }
+    REQUIRE(order == std::vector{bool_var(3), bool_var(1), bool_var(0), bool_var(4), bool_var(2)});
+}
+
+TEST_CASE("Bump rational variables in linear constraints", "[vmtf]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Vmtf vmtf{lra};
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    dispatcher.add(&vmtf);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto [x, y, z] = real_vars<3>();
+    auto cons = linear(x < y);
+
+    dispatcher.on_init(db, trail);
+
+    trail.decide(cons.lit().var());
+    vmtf.on_learned_clause(db, trail, clause(cons.lit()));
+    vmtf.on_before_backtrack(db, trail, 0);
+    trail.backtrack(0);
+
+    auto res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == cons.lit().var());
+
+    trail.decide(res.value());
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == y);
+
+    trail.decide(res.value());
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == x);
+
+    trail.decide(res.value());
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == z);
+}
+
+TEST_CASE("Prefer effectively decided rational variables", "[vmtf]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.prop_rational = true;
+    lra.set_options(options);
+    Vmtf vmtf{lra};
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    dispatcher.add(&vmtf);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto [x, y, z] = real_vars<3>();
+    auto upper = linear(y <= 1);
+    auto lower = linear(y >= 1);
+
+    dispatcher.on_init(db, trail);
+
+    // z is at the front of the queue but y can only be 1
+    auto& bool_model = trail.model<bool>(Variable::boolean);
+    for (auto lit : {upper.lit(), lower.lit()})
+    {
+        bool_model.set_value(lit.var().ord(), !lit.is_negation());
+        trail.decide(lit.var());
+        REQUIRE(lra.propagate(db, trail).empty());
+    }
+
+    auto res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == y);
+
+    trail.model<Rational>(Variable::rational).set_value(y.ord(), 1);
+    trail.decide(y);
+    res = vmtf.pick(db, trail);
+    REQUIRE(res.value() == z);
+}
@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+"""Run `sat` and `smt` on benchmark instances and compare them with a stored baseline.
+
+Every instance is solved several times. The script records wall time, peak resident set size
+and solver statistics (`--stats-json` of `smt`, `name = value` lines of `sat`). If the baseline
+file does not exist (or `--update-baseline` is given), the results are stored as the new
+baseline. Otherwise, wall time and peak RSS of each instance are compared with the baseline by
+the Mann-Whitney U test and the overall change is tested by the Wilcoxon signed-rank test on
+per-instance ratios of medians. The script exits with status 1 if an answer differs from the
+baseline or if some instance is significantly slower.
+
+Usage: bench.py [--sat PATH] [--smt PATH] [--baseline PATH] INSTANCE_OR_DIRECTORY...
+(see `bench.py --help` for all options)
+"""
+
+import argparse
+import json
+import math
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+SAT_SUFFIXES = (".cnf", ".cnf.gz", ".cnf.xz", ".dimacs")
+SMT_SUFFIXES = (".smt2",)
+
+
+def find_instances(paths):
+    """Return sorted list of instance files in `paths` (files or directories)."""
+    result = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, _, files in os.walk(path):
+                for name in files:
+                    if name.endswith(SAT_SUFFIXES + SMT_SUFFIXES):
+                        result.append(os.path.join(root, name))
+        else:
+            result.append(path)
+    return sorted(result)
+
+
+def read_peak_rss(pid, exe):
+    """Return peak RSS in KiB (VmHWM on Linux) of process `pid` running `exe` or None."""
+    try:
+        # skip samples taken before `exec` (the memory of the forked script)
+        if os.path.realpath(f"/proc/{pid}/exe") != exe:
+            return None
+        with open(f"/proc/{pid}/status") as f:
+            for line in f:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1])
+    except (OSError, ValueError):
+        pass
+    return None
+
+
+def run_once(cmd, timeout):
+    """Run `cmd` and return (stdout, wall time in seconds, peak RSS in KiB, timed out).
+
+    `ru_maxrss` of a child includes memory of this script before `exec` on Linux so peak RSS is
+    sampled from `/proc` while the process runs (it is None if the process ends before the first
+    sample). `ru_maxrss` is used on systems without `/proc`.
+    """
+    exe = os.path.realpath(cmd[0])
+    with tempfile.TemporaryFile(mode="w+") as out:
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=out, stderr=subprocess.DEVNULL)
+
+        # wait for the process in a thread so that the wall time does not depend on sampling
+        finished = {}
+
+        def wait():
+            _, status, usage = os.wait4(proc.pid, 0)
+            finished.update(end=time.perf_counter(), status=status, usage=usage)
+
+        waiter = threading.Thread(target=wait)
+        waiter.start()
+        peak, timed_out, delay = None, False, 0.001
+        while waiter.is_alive():
+            sample = read_peak_rss(proc.pid, exe)
+            if sample is not None:
+                peak = max(peak or 0, sample)
+            if not timed_out and time.perf_counter() - start >= timeout:
+                proc.kill()
+                timed_out = True
+            waiter.join(delay)
+            delay = min(2 * delay, 0.05)
+        proc.returncode = os.waitstatus_to_exitcode(finished["status"])
+        elapsed = finished["end"] - start
+        usage = finished["usage"]
+        out.seek(0)
+        output = out.read()
+
+    if peak is None and not os.path.isdir("/proc"):
+        # ru_maxrss is in bytes on macOS and in KiB elsewhere
+        peak = usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss
+    return output, elapsed, peak, timed_out
+
+
+def parse_answer(out):
+    for line in out.splitlines():
+        word = line.strip().lower()
+        if word in ("sat", "unsat", "unknown"):
+            return word
+    return "error"
+
+
+def run_instance(path, args):
+    """Solve `path` `args.runs` times and return a dictionary with the measurements."""
+    is_smt = path.endswith(SMT_SUFFIXES)
+    times, rss = [], []
+    answer, stats = None, {}
+    for _ in range(args.runs):
+        if is_smt:
+            with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as f:
+                stats_path = f.name
+            out, elapsed, peak, timed_out = run_once(
+                [args.smt, "--stats-json", stats_path, path], args.timeout)
+            try:
+                with open(stats_path) as f:
+                    data = json.load(f)
+                stats = dict(data["counters"])
+                stats.update({name + ".seconds": timer["seconds"]
+                              for name, timer in data["timers"].items()})
+            except (OSError, ValueError, KeyError):
+                stats = {}
+            finally:
+                os.remove(stats_path)
+        else:
+            out, elapsed, peak, timed_out = run_once([args.sat, path], args.timeout)
+            stats = {}
+            for line in out.splitlines():
+                name, sep, value = line.partition("=")
+                if sep:
+                    try:
+                        stats[name.strip()] = float(value)
+                    except ValueError:
+                        pass
+
+        answer = "timeout" if timed_out else parse_answer(out)
+        times.append(elapsed)
+        rss.append(peak)
+        if timed_out:
+            break
+    return {"answer": answer, "time": times, "rss": rss, "stats": stats}
+
+
+def mann_whitney(xs, ys):
+    """Two-sided p-value of the Mann-Whitney U test (normal approximation with tie correction)."""
+    n1, n2 = len(xs), len(ys)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    values = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    ranks = [0.0] * len(values)
+    ties = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        count = j - i + 1
+        ties += count ** 3 - count
+        i = j + 1
+    rank_sum = sum(r for r, (_, group) in zip(ranks, values) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2) - 0.5) / math.sqrt(variance)
+    return min(1.0, 2 * (1 - statistics.NormalDist().cdf(max(z, 0.0))))
+
+
+def wilcoxon(diffs):
+    """Two-sided p-value of the Wilcoxon signed-rank test (normal approximation)."""
+    diffs = [d for d in diffs if d != 0]
+    n = len(diffs)
+    if n == 0:
+        return 1.0
+    order = sorted(range(n), key=lambda i: abs(diffs[i]))
+    ranks = [0.0] * n
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and abs(diffs[order[j + 1]]) == abs(diffs[order[i]]):
+            j += 1
+        for k in range(i, j + 1):
+            ranks[order[k]] = (i + j) / 2 + 1
+        i = j + 1
+    w = sum(r for r, d in zip(ranks, diffs) if d > 0)
+    mean = n * (n + 1) / 4
+    sd = math.sqrt(n * (n + 1) * (2 * n + 1) / 24)
+    z = (abs(w - mean) - 0.5) / sd
+    return min(1.0, 2 * (1 - statistics.NormalDist().cdf(max(z, 0.0))))
+
+
+def compare(baseline, current, alpha, threshold, min_time):
+    """Print comparison of `current` results with `baseline`. Return True iff there is no
+    regression."""
+    ok = True
+    log_ratios = []
+    print(f"{'instance':50} {'answer':>8} {'time':>9} {'ratio':>7} {'p':>6} "
+          f"{'rss[KiB]':>10} {'ratio':>7} {'p':>6}")
+    for path, result in current.items():
+        base = baseline.get(path)
+        if base is None:
+            print(f"{path:50} {result['answer']:>8}  (not in baseline)")
+            continue
+
+        flags = []
+        if result["answer"] != base["answer"]:
+            flags.append(f"ANSWER {base['answer']} -> {result['answer']}")
+            ok = False
+
+        time_ratio = statistics.median(result["time"]) / statistics.median(base["time"])
+        time_p = mann_whitney(result["time"], base["time"])
+        # runs which ended before the first sample of peak RSS are skipped
+        rss = [value for value in result["rss"] if value is not None]
+        base_rss = [value for value in base["rss"] if value is not None]
+        rss_median = statistics.median(rss) if rss else math.nan
+        rss_ratio = rss_median / statistics.median(base_rss) if rss and base_rss else math.nan
+        rss_p = mann_whitney(rss, base_rss)
+        log_ratios.append(math.log(time_ratio))
+        # timing of very short runs is dominated by noise
+        is_timed = statistics.median(base["time"]) >= min_time
+        if is_timed and time_p < alpha and time_ratio > 1 + threshold:
+            flags.append("SLOWER")
+            ok = False
+        elif is_timed and time_p < alpha and time_ratio < 1 - threshold:
+            flags.append("faster")
+        if rss_p < alpha and rss_ratio > 1 + threshold:
+            flags.append("MORE MEMORY")
+
+        # deterministic counters which changed (e.g., the number of conflicts)
+        changed = [name for name, value in result["stats"].items()
+                   if not name.endswith(("seconds", "time[s]")) and
+                   name in base["stats"] and base["stats"][name] != value]
+        if changed:
+            flags.append(f"{len(changed)} counters changed")
+
+        print(f"{path:50} {result['answer']:>8} {statistics.median(result['time']):9.3f} "
+              f"{time_ratio:7.3f} {time_p:6.3f} {rss_median:10.0f} "
+              f"{rss_ratio:7.3f} {rss_p:6.3f} {' '.join(flags)}")
+
+    if log_ratios:
+        geomean = math.exp(statistics.fmean(log_ratios))
+        p = wilcoxon(log_ratios)
+        print(f"\ngeometric mean of time ratios: {geomean:.3f} (Wilcoxon p = {p:.3f}, "
+              f"{len(log_ratios)} instances)")
+        if p < alpha and geomean > 1 + threshold:
+            print("overall: significantly slower")
+            ok = False
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("paths", nargs="+", help="instances or directories with instances")
+    parser.add_argument("--sat", default="build-release/sat", help="path to the sat executable")
+    parser.add_argument("--smt", default="build-release/smt", help="path to the smt executable")
+    parser.add_argument("--runs", type=int, default=5, help="number of runs of each instance")
+    parser.add_argument("--timeout", type=float, default=300, help="time limit of one run [s]")
+    parser.add_argument("--baseline", default="bench-baseline.json", help="baseline file")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="store the results as the new baseline")
+    parser.add_argument("--output", help="also store the results to this file")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="ignore relative changes smaller than this")
+    parser.add_argument("--min-time", type=float, default=0.1,
+                        help="do not flag time changes of instances faster than this [s]")
+    args = parser.parse_args()
+
+    instances = find_instances(args.paths)
+    if not instances:
+        print("No instances found.", file=sys.stderr)
+        return 2
+
+    results = {}
+    for path in instances:
+        results[path] = run_instance(path, args)
+        print(f"solved {path}: {results[path]['answer']} "
+              f"({statistics.median(results[path]['time']):.3f} s)", file=sys.stderr)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"instances": results}, f, indent=2)
+
+    if args.update_baseline or not os.path.exists(args.baseline):
+        with open(args.baseline, "w") as f:
+            json.dump({"instances": results}, f, indent=2)
+        print(f"Stored baseline of {len(results)} instances to {args.baseline}")
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)["instances"]
+    return 0 if compare(baseline, results, args.alpha, args.threshold, args.min_time) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())